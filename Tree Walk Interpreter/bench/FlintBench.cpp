@@ -0,0 +1,317 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintBench.cpp – Phase Timings of the Benchmark Workloads (flint_bench)
+// ─────────────────────────────────────────────────────────────────────────────
+//  Usage: flint_bench [--runs=N] [--engine=tree|vm|closure] [-O|-O0] [--out=FILE]
+//                     [workload.flint ...]
+//
+//  Runs each workload (by default every .flint file in the bench directory)
+//  N times, each time from the source text on a fresh interpreter, and times
+//  the phases of Flint::run separately:
+//
+//    scan       Scanner alone, over the whole text
+//    parse      Parser (which drives the Scanner itself, so this includes
+//               a second scan)
+//    resolve    Resolver
+//    optimize   Optimizer (skipped with -O0)
+//    interpret  Interpreter::interpret (lowering included with
+//               --engine=closure), or with --engine=vm:
+//    compile    Compiler, and
+//    run        VM::interpret
+//
+//  `total` is everything but the separate scan.  The results – every
+//  sample and the min/median/mean of each phase, in milliseconds – are
+//  written as JSON to FILE (stdout by default), with a summary on stderr.
+//  The workloads' own output is discarded; one that reports an error fails
+//  the benchmark (exit status 1).
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Flint/Flint.h"
+#include "Flint/Heap.h"
+#include "Flint/Scanner/Scanner.h"
+#include "Flint/Scanner/SourceText.h"
+#include "Flint/Parser/Parser.h"
+#include "Flint/Resolver/Resolver.h"
+#include "Flint/Optimizer/Optimizer.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/VM/Compiler.h"
+#include "Flint/VM/VM.h"
+
+#ifndef FLINT_BENCH_DIR
+#define FLINT_BENCH_DIR "bench"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    size_t runs = 5;
+    Engine engine = Engine::TREE_WALK;
+    bool optimize = true;
+    std::string out;                  // Empty: stdout
+    std::vector<std::string> files;
+};
+
+// One phase of one workload: its time in every run
+struct Phase {
+    std::string name;
+    std::vector<double> samples;      // Milliseconds
+
+    double min() const { return *std::min_element(samples.begin(), samples.end()); }
+    double mean() const
+    {
+        double sum = 0;
+        for (double s : samples) sum += s;
+        return sum / samples.size();
+    }
+    double median() const
+    {
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        size_t mid = sorted.size() / 2;
+        return sorted.size() % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+    }
+};
+
+struct Result {
+    std::string name;                 // The file name without .flint
+    std::string path;
+    std::vector<Phase> phases;        // In pipeline order, then total
+};
+
+// Swallows what it is given: the workloads' prints
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+double since(Clock::time_point& start)
+{
+    Clock::time_point now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+    return ms;
+}
+
+// Runs the workload once; adds each phase's time to `result`, in order.
+// False (with the reason in `error`) if it reported an error.
+bool runOnce(const std::shared_ptr<const SourceText>& source, const Options& options,
+             Result& result, std::string& error)
+{
+    std::vector<std::pair<const char*, double>> times;
+    NullBuffer discard;
+    std::ostringstream diagnostics;
+    std::streambuf* out = std::cout.rdbuf(&discard);
+    std::streambuf* err = std::cerr.rdbuf(diagnostics.rdbuf());
+
+    {
+        // The interpreter's closures point into the arena: it goes first
+        auto arena = std::make_unique<AstArena>();
+        arena->source = source;
+        auto interpreter = std::make_unique<Interpreter>();
+
+        Clock::time_point start = Clock::now();
+        Scanner scanner(source->text());
+        while (scanner.next().type != TokenType::END_OF_FILE) {}
+        times.emplace_back("scan", since(start));
+
+        Scanner lexer(source->text());
+        std::vector<StmtPtr> statements = Parser(lexer, *arena).parse();
+        times.emplace_back("parse", since(start));
+
+        if (diagnostics.tellp() == 0) {
+            Resolver().resolve(statements);
+            times.emplace_back("resolve", since(start));
+        }
+        if (diagnostics.tellp() == 0 && options.optimize) {
+            Optimizer(*arena, *interpreter).optimize(statements);
+            times.emplace_back("optimize", since(start));
+        }
+        if (diagnostics.tellp() == 0 && options.engine == Engine::VM) {
+            Compiler compiler;
+            Ref<VMFunction> script = compiler.compile(statements);
+            times.emplace_back("compile", since(start));
+            if (diagnostics.tellp() == 0) {
+                VM vm(*interpreter);
+                vm.interpret(script);
+                times.emplace_back("run", since(start));
+            }
+        }
+        else if (diagnostics.tellp() == 0) {
+            if (options.engine == Engine::CLOSURE) interpreter->lowerToClosures();
+            interpreter->interpret(statements);
+            times.emplace_back("interpret", since(start));
+        }
+
+        interpreter.reset();
+        Heap::collect();
+    }
+
+    std::cout.rdbuf(out);
+    std::cerr.rdbuf(err);
+
+    if (diagnostics.tellp() != 0) {
+        error = diagnostics.str();
+        return false;
+    }
+
+    double total = 0;
+    for (size_t i = 0; i < times.size(); ++i) {
+        if (result.phases.size() == i) result.phases.push_back(Phase{times[i].first, {}});
+        result.phases[i].samples.push_back(times[i].second);
+        if (i > 0) total += times[i].second;
+    }
+    if (result.phases.size() == times.size()) result.phases.push_back(Phase{"total", {}});
+    result.phases.back().samples.push_back(total);
+    return true;
+}
+
+std::string quoted(const std::string& text)
+{
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+const char* engineName(Engine engine)
+{
+    switch (engine) {
+        case Engine::VM:      return "\"vm\"";
+        case Engine::CLOSURE: return "\"closure\"";
+        default:              return "\"tree\"";
+    }
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results)
+{
+    out << std::setprecision(6);
+    out << "{\n"
+        << "  \"engine\": " << engineName(options.engine) << ",\n"
+        << "  \"optimize\": " << (options.optimize ? "true" : "false") << ",\n"
+        << "  \"runs\": " << options.runs << ",\n"
+        << "  \"unit\": \"ms\",\n"
+        << "  \"benchmarks\": [";
+    for (size_t b = 0; b < results.size(); ++b) {
+        const Result& result = results[b];
+        out << (b ? "," : "") << "\n    {\n"
+            << "      \"name\": " << quoted(result.name) << ",\n"
+            << "      \"file\": " << quoted(result.path) << ",\n"
+            << "      \"phases\": {";
+        for (size_t p = 0; p < result.phases.size(); ++p) {
+            const Phase& phase = result.phases[p];
+            out << (p ? "," : "") << "\n        " << quoted(phase.name) << ": {"
+                << "\"min\": " << phase.min() << ", \"median\": " << phase.median()
+                << ", \"mean\": " << phase.mean() << ", \"samples\": [";
+            for (size_t s = 0; s < phase.samples.size(); ++s)
+                out << (s ? ", " : "") << phase.samples[s];
+            out << "]}";
+        }
+        out << "\n      }\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeSummary(std::ostream& out, const std::vector<Result>& results)
+{
+    out << std::fixed << std::setprecision(3);
+    for (const Result& result : results) {
+        out << std::left << std::setw(12) << result.name << std::right;
+        for (const Phase& phase : result.phases)
+            out << "  " << phase.name << " " << phase.median();
+        out << "  (median ms)\n";
+    }
+}
+
+[[noreturn]] void usage(const std::string& problem, const std::string& arg)
+{
+    std::cerr << problem << ": " << arg << "\n"
+              << "Usage: flint_bench [--runs=N] [--engine=tree|vm|closure] [-O|-O0] [--out=FILE]"
+                 " [workload.flint ...]\n";
+    exit(64);
+}
+
+Options parseOptions(int argc, char const* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--engine=tree") options.engine = Engine::TREE_WALK;
+        else if (arg == "--engine=vm") options.engine = Engine::VM;
+        else if (arg == "--engine=closure") options.engine = Engine::CLOSURE;
+        else if (arg == "-O") options.optimize = true;
+        else if (arg == "-O0") options.optimize = false;
+        else if (arg.rfind("--out=", 0) == 0) options.out = arg.substr(6);
+        else if (arg.rfind("--runs=", 0) == 0) {
+            std::string value = arg.substr(7);
+            size_t used = 0;
+            try {
+                options.runs = std::stoul(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != value.size() || options.runs == 0)
+                usage("Invalid value", arg);
+        }
+        else if (arg.rfind("-", 0) == 0) usage("Unknown option", arg);
+        else options.files.push_back(arg);
+    }
+
+    if (options.files.empty()) {
+        for (const auto& entry : std::filesystem::directory_iterator(FLINT_BENCH_DIR))
+            if (entry.path().extension() == ".flint")
+                options.files.push_back(entry.path().string());
+        std::sort(options.files.begin(), options.files.end());
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    Options options = parseOptions(argc, argv);
+
+    std::vector<Result> results;
+    for (const std::string& path : options.files) {
+        std::shared_ptr<const SourceText> source = SourceText::fromFile(path);
+        if (!source) {
+            std::cerr << "Error: Could not open source file: " << path << "\n";
+            return 74;
+        }
+
+        Result result{std::filesystem::path(path).stem().string(), path, {}};
+        for (size_t run = 0; run < options.runs; ++run) {
+            std::string error;
+            if (!runOnce(source, options, result, error)) {
+                std::cerr << path << " failed:\n" << error;
+                return 1;
+            }
+        }
+        results.push_back(std::move(result));
+    }
+
+    if (options.out.empty()) writeJson(std::cout, options, results);
+    else {
+        std::ofstream file(options.out);
+        if (!file) {
+            std::cerr << "Error: Could not write results: " << options.out << "\n";
+            return 74;
+        }
+        writeJson(file, options, results);
+    }
+    writeSummary(std::cerr, results);
+    return 0;
+}
@@ -5,6 +5,9 @@
 // ─────────────────────────────────────────────────────────────────────────────
 //  Defines every kind of expression in Flint.  Parsers build these nodes,
 //  and the Interpreter walks them to evaluate code.
+//
+//  All nodes of one compilation unit are owned by its AstArena; nodes point
+//  to each other with plain, non-owning pointers (ExprPtr, StmtPtr).
 // ─────────────────────────────────────────────────────────────────────────────
 
 #include <memory>
@@ -13,6 +16,7 @@
 #include <variant>
 #include "Flint/Scanner/Token.h"      // Token type for operators, identifiers, literals
 #include "Flint/Parser/Value.h"      // LiteralValue variant holding runtime values
+#include "Flint/Callables/Classes/Shape.h"  // PropertyCache for Get/Set sites
 
 // ─────────────────────────────────────────────────────────────
 //  Forward declarations of all statement types
@@ -24,7 +28,7 @@ struct WhileStmt;
 struct ReturnStmt;
 struct BreakStmt;
 struct ContinueStmt;
-struct TryCatchContinueStmt;
+struct ForStmt;
 struct LetStmt;
 struct BlockStmt;
 struct ClassStmt;
@@ -41,13 +45,16 @@ using Statement = std::variant<
     ReturnStmt,
     BreakStmt,
     ContinueStmt,
-    TryCatchContinueStmt,
+    ForStmt,
     IfStmt, 
     LetStmt, 
     BlockStmt,
     ClassStmt
 >;
 
+// Non-owning pointer to a Statement allocated in the AstArena
+using StmtPtr = Statement*;
+
 // ─────────────────────────────────────────────────────────────
 //  Forward declarations of all expression structs
 // ─────────────────────────────────────────────────────────────
@@ -73,7 +80,7 @@ struct SetIndex;
 //  ExpressionNode
 // ─────────────────────────────────────────────────────────────
 //  Variant over each expression type.  An ExprPtr points to one
-//  of these by wrapping in shared_ptr for polymorphic storage.
+//  of these, allocated in the AstArena.
 using ExpressionNode = std::variant<
     Binary,
     Call,
@@ -97,8 +104,26 @@ using ExpressionNode = std::variant<
 // ─────────────────────────────────────────────────────────────
 //  ExprPtr
 // ─────────────────────────────────────────────────────────────
-//  Shared pointer to an ExpressionNode, for nesting and ownership.
-using ExprPtr = std::shared_ptr<ExpressionNode>;
+//  Non-owning pointer to an ExpressionNode allocated in the
+//  AstArena; the arena outlives every reference into the tree.
+using ExprPtr = ExpressionNode*;
+
+// ─────────────────────────────────────────────────────────────
+//  LocalSlot: resolved address of a variable reference, written
+//  into the node by the Resolver.
+//    depth: environments to walk outward from the current one
+//           (-1 marks a global, looked up by name)
+//    slot : index into that environment's slot array
+//    global: for a global, its index in the global table once a
+//           lookup has found it (see Environment::getCached)
+// ─────────────────────────────────────────────────────────────
+struct LocalSlot {
+    int depth = -1;
+    int slot = -1;
+    mutable uint32_t global = UINT32_MAX;   // Environment::NOT_CACHED
+
+    bool isGlobal() const { return depth < 0; }
+};
 
 // ─────────────────────────────────────────────────────────────
 //  Binary: left op right
@@ -108,6 +133,20 @@ struct Binary {
     Token    op;    // operator token (e.g. '+', '==')
     ExprPtr right;  // right operand
 
+    // Specialization chosen from the operand types this site sees (type
+    // feedback, written by the Evaluator).  UNSEEN until the first
+    // evaluation; a specialized site checks one cheap guard and runs its
+    // operation directly.  When the guard fails it falls back to GENERIC
+    // (the full type dispatch) for good.
+    enum class Quickened : uint8_t {
+        UNSEEN, GENERIC,
+        ADD_NUMBERS, SUBTRACT_NUMBERS, MULTIPLY_NUMBERS, DIVIDE_NUMBERS, MODULO_NUMBERS,
+        LESS_NUMBERS, LESS_EQUAL_NUMBERS, GREATER_NUMBERS, GREATER_EQUAL_NUMBERS,
+        EQUAL_NUMBERS, NOT_EQUAL_NUMBERS,
+        CONCAT_STRINGS,
+    };
+    mutable Quickened quickened = Quickened::UNSEEN;
+
     Binary(ExprPtr left, Token op, ExprPtr right)
         : left(std::move(left)), op(std::move(op)), right(std::move(right)) {}
 };
@@ -186,6 +225,7 @@ struct Grouping {
 // ─────────────────────────────────────────────────────────────
 struct Variable {
     Token name;  // identifier token
+    mutable LocalSlot local;  // resolved address (global by default)
 
     Variable(Token name)
         : name(std::move(name)) {}
@@ -197,6 +237,7 @@ struct Variable {
 struct Assignment {
     Token   name;   // variable name token
     ExprPtr value;  // expression to assign
+    mutable LocalSlot local;  // resolved address of the target (global by default)
 
     Assignment(Token name, ExprPtr value)
         : name(std::move(name)), value(std::move(value)) {}
@@ -206,10 +247,10 @@ struct Assignment {
 //  Lambda: anonymous function literal
 // ─────────────────────────────────────────────────────────────
 struct Lambda {
-    std::shared_ptr<FunctionStmt> function;  // holds parameters and body
+    FunctionStmt* function;  // holds parameters and body (arena-owned)
 
-    Lambda(std::shared_ptr<FunctionStmt> function)
-        : function(std::move(function)) {}
+    Lambda(FunctionStmt* function)
+        : function(function) {}
 };
 
 // ─────────────────────────────────────────────────────────────
@@ -218,6 +259,7 @@ struct Lambda {
 struct Get {
     ExprPtr object;  // expression evaluating to an instance
     Token   name;    // property name token
+    mutable PropertyCache cache;  // shapes seen at this site
 
     Get(ExprPtr object, Token name)
         : object(std::move(object)), name(std::move(name)) {}
@@ -230,6 +272,7 @@ struct Set {
     ExprPtr object;  // target instance expression
     Token   name;    // property name token
     ExprPtr value;   // value expression
+    mutable PropertyCache cache;  // shapes seen at this site
 
     Set(ExprPtr object, Token name, ExprPtr value)
         : object(std::move(object))
@@ -242,6 +285,7 @@ struct Set {
 // ─────────────────────────────────────────────────────────────
 struct This {
     Token keyword;  // 'this' token, used for errors and binding
+    mutable LocalSlot local;  // resolved address of 'this'
 
     This(Token keyword)
         : keyword(std::move(keyword)) {}
@@ -253,6 +297,8 @@ struct This {
 struct Super {
     Token keyword;
     Token method;
+    mutable LocalSlot local;  // resolved address of 'super' ('this' is one scope closer)
+    mutable PropertyCache cache;  // superclasses seen at this site, by root shape
 
     Super(Token keyword, Token method) : keyword(keyword), method(method) {}
 };
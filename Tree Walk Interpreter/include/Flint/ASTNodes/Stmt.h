@@ -14,6 +14,12 @@
 #include <variant>
 #include <optional>
 #include "ExpressionNode.h"  // Provides ExprPtr for embedding expressions
+#include "Flint/Callables/Functions/FunctionType.h"
+#include "Flint/Callables/Classes/ClassType.h"
+
+class LoweredStmt;  // A function body lowered by the closure engine (ClosureCompiler.h)
+class AstArena;
+class Flint;
 
 // ─────────────────────────────────────────────────────────────
 //  Forward declarations of statement structs
@@ -25,7 +31,7 @@ struct WhileStmt;
 struct ReturnStmt;
 struct BreakStmt;
 struct ContinueStmt;
-struct TryCatchContinueStmt;
+struct ForStmt;
 struct LetStmt;
 struct BlockStmt;
 struct ClassStmt;
@@ -42,19 +48,28 @@ using Statement = std::variant<
     ReturnStmt,
     BreakStmt,
     ContinueStmt,
-    TryCatchContinueStmt,
+    ForStmt,
     IfStmt,
     LetStmt,
     BlockStmt,
     ClassStmt
 >;
 
+// ─────────────────────────────────────────────────────────────
+//  StmtBase
+// ─────────────────────────────────────────────────────────────
+//  What every statement carries: the line it starts on, set by the
+//  Parser (0 for nodes the Optimizer makes).  Read by the profiler.
+struct StmtBase {
+    size_t line = 0;
+};
+
 // ─────────────────────────────────────────────────────────────
 //  ExpressionStmt
 // ─────────────────────────────────────────────────────────────
 //  Wraps an expression as a statement to evaluate it for side effects
 //  Example: `x + 1;` discards the result but may trigger errors or calls
-struct ExpressionStmt {
+struct ExpressionStmt : StmtBase {
     ExprPtr expression;  // Expression to evaluate
 
     ExpressionStmt(ExprPtr expr)
@@ -65,33 +80,69 @@ struct ExpressionStmt {
 //  IfStmt
 // ─────────────────────────────────────────────────────────────
 //  Conditional execution of thenBranch or elseBranch based on condition.
-struct IfStmt {
+struct IfStmt : StmtBase {
     ExprPtr condition;                        // Boolean expression
-    std::shared_ptr<Statement> thenBranch;    // Executed when true
-    std::shared_ptr<Statement> elseBranch;    // Executed when false (optional)
+    StmtPtr thenBranch;    // Executed when true
+    StmtPtr elseBranch;    // Executed when false (optional)
 
     IfStmt(ExprPtr condition,
-           std::shared_ptr<Statement> thenBranch,
-           std::shared_ptr<Statement> elseBranch)
+           StmtPtr thenBranch,
+           StmtPtr elseBranch)
         : condition(std::move(condition)),
           thenBranch(std::move(thenBranch)),
           elseBranch(std::move(elseBranch)) {}
 };
 
+// ─────────────────────────────────────────────────────────────
+//  DeferredBody
+// ─────────────────────────────────────────────────────────────
+//  The body of a top-level function or method that the Parser only
+//  skipped over (Flint::lazy): where it is, and what parsing and
+//  resolving it on the first call needs (Flint::compileBody).
+struct DeferredBody {
+    Flint* context;      // The context whose unit it is
+    AstArena* arena;     // The unit: its source, and where the body's nodes go
+    uint32_t offset;     // Of the body's '{' in the unit's source
+    size_t line;         // Line of the '{'
+
+    // Filled in by the Resolver and the Optimizer, which meet the
+    // declaration without its body
+    FunctionType type = FunctionType::FUNCTION;
+    ClassType classType = ClassType::NONE;   // Of the class around a method
+    bool optimize = false;                   // Optimize the body once parsed
+    bool failed = false;                     // It had errors, already reported
+};
+
 // ─────────────────────────────────────────────────────────────
 //  FunctionStmt
 // ─────────────────────────────────────────────────────────────
 //  Declares a (possibly anonymous) function or getter in the current scope.
 //  If isGetter==true, the function is invoked as a property getter.
-struct FunctionStmt {
+struct FunctionStmt : StmtBase {
     std::optional<Token> name;                 // Function name; empty for lambdas
     std::vector<Token> params;                 // Parameter names
-    std::vector<std::shared_ptr<Statement>> body; // Statements in function body
+    mutable std::vector<StmtPtr> body;         // Statements in function body (empty while deferred)
     bool isGetter;                             // Marks getter methods
 
+    // Set while the body is still unparsed (in the unit's arena)
+    mutable DeferredBody* deferred = nullptr;
+
+    // Filled in by the Resolver, once per declaration.  Together with the
+    // node itself this is the function's template: every closure created
+    // from it is just the template pointer plus the captured environment.
+    mutable int slot = -1;       // Slot of the function's name in its scope (-1 = global)
+    mutable int arity = 0;       // Number of parameters
+    mutable int slotCount = 0;   // Size of the call frame (parameters + body locals)
+    mutable bool isInitializer = false; // A class's init(): calls return 'this'
+    mutable bool hasReceiver = false;  // Method: slot 0 of the frame holds 'this'
+    mutable bool isCaptured = false;   // A closure created in the body can outlive the call
+
+    // The body lowered by the closure engine, on the first call (nullptr before)
+    mutable const LoweredStmt* lowered = nullptr;
+
     FunctionStmt(std::optional<Token> name,
                  std::vector<Token> params,
-                 std::vector<std::shared_ptr<Statement>> body,
+                 std::vector<StmtPtr> body,
                  bool isGetter = false)
         : name(std::move(name)),
           params(std::move(params)),
@@ -103,12 +154,12 @@ struct FunctionStmt {
 //  WhileStmt
 // ─────────────────────────────────────────────────────────────
 //  Repeatedly executes statement as long as condition is true.
-struct WhileStmt {
+struct WhileStmt : StmtBase {
     ExprPtr condition;                      // Loop condition expression
-    std::shared_ptr<Statement> statement;   // Body to execute each iteration
+    StmtPtr statement;   // Body to execute each iteration
 
     WhileStmt(ExprPtr condition,
-              std::shared_ptr<Statement> statement)
+              StmtPtr statement)
         : condition(std::move(condition)),
           statement(std::move(statement)) {}
 };
@@ -117,7 +168,7 @@ struct WhileStmt {
 //  ReturnStmt
 // ─────────────────────────────────────────────────────────────
 //  Exits a function, optionally returning a value.
-struct ReturnStmt {
+struct ReturnStmt : StmtBase {
     Token keyword;  // 'return' token, used for error reporting
     ExprPtr val;    // Expression whose value is returned
 
@@ -129,26 +180,48 @@ struct ReturnStmt {
 //  BreakStmt & ContinueStmt
 // ─────────────────────────────────────────────────────────────
 //  Alters control flow of loops.  Break exits, continue skips to next
-struct BreakStmt {
+//  Set by the Resolver: insideLoop is false when no loop of the
+//  same function encloses the statement (a runtime error if reached).
+struct BreakStmt : StmtBase {
     Token keyword;
+    mutable bool insideLoop = false;
     BreakStmt(Token keyword) : keyword(std::move(keyword)) {}
 };
 
-struct ContinueStmt {
+struct ContinueStmt : StmtBase {
     Token keyword;
+    mutable bool insideLoop = false;
     ContinueStmt(Token keyword) : keyword(std::move(keyword)) {}
 };
 
 // ─────────────────────────────────────────────────────────────
-//  TryCatchContinueStmt
+//  ForStmt
 // ─────────────────────────────────────────────────────────────
-//  Used internally for desugaring 'for' loops: wraps loop body
-//  so that 'continue' can advance the loop index before repeating.
-struct TryCatchContinueStmt {
-    std::shared_ptr<Statement> body;  // Original loop body
+//  for (initializer; condition; increment) body
+//  Variables declared by the initializer live in one scope for
+//  the whole loop.  'continue' skips the rest of the body but
+//  still runs the increment.
+struct ForStmt : StmtBase {
+    StmtPtr initializer;  // LetStmt or ExpressionStmt; nullptr if omitted
+    ExprPtr condition;    // nullptr: loop until break or return
+    ExprPtr increment;    // nullptr if omitted
+    StmtPtr body;
+
+    // Filled in by the Resolver:
+    mutable int slotCount = 0;        // Locals of the loop's scope
+    mutable bool hasScope = false;    // The initializer declares variables
+    mutable bool isCaptured = false;  // A closure created inside can outlive the loop
 
-    TryCatchContinueStmt(std::shared_ptr<Statement> body)
-        : body(std::move(body)) {}
+    // Counted loop, `for (let i = a; i < n; i = i + step)` (with <, <=, >,
+    // >= and + or -): slot of `i` in the loop's scope, or -1 if the loop
+    // has another shape.  The condition and increment then read and bump
+    // the slot directly while it holds a number.
+    mutable int counterSlot = -1;
+    mutable double step = 0;
+
+    ForStmt(StmtPtr initializer, ExprPtr condition, ExprPtr increment, StmtPtr body)
+        : initializer(initializer), condition(condition),
+          increment(increment), body(body) {}
 };
 
 // ─────────────────────────────────────────────────────────────
@@ -156,9 +229,12 @@ struct TryCatchContinueStmt {
 // ─────────────────────────────────────────────────────────────
 //  Declares one or more variables in the current environment.
 //  Example: `let x = 5, y = 10;`
-struct LetStmt {
+struct LetStmt : StmtBase {
     std::vector<std::pair<Token, ExprPtr>> declarations;
 
+    // Slot of each declared name, filled in by the Resolver (empty = global)
+    mutable std::vector<int> slots;
+
     LetStmt(std::vector<std::pair<Token, ExprPtr>> declarations)
         : declarations(std::move(declarations)) {}
 };
@@ -167,10 +243,15 @@ struct LetStmt {
 //  BlockStmt
 // ─────────────────────────────────────────────────────────────
 //  A sequence of statements with its own scope.
-struct BlockStmt {
-    std::vector<std::shared_ptr<Statement>> statements;
+struct BlockStmt : StmtBase {
+    std::vector<StmtPtr> statements;
 
-    BlockStmt(std::vector<std::shared_ptr<Statement>> statements)
+    // Filled in by the Resolver:
+    mutable int slotCount = 0;       // Number of locals declared directly in this block
+    mutable bool hasScope = true;    // False if it declares nothing (runs in the enclosing scope)
+    mutable bool isCaptured = false; // A closure created inside can outlive the block
+
+    BlockStmt(std::vector<StmtPtr> statements)
         : statements(std::move(statements)) {}
 };
 
@@ -178,16 +259,19 @@ struct BlockStmt {
 //  ClassStmt
 // ─────────────────────────────────────────────────────────────
 //  Declares a class with instance and static (class) methods.
-struct ClassStmt {
+struct ClassStmt : StmtBase {
     Token name;  // Class identifier
     ExprPtr superClass;
-    std::vector<std::shared_ptr<Statement>> instanceMethods; // Methods on instances
-    std::vector<std::shared_ptr<Statement>> classMethods;    // Static methods
+    std::vector<StmtPtr> instanceMethods; // Methods on instances
+    std::vector<StmtPtr> classMethods;    // Static methods
+
+    // Slot of the class name in its scope, filled in by the Resolver (-1 = global)
+    mutable int slot = -1;
 
     ClassStmt(Token name,
               ExprPtr superClass,
-              std::vector<std::shared_ptr<Statement>> instanceMethods,
-              std::vector<std::shared_ptr<Statement>> classMethods)
+              std::vector<StmtPtr> instanceMethods,
+              std::vector<StmtPtr> classMethods)
         : name(std::move(name)),
           superClass(std::move(superClass)),
           instanceMethods(std::move(instanceMethods)),
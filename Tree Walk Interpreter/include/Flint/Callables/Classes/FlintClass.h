@@ -5,49 +5,83 @@
 #include <unordered_map>
 #include "Flint/Callables/FlintCallable.h"
 #include "Flint/Callables/Classes/FlintInstance.h"
+#include "Flint/Callables/Classes/Shape.h"
 
 // Forward declaration to avoid circular dependency
 class FlintFunction;
 
 // FlintClass represents user-defined classes in Flint.
-// It is both callable (acts like a constructor) and an instance (supports method lookup).
-class FlintClass : public FlintCallable, public FlintInstance
+// It is callable (acts like a constructor) and supports static method lookup.
+class FlintClass : public FlintCallable
 {
 private:
     // Name of the class (used for display and debugging)
     const std::string name;
 
-    // Methods that instances of this class can call
-    mutable std::unordered_map<std::string, std::shared_ptr<FlintFunction>> instanceMethods;
+    // Methods that instances of this class can call, keyed by interned name.
+    // Inherited methods are copied down when the class is declared
+    // (Interpreter's ClassStmt), so a lookup never walks the superclass chain.
+    mutable std::unordered_map<Symbol, Ref<FlintFunction>> instanceMethods;
+
+    // Cached instanceMethods[init], null if there is none
+    FlintFunction* initializer = nullptr;
 
     
     // Static methods defined on the class itself
-    mutable std::unordered_map<std::string, std::shared_ptr<FlintFunction>> classMethods;
+    mutable std::unordered_map<Symbol, Ref<FlintFunction>> classMethods;
     
-    std::shared_ptr<FlintClass> superClass;
+    Ref<FlintClass> superClass;
+
+    // Root of the shape tree shared by this class's instances
+    Shape emptyShape;
+
+protected:
+    // Cycle collector: methods (whose closures usually hold the class) and the superclass
+    void trace(Tracer& trace) const override;
+    void clearReferences() override;
+
 public:
+    static bool classof(ObjectType type) { return type == ObjectType::CLASS; }
+
     // Returns a string representation of the class (e.g., the class name)
     std::string toString() const override { return name; }
 
     // Handles property/method access on the class itself (like static methods)
-    LiteralValue get(Token name, Interpreter& interpreter) override;
+    LiteralValue get(const Token& name, Interpreter& interpreter);
 
     // When the class is called (e.g., Circle(4)), this constructs a new instance.
     LiteralValue call(Interpreter &interpreter, 
                       const std::vector<LiteralValue> &args, 
                       const Token &paren) override;
 
-    // Looks up an instance method by name
-    std::shared_ptr<FlintFunction> findMethod(std::string name) const;
+    // Shape of a freshly created instance (no fields yet)
+    Shape* rootShape() { return &emptyShape; }
+
+    // Looks up an instance method by name, own or inherited (owned by the class)
+    FlintFunction* findMethod(Symbol name) const
+    {
+        auto it = instanceMethods.find(name);
+        return it != instanceMethods.end() ? it->second.get() : nullptr;
+    }
+
+    // Every instance method, inherited ones included (what a subclass copies down)
+    const std::unordered_map<Symbol, Ref<FlintFunction>>& methods() const { return instanceMethods; }
+
+    // Looks up a static (class) method by name
+    Ref<FlintFunction> findClassMethod(Symbol name) const;
 
     // Returns the number of parameters expected by the class's constructor
     int arity() const override;
 
-    // Constructor to initialize the class with its name, instance methods, and class (static) methods
+    // Constructor to initialize the class with its name, instance methods
+    // (inherited ones included), and class (static) methods
     FlintClass(std::string name,
-               std::unordered_map<std::string, std::shared_ptr<FlintFunction>> instanceMethods,
-               std::unordered_map<std::string, std::shared_ptr<FlintFunction>> classMethods,
-            std::shared_ptr<FlintClass> superClass) : 
-        name(name), instanceMethods(instanceMethods), classMethods(classMethods), 
-        superClass(superClass) {}
+               std::unordered_map<Symbol, Ref<FlintFunction>> instanceMethods,
+               std::unordered_map<Symbol, Ref<FlintFunction>> classMethods,
+            Ref<FlintClass> superClass) : 
+        FlintCallable(ObjectType::CLASS), name(std::move(name)), instanceMethods(std::move(instanceMethods)), 
+        classMethods(std::move(classMethods)), superClass(std::move(superClass))
+    {
+        initializer = findMethod(Symbols::INIT);
+    }
 };
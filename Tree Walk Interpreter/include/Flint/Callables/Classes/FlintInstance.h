@@ -2,39 +2,60 @@
 
 #include <string>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 #include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
 #include "Flint/Scanner/Token.h"
 #include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Callables/Classes/Shape.h"
 
 class FlintClass;
+class FlintFunction;
 
 // FlintInstance represents an instance of a class at runtime.
 // It stores fields and handles method/property lookups.
-class FlintInstance : public std::enable_shared_from_this<FlintInstance>
+// Field names live in the shared Shape; the instance only holds the values.
+class FlintInstance : public FlintObject
 {
 private:
-    // Pointer to the class this instance was created from.
-    std::shared_ptr<FlintClass> klass;
+    // The class this instance was created from.
+    Ref<FlintClass> klass;
 
-    // Stores instance-specific fields (properties and values).
-    std::unordered_map<std::string, LiteralValue> fields;
+    // Layout of `slots`: which field lives in which slot
+    Shape* shape;
+
+    // Field values, indexed by the slot numbers of `shape`
+    std::vector<LiteralValue> slots;
+
+    // Bind `method` to this instance, calling it right away if it is a getter
+    LiteralValue bindMethod(FlintFunction* method, const Token& name, Interpreter& interpreter);
+
+protected:
+    // Cycle collector: the class and every field
+    void trace(Tracer& trace) const override;
+    void clearReferences() override;
 
 public:
-    // Default constructor (rarely used; mostly for safety or placeholder).
-    FlintInstance() = default;
+    static bool classof(ObjectType type) { return type == ObjectType::INSTANCE; }
 
     // Constructor to create an instance from a given class.
-    explicit FlintInstance(std::shared_ptr<FlintClass> klass) : klass(klass) {}
+    explicit FlintInstance(Ref<FlintClass> klass);
+    ~FlintInstance() override;
 
     // Called when accessing a property or method on the instance.
     // If the name is a field, it returns it. Otherwise, it tries to return a bound method.
-    virtual LiteralValue get(Token name, Interpreter& interpreter);
+    // `cache` is the inline cache of the Get site doing the access.
+    LiteralValue get(const Token& name, Interpreter& interpreter, PropertyCache& cache);
+
+    // The method `obj.name(...)` should invoke with this instance as 'this',
+    // or nullptr when the property is a field, a getter, or undefined (in
+    // which case the call goes through get).  Shares the Get site's cache.
+    FlintFunction* findMethod(const Token& name, PropertyCache& cache);
 
     // Called when assigning a value to a field.
-    // If the field doesn't exist, it's created dynamically.
-    void set(Token name, LiteralValue object);
+    // If the field doesn't exist, it's created dynamically (moving to a new shape).
+    void set(const Token& name, LiteralValue object, PropertyCache& cache);
 
     // Returns a string representation of the instance.
-    std::string toString() const;
+    std::string toString() const override;
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Shape.h – Hidden Classes and Inline Caches for Instance Properties
+// ─────────────────────────────────────────────────────────────────────────────
+//  An instance does not carry a name → value map.  It points at a Shape,
+//  which maps each field name to a slot in the instance's value vector, and
+//  instances that gained the same fields in the same order share one Shape.
+//
+//  Shapes form a transition tree rooted at their class: adding field `x` to
+//  an instance of shape S moves it to S.withField(x), which is created once
+//  and then reused by every other instance taking the same step.  Because
+//  each class has its own root, a shape also identifies the class, so method
+//  lookups can be cached by shape as well.
+//
+//  Every Get/Set site in the AST owns a PropertyCache mapping the shapes it
+//  has seen to the answer of the lookup, so a repeated `this.position` is a
+//  shape check plus a slot load.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "Flint/Scanner/SymbolTable.h"
+
+class FlintFunction;
+
+class Shape
+{
+public:
+    // Unique for the life of the process (never reused, unlike an address),
+    // so a cache entry can only ever match the shape it was filled for.
+    // Zero is never handed out and marks an empty cache entry.
+    const uint32_t id;
+
+    // Root shape of a class: no fields
+    Shape();
+
+    Shape(const Shape&) = delete;
+    Shape& operator=(const Shape&) = delete;
+
+    // Slot holding field `name`, or -1 if this shape has no such field
+    int find(Symbol name) const
+    {
+        auto it = slots.find(name);
+        return it != slots.end() ? it->second : -1;
+    }
+
+    // Number of fields (and slots) of an instance with this shape
+    int slotCount() const { return static_cast<int>(slots.size()); }
+
+    // The shape reached by adding field `name` (a new, last slot)
+    Shape* withField(Symbol name);
+
+private:
+    Shape(const Shape& parent, Symbol name);
+
+    std::unordered_map<Symbol, int> slots;
+    std::unordered_map<Symbol, std::unique_ptr<Shape>> transitions;
+
+    static std::atomic<uint32_t> nextId;   // Shared by the interpreters on every thread
+};
+
+// ─────────────────────────────────────────────────────────────
+//  PropertyCache: polymorphic inline cache of one Get/Set site.
+//  Remembers up to WAYS shapes; once full the site is treated as
+//  megamorphic and further shapes take the uncached path.
+//
+//  Get sites fill `slot` for a field, or `method` for an instance
+//  method (slot -1).  Set sites fill `slot`, plus `next` when the
+//  assignment adds the field and moves the instance to a new shape.
+//  The pointers are only followed on a hit, and a hit means an
+//  instance of that shape (and so its class) is still alive.
+// ─────────────────────────────────────────────────────────────
+struct PropertyCache
+{
+    static constexpr int WAYS = 4;
+
+    struct Entry {
+        uint32_t shapeId = 0;
+        int slot = -1;
+        Shape* next = nullptr;
+        FlintFunction* method = nullptr;
+    };
+
+    Entry entries[WAYS];
+    int count = 0;
+
+    const Entry* lookup(uint32_t shapeId) const
+    {
+        for (int i = 0; i < count; i++)
+            if (entries[i].shapeId == shapeId) return &entries[i];
+        return nullptr;
+    }
+
+    void add(const Entry& entry)
+    {
+        if (count < WAYS) entries[count++] = entry;
+    }
+};
@@ -7,6 +7,8 @@
 //  that can be "called" like a function (e.g., user-defined functions, 
 //  native functions, class constructors).
 //
+//  Callables are FlintObjects: a LiteralValue holds them by pointer.
+//
 //  Any class implementing this interface must define:
 //    - arity(): number of arguments it expects
 //    - call(): the logic to invoke the function or callable
@@ -19,12 +21,20 @@
 #include <vector>
 #include <string>
 #include "Flint/Scanner/Token.h"   // Required for passing the closing paren for error reporting
-#include "Flint/Parser/Value.h"   // Defines LiteralValue (variant for function arguments)
+#include "Flint/Parser/Value.h"   // Defines LiteralValue (NaN-boxed runtime values)
+#include "Flint/FlintObject.h"    // FlintObject base and ObjectType tags
 
 class Interpreter;           // Forward declaration to avoid circular dependency
 
-class FlintCallable {
+class FlintCallable : public FlintObject {
 public:
+    //──────────────────────────────────────────────────────────────────────────
+    // classof: every ObjectType from FUNCTION onward is callable
+    //──────────────────────────────────────────────────────────────────────────
+    static bool classof(ObjectType type) { return type >= ObjectType::FUNCTION; }
+
+    explicit FlintCallable(ObjectType type) : FlintObject(type) {}
+
     //──────────────────────────────────────────────────────────────────────────
     // arity: returns number of arguments expected by the callable
     //──────────────────────────────────────────────────────────────────────────
@@ -48,10 +58,10 @@ public:
     //──────────────────────────────────────────────────────────────────────────
     // toString: human-readable name for debugging (default: "<fn>")
     //──────────────────────────────────────────────────────────────────────────
-    virtual std::string toString() const { return "<fn>"; }
+    std::string toString() const override { return "<fn>"; }
 
     //──────────────────────────────────────────────────────────────────────────
     // Virtual destructor for safe polymorphic destruction
     //──────────────────────────────────────────────────────────────────────────
-    virtual ~FlintCallable() = default;
+    ~FlintCallable() override = default;
 };
\ No newline at end of file
@@ -1,23 +1,76 @@
 #pragma once
 
-#include <functional>
+// ─────────────────────────────────────────────────────────────────────────────
+//  BuiltInFunction.h – Methods Built Into Strings and Arrays
+// ─────────────────────────────────────────────────────────────────────────────
+//  A BuiltinMethod is one entry of a per-type method table (FlintString,
+//  FlintArray).  The table is static and shared by every value of the type;
+//  the receiver is passed in at call time, so creating a string or an array
+//  allocates no callables at all.
+//
+//  `s.upper()` is dispatched straight from the table by the Evaluator.  Only
+//  when a method escapes as a value (`let f = s.upper;`) is it wrapped in a
+//  BuiltinFunction that keeps the receiver alive.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <memory>
+#include <string>
 #include "Flint/Parser/Value.h"
 #include "Flint/Callables/FlintCallable.h"
+#include "Flint/Interpreter/Profiler.h"
+
+//──────────────────────────────────────────────────────────────────────────────
+// BuiltinMethod: arity (-1 for variadic) plus the native implementation.
+//──────────────────────────────────────────────────────────────────────────────
+template <typename Receiver>
+struct BuiltinMethod
+{
+    using Fn = LiteralValue (*)(Receiver& self, Interpreter& interpreter,
+                                const std::vector<LiteralValue>& args,
+                                const Token& token);
+    int arity;
+    Fn fn;
+};
+
+// The profiler of `interpreter`, or nullptr (out of line, since
+// Interpreter.h includes this file)
+Profiler* profilerOf(const Interpreter& interpreter);
 
+// How a profile names the method `name` of Receiver ("string.upper")
+template <typename Receiver>
+std::string builtinName(Symbol name)
+{
+    return std::string(Receiver::TYPE_NAME) + "." + std::string(SymbolTable::name(name));
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// BuiltinFunction: a table method bound to its receiver, for when the method
+// is used as a first-class value instead of being called in place.
+//──────────────────────────────────────────────────────────────────────────────
+template <typename Receiver>
 class BuiltinFunction : public FlintCallable {
 public:
-    using BuiltinFn = std::function<LiteralValue(Interpreter&, const std::vector<LiteralValue>&, const Token&)>;
-    
-    BuiltinFunction(BuiltinFn fn, int arity)
-        : fn_(std::move(fn)), arity_(arity) {}
+    static bool classof(ObjectType type) { return type == ObjectType::BUILTIN; }
+
+    BuiltinFunction(Ref<Receiver> receiver, const BuiltinMethod<Receiver>& method, Symbol name)
+        : FlintCallable(ObjectType::BUILTIN), receiver_(std::move(receiver)), method_(method),
+          name_(name) {}
 
-    int arity() const override { return arity_; }
+    int arity() const override { return method_.arity; }
 
     LiteralValue call(Interpreter& interpreter, const std::vector<LiteralValue>& args, const Token& token) override {
-        return fn_(interpreter, args, token);
+        Profiler::Scope profile(profilerOf(interpreter), &method_,
+                                [this] { return builtinName<Receiver>(name_); });
+        return method_.fn(*receiver_, interpreter, args, token);
     }
 
+protected:
+    // Cycle collector: the receiver (`a.push(a.push)` makes a cycle)
+    void trace(Tracer& trace) const override { trace(receiver_); }
+    void clearReferences() override { receiver_ = nullptr; }
+
 private:
-    BuiltinFn fn_;
-    int arity_;
-};
\ No newline at end of file
+    Ref<Receiver> receiver_;
+    const BuiltinMethod<Receiver>& method_;  // Entry in the static per-type table
+    Symbol name_;                            // Its name in the table
+};
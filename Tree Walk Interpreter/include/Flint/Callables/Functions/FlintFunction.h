@@ -3,40 +3,108 @@
 #include "Flint/Callables/FlintCallable.h"
 #include "Flint/Environment.h"
 #include "Flint/Exceptions/ReturnException.h"
+#include "Flint/Interpreter/Profiler.h"
 
 // FlintFunction represents a user-defined function in the language.
 // It implements FlintCallable, meaning it can be "called" like a function.
 class FlintFunction : public FlintCallable
 {
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::FUNCTION; }
+
 private:
     // The environment where the function was defined; used to capture closures.
     std::shared_ptr<Environment> closure;
 
-    // Indicates whether this function is an initializer (i.e., a constructor).
-    bool isInitializer;
+    // The instance (or class, for static methods) a bound method was taken
+    // from; nil for plain functions and for methods that are not bound.
+    LiteralValue receiver;
+
+protected:
+    // Cycle collector: the closure environment and the receiver
+    void trace(Tracer& trace) const override { trace(closure); trace(receiver); }
+    void clearReferences() override { closure.reset(); receiver = nullptr; }
 
 public:
-    // AST node representing the function declaration.
-    std::shared_ptr<FunctionStmt> declaration;
+    // AST node representing the function declaration (owned by the AstArena).
+    // Arity, frame size and the initializer/receiver flags were worked out
+    // by the Resolver and live on the node, shared by every closure of it.
+    const FunctionStmt* declaration;
 
-    // Constructor initializes the function with its declaration, closure, and initializer flag.
-    FlintFunction(std::shared_ptr<FunctionStmt> declaration, 
-                  std::shared_ptr<Environment> closure,
-                  bool isInitializer) 
-        : declaration(std::move(declaration)), closure(closure), isInitializer(isInitializer) {}
+    // Creates a closure of `declaration` over `closure`
+    FlintFunction(const FunctionStmt* declaration, 
+                  std::shared_ptr<Environment> closure) 
+        : FlintCallable(ObjectType::FUNCTION), closure(std::move(closure)), 
+          declaration(declaration) {}
 
     // This function is called when the function is invoked in the source code.
     // Example: myFunc(1, 2); -> triggers call() with 1 and 2 as args.
     LiteralValue call(Interpreter &interpreter, 
                       const std::vector<LiteralValue> &args, const Token &paren) override;
 
+    // Invokes a method with `self` as 'this' (slot 0 of the new frame).
+    // Used directly for obj.method(args), so no bound method is created.
+    LiteralValue callMethod(Interpreter &interpreter, const LiteralValue &self,
+                            const std::vector<LiteralValue> &args, const Token &paren);
+
+    // Calls with `self` as 'this' and argument i given by `argument(i)`,
+    // which is written straight into the new frame (no argument vector).
+    // The caller has already checked the argument count; `paren` is
+    // reported if the call is one too deep.
+    template <typename ArgumentSource>
+    LiteralValue invoke(Interpreter &interpreter, const LiteralValue &self,
+                        ArgumentSource &&argument, const Token &paren);
+
+    // The receiver of a bound method, nil otherwise
+    const LiteralValue& boundReceiver() const { return receiver; }
+
     // Returns the number of parameters the function expects.
     int arity() const override;
 
     // Returns a string representation of the function (usually the name or "<fn>")
     std::string toString() const override;
 
+    // How a profile names it: "name:line", or "<lambda>:line"
+    std::string profileName() const;
+
+    // Runs the body in `frame`, whose slots already hold 'this' and the arguments,
+    // and then any tail calls it ends in
+    LiteralValue execute(Interpreter &interpreter, const std::shared_ptr<Environment> &frame,
+                         const LiteralValue &self);
+
+    // The call's result once the body of this function completed with `completion`
+    LiteralValue result(Interpreter &interpreter, Completion completion,
+                        const LiteralValue &self) const;
+
+    // Runs the pending Interpreter::tailCall, and the ones those end in
+    static LiteralValue runTailCalls(Interpreter &interpreter);
+
+    // The first call of a function whose body is still deferred: has it
+    // parsed and resolved, which sizes the frame (see Flint::compileBody)
+    void compileBody() const;
+
     // Binds 'this' to a given instance in methods.
-    // Used to bind methods to class instances so `this` works correctly.
+    // Only needed when a method is used as a value (let f = obj.method;).
     LiteralValue bind(LiteralValue instance);
-};
\ No newline at end of file
+};
+
+template <typename ArgumentSource>
+LiteralValue FlintFunction::invoke(Interpreter &interpreter, const LiteralValue &self,
+                                   ArgumentSource &&argument, const Token &paren)
+{
+    interpreter.step(paren.line);
+    if (declaration->deferred) compileBody();
+    Interpreter::CallDepth depth(interpreter, paren);
+    Profiler::Scope profile(interpreter.profiler, declaration, [this] { return profileName(); });
+    Interpreter::Frame frame(interpreter, closure, declaration->slotCount, declaration->isCaptured);
+    Environment& environment = *frame.environment();
+
+    // Methods: 'this' is slot 0, then the parameters in declaration order
+    int slot = 0;
+    if (declaration->hasReceiver) environment.defineAt(slot++, self);
+
+    for (int i = 0; i < declaration->arity; ++i)
+        environment.defineAt(slot++, argument(i));
+
+    return execute(interpreter, frame.environment(), self);
+}
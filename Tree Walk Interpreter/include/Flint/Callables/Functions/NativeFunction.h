@@ -3,11 +3,15 @@
 #include <functional>
 #include <string>
 #include "Flint/Callables/FlintCallable.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Interpreter/Profiler.h"
 
 // Represents a built-in (native) function callable from Flint code.
 class NativeFunction : public FlintCallable 
 {
 public:
+    static bool classof(ObjectType type) { return type == ObjectType::NATIVE; }
+
     // Type alias for the C++ function that implements the native behavior.
     // It accepts arguments and a token for error reporting (like a closing parenthesis).
     using NativeFn = std::function<LiteralValue
@@ -17,7 +21,7 @@ public:
     // Constructor for a native function. Takes the function arity (number of parameters),
     // the actual native function implementation, and an optional name for debugging.
     NativeFunction(int arity, NativeFn fn, std::string name = "") 
-        : arity_(arity), fn_(std::move(fn)), 
+        : FlintCallable(ObjectType::NATIVE), arity_(arity), fn_(std::move(fn)), 
           name_(std::move(name)) {}
 
     // Returns the number of arguments the function expects.
@@ -28,6 +32,7 @@ public:
     // Calls the native function using the provided arguments.
     LiteralValue call(Interpreter& interpreter, 
         const std::vector<LiteralValue>& args, const Token &paren) override {
+        Profiler::Scope profile(interpreter.profiler, this, [this] { return name_ + " [native]"; });
         return fn_(args, paren);
     }
 
@@ -0,0 +1,251 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Embedding.h – Calling Flint From C++, and C++ From Flint
+// ─────────────────────────────────────────────────────────────────────────────
+//  A host keeps a Flint context, runs its scripts once, and then calls into
+//  them as often as it likes:
+//
+//      Flint flint;
+//      flint.define("lerp", makeNative("lerp", [](double a, double b, double t) {
+//          return a + (b - a) * t;
+//      }));
+//      flint.run(source);
+//
+//      FunctionHandle update = flint.function("update");
+//      for (Entity& entity : entities) update(entity.id, dt);
+//
+//  function() looks the global up once and the handle keeps the function it
+//  found (a later redefinition by the script is not seen).  A call takes its
+//  arguments from an array on the caller's stack, and in the tree-walker
+//  they are written straight into the callee's frame, so the call itself
+//  allocates nothing.  Errors come back as RuntimeError exceptions.
+//
+//  makeNative() turns a C++ function or lambda into a native whose argument
+//  count and types are checked by code generated from its signature; see
+//  ValueTraits for the types it converts.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Flint/Flint.h"
+#include "Flint/ValueSpan.h"
+#include "Flint/FlintArray.h"
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintMath.h"
+#include "Flint/FlintString.h"
+#include "Flint/Callables/Functions/NativeFunction.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+//──────────────────────────────────────────────────────────────────────────────
+// ValueTraits<T>: how a C++ type maps onto Flint values.
+//   is(value)    does the value convert to T?
+//   get(value)   the converted value (is() already checked)
+//   make(x)      a Flint value holding x
+//   name         what an argument of type T must be, for error messages
+//
+// Numbers: any arithmetic type but bool (converted from and to double).
+// Also bool, std::string, std::string_view (valid during the call), nil
+// (std::nullptr_t), LiteralValue itself, and pointers to FlintString,
+// FlintArray, FlintFloat64Array, FlintVec3, FlintQuat and FlintMat4.
+//──────────────────────────────────────────────────────────────────────────────
+template <typename T, typename = void>
+struct ValueTraits;
+
+template <typename T>
+struct ValueTraits<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+{
+    static constexpr const char* name = "a number";
+    static bool is(const LiteralValue& value) { return value.isNumber(); }
+    static T get(const LiteralValue& value) { return static_cast<T>(value.asNumber()); }
+    static LiteralValue make(T number) { return static_cast<double>(number); }
+};
+
+template <>
+struct ValueTraits<bool>
+{
+    static constexpr const char* name = "a boolean";
+    static bool is(const LiteralValue& value) { return value.isBool(); }
+    static bool get(const LiteralValue& value) { return value.asBool(); }
+    static LiteralValue make(bool boolean) { return boolean; }
+};
+
+template <>
+struct ValueTraits<std::string>
+{
+    static constexpr const char* name = "a string";
+    static bool is(const LiteralValue& value) { return value.is<FlintString>(); }
+    static std::string get(const LiteralValue& value) { return value.as<FlintString>()->value; }
+    static LiteralValue make(std::string text) { return makeRef<FlintString>(std::move(text)); }
+};
+
+template <>
+struct ValueTraits<std::string_view>
+{
+    static constexpr const char* name = "a string";
+    static bool is(const LiteralValue& value) { return value.is<FlintString>(); }
+    static std::string_view get(const LiteralValue& value) { return value.as<FlintString>()->value; }
+    static LiteralValue make(std::string_view text) { return makeRef<FlintString>(std::string(text)); }
+};
+
+template <>
+struct ValueTraits<const char*>
+{
+    static LiteralValue make(const char* text) { return makeRef<FlintString>(text); }
+};
+
+template <>
+struct ValueTraits<std::nullptr_t>
+{
+    static constexpr const char* name = "nil";
+    static bool is(const LiteralValue& value) { return value.isNil(); }
+    static std::nullptr_t get(const LiteralValue&) { return nullptr; }
+    static LiteralValue make(std::nullptr_t) { return nullptr; }
+};
+
+template <>
+struct ValueTraits<LiteralValue>
+{
+    static constexpr const char* name = "a value";
+    static bool is(const LiteralValue&) { return true; }
+    static const LiteralValue& get(const LiteralValue& value) { return value; }
+    static LiteralValue make(LiteralValue value) { return value; }
+};
+
+template <typename Object> struct ObjectName;
+template <> struct ObjectName<FlintString>       { static constexpr const char* value = "a string"; };
+template <> struct ObjectName<FlintArray>        { static constexpr const char* value = "an array"; };
+template <> struct ObjectName<FlintFloat64Array> { static constexpr const char* value = "a Float64Array"; };
+template <> struct ObjectName<FlintVec3>         { static constexpr const char* value = "a vec3"; };
+template <> struct ObjectName<FlintQuat>         { static constexpr const char* value = "a quat"; };
+template <> struct ObjectName<FlintMat4>         { static constexpr const char* value = "a mat4"; };
+
+template <typename Object>
+struct ValueTraits<Object*, std::enable_if_t<std::is_base_of_v<FlintObject, Object>>>
+{
+    static constexpr const char* name = ObjectName<std::remove_const_t<Object>>::value;
+    static bool is(const LiteralValue& value) { return value.is<std::remove_const_t<Object>>(); }
+    static Object* get(const LiteralValue& value) { return value.as<std::remove_const_t<Object>>(); }
+    static LiteralValue make(Object* object) { return LiteralValue(static_cast<FlintObject*>(object)); }
+};
+
+template <typename Object>
+struct ValueTraits<Ref<Object>>
+{
+    static LiteralValue make(const Ref<Object>& object) { return object; }
+};
+
+// The Flint value of a C++ value, by ValueTraits
+template <typename T>
+LiteralValue toValue(T&& value)
+{
+    return ValueTraits<std::decay_t<T>>::make(std::forward<T>(value));
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// FunctionHandle: a function of a Flint context, looked up once by
+// Flint::function() and called any number of times.  Empty (false) if the
+// global did not exist or was not callable.  The handle holds a Flint value,
+// so it belongs to the context's thread, like the context itself.
+//──────────────────────────────────────────────────────────────────────────────
+class FunctionHandle
+{
+public:
+    FunctionHandle() = default;
+
+    explicit operator bool() const { return context != nullptr; }
+
+    // Call with `arguments`; a RuntimeError propagates to the caller
+    LiteralValue call(ValueSpan arguments) const { return context->call(callee, arguments, *where); }
+
+    // Call with C++ values, converted by ValueTraits into a local array
+    template <typename... Args>
+    LiteralValue operator()(Args&&... args) const
+    {
+        if constexpr (sizeof...(Args) == 0) {
+            return call(ValueSpan());
+        } else {
+            const LiteralValue values[] = { toValue(std::forward<Args>(args))... };
+            return call(ValueSpan(values));
+        }
+    }
+
+private:
+    friend class Flint;
+
+    FunctionHandle(Flint* context, LiteralValue callee, Token where)
+        : context(context), callee(std::move(callee)), where(std::move(where)) {}
+
+    Flint* context = nullptr;
+    LiteralValue callee;
+    std::optional<Token> where;   // Reported by errors the call itself raises (wrong arity)
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// makeNative(name, function): a native with the arity and argument checks
+// of `function`'s parameter list.  Its result is converted by ValueTraits
+// (void returns nil); a C++ exception it throws becomes a RuntimeError.
+//──────────────────────────────────────────────────────────────────────────────
+namespace NativeBinding {
+    template <typename T> struct Signature : Signature<decltype(&T::operator())> {};
+
+    template <typename R, typename... A>
+    struct Signature<R (*)(A...)> { using Result = R; using Arguments = std::tuple<A...>; };
+    template <typename R, typename... A>
+    struct Signature<R (A...)> : Signature<R (*)(A...)> {};
+    template <typename C, typename R, typename... A>
+    struct Signature<R (C::*)(A...)> : Signature<R (*)(A...)> {};
+    template <typename C, typename R, typename... A>
+    struct Signature<R (C::*)(A...) const> : Signature<R (*)(A...)> {};
+
+    template <typename Argument>
+    void check(const LiteralValue& value, size_t index, const std::string& name, const Token& paren)
+    {
+        using Traits = ValueTraits<std::decay_t<Argument>>;
+        if (!Traits::is(value))
+            throw RuntimeError(paren, name + "() expects " + Traits::name +
+                                      " as argument " + std::to_string(index + 1) + ".");
+    }
+
+    template <typename Function, typename Result, typename... A, size_t... I>
+    LiteralValue call(Function& function, const std::string& name, const std::vector<LiteralValue>& args,
+                      const Token& paren, std::tuple<A...>*, std::index_sequence<I...>)
+    {
+        (check<A>(args[I], I, name, paren), ...);
+        try {
+            if constexpr (std::is_void_v<Result>) {
+                function(ValueTraits<std::decay_t<A>>::get(args[I])...);
+                return nullptr;
+            } else {
+                return toValue(function(ValueTraits<std::decay_t<A>>::get(args[I])...));
+            }
+        } catch (const RuntimeError&) {
+            throw;
+        } catch (const std::exception& error) {
+            throw RuntimeError(paren, name + "(): " + error.what());
+        }
+    }
+}
+
+template <typename Function>
+Ref<NativeFunction> makeNative(std::string name, Function function)
+{
+    using Signature = NativeBinding::Signature<std::decay_t<Function>>;
+    using Arguments = typename Signature::Arguments;
+    constexpr size_t arity = std::tuple_size_v<Arguments>;
+
+    return makeRef<NativeFunction>(static_cast<int>(arity),
+        [function = std::move(function), name](const std::vector<LiteralValue>& args,
+                                             const Token& paren) mutable -> LiteralValue {
+            return NativeBinding::call<Function, typename Signature::Result>(
+                function, name, args, paren, static_cast<Arguments*>(nullptr),
+                std::make_index_sequence<arity>());
+        }, name);
+}
@@ -3,13 +3,16 @@
 // ─────────────────────────────────────────────────────────────────────────────
 //  Environment.h – Runtime Environment for Flint Variables
 // ─────────────────────────────────────────────────────────────────────────────
-//  Manages variable scopes during interpretation.  Each Environment maps
-//  names to values (LiteralValue) and optionally chains to an enclosing
-//  environment to implement nested scopes (blocks, functions, classes).
+//  Manages variable scopes during interpretation.  The global Environment
+//  keeps its variables in an indexed table, with a map from interned names
+//  (Symbol) to their index; every local Environment stores its
+//  variables in a flat, fixed-size slot array whose layout is computed by the
+//  Resolver.  Environments chain to an enclosing environment to implement
+//  nested scopes (blocks, functions, classes).
 //
 //  Core responsibilities:
 //    - Define new variables (`let`)
-//    - Lookup variables by name (current or parent scope)
+//    - Lookup variables by name (globals) or by (depth, slot) (locals)
 //    - Assign to existing variables
 //
 //  Dependencies:
@@ -19,17 +22,50 @@
 
 #include <unordered_map>
 #include <optional>
+#include <vector>
 #include "Flint/Parser/Value.h"   // LiteralValue
 #include "Flint/Scanner/Token.h"   // Token for name & errors
+#include "Flint/Heap.h"            // Collectable: closures and environments form cycles
+
+class Environment : public Collectable, public std::enable_shared_from_this<Environment> {
+public:
+    // A variable defined by name (see `named`)
+    struct Named {
+        Symbol name;
+        LiteralValue value;
+    };
 
-class Environment : public std::enable_shared_from_this<Environment> {
 private:
     //──────────────────────────────────────────────────────────────────────────
-    // values: maps variable names to their runtime values.
+    // named / index: variables defined by name (the globals), in the order
+    // they were first defined, and where each name is in `named`.  A name
+    // keeps its index for good (redefining it replaces the value in place),
+    // so a site that found a global once can read it by index (getCached).
+    //──────────────────────────────────────────────────────────────────────────
+    std::vector<Named> named;
+    std::unordered_map<Symbol, uint32_t> index;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // slots: local variables, indexed by the slot the Resolver assigned.
     //──────────────────────────────────────────────────────────────────────────
-    std::unordered_map<std::string, LiteralValue> values;
+    std::vector<LiteralValue> slots;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Collectable: environments are owned through shared_ptr (pooled frames
+    // are not, and report no owners); `self` keeps a garbage environment
+    // alive while the Heap breaks its cycle.
+    //──────────────────────────────────────────────────────────────────────────
+    std::shared_ptr<Environment> self;
+
+    size_t referenceCount() const override { return weak_from_this().use_count(); }
+    void trace(Tracer& trace) const override;
+    void clearReferences() override;
+    void pin() override { self = shared_from_this(); }
+    void unpin() override { std::shared_ptr<Environment> last = std::move(self); }
 
-   
+    // Allocation counts (Heap::Counts); a pooled frame counts once, however
+    // many calls reuse it
+    static void counted() { Heap::countAllocation(Heap::ENVIRONMENT, sizeof(Environment)); }
 
 public:
     //──────────────────────────────────────────────────────────────────────────
@@ -41,52 +77,127 @@ public:
     //──────────────────────────────────────────────────────────────────────────
     // Constructor: global scope (no enclosing)
     //──────────────────────────────────────────────────────────────────────────
-    Environment() : enclosing(nullptr) {}
+    Environment() : enclosing(nullptr) { counted(); }
 
     //──────────────────────────────────────────────────────────────────────────
     // Constructor: nested scope with reference to parent environment.
     //──────────────────────────────────────────────────────────────────────────
     explicit Environment(std::shared_ptr<Environment> enclosing)
-        : enclosing(std::move(enclosing)) {}
+        : enclosing(std::move(enclosing)) { counted(); }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Constructor: local scope with `slotCount` pre-sized variable slots.
+    //──────────────────────────────────────────────────────────────────────────
+    Environment(std::shared_ptr<Environment> enclosing, int slotCount)
+        : slots(slotCount), enclosing(std::move(enclosing)) { counted(); }
+
+    ~Environment() override { Heap::countRelease(Heap::ENVIRONMENT, sizeof(Environment)); }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // reset / clear: reuse this environment as a fresh call frame, and drop
+    // everything it references afterwards (pooled frames, see Interpreter).
+    // The slot array keeps its capacity between uses.
+    //──────────────────────────────────────────────────────────────────────────
+    void reset(std::shared_ptr<Environment> enclosing, int slotCount)
+    {
+        this->enclosing = std::move(enclosing);
+        slots.resize(slotCount);
+    }
+    void clear() { slots.clear(); enclosing.reset(); }
 
     //──────────────────────────────────────────────────────────────────────────
     // define: declare a new variable in this scope.
-    // Usage: env.define("x", LiteralValue(42.0)); // let x = 42;
+    // Usage: env.define(token.symbol, LiteralValue(42.0)); // let x = 42;
     //──────────────────────────────────────────────────────────────────────────
-    void define(std::string name, LiteralValue value);
+    void define(Symbol name, LiteralValue value);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // defineAt: initialize a local variable in this scope by slot index.
+    //──────────────────────────────────────────────────────────────────────────
+    void defineAt(int slot, LiteralValue value) { slots[slot] = std::move(value); }
 
     //──────────────────────────────────────────────────────────────────────────
     // get: retrieve a variable's value, searching outward through enclosing.
     // Throws RuntimeError if name not found.
     //──────────────────────────────────────────────────────────────────────────
-    LiteralValue get(Token name);
+    LiteralValue get(const Token& name);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // getCached / assignCached: get and assign for a site that remembers, in
+    // `cached`, the index the name was last found at (NOT_CACHED at first).
+    // While that index still holds the name, neither hashes anything.
+    //──────────────────────────────────────────────────────────────────────────
+    static constexpr uint32_t NOT_CACHED = UINT32_MAX;
+
+    const LiteralValue& getCached(const Token& name, uint32_t& cached)
+    {
+        if (cached < named.size() && named[cached].name == name.symbol &&
+            !named[cached].value.isNothing())
+            return named[cached].value;
+        return getIndexed(name, cached);
+    }
+
+    void assignCached(const Token& name, LiteralValue value, uint32_t& cached)
+    {
+        if (cached < named.size() && named[cached].name == name.symbol)
+            named[cached].value = std::move(value);
+        else
+            assignIndexed(name, std::move(value), cached);
+    }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // lookup: a variable defined by name in this scope itself, or nullptr.
+    // The pointer is good until the next name is defined.
+    //──────────────────────────────────────────────────────────────────────────
+    const LiteralValue* lookup(Symbol name) const
+    {
+        auto it = index.find(name);
+        return it != index.end() ? &named[it->second].value : nullptr;
+    }
 
     //──────────────────────────────────────────────────────────────────────────
-    // getAt: direct lookup in an ancestor environment at fixed distance.
-    // Used by Resolver to handle statically-scoped variables.
+    // getAt: direct slot lookup in an ancestor environment at fixed distance.
+    // Used for variables the Resolver bound to a (depth, slot) pair.
     //──────────────────────────────────────────────────────────────────────────
-    LiteralValue getAt(int distance, Token name);
+    const LiteralValue& getAt(int distance, int slot);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // at: a slot of this scope itself (getAt(0, slot) without the walk).
+    //──────────────────────────────────────────────────────────────────────────
+    const LiteralValue& at(int slot) const { return slots[slot]; }
 
     //──────────────────────────────────────────────────────────────────────────
     // getOptional: attempt to retrieve value in this scope only.
     // Returns std::nullopt if not present (does not search enclosing).
     //──────────────────────────────────────────────────────────────────────────
-    std::optional<LiteralValue> getOptional(const std::string &name) const;
+    std::optional<LiteralValue> getOptional(Symbol name) const;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // definitions: every variable defined by name in this environment, in
+    // the order they were first defined (used to hand the native globals
+    // over to the bytecode VM)
+    //──────────────────────────────────────────────────────────────────────────
+    const std::vector<Named>& definitions() const { return named; }
 
     //──────────────────────────────────────────────────────────────────────────
     // ancestors: return the environment `distance` levels up.
     //──────────────────────────────────────────────────────────────────────────
-    std::shared_ptr<Environment> ancestors(int distance);
+    Environment* ancestors(int distance);
 
     //──────────────────────────────────────────────────────────────────────────
     // assign: rebind an existing variable (must exist in current or parent).
     // Throws RuntimeError if variable undefined.
     //──────────────────────────────────────────────────────────────────────────
-    void assign(Token name, LiteralValue value);
+    void assign(const Token& name, LiteralValue value);
 
     //──────────────────────────────────────────────────────────────────────────
-    // assignAt: direct assignment in ancestor environment at given distance.
-    // Used by Resolver for efficiency in statically-scoped resolution.
+    // assignAt: direct slot assignment in ancestor environment at a distance.
+    // Used for variables the Resolver bound to a (depth, slot) pair.
     //──────────────────────────────────────────────────────────────────────────
-    void assignAt(int distance, Token name, LiteralValue value);
+    void assignAt(int distance, int slot, LiteralValue value);
+
+private:
+    // The hashed halves of getCached and assignCached: they also update `cached`
+    const LiteralValue& getIndexed(const Token& name, uint32_t& cached);
+    void assignIndexed(const Token& name, LiteralValue value, uint32_t& cached);
 };
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Flint/Exceptions/RuntimeError.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  BudgetExceeded – A Run Went Past Its Execution Budget
+// ─────────────────────────────────────────────────────────────────────────────
+//  Thrown at the loop iteration or call that would take a run past the
+//  budget the host set (Interpreter::setBudget).  It is a RuntimeError, so
+//  it unwinds and is reported like one, but it ends the whole run rather
+//  than only the top-level statement it was raised in.  A host calling into
+//  the program (Flint::call, FunctionHandle) can catch it by this type to
+//  tell a script that ran out of time from one that failed.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class BudgetExceeded : public RuntimeError
+{
+public:
+    using RuntimeError::RuntimeError;
+};
@@ -1,9 +1,30 @@
 #pragma once  // Ensures this header is only included once during compilation
 
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "Flint/Exceptions/RuntimeError.h"
 #include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Parser/AstArena.h"
+#include "Flint/ValueSpan.h"
+
+class VM;
+class TaskProgram;
+class FunctionHandle;
+class SourceText;
+class Profiler;
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Engine — which back end executes the resolved program
+// ─────────────────────────────────────────────────────────────────────────────
+enum class Engine
+{
+    TREE_WALK,  // Interpreter: walks the AST directly (default)
+    VM,         // Compiler + VM: compiles to bytecode, runs on a stack VM
+    CLOSURE,    // Interpreter over the AST lowered to closures (ClosureCompiler)
+};
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Flint Class — Core Entry Point for Running Code
@@ -14,24 +35,45 @@
 //
 //  Acts as the "driver" of the interpreter — coordinates parsing, execution,
 //  and error handling, and is the first layer called from main() or tests.
+//
+//  Each Flint object is an independent context: it owns its interpreter,
+//  VM, program trees and error flags, and shares nothing mutable with the
+//  others (the symbol table and thread pool it does share are thread-safe).
+//  So several can run at once, one per thread:
+//
+//      std::thread([] { Flint flint; flint.run(source); });
+//
+//  A context, and every value it creates, must stay on one thread at a time
+//  (see Heap.h).
 // ─────────────────────────────────────────────────────────────────────────────
 
 class Flint
 {
 public:
+    Flint();
+    ~Flint();
+
+    // A worker context for the tasks of `program` (see Tasks.h)
+    explicit Flint(std::shared_ptr<TaskProgram> program);
+
+    Flint(const Flint&) = delete;
+    Flint& operator=(const Flint&) = delete;
+
     // ───────────────────────────────────────────────────────────────
     // runFile(path):
     // Executes a Flint script from a file path.
     // This is typically used when the interpreter is run via CLI.
+    // With the VM engine, the compiled script is cached beside the
+    // file (see BytecodeCache.h and `cache` below).
     // ───────────────────────────────────────────────────────────────
-    static void runFile(const std::string& path);
+    void runFile(const std::string& path);
 
     // ───────────────────────────────────────────────────────────────
     // runPrompt():
     // Launches a REPL (Read-Eval-Print Loop) for interactive execution.
     // Used when no script is provided — enables live code testing.
     // ───────────────────────────────────────────────────────────────
-    static void runPrompt();
+    void runPrompt();
 
     // ───────────────────────────────────────────────────────────────
     // run(source):
@@ -40,9 +82,77 @@ public:
     // - Parses
     // - Interprets
     //
-    // Called by both `runFile()` and `runPrompt()`.
+    // Called by both `runFile()` and `runPrompt()`.  Globals persist
+    // from one call to the next.  The string is copied once into a
+    // SourceText; the overload runs one the caller already has.
+    // ───────────────────────────────────────────────────────────────
+    void run(const std::string& source);
+    void run(std::shared_ptr<const SourceText> source);
+
+    // ───────────────────────────────────────────────────────────────
+    // declare(source):
+    // Like run(), but executes only the top-level function and class
+    // declarations; how a worker context replays its program.
+    // ───────────────────────────────────────────────────────────────
+    void declare(std::shared_ptr<const SourceText> source);
+
+    // ───────────────────────────────────────────────────────────────
+    // global(name) / call(callee, args, where):
+    // Read a global defined by the units run so far (undefined if
+    // there is none), and call a value of this context from outside
+    // a run, with this context current.  A RuntimeError raised by the
+    // call propagates to the caller instead of being reported.
+    // ───────────────────────────────────────────────────────────────
+    LiteralValue global(Symbol name) const;
+    LiteralValue call(const LiteralValue& callee, ValueSpan args, const Token& where);
+
+    // ───────────────────────────────────────────────────────────────
+    // define(name, value) / function(name):
+    // The embedding API (see Embedding.h).  define() makes `value` a
+    // global of both engines, such as a native from makeNative();
+    // function() looks a global up once and returns a handle that
+    // calls it (empty if it is missing or not callable).
+    // ───────────────────────────────────────────────────────────────
+    void define(std::string_view name, LiteralValue value);
+    FunctionHandle function(std::string_view name);
+
+    // ───────────────────────────────────────────────────────────────
+    // profileTo(path) / reportProfile():
+    // Start profiling the runs that follow, in either engine (see
+    // Profiler.h); then stop, print the report to stderr and write
+    // the collapsed stacks to `path`.  `--profile[=path]` does both
+    // around the script or the REPL session.  The workers of tasks
+    // are not profiled.
     // ───────────────────────────────────────────────────────────────
-    static void run(const std::string& source);
+    void profileTo(std::string path);
+    void reportProfile();
+
+    // ───────────────────────────────────────────────────────────────
+    // reportStats(out):
+    // This thread's allocation counts per kind of object (see
+    // Heap.h) and the collector's work, as a table.  Tasks' workers
+    // have heaps of their own, which are not included.
+    // ───────────────────────────────────────────────────────────────
+    static void reportStats(std::ostream& out);
+
+    // The units this context has run, shared with its tasks' workers
+    const std::shared_ptr<TaskProgram>& taskProgram() const { return program; }
+
+    // The context running on this thread, or nullptr outside any run
+    static Flint* running() { return current; }
+
+    // ───────────────────────────────────────────────────────────────
+    // hadError() / hadRuntimeError():
+    // Whether a run so far reported a compile-time or runtime error;
+    // clearErrors() resets both (the REPL does so after every line).
+    // ───────────────────────────────────────────────────────────────
+    bool hadError() const { return compileFailed; }
+    bool hadRuntimeError() const { return runtimeFailed; }
+    void clearErrors() { compileFailed = runtimeFailed = false; }
+
+    // The tree-walk interpreter; also hosts the globals and natives
+    // the VM uses
+    Interpreter& interpreter() { return *treeWalker; }
 
     // ───────────────────────────────────────────────────────────────
     // error(line, message):
@@ -56,7 +166,7 @@ public:
     // Reports an error tied to a specific token — used for clearer context.
     // If the token is EOF, reports it as "at end".
     // ───────────────────────────────────────────────────────────────
-    static void error(Token token, const std::string& message);
+    static void error(const Token& token, const std::string& message);
 
     // ───────────────────────────────────────────────────────────────
     // runtimeError(error):
@@ -79,16 +189,94 @@ public:
     // ───────────────────────────────────────────────────────────────
     static void main(const std::vector<std::string>& args);
 
+    // ───────────────────────────────────────────────────────────────
+    // engine:
+    // Back end used by run(); chosen with `--engine=tree|vm|closure`.
+    // ───────────────────────────────────────────────────────────────
+    Engine engine = Engine::TREE_WALK;
+
+    // ───────────────────────────────────────────────────────────────
+    // optimize:
+    // Whether run() passes the resolved AST through the Optimizer;
+    // on by default, `-O0` turns it off (`-O` turns it back on).
+    // ───────────────────────────────────────────────────────────────
+    bool optimize = true;
+
+    // ───────────────────────────────────────────────────────────────
+    // lazy:
+    // Whether run() leaves the bodies of top-level functions and of
+    // the methods of top-level classes unparsed until their first
+    // call (see DeferredBody), so a large script starts sooner when
+    // it calls little of itself.  Their syntax and resolution errors
+    // are then reported at that call instead of before the run.  Set
+    // by `--lazy`; the VM engine and tasks' workers parse eagerly.
+    // ───────────────────────────────────────────────────────────────
+    bool lazy = false;
+
+    // ───────────────────────────────────────────────────────────────
+    // compileBody(function):
+    // Parses, resolves and optimizes the deferred body of `function`,
+    // a declaration of this context's.  Called by its first call;
+    // throws a RuntimeError at its name if the body has errors
+    // (reported then, with this context flagged).
+    // ───────────────────────────────────────────────────────────────
+    void compileBody(const FunctionStmt& function);
+
+    // ───────────────────────────────────────────────────────────────
+    // cache:
+    // Whether runFile() loads and saves the `.flintc` bytecode of its
+    // script under `--engine=vm`; `--no-cache` turns it off.
+    // ───────────────────────────────────────────────────────────────
+    bool cache = true;
+
+    // ───────────────────────────────────────────────────────────────
+    // stats:
+    // Whether runFile() and the REPL end with reportStats(); set by
+    // `--stats`.
+    // ───────────────────────────────────────────────────────────────
+    bool stats = false;
+
 private:
     // ───────────────────────────────────────────────────────────────
-    // Global interpreter instance, used to evaluate parsed ASTs.
-    // Shared across runFile and runPrompt.
+    // current:
+    // The context whose run() is executing on this thread; the
+    // static error functions above set its flags.  Null outside run().
     // ───────────────────────────────────────────────────────────────
-    static const std::shared_ptr<Interpreter> interpreter;
+    static thread_local Flint* current;
+
+    // Makes a context `current` for as long as it lives, then restores
+    // the previous one (a context may run inside another's native)
+    struct Use {
+        Flint* previous;
+        explicit Use(Flint* context) : previous(current) { current = context; }
+        ~Use() { current = previous; }
+    };
+
+    // cachePath: the unit's `.flintc`, or null to compile it every time
+    void execute(std::shared_ptr<const SourceText> source, bool declarationsOnly,
+                 const std::string* cachePath = nullptr);
+
+    std::shared_ptr<TaskProgram> program;
+
+    // The profile being taken and where its collapsed stacks go; the
+    // engines point at it, so it outlives them
+    std::unique_ptr<Profiler> profiler;
+    std::string profilePath;
+
+    // ASTs of every unit run by the interpreter; FlintFunctions refer into
+    // them, so declared before `treeWalker` to be destroyed after it
+    std::vector<std::unique_ptr<AstArena>> programs;
+
+    // Interpreter used to evaluate parsed ASTs.
+    // Shared across runFile and runPrompt.
+    std::unique_ptr<Interpreter> treeWalker;
+
+    // Bytecode VM, created on first use; hosts natives on `treeWalker`.
+    std::unique_ptr<VM> vm;
 
     // Tracks whether a syntax or lexical error has occurred.
-    static bool hadError;
+    bool compileFailed = false;
 
     // Tracks whether a runtime error occurred during interpretation.
-    static bool hadRuntimeError;
-};
\ No newline at end of file
+    bool runtimeFailed = false;
+};
@@ -4,28 +4,44 @@
 #include <unordered_map>
 #include <string>
 #include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
 #include "Flint/Callables/Functions/BuiltInFunction.h"
 #include "Flint/Interpreter/Interpreter.h"
 
-class FlintArray {
+class FlintArray : public FlintObject {
 private:
-    std::unordered_map<std::string, std::shared_ptr<BuiltinFunction>> builtInFunctions;
+    // Builtin methods shared by every array (push, pop, length, map, sort, ...)
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintArray>>& builtInFunctions();
+
+protected:
+    // Cycle collector: an array may contain itself, directly or not
+    void trace(Tracer& trace) const override { for (const LiteralValue& e : elements) trace(e); }
+    void clearReferences() override { elements.clear(); }
 
 public:
+    static bool classof(ObjectType type) { return type == ObjectType::ARRAY; }
+    static constexpr const char* TYPE_NAME = "array";   // Prefix of its methods in profiles
+
     // Underlying storage
     std::vector<LiteralValue> elements;
 
-    std::string toString()  {
-       std::string out = "[";
+    std::string toString() const override {
+        Printing printing(this);
+        if (printing.recurring) return "[...]";
+        std::string out = "[";
         for (size_t i = 0; i < elements.size(); ++i) {
-            out += Interpreter::stringify(elements[i]);
+            Interpreter::appendTo(out, elements[i]);
             if (i + 1 < elements.size()) out += ", ";
         }
         out += "]";
         return out;
     }
 
-    LiteralValue getInBuiltFunction(Token name);
+    // Table entry for a builtin method, or nullptr if there is none
+    static const BuiltinMethod<FlintArray>* findBuiltin(Symbol name);
+
+    // The method bound to this array, for when it is used as a value
+    LiteralValue getInBuiltFunction(const Token& name);
 
     FlintArray(std::vector<LiteralValue> elems);
 };
\ No newline at end of file
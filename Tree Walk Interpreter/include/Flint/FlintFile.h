@@ -0,0 +1,84 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintFile.h – Open File Handles (`open`)
+// ─────────────────────────────────────────────────────────────────────────────
+//  open(path, mode) returns a handle that reads or writes the file through
+//  a buffer of its own, so a script streams through files of any size:
+//
+//      let log = open("access.log");
+//      log.forEachLine(func(line) { ... });
+//
+//  Reads fill the buffer BUFFER_SIZE bytes at a time and lines are cut out
+//  of it in place; readInto() copies numbers from the buffer straight into
+//  a Float64Array and reads the rest of the request directly into it.
+//  Writes go through stdio with a buffer of the same size.  The file is
+//  closed by close() or when the last reference goes.
+//
+//  Modes are "r" (the default), "w" and "a", always binary: what is read
+//  is the bytes of the file, and a line is cut at "\n" (with a "\r" before
+//  it dropped too).
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
+#include "Flint/Callables/Functions/BuiltInFunction.h"
+
+class FlintFile : public FlintObject {
+private:
+    // Builtin methods shared by every handle (readLine, forEachLine, read,
+    // readInto, write, flush, close)
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintFile>>& builtInFunctions();
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::FILE_HANDLE; }
+    static constexpr const char* TYPE_NAME = "file";   // Prefix of its methods in profiles
+
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+    // The open(path, mode?) native; throws at `paren` if the file cannot be
+    // opened
+    static LiteralValue open(const std::vector<LiteralValue>& args, const Token& paren);
+
+    ~FlintFile() override;
+
+    std::string toString() const override { return "<file " + path + ">"; }
+
+    // Table entry for a builtin method, or nullptr if there is none
+    static const BuiltinMethod<FlintFile>* findBuiltin(Symbol name);
+
+    // The method bound to this handle, for when it is used as a value
+    LiteralValue getInBuiltFunction(const Token& name);
+
+    // The next line, without its end; false at the end of the file
+    bool readLine(std::string& line, const Token& where);
+
+    // Up to `size` bytes into `into`; fewer only at the end of the file
+    size_t read(char* into, size_t size, const Token& where);
+
+    void write(std::string_view text, const Token& where);
+
+    FlintFile(std::FILE* file, std::string path, bool writing);
+
+private:
+    std::FILE* file;                 // nullptr once closed
+    std::string path;
+    bool writing;
+
+    std::vector<char> buffer;        // Read ahead; [begin, end) is not consumed yet
+    size_t begin = 0;
+    size_t end = 0;
+
+    // Checks the handle is open in the right direction
+    void expect(bool forWriting, const Token& where) const;
+
+    // Reads more once the buffer is consumed; false at the end of the file
+    bool fill();
+
+    void close();
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintFloat64Array.h – Packed Array of Numbers
+// ─────────────────────────────────────────────────────────────────────────────
+//  Float64Array(n) is a fixed-length array of doubles stored back to back,
+//  with no per-element tags.  It is indexed and assigned like an array
+//  (a[i], a[i] = x, numbers only) and has bulk methods – sum, dot, scale,
+//  add, min, max, fill – that run as SIMD kernels over the whole buffer
+//  (see Simd.h) instead of one interpreted operation per element.  On large
+//  arrays the kernels are split across the ThreadPool, as is parallelSort.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
+#include "Flint/Callables/Functions/BuiltInFunction.h"
+
+class FlintFloat64Array : public FlintObject {
+private:
+    // Builtin methods shared by every Float64Array
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintFloat64Array>>& builtInFunctions();
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::FLOAT64_ARRAY; }
+    static constexpr const char* TYPE_NAME = "Float64Array";   // Prefix of its methods in profiles
+
+    // Underlying storage: 8 bytes per element
+    std::vector<double> elements;
+
+    std::string toString() const override;
+
+    // Table entry for a builtin method, or nullptr if there is none
+    static const BuiltinMethod<FlintFloat64Array>* findBuiltin(Symbol name);
+
+    // The method bound to this array, for when it is used as a value
+    LiteralValue getInBuiltFunction(const Token& name);
+
+    // The Float64Array(...) native: a length (zero-filled), or an array or
+    // Float64Array whose numbers are copied
+    static LiteralValue construct(const LiteralValue& from, const Token& paren);
+
+    explicit FlintFloat64Array(std::vector<double> elements);
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintMap.h – Hash Map from Values to Values (`Map()`)
+// ─────────────────────────────────────────────────────────────────────────────
+//  let counts = Map();
+//  counts[word] = (counts[word] or 0) + 1;
+//
+//  Keys compare the way == compares them for numbers (0 and -0 are one key)
+//  and strings (by content); any other value is its own key, by identity.
+//  nil and NaN cannot be keys.  Reading a missing key gives nil.
+//
+//  Entries are kept in an array in insertion order, which is the order
+//  keys(), values(), forEach() and print() see; a removed entry leaves a
+//  hole that is squeezed out when the map is next rebuilt.  The lookup
+//  table beside it is open-addressed with linear probing and holds entry
+//  positions, so it is 4 bytes a slot and is rebuilt without moving any
+//  values.  Each entry keeps its key's hash, so probes compare hashes first
+//  and rebuilding hashes nothing again.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
+#include "Flint/Callables/Functions/BuiltInFunction.h"
+
+class FlintMap : public FlintObject {
+private:
+    // Builtin methods shared by every map (has, get, remove, keys, ...)
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintMap>>& builtInFunctions();
+
+protected:
+    void trace(Tracer& trace) const override;
+    void clearReferences() override;
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::MAP; }
+    static constexpr const char* TYPE_NAME = "Map";   // Prefix of its methods in profiles
+
+    struct Entry {
+        LiteralValue key;       // Undefined for a removed entry
+        LiteralValue value;
+        size_t hash;
+    };
+
+    FlintMap() : FlintObject(ObjectType::MAP) {}
+
+    std::string toString() const override;
+
+    // Table entry for a builtin method, or nullptr if there is none
+    static const BuiltinMethod<FlintMap>* findBuiltin(Symbol name);
+
+    // The method bound to this map, for when it is used as a value
+    LiteralValue getInBuiltFunction(const Token& name);
+
+    // The value stored under `key`, or nullptr
+    const LiteralValue* find(const LiteralValue& key) const;
+
+    // Store `value` under `key`; throws at `where` for a key that cannot
+    // be used
+    void set(const LiteralValue& key, LiteralValue value, const Token& where);
+
+    // False if there was nothing under `key`
+    bool remove(const LiteralValue& key);
+
+    size_t size() const { return count; }
+
+    // [begin, end) of entries, holes included (key undefined)
+    const std::vector<Entry>& entries() const { return items; }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+    static constexpr uint32_t REMOVED = UINT32_MAX - 1;
+
+    // The slot holding the entry for `key`, or the size of `slots`
+    size_t slotOf(const LiteralValue& key, size_t hash) const;
+
+    // A new lookup table at most half full, squeezing out holes first
+    // unless a forEach is walking them
+    void rebuild();
+
+    std::vector<Entry> items;         // Insertion order, with holes
+    std::vector<uint32_t> slots;      // Positions in `items`, EMPTY or REMOVED
+    size_t count = 0;                 // Entries that are not holes
+    uint32_t walkers = 0;             // forEach calls in progress
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintMath.h – Native Vector, Quaternion and Matrix Values
+// ─────────────────────────────────────────────────────────────────────────────
+//  vec3(x, y, z), quat(x, y, z, w) and mat4() are built-in value types for
+//  scripting 3D math.  They are immutable: every operator and method returns
+//  a new value, so sharing one between variables behaves like sharing a
+//  number, and == compares components.
+//
+//    vec3:  v + v, v - v, v * v (componentwise), v * k, k * v, v / k, -v
+//    quat:  q * q (composition), q * v (rotates v)
+//    mat4:  m * m, m * v (transforms the point v), m * k
+//
+//  Components live in 16-byte-aligned arrays padded to whole SIMD lanes (see
+//  Simd.h), and .x/.y/.z/.w compare the property's symbol against constants
+//  instead of looking up a name.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <unordered_map>
+#include <string>
+#include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
+#include "Flint/Callables/Functions/BuiltInFunction.h"
+#include "Flint/Scanner/TokenType.h"
+
+class FlintVec3 : public FlintObject {
+private:
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintVec3>>& builtInFunctions();
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VEC3; }
+    static constexpr const char* TYPE_NAME = "vec3";   // Prefix of its methods in profiles
+
+    alignas(16) double v[4];   // x, y, z, and 0 padding the second lane
+
+    std::string toString() const override;
+
+    static const BuiltinMethod<FlintVec3>* findBuiltin(Symbol name);
+
+    // .x/.y/.z, or a builtin method bound to this vector
+    LiteralValue get(const Token& name);
+
+    FlintVec3(double x, double y, double z);
+};
+
+class FlintQuat : public FlintObject {
+private:
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintQuat>>& builtInFunctions();
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::QUAT; }
+    static constexpr const char* TYPE_NAME = "quat";   // Prefix of its methods in profiles
+
+    alignas(16) double q[4];   // x, y, z (vector part), w (scalar part)
+
+    std::string toString() const override;
+
+    static const BuiltinMethod<FlintQuat>* findBuiltin(Symbol name);
+
+    // .x/.y/.z/.w, or a builtin method bound to this quaternion
+    LiteralValue get(const Token& name);
+
+    // Rotation of `angle` radians about `axis` (normalized here)
+    static LiteralValue fromAxisAngle(const FlintVec3& axis, double angle);
+
+    FlintQuat(double x, double y, double z, double w);
+};
+
+class FlintMat4 : public FlintObject {
+private:
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintMat4>>& builtInFunctions();
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::MAT4; }
+    static constexpr const char* TYPE_NAME = "mat4";   // Prefix of its methods in profiles
+
+    alignas(16) double m[16];  // Column-major: m[column * 4 + row]
+
+    std::string toString() const override;
+
+    static const BuiltinMethod<FlintMat4>* findBuiltin(Symbol name);
+
+    // A builtin method bound to this matrix
+    LiteralValue get(const Token& name);
+
+    // The identity matrix
+    FlintMat4();
+};
+
+namespace FlintMath {
+    // Is `value` a vec3, quat or mat4?
+    inline bool isMath(const LiteralValue& value)
+    {
+        if (!value.isObject()) return false;
+        ObjectType type = value.asObject()->type;
+        return type >= ObjectType::VEC3 && type <= ObjectType::MAT4;
+    }
+
+    // `left op right` where at least one operand isMath; an unsupported
+    // combination is a RuntimeError at `where`
+    LiteralValue binary(TokenType op, const LiteralValue& left,
+                        const LiteralValue& right, const Token& where);
+
+    // -value for a vec3; anything else is a RuntimeError at `where`
+    LiteralValue negate(const LiteralValue& value, const Token& where);
+
+    // Componentwise equality of two values of the same math type
+    bool equal(const LiteralValue& left, const LiteralValue& right);
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintObject.h – Common Base of Every Heap-Allocated Flint Value
+// ─────────────────────────────────────────────────────────────────────────────
+//  Strings, arrays, instances, classes and every kind of callable derive from
+//  FlintObject.  It carries:
+//    - type:     a tag, so a LiteralValue can be type-tested without RTTI
+//    - refCount: an intrusive reference count, so a LiteralValue can own an
+//                object through a single 8-byte pointer
+//  and is a Collectable, so reference cycles between objects are found and
+//  freed by the Heap.  Subclasses that own references to other objects
+//  override trace() and clearReferences() to expose them.
+//
+//  Ref<T> is the owning smart pointer used by C++ code that holds objects
+//  outside of a LiteralValue (method tables, superclass links, ...).
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Flint/Heap.h"
+
+//──────────────────────────────────────────────────────────────────────────────
+// ObjectType: the concrete kind of a FlintObject.  Callables are kept last so
+// FlintCallable can test for the whole range.  The bytecode VM's objects are
+// called by the VM itself, not through FlintCallable, so they sit before it.
+//──────────────────────────────────────────────────────────────────────────────
+enum class ObjectType : uint8_t
+{
+    STRING,
+    STRING_BUILDER,   // Growable text buffer (FlintStringBuilder)
+    ARRAY,
+    MAP,              // Hash map from values to values (FlintMap)
+    FLOAT64_ARRAY,    // Packed array of doubles (FlintFloat64Array)
+    VEC3,             // 3-component vector (FlintVec3)
+    QUAT,             // Quaternion (FlintQuat)
+    MAT4,             // 4x4 matrix (FlintMat4)
+    FUTURE,           // Result of spawn(), to be awaited (FlintFuture)
+    FILE_HANDLE,      // Open file handle (FlintFile)
+    INSTANCE,
+    VM_FUNCTION,      // Compiled function prototype (VMFunction)
+    VM_UPVALUE,       // Captured variable of a VM closure (VMUpvalue)
+    VM_CLOSURE,       // VMFunction plus its captured upvalues (VMClosure)
+    VM_CLASS,         // Class created by the VM (VMClass)
+    VM_INSTANCE,      // Instance of a VMClass (VMInstance)
+    VM_BOUND_METHOD,  // VM method bound to its receiver (VMBoundMethod)
+    FUNCTION,   // User-defined function, method or lambda (FlintFunction)
+    NATIVE,     // Global native function (NativeFunction)
+    BUILTIN,    // String/array method bound to its receiver (BuiltinFunction)
+    CLASS,      // FlintClass, callable as its own constructor
+};
+
+class FlintObject : public Collectable
+{
+public:
+    const ObjectType type;
+
+    explicit FlintObject(ObjectType type) : type(type) {}
+    ~FlintObject() override
+    {
+        if (allocationSize) Heap::countRelease(static_cast<uint8_t>(type), allocationSize);
+    }
+
+    // Text shown by print() and string concatenation
+    virtual std::string toString() const = 0;
+
+    void retain() { ++refCount; }
+    void release() { if (--refCount == 0) delete this; }
+
+protected:
+    size_t referenceCount() const override { return refCount; }
+    void pin() override { retain(); }
+    void unpin() override { release(); }
+
+private:
+    template <typename T, typename... Args>
+    friend Ref<T> makeRef(Args&&... args);
+
+    uint16_t allocationSize = 0;   // sizeof the object, once makeRef has counted it
+    uint32_t refCount = 0;
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// Printing: marks a container as being printed on this thread for as long as
+// it lives.  A container that holds itself, directly or through others, is
+// printed as "[...]" or "{...}" where it comes round again (`recurring`),
+// instead of toString() recursing until the stack runs out.
+//──────────────────────────────────────────────────────────────────────────────
+class Printing
+{
+public:
+    explicit Printing(const FlintObject* object)
+        : recurring(std::find(open().begin(), open().end(), object) != open().end())
+    {
+        if (!recurring) open().push_back(object);
+    }
+    ~Printing() { if (!recurring) open().pop_back(); }
+
+    Printing(const Printing&) = delete;
+    Printing& operator=(const Printing&) = delete;
+
+    const bool recurring;   // Already being printed further out
+
+private:
+    static std::vector<const FlintObject*>& open()
+    {
+        static thread_local std::vector<const FlintObject*> printing;
+        return printing;
+    }
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// Ref<T>: intrusive owning pointer to a FlintObject subclass.
+//──────────────────────────────────────────────────────────────────────────────
+template <typename T>
+class Ref
+{
+public:
+    Ref() = default;
+    Ref(std::nullptr_t) {}
+
+    // Adopts (and retains) an object that is already managed by refcounting,
+    // e.g. `Ref<FlintInstance>(this)` from inside a method
+    explicit Ref(T* object) : object(object) { if (object) object->retain(); }
+
+    Ref(const Ref& other) : Ref(other.object) {}
+    Ref(Ref&& other) noexcept : object(std::exchange(other.object, nullptr)) {}
+
+    template <typename U>
+    Ref(const Ref<U>& other) : Ref(static_cast<T*>(other.get())) {}
+
+    ~Ref() { if (object) object->release(); }
+
+    Ref& operator=(Ref other) noexcept
+    {
+        std::swap(object, other.object);
+        return *this;
+    }
+
+    T* get() const { return object; }
+    T* operator->() const { return object; }
+    T& operator*() const { return *object; }
+    explicit operator bool() const { return object != nullptr; }
+
+    bool operator==(const Ref& other) const { return object == other.object; }
+    bool operator!=(const Ref& other) const { return object != other.object; }
+
+private:
+    T* object = nullptr;
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// makeRef: allocate a new object and take the first reference to it.
+//──────────────────────────────────────────────────────────────────────────────
+template <typename T, typename... Args>
+Ref<T> makeRef(Args&&... args)
+{
+    static_assert(sizeof(T) <= UINT16_MAX, "allocationSize holds the size");
+    T* object = new T(std::forward<Args>(args)...);
+    object->allocationSize = sizeof(T);
+    Heap::countAllocation(static_cast<uint8_t>(object->type), sizeof(T));
+    return Ref<T>(object);
+}
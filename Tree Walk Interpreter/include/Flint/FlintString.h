@@ -3,19 +3,36 @@
 #include <string>
 #include <unordered_map>
 #include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
 #include "Flint/Scanner/Token.h"
 #include "Flint/Callables/Functions/BuiltInFunction.h"
 
-class FlintString : public std::enable_shared_from_this<FlintString> {
+class FlintString : public FlintObject {
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<BuiltinFunction>> builtInFunctions;
+    // Builtin methods shared by every string (lower, upper, length)
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintString>>& builtInFunctions();
 
 public:
-    // Underlying storage
-    std::string value;
-    LiteralValue getInBuiltFunction(Token name);
+    static bool classof(ObjectType type) { return type == ObjectType::STRING; }
+    static constexpr const char* TYPE_NAME = "string";   // Prefix of its methods in profiles (string.upper)
+
+    // Underlying storage; strings are immutable once created, so one
+    // FlintString can be shared by every reference (pooled literals included)
+    const std::string value;
+
+    // Table entry for a builtin method, or nullptr if there is none
+    static const BuiltinMethod<FlintString>* findBuiltin(Symbol name);
+
+    // The method bound to this string, for when it is used as a value
+    LiteralValue getInBuiltFunction(const Token& name);
+
+    std::string toString() const override { return value; }
+
+    // `a + b` with a string on either side: the text of both, written into
+    // one buffer sized for it
+    static Ref<FlintString> concat(const LiteralValue& a, const LiteralValue& b);
 
     // Construct with some value
-    FlintString(std::string value);
+    explicit FlintString(std::string value);
 };
\ No newline at end of file
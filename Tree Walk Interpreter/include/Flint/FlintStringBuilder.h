@@ -0,0 +1,45 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlintStringBuilder.h – Growable Text Buffer
+// ─────────────────────────────────────────────────────────────────────────────
+//  Strings are immutable, so `s = s + x` in a loop copies everything built
+//  so far on every step.  A StringBuilder appends in place into a buffer
+//  that grows by doubling:
+//
+//      let out = StringBuilder();
+//      for (let i = 0; i < n; i = i + 1) out.append(i, ", ");
+//      print(out.toString());
+//
+//  append(...) takes any number of values, formatted as print() does, and
+//  returns the builder so calls can be chained.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <string>
+#include <unordered_map>
+#include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
+#include "Flint/Callables/Functions/BuiltInFunction.h"
+
+class FlintStringBuilder : public FlintObject {
+private:
+    // Builtin methods shared by every builder (append, length, toString, clear)
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintStringBuilder>>& builtInFunctions();
+
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::STRING_BUILDER; }
+    static constexpr const char* TYPE_NAME = "StringBuilder";   // Prefix of its methods in profiles
+
+    // The text appended so far
+    std::string buffer;
+
+    std::string toString() const override { return buffer; }
+
+    // Table entry for a builtin method, or nullptr if there is none
+    static const BuiltinMethod<FlintStringBuilder>* findBuiltin(Symbol name);
+
+    // The method bound to this builder, for when it is used as a value
+    LiteralValue getInBuiltFunction(const Token& name);
+
+    FlintStringBuilder() : FlintObject(ObjectType::STRING_BUILDER) {}
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Heap.h – Cycle Collector for Reference-Counted Runtime Objects
+// ─────────────────────────────────────────────────────────────────────────────
+//  Objects and environments are freed by reference counting the moment the
+//  last reference goes away.  That cannot free a cycle: a closure holds its
+//  Environment and the environment holds the closure, an instance stores
+//  itself in one of its own fields, and so on.  The Heap finds those cycles.
+//
+//  Every Collectable registers itself with the Heap.  A collection
+//    1. copies each object's reference count,
+//    2. subtracts every reference that comes from another object (found by
+//       asking each object to trace its references),
+//    3. treats objects with references left over as roots – something
+//       outside the heap (the C++ stack, the interpreter, the VM stack)
+//       still holds them – and marks everything reachable from them,
+//    4. breaks the unmarked ones apart (clearReferences), after which they
+//       are freed by their reference counts.
+//
+//  Because only counts are read, no root set has to be registered and a
+//  collection is safe at any allocation: whatever the running code holds
+//  is counted, so it can never look like garbage.  Collections run when the
+//  number of live objects passes a threshold that grows with the number
+//  that survived the last one, so their cost stays proportional to
+//  allocation (see Heap::configure).
+//
+//  Each thread has a Heap of its own, so interpreters running on different
+//  threads never touch the same registry.  Objects therefore belong to the
+//  thread that created them: they must be released on that thread, and a
+//  value handed to another thread has to be copied there.
+//
+//  The heap also keeps allocation counts per kind of object (`--stats`,
+//  memStats()): how many were allocated, how many are live, the bytes they
+//  take and the high-water marks of both.  Bytes are those of the objects
+//  themselves (sizeof), not of the buffers they own.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+class Collectable;
+class Environment;
+class LiteralValue;
+template <typename T> class Ref;
+
+//──────────────────────────────────────────────────────────────────────────────
+// Tracer: handed to Collectable::trace, which calls it on every reference the
+// object owns (exactly those counted in the referents' reference counts).
+//──────────────────────────────────────────────────────────────────────────────
+class Tracer
+{
+public:
+    void operator()(const LiteralValue& value);
+    void operator()(const std::shared_ptr<Environment>& environment);
+
+    template <typename T>
+    void operator()(const Ref<T>& ref) { if (ref) visit(ref.get()); }
+
+private:
+    friend class Heap;
+
+    enum class Mode { SUBTRACT, MARK };
+
+    Tracer(Mode mode, std::vector<Collectable*>& worklist) : mode(mode), worklist(worklist) {}
+
+    void visit(Collectable* node);
+
+    Mode mode;
+    std::vector<Collectable*>& worklist;   // MARK: reached, children not yet visited
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// Collectable: base of everything the Heap tracks (FlintObject, Environment).
+//──────────────────────────────────────────────────────────────────────────────
+class Collectable
+{
+public:
+    Collectable(const Collectable&) = delete;
+    Collectable& operator=(const Collectable&) = delete;
+
+protected:
+    Collectable();
+    virtual ~Collectable();
+
+    // Owners counted by reference counting; 0 for objects that are owned
+    // some other way (pooled frames) or not yet adopted by a Ref, which the
+    // collector never frees
+    virtual size_t referenceCount() const = 0;
+
+    // Call `tracer` on every owned reference to another Collectable
+    virtual void trace(Tracer& tracer) const {}
+
+    // Drop those references; the object is garbage and about to be freed
+    virtual void clearReferences() {}
+
+    // Keep the object alive while its cycle is being broken, then let go
+    virtual void pin() = 0;
+    virtual void unpin() = 0;
+
+private:
+    friend class Heap;
+    friend class Tracer;
+
+    uint32_t heapIndex;   // Position in Heap::objects
+    int32_t gcRefs = 0;   // Collection scratch: references from outside the heap
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// Heap: the registry of live Collectables and the collector itself.
+//──────────────────────────────────────────────────────────────────────────────
+class Heap
+{
+public:
+    struct Stats {
+        size_t liveObjects;      // Objects and environments currently allocated
+        size_t nextCollection;   // Live count that triggers the next collection
+        size_t collections;      // Collections run so far
+        size_t collected;        // Objects freed by the collector in total
+    };
+
+    // Collect once `threshold` objects are live, and afterwards once the live
+    // count reaches `growth` times the number that survived the previous
+    // collection (or `threshold`, whichever is larger).  Applies to this
+    // thread's heap and to those of threads that allocate for the first time
+    // afterwards.
+    static void configure(size_t threshold, double growth);
+
+    // Run a collection of this thread's heap now; returns the number of
+    // objects freed
+    static size_t collect();
+
+    static Stats stats();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Allocation counts of this thread's heap, per kind: a FlintObject's kind
+    // is its ObjectType, environments have one of their own.
+    //──────────────────────────────────────────────────────────────────────────
+    struct Counts {
+        size_t allocated = 0;    // Ever
+        size_t live = 0;
+        size_t peakLive = 0;
+        size_t bytes = 0;        // Of the live ones
+        size_t peakBytes = 0;
+    };
+
+    static constexpr size_t KINDS = 32;
+    static constexpr uint8_t ENVIRONMENT = KINDS - 1;
+
+    static void countAllocation(uint8_t kind, size_t bytes);
+    static void countRelease(uint8_t kind, size_t bytes);
+
+    static const Counts& counts(uint8_t kind);
+    static Counts totals();            // Peaks are those of the sums, not sums of peaks
+
+    // "string", "environment", ...; nullptr for a kind that is not used
+    static const char* kindName(uint8_t kind);
+
+    static constexpr size_t DEFAULT_THRESHOLD = 10000;
+    static constexpr double DEFAULT_GROWTH = 2.0;
+
+private:
+    friend class Collectable;
+    friend class Tracer;
+
+    // This thread's heap, created on first use
+    static Heap& instance();
+
+    Heap();
+
+    struct Reaper;
+    void releaseIfOrphaned();   // Delete the heap if its thread has ended and it is empty
+
+    void track(Collectable* node);
+    void untrack(Collectable* node);
+    size_t run();
+
+    // Marks objects reached from a root; never a real reference count
+    static constexpr int32_t REACHABLE = -1;
+    // Stands in for the count of an object with no counted owners
+    static constexpr int32_t PINNED = INT32_MAX / 2;
+
+    std::vector<Collectable*> objects;
+    size_t threshold;
+    double growth;
+    size_t nextCollection;
+    size_t collections = 0;
+    size_t collected = 0;
+    bool collecting = false;
+    bool orphaned = false;    // The owning thread has ended
+
+    Counts kinds[KINDS];
+    Counts total;
+};
+
+inline void Heap::countAllocation(uint8_t kind, size_t bytes)
+{
+    Heap& heap = instance();
+    for (Counts* c : { &heap.kinds[kind], &heap.total }) {
+        ++c->allocated;
+        c->bytes += bytes;
+        if (++c->live > c->peakLive) c->peakLive = c->live;
+        if (c->bytes > c->peakBytes) c->peakBytes = c->bytes;
+    }
+}
+
+inline void Heap::countRelease(uint8_t kind, size_t bytes)
+{
+    Heap& heap = instance();
+    for (Counts* c : { &heap.kinds[kind], &heap.total }) {
+        --c->live;
+        c->bytes -= bytes;
+    }
+}
+
+inline void Tracer::visit(Collectable* node)
+{
+    if (mode == Mode::SUBTRACT)
+        node->gcRefs--;
+    else if (node->gcRefs != Heap::REACHABLE)
+    {
+        node->gcRefs = Heap::REACHABLE;
+        worklist.push_back(node);
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ClosureCompiler.h – The Resolved AST Lowered to Closures (--engine=closure)
+// ─────────────────────────────────────────────────────────────────────────────
+//  The closure engine runs the same trees as the Interpreter, but first
+//  walks each one once and turns every node into a lowered node: an object
+//  whose run() does that node's work with everything it needs already
+//  bound – its lowered children, the resolved slot of a variable, the
+//  operator of a Binary – so running it dispatches on nothing but the
+//  virtual call itself.  Shapes of node that are common and cheap get
+//  nodes of their own (a local of the current scope, a binary operator on
+//  a local and a number, a counted for loop).
+//
+//  Lowering starts from the statements Interpreter::interpret is given; a
+//  function's body is lowered the first time it is called, and stays
+//  with its FunctionStmt.  What a lowered node does is what the Evaluator
+//  and the Interpreter do for it, mostly by calling them with operands it
+//  has evaluated (binaryOperation, getProperty, call, ...), so both
+//  engines report the same errors at the same tokens.
+//
+//  Lowered nodes live in the compiler's arena, as long as the interpreter.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <memory>
+#include <vector>
+#include "Flint/ASTNodes/Stmt.h"
+#include "Flint/Parser/AstArena.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Interpreter/Profiler.h"
+
+// An expression, lowered: run() is its value
+class LoweredExpr {
+public:
+    virtual LiteralValue run(const Evaluator& evaluator) const = 0;
+
+protected:
+    ~LoweredExpr() = default;
+};
+
+// A statement, lowered
+class LoweredStmt {
+public:
+    explicit LoweredStmt(size_t line) : line(line) {}
+
+    // Runs it, telling the profiler (if any) which line this is first, as
+    // Interpreter::execute does
+    Completion execute(const Evaluator& evaluator) const
+    {
+        if (Profiler* profiler = evaluator.interpreter.profiler) profiler->at(line);
+        return run(evaluator);
+    }
+
+    virtual Completion run(const Evaluator& evaluator) const = 0;
+
+protected:
+    ~LoweredStmt() = default;
+
+    size_t line;
+};
+
+// The parts of a lowered Call, as Evaluator::call evaluates them
+struct LoweredCall {
+    const Evaluator& evaluator;
+    const LoweredExpr* objectCode;                       // Of a Get callee
+    const LoweredExpr* calleeCode;                       // Any other (but super.name)
+    const std::vector<const LoweredExpr*>& argumentCode;
+
+    LiteralValue object() const { return objectCode->run(evaluator); }
+    LiteralValue callee() const { return calleeCode->run(evaluator); }
+    LiteralValue argument(size_t i) const { return argumentCode[i]->run(evaluator); }
+};
+
+class ClosureCompiler {
+public:
+    // What lowered nodes reach into the interpreter for (ClosureCompiler.cpp)
+    struct Access;
+
+    // `statement`, lowered
+    const LoweredStmt* lower(const Statement& statement);
+
+    // Runs the body of `function` in `frame` (in place of the Interpreter's
+    // executeBlock), lowering it first if this is its first call
+    Completion runBody(const Interpreter& interpreter, const FunctionStmt& function,
+                       const std::shared_ptr<Environment>& frame);
+
+private:
+    AstArena code;
+
+    template <typename Node, typename... Args>
+    const Node* make(Args&&... args) { return code.make<Node>(std::forward<Args>(args)...); }
+
+    const LoweredExpr* lower(ExprPtr expr);
+    std::vector<const LoweredStmt*> lower(const std::vector<StmtPtr>& statements);
+    std::vector<const LoweredExpr*> lower(const std::vector<ExprPtr>& expressions);
+
+    // The node kinds, each lowered by one overload
+    const LoweredExpr* lowerExpr(const Binary& expr);
+    const LoweredExpr* lowerExpr(const Logical& expr);
+    const LoweredExpr* lowerExpr(const Conditional& expr);
+    const LoweredExpr* lowerExpr(const Unary& expr);
+    const LoweredExpr* lowerExpr(const Literal& expr);
+    const LoweredExpr* lowerExpr(const Grouping& expr);
+    const LoweredExpr* lowerExpr(const Variable& expr);
+    const LoweredExpr* lowerExpr(const Assignment& expr);
+    const LoweredExpr* lowerExpr(const Lambda& expr);
+    const LoweredExpr* lowerExpr(const Call& expr);
+    const LoweredExpr* lowerExpr(const Get& expr);
+    const LoweredExpr* lowerExpr(const Set& expr);
+    const LoweredExpr* lowerExpr(const This& expr);
+    const LoweredExpr* lowerExpr(const Super& expr);
+    const LoweredExpr* lowerExpr(const Array& expr);
+    const LoweredExpr* lowerExpr(const GetIndex& expr);
+    const LoweredExpr* lowerExpr(const SetIndex& expr);
+
+    const LoweredStmt* lowerStmt(const ExpressionStmt& stmt);
+    const LoweredStmt* lowerStmt(const FunctionStmt& stmt);
+    const LoweredStmt* lowerStmt(const WhileStmt& stmt);
+    const LoweredStmt* lowerStmt(const ReturnStmt& stmt);
+    const LoweredStmt* lowerStmt(const BreakStmt& stmt);
+    const LoweredStmt* lowerStmt(const ContinueStmt& stmt);
+    const LoweredStmt* lowerStmt(const ForStmt& stmt);
+    const LoweredStmt* lowerStmt(const IfStmt& stmt);
+    const LoweredStmt* lowerStmt(const LetStmt& stmt);
+    const LoweredStmt* lowerStmt(const BlockStmt& stmt);
+    const LoweredStmt* lowerStmt(const ClassStmt& stmt);
+
+    // A read of the variable at `local` (`name` if it is a global)
+    const LoweredExpr* lowerRead(const Token& name, const LocalSlot& local);
+
+    // A Binary whose operator Op has a fast path for two numbers
+    template <typename Op>
+    const LoweredExpr* lowerArithmetic(const Binary& expr);
+
+    // The Call node; with Tail, a tail call (see Interpreter::TailCall)
+    template <bool Tail>
+    const LoweredExpr* lowerCall(const Call& expr);
+};
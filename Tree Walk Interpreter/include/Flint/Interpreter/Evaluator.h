@@ -18,8 +18,11 @@
 #include <cmath>
 #include "Flint/ASTNodes/Stmt.h"           // AST node definitions (ExprPtr)
 #include "Flint/Environment.h"        // For variable resolution
+#include "Flint/Callables/Functions/BuiltInFunction.h"  // BuiltinMethod table entries
 
 class Interpreter;  // Forward declare to avoid cyclic include
+class FlintFunction;
+class FlintClass;
 
 class Evaluator {
 public:
@@ -49,10 +52,10 @@ public:
     LiteralValue operator()(const Grouping& expr) const;
 
     // Look up variable value in appropriate environment.
-    LiteralValue operator()(const Variable& expr, ExprPtr exprPtr) const;
+    LiteralValue operator()(const Variable& expr) const;
 
     // Evaluate assignment: update variable and return new value.
-    LiteralValue operator()(const Assignment& expr, ExprPtr exprPtr) const;
+    LiteralValue operator()(const Assignment& expr) const;
 
     // Create a callable for a lambda expression.
     LiteralValue operator()(const Lambda& expr) const;
@@ -67,10 +70,10 @@ public:
     LiteralValue operator()(const Set& expr) const;
 
     // Handle 'this' keyword to reference current instance.
-    LiteralValue operator()(const This& expr, ExprPtr exprPtr) const;
+    LiteralValue operator()(const This& expr) const;
 
     // Handle 'super' keyword to reference the super class.
-    LiteralValue operator()(const Super& expr, ExprPtr exprPtr) const;
+    LiteralValue operator()(const Super& expr) const;
 
     LiteralValue operator()(const Array& expr) const;
     LiteralValue operator()(const GetIndex& expr) const;
@@ -87,16 +90,67 @@ public:
     //──────────────────────────────────────────────────────────────────────────
 
     // Determine truthiness: nil, false, and numeric zero are false; others true.
-    bool isTruthy(const LiteralValue& value) const;
+    static bool isTruthy(const LiteralValue& value);
 
-    // Resolve variable using static analysis distance or default lookup.
-    LiteralValue lookUpVariable(Token name, ExprPtr expr) const;
+    // Resolve variable using its resolved (depth, slot) or a global lookup.
+    LiteralValue lookUpVariable(const Token& name, const LocalSlot& local) const;
 
     // Compare two values for equality (handles numeric and other types).
-    bool isEqual(const LiteralValue& left, const LiteralValue& right) const;
+    static bool isEqual(const LiteralValue& left, const LiteralValue& right);
 
     std::string getMethodName(const ExprPtr& callee) const;
 
+    // Look up `expr.name` on an already evaluated object (fields, methods, builtins).
+    LiteralValue getProperty(const LiteralValue& object, const Get& expr) const;
+
+    // Evaluate `expr` as the value of a return statement: a call to a Flint
+    // function is left pending in the interpreter's tailCall instead.
+    LiteralValue tailCall(const Call& expr) const;
+
+    // The Call visitor; with Tail, calls to Flint functions are deferred.
+    // `parts` evaluates the pieces of the call: parts.object() the object
+    // of a Get callee, parts.callee() any other callee but super.name, and
+    // parts.argument(i) each argument.  The tree walker evaluates the nodes;
+    // the closure engine runs their lowered code (see ClosureCompiler.h).
+    template <bool Tail, typename Parts>
+    LiteralValue call(const Call& expr, const Parts& parts) const;
+
+    // Evaluate the arguments of `expr` and call `method` with `receiver` as 'this'.
+    template <typename Parts>
+    LiteralValue invokeMethod(const LiteralValue& receiver,
+        FlintFunction& method, const Call& expr, const Parts& parts) const;
+
+    // Evaluate the arguments of `expr` into the interpreter's tailCall.
+    template <typename Parts>
+    LiteralValue deferCall(const LiteralValue& receiver,
+        FlintFunction& function, const Call& expr, const Parts& parts) const;
+
+    // 'this' of the method containing `expr`; also yields the superclass
+    // method it names (throws if there is none).
+    const LiteralValue& superReceiver(const Super& expr, FlintFunction*& method) const;
+
+    // Evaluate the arguments of `expr` and call a builtin method on `receiver` directly.
+    template <typename Receiver, typename Parts>
+    LiteralValue invokeBuiltin(Receiver& receiver,
+        const BuiltinMethod<Receiver>& method, const Call& expr, const Parts& parts) const;
+
+    // The generic (unspecialized) operation of a Binary node on evaluated operands.
+    LiteralValue binaryOperation(const Binary& expr,
+        const LiteralValue& left, const LiteralValue& right) const;
+
+    // The operation of a Unary node on its evaluated operand.
+    LiteralValue unaryOperation(const Unary& expr, const LiteralValue& right) const;
+
+    // array[index] and array[index] = value on evaluated operands.
+    LiteralValue getIndexOperation(const GetIndex& expr,
+        const LiteralValue& array, const LiteralValue& index) const;
+    LiteralValue setIndexOperation(const SetIndex& expr,
+        const LiteralValue& array, const LiteralValue& index, const LiteralValue& value) const;
+
+    // The specialization for a Binary site whose operands were `left` and `right`.
+    static Binary::Quickened quicken(const Binary& expr,
+        const LiteralValue& left, const LiteralValue& right);
+
     // Enforce that operands match expected types (e.g., numbers for +).
     template<typename... Operands>
     void checkOperandType(const Token& op, const Operands&... operands) const;
@@ -8,6 +8,8 @@
 //  Manages the runtime environment (variable scopes, function contexts).
 // ─────────────────────────────────────────────────────────────────────────────
 
+#include <chrono>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -16,28 +18,45 @@
 #include "Flint/Environment.h"    // Environment for variable scopes
 #include "Evaluator.h"            // Expression evaluator
 #include "Flint/ASTNodes/Stmt.h"                 // AST nodes for statements
+#include "Flint/Exceptions/RuntimeError.h"       // Stack overflow
+#include "Flint/ValueSpan.h"                      // Arguments of calls from the host
+
+class Profiler;
+class ClosureCompiler;
+
+//──────────────────────────────────────────────────────────────────────────────
+// Completion: how a statement finished.  Blocks stop at anything but NORMAL
+// and hand it outward; loops consume BREAK and CONTINUE, and the function
+// call consumes RETURN, whose value waits in Interpreter::returnValue.
+//──────────────────────────────────────────────────────────────────────────────
+enum class Completion : uint8_t { NORMAL, RETURN, BREAK, CONTINUE };
 
 class Interpreter {
-private:
+public:
+    // Deepest call nesting allowed by default; leaves ample room on the
+    // default 8 MB main-thread stack for the C++ frames of each Flint call
+    static constexpr size_t DEFAULT_MAX_CALL_DEPTH = 4096;
+
     //──────────────────────────────────────────────────────────────────────────
-    // isInsideLoop: flag to track if currently in a loop context
-    // Used to validate break/continue usage and manage loop control flow.
+    // Budget: how far one run may go.  Every loop iteration and every call
+    // of a Flint function is a step; the step past `steps`, or the first
+    // one taken `time` after the run started, throws BudgetExceeded.  Zero
+    // is no limit.  A run is an outermost interpret() or host call (see
+    // Run), so a host time-slicing many scripts per frame gives each call
+    // the whole budget.  Every engine counts them.
     //──────────────────────────────────────────────────────────────────────────
-    mutable bool isInsideLoop = false;
-
+    struct Budget {
+        uint64_t steps = 0;
+        std::chrono::nanoseconds time{0};
+    };
 
+private:
     //──────────────────────────────────────────────────────────────────────────
     // globals: the global (outermost) environment
     // Stores all top-level variable and function definitions.
     //──────────────────────────────────────────────────────────────────────────
     std::shared_ptr<Environment> globals;
 
-    //──────────────────────────────────────────────────────────────────────────
-    // locals: mapping from expression nodes to their lexical scope depth
-    // Populated by the Resolver.  Enables fast lookups via Environment.getAt().
-    //──────────────────────────────────────────────────────────────────────────
-    std::unordered_map<ExprPtr, int> locals;
-
     //──────────────────────────────────────────────────────────────────────────
     // evaluator: helper object to compute expression values
     // Created on first use; uses this interpreter for context (e.g., function calls).
@@ -50,49 +69,232 @@ private:
     //──────────────────────────────────────────────────────────────────────────
     mutable std::shared_ptr<Environment> environment;
 
+    //──────────────────────────────────────────────────────────────────────────
+    // frames: environments of calls and blocks that no closure can capture,
+    // used as a stack and reused from one call or iteration to the next
+    // (see Frame).
+    //──────────────────────────────────────────────────────────────────────────
+    mutable std::vector<std::unique_ptr<Environment>> frames;
+    mutable size_t frameDepth = 0;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // callDepth: Flint calls currently running on the C++ stack (tail calls
+    // replace the caller instead of adding one).  A call past maxCallDepth,
+    // or one that would take the C++ stack below stackBase - stackBudget
+    // (whatever the depth limit), is a "Stack overflow." RuntimeError
+    // rather than a crash of the host.
+    //──────────────────────────────────────────────────────────────────────────
+    mutable size_t callDepth = 0;
+    size_t maxCallDepth = DEFAULT_MAX_CALL_DEPTH;
+    mutable std::uintptr_t stackBase = 0;   // Where the outermost interpret() started; 0 outside it
+    mutable std::uintptr_t stackBudget = 0; // C++ stack the interpreter may use below that
+
+    // Sets stackBase for as long as it lives, if nothing has yet (the
+    // outermost interpret() or host call)
+    class StackBase;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Execution budget (see Budget).  `ticks` counts the steps left before
+    // checkBudget() next looks at the budget: a slice of the steps allowed,
+    // cut short to CLOCK_INTERVAL steps when there is a deadline to read the
+    // clock for.  With no budget, or outside a run, it starts so high that
+    // it never runs out, and a step costs one decrement.
+    //──────────────────────────────────────────────────────────────────────────
+    static constexpr uint64_t NO_BUDGET = UINT64_MAX;
+    static constexpr uint64_t CLOCK_INTERVAL = 1024;
+    mutable uint64_t ticks = NO_BUDGET;
+    mutable uint64_t stepsLeft = 0;      // Of budget.steps, beyond `ticks`
+    mutable std::chrono::steady_clock::time_point deadline;
+    mutable int runs = 0;                // Runs in progress (see Run)
+
+    // Start the budget over for a run; hand `ticks` its next slice
+    void startBudget() const;
+    void refillTicks() const;
+    [[noreturn]] void budgetExceeded(size_t line, bool outOfSteps) const;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // closures: with the closure engine (see ClosureCompiler.h), the code
+    // programs and function bodies are lowered to; nullptr walks the tree.
+    //──────────────────────────────────────────────────────────────────────────
+    std::unique_ptr<ClosureCompiler> closures;
+
+    // What a run may spend (setBudget)
+    Budget budget;
+
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // CallbackRunner: calls the values an engine creates that are not
+    // FlintCallables (the VM's closures, classes and bound methods), so that
+    // builtins can call back into whichever engine is running.
+    //──────────────────────────────────────────────────────────────────────────
+    class CallbackRunner {
+    public:
+        virtual LiteralValue runCallback(const LiteralValue& callee,
+            const std::vector<LiteralValue>& arguments, const Token& paren) = 0;
+
+    protected:
+        ~CallbackRunner() = default;
+    };
+
+private:
+    CallbackRunner* callbackRunner = nullptr;
+
 public:
+    //──────────────────────────────────────────────────────────────────────────
+    // Frame: the environment of one function call or block execution, for
+    // as long as the object lives.  If the Resolver proved that no closure
+    // can capture it (`captured` is false), it comes from the frame stack
+    // and costs no allocation; otherwise it is heap-allocated, since a
+    // closure may keep it alive afterwards.
+    //──────────────────────────────────────────────────────────────────────────
+    class Frame {
+    public:
+        Frame(const Interpreter& interpreter, std::shared_ptr<Environment> enclosing,
+              int slotCount, bool captured);
+        ~Frame();
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        const std::shared_ptr<Environment>& environment() const { return frame; }
 
-    mutable bool returning = false;
+    private:
+        const Interpreter& interpreter;
+        std::shared_ptr<Environment> frame;   // Non-owning when pooled
+        bool pooled;
+    };
+
+    //──────────────────────────────────────────────────────────────────────────
+    // CallDepth: counts one Flint call for as long as the object lives;
+    // throws instead if the call would go past the depth limit.
+    //──────────────────────────────────────────────────────────────────────────
+    class CallDepth {
+    public:
+        CallDepth(const Interpreter& interpreter, const Token& paren) : interpreter(interpreter)
+        {
+            char top;   // Its address: how far down the C++ stack this call is
+            auto here = reinterpret_cast<std::uintptr_t>(&top);
+            if (interpreter.callDepth == interpreter.maxCallDepth ||
+                (here < interpreter.stackBase && interpreter.stackBase - here > interpreter.stackBudget))
+                throw RuntimeError(paren, "Stack overflow.");
+            interpreter.callDepth++;
+        }
+        ~CallDepth() { interpreter.callDepth--; }
+
+        CallDepth(const CallDepth&) = delete;
+        CallDepth& operator=(const CallDepth&) = delete;
+
+    private:
+        const Interpreter& interpreter;
+    };
+
+    //──────────────────────────────────────────────────────────────────────────
+    // TailCall: `return f(args)` to a Flint function does not call f but
+    // leaves it here with its evaluated arguments and RETURN as the
+    // completion; the function returning runs it in its own place
+    // (FlintFunction::execute), so tail recursion uses constant stack.
+    //──────────────────────────────────────────────────────────────────────────
+    struct TailCall {
+        LiteralValue callee = nullptr;      // A FlintFunction; nil if none is pending
+        LiteralValue receiver = nullptr;    // 'this' for a method
+        std::vector<LiteralValue> arguments;
+    };
+
+    //──────────────────────────────────────────────────────────────────────────
+    // returnValue: the value of the last Completion::RETURN, read (and
+    // reset) by the call it returns from, unless tailCall is pending
+    //──────────────────────────────────────────────────────────────────────────
     mutable LiteralValue returnValue = nullptr;
-    mutable bool breaking = false;
-    mutable bool continuing = false;
+    mutable TailCall tailCall;
+
+    // The profile being taken (`--profile`, see Profiler.h), or nullptr
+    Profiler* profiler = nullptr;
+
+    // C++ stack available to Flint calls on this platform and thread
+    static std::uintptr_t nativeStackBudget();
+
+    // Set the deepest call nesting allowed (at least 1)
+    void limitCallDepth(size_t depth) { maxCallDepth = depth; }
+    size_t callDepthLimit() const { return maxCallDepth; }
+
+    // The budget of the runs that follow
+    void setBudget(Budget limit) { budget = limit; }
+    const Budget& executionBudget() const { return budget; }
+
+    // Count one step at `line`; throws once the budget is spent
+    void step(size_t line) const { if (stepDue()) checkBudget(line); }
+
+    // step() in two halves, for an engine that finds its line only when it
+    // has to: whether this step needs checkBudget(), and the check itself
+    bool stepDue() const { return ticks-- == 0; }
+    void checkBudget(size_t line) const;
+
+    // checkBudget() for a run that is waiting rather than stepping (await):
+    // only the deadline, and no step taken
+    void checkDeadline(size_t line) const;
+
+    // What is left of the current run's budget (all of it outside a run), to
+    // hand to the tasks it spawns.  A limit already used up is left at its
+    // smallest, one step or one nanosecond, since zero would be no limit.
+    Budget remainingBudget() const;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Run: one run of either engine, for as long as the object lives.  The
+    // outermost one starts the budget; runs nested in it (natives calling
+    // back, a host call from inside a native) share what is left of it.
+    //──────────────────────────────────────────────────────────────────────────
+    class Run {
+    public:
+        explicit Run(const Interpreter& interpreter) : interpreter(interpreter)
+        {
+            if (interpreter.runs++ == 0) interpreter.startBudget();
+        }
+        ~Run() { if (--interpreter.runs == 0) interpreter.ticks = NO_BUDGET; }
+
+        Run(const Run&) = delete;
+        Run& operator=(const Run&) = delete;
+
+    private:
+        const Interpreter& interpreter;
+    };
+
     //──────────────────────────────────────────────────────────────────────────
     // Statement Visitors: executes different statement types
     // Invoked by std::visit on Statement variant.
     //──────────────────────────────────────────────────────────────────────────
 
     // while (condition) body
-    void operator()(const WhileStmt& stmt) const;
+    Completion operator()(const WhileStmt& stmt) const;
 
     // Function declaration: registers function in current environment
-    void operator()(const FunctionStmt& stmt) const;
+    Completion operator()(const FunctionStmt& stmt) const;
 
     // return statement inside function
-    void operator()(const ReturnStmt& stmt) const;
+    Completion operator()(const ReturnStmt& stmt) const;
 
     // if (condition) thenBranch else elseBranch
-    void operator()(const IfStmt& stmt) const;
+    Completion operator()(const IfStmt& stmt) const;
 
     // break: exit current loop
-    void operator()(const BreakStmt& stmt) const;
+    Completion operator()(const BreakStmt& stmt) const;
 
     // continue: jump to next loop iteration
-    void operator()(const ContinueStmt& stmt) const;
+    Completion operator()(const ContinueStmt& stmt) const;
 
-    // internal node for for-loop desugaring: ensures continue advances index
-    void operator()(const TryCatchContinueStmt& stmt) const;
+    // for (initializer; condition; increment) body
+    Completion operator()(const ForStmt& stmt) const;
 
     // expression stmt: evaluate and discard result
-    void operator()(const ExpressionStmt& exprStatement) const;
+    Completion operator()(const ExpressionStmt& exprStatement) const;
 
     // let stmt: declare variables
-    void operator()(const LetStmt& letStatement) const;
+    Completion operator()(const LetStmt& letStatement) const;
 
     // block stmt: execute a series of statements in new scope
-    void operator()(const BlockStmt& blockStatement) const;
+    Completion operator()(const BlockStmt& blockStatement) const;
 
     // class declaration: define a new class
-    void operator()(const ClassStmt& classStmt) const;
+    Completion operator()(const ClassStmt& classStmt) const;
 
     //──────────────────────────────────────────────────────────────────────────
     // Runtime Helpers
@@ -105,26 +307,69 @@ public:
     // Used by print and error messages.
     static std::string stringify(const LiteralValue& val);
 
+    // stringify(val) added to the end of `out`, with no string in between
+    // (concatenation, StringBuilder)
+    static void appendTo(std::string& out, const LiteralValue& val);
+
+    // The global environment, holding the native functions
+    const std::shared_ptr<Environment>& globalEnvironment() const { return globals; }
+
+    // Call a Flint value from a builtin (map, sort, ...).  Builtins calling
+    // once per element pass the same `arguments` vector each time.
+    LiteralValue callback(const LiteralValue& callee,
+        const std::vector<LiteralValue>& arguments, const Token& paren);
+
+    // callback() from outside the interpreter, for a host or a task calling
+    // into the program: the stack check measures from here, as interpret()
+    // does.  A Flint function reads its arguments straight from the span.
+    // A RuntimeError propagates to the caller.
+    LiteralValue invoke(const LiteralValue& callee, ValueSpan arguments, const Token& paren);
+
+    // Install (or, with nullptr, remove) the runner for non-FlintCallables
+    void setCallbackRunner(CallbackRunner* runner) { callbackRunner = runner; }
+
+    // Run what interpret() is given, and every function body, on the
+    // closure engine from now on
+    void lowerToClosures();
+
     //──────────────────────────────────────────────────────────────────────────
     // Entry Points for Execution
     //──────────────────────────────────────────────────────────────────────────
 
     // Execute a list of statement nodes (program or REPL line)
-    void interpret(std::vector<std::shared_ptr<Statement>> statements) const;
+    void interpret(const std::vector<StmtPtr>& statements) const;
 
     // Execute a single statement
-    void execute(std::shared_ptr<Statement> statement) const;
+    Completion execute(StmtPtr statement) const;
 
     // Execute a block of statements in a new environment
-    void executeBlock(std::vector<std::shared_ptr<Statement>> statements,
-                      std::shared_ptr<Environment> newEnv) const;
+    Completion executeBlock(const std::vector<StmtPtr>& statements,
+                            std::shared_ptr<Environment> newEnv) const;
+
+    // Execute the body of `function` in `frame`, the new environment of a
+    // call (lowered first with the closure engine)
+    Completion executeBody(const FunctionStmt& function,
+                           const std::shared_ptr<Environment>& frame) const;
+
+    // Execute statements in the current environment, stopping early on
+    // return, break or continue
+    Completion executeStatements(const std::vector<StmtPtr>& statements) const;
+
+    // Run a for loop in the current environment (its scope, if it has one)
+    Completion executeFor(const ForStmt& stmt) const;
+
+    // A for loop's condition, reading a counted loop's counter directly
+    bool forCondition(const ForStmt& stmt) const;
 
-    // Store resolved scope depth for a variable expression
-    void resolve(ExprPtr expr, int depth);
+    // Bind a declared name in the current scope: by slot for locals,
+    // by name for globals (slot == -1)
+    void declare(const Token& name, int slot, LiteralValue value) const;
 
-    // Allow Evaluator to access private members (environment, locals)
+    // Allow Evaluator to access private members (environment, globals)
     friend class Evaluator;
+    friend class ClosureCompiler;
 
     // Constructor: initializes global environment and evaluator
     Interpreter();
+    ~Interpreter();
 };
\ No newline at end of file
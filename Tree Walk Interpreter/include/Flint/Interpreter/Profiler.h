@@ -0,0 +1,163 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Profiler.h – Where a Script Spends Its Time (`--profile`)
+// ─────────────────────────────────────────────────────────────────────────────
+//  Two views of one run:
+//
+//    Functions – every call of a Flint function, native or builtin method is
+//      timed on the steady clock as it enters and leaves.  A function's
+//      inclusive time counts its outermost activations only (recursion is not
+//      counted twice); exclusive time leaves out the calls it made.  The same
+//      timings, kept per call path, give the collapsed stacks ("a;b;c 1234",
+//      in microseconds) that flamegraph.pl and speedscope read.
+//
+//    Lines – a sampling thread wakes every interval and counts the line of
+//      the statement the tree-walker is executing.  The VM does not track
+//      statement lines, so under `--engine=vm` only functions are reported.
+//
+//  The engines hold a Profiler pointer that is null unless profiling is on,
+//  so a run without one pays a test of it per call and per statement.
+//  All but the sampler belong to the thread running the context.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Starts the clock and the line sampler
+    explicit Profiler(std::chrono::microseconds interval = std::chrono::milliseconds(1));
+    ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Calls.  `key` is any address that stays put and identifies the callee
+    // (a declaration, a native, a method table entry); name() is only
+    // called the first time a key is seen.
+    //──────────────────────────────────────────────────────────────────────────
+    template <typename Name>
+    void enter(const void* key, Name&& name) { push(function(key, std::forward<Name>(name))); }
+
+    void leave();
+
+    // A tail call: the running function is left and `key` entered in its place
+    template <typename Name>
+    void replace(const void* key, Name&& name)
+    {
+        leave();
+        enter(key, std::forward<Name>(name));
+    }
+
+    // Calls under way, and leaving all but the first `calls` of them (an
+    // engine unwinding its frames after an error)
+    size_t depth() const { return stack.size() - 1; }
+    void unwindTo(size_t calls);
+
+    // Enter a call for as long as it lives, if `profiler` is not null
+    class Scope
+    {
+    public:
+        template <typename Name>
+        Scope(Profiler* profiler, const void* key, Name&& name) : profiler(profiler)
+        {
+            if (profiler) profiler->enter(key, std::forward<Name>(name));
+        }
+        ~Scope() { if (profiler) profiler->leave(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Profiler* profiler;
+    };
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Lines: the statement now executing, read by the sampler
+    //──────────────────────────────────────────────────────────────────────────
+    void at(size_t line) { currentLine.store(static_cast<uint32_t>(line), std::memory_order_relaxed); }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Results: stop() ends the run (the clock and the sampler); the others
+    // stop it first if need be.
+    //──────────────────────────────────────────────────────────────────────────
+    void stop();
+
+    // Functions by exclusive time, then the most sampled lines
+    void report(std::ostream& out);
+
+    // One "caller;callee microseconds" line per call path; false if the file
+    // cannot be written
+    bool writeCollapsed(const std::string& path);
+
+private:
+    struct Function {
+        std::string name;
+        uint64_t calls = 0;
+        Clock::duration inclusive{};
+        Clock::duration exclusive{};
+        uint32_t active = 0;                     // Activations on the stack
+    };
+
+    // One call path: a function as called from its parent's path
+    struct Node {
+        uint32_t function;
+        uint32_t parent;
+        Clock::duration self{};
+        std::vector<std::pair<uint32_t, uint32_t>> children;   // (function, node)
+    };
+
+    struct Frame {
+        uint32_t node;
+        uint32_t function;
+        Clock::time_point start;
+        Clock::duration children{};              // Time spent in calls it made
+        uint32_t line;                           // The caller's, restored on leave
+    };
+
+    template <typename Name>
+    uint32_t function(const void* key, Name&& name)
+    {
+        auto found = ids.find(key);
+        if (found != ids.end()) return found->second;
+        uint32_t id = static_cast<uint32_t>(functions.size());
+        functions.push_back(Function{std::string(name())});
+        ids.emplace(key, id);
+        return id;
+    }
+
+    void push(uint32_t function);
+    uint32_t child(uint32_t node, uint32_t function);
+    void sample();
+
+    std::unordered_map<const void*, uint32_t> ids;
+    std::vector<Function> functions;     // 0 is the script itself
+    std::vector<Node> nodes;             // 0 is the script's
+    std::vector<Frame> stack;            // stack[0] is the script's
+    Clock::duration total{};
+    bool stopped = false;
+
+    // Sampler
+    std::atomic<uint32_t> currentLine{0};
+    std::chrono::microseconds interval;
+    std::unordered_map<uint32_t, uint64_t> lineSamples;   // Written by the sampler until it is joined
+    uint64_t samples = 0;
+    std::mutex mutex;                    // Guards quit
+    std::condition_variable wake;
+    bool quit = false;
+    std::thread sampler;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MappedFile.h – A Whole File, Read-Only, in Memory
+// ─────────────────────────────────────────────────────────────────────────────
+//  Maps the file where the platform has mmap, so its pages are only read
+//  (and shared between processes) as they are touched; elsewhere it is read
+//  into a buffer.  Either way the bytes start on an 8-byte boundary, which
+//  lets BytecodeCache read its records in place.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False if the file could not be opened or read
+    explicit operator bool() const { return opened; }
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+    std::string_view text() const { return { reinterpret_cast<const char*>(bytes), length }; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    bool mapped = false;
+    std::vector<uint64_t> words;     // The contents, when not mapped
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Optimizer.h – AST Simplification Between Resolution and Execution
+// ─────────────────────────────────────────────────────────────────────────────
+//  Runs after the Resolver (so every error it reports is still reported) and
+//  rewrites the tree in place, for both engines:
+//    - folds Binary/Unary subtrees whose operands are all literals
+//      (`60 * 60 * 24` becomes one Literal)
+//    - decides Logical and Conditional expressions with a literal test
+//    - drops IfStmt branches and WhileStmt loops a literal test rules out
+//    - removes Grouping nodes, which only mattered to the parser
+//
+//  Folding uses the Evaluator itself, so a folded value is exactly what the
+//  expression would have produced at runtime.  An expression whose
+//  evaluation fails (`1 / 0`, `"a" - 1`) is left alone and still raises its
+//  error when, and only if, it runs.
+//
+//  Each visitor optimizes the node's children and returns the node that
+//  should take its place, or nullptr to keep it.  Replacements are either
+//  existing subtrees or new nodes allocated in the unit's AstArena.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <vector>
+#include "Flint/ASTNodes/Stmt.h"
+#include "Flint/ASTNodes/ExpressionNode.h"
+#include "Flint/Interpreter/Evaluator.h"
+#include "Flint/Parser/AstArena.h"
+
+class Optimizer
+{
+public:
+    Optimizer(AstArena& arena, Interpreter& interpreter)
+        : arena(arena), evaluator(interpreter) {}
+
+    // Entry point: optimize a unit's top-level statements in place
+    void optimize(std::vector<StmtPtr>& statements);
+
+    // === Statements ===
+
+    StmtPtr operator()(ExpressionStmt& stmt);
+    StmtPtr operator()(FunctionStmt& stmt);
+    StmtPtr operator()(WhileStmt& stmt);
+    StmtPtr operator()(ReturnStmt& stmt);
+    StmtPtr operator()(BreakStmt& stmt) { return nullptr; }
+    StmtPtr operator()(ContinueStmt& stmt) { return nullptr; }
+    StmtPtr operator()(ForStmt& stmt);
+    StmtPtr operator()(IfStmt& stmt);
+    StmtPtr operator()(LetStmt& stmt);
+    StmtPtr operator()(BlockStmt& stmt);
+    StmtPtr operator()(ClassStmt& stmt);
+
+    // === Expressions ===
+
+    ExprPtr operator()(Binary& expr);
+    ExprPtr operator()(Logical& expr);
+    ExprPtr operator()(Conditional& expr);
+    ExprPtr operator()(Unary& expr);
+    ExprPtr operator()(Literal& expr) { return nullptr; }
+    ExprPtr operator()(Grouping& expr);
+    ExprPtr operator()(Variable& expr) { return nullptr; }
+    ExprPtr operator()(Assignment& expr);
+    ExprPtr operator()(Lambda& expr);
+    ExprPtr operator()(Call& expr);
+    ExprPtr operator()(Get& expr);
+    ExprPtr operator()(Set& expr);
+    ExprPtr operator()(This& expr) { return nullptr; }
+    ExprPtr operator()(Super& expr) { return nullptr; }
+    ExprPtr operator()(Array& expr);
+    ExprPtr operator()(GetIndex& expr);
+    ExprPtr operator()(SetIndex& expr);
+
+private:
+    AstArena& arena;        // Owns the nodes created for folded values
+    Evaluator evaluator;    // Computes folded values
+
+    // Optimize the node `slot` points to, replacing it if it simplifies
+    void optimize(StmtPtr& slot);
+    void optimize(ExprPtr& slot);
+
+    // The literal `expr` holds, or nullptr if it is not a Literal
+    static const LiteralValue* constant(ExprPtr expr);
+
+    // A Literal node for the value of `node` (whose operands are literals),
+    // or nullptr if evaluating it raises a RuntimeError
+    template <typename Node>
+    ExprPtr fold(const Node& node);
+
+    // A statement that does nothing, for a branch or loop that never runs
+    StmtPtr emptyStatement();
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  AstArena.h – Bump Allocator Owning the AST of One Compilation Unit
+// ─────────────────────────────────────────────────────────────────────────────
+//  The Parser allocates every statement and expression node of one run()
+//  (a script, or one REPL line) in an AstArena.  Nodes refer to each other
+//  through plain pointers (ExprPtr, StmtPtr), so building the tree costs a
+//  pointer bump per node instead of a heap allocation plus a shared_ptr
+//  control block, and nothing is reference counted while it is walked.
+//
+//  Destroying the arena releases the whole tree at once: the destructors
+//  that still matter (nodes holding std::vectors or string constants) run
+//  from a list, then the blocks are freed in one sweep.
+//
+//  Runtime functions point back into the tree, so the arena must outlive
+//  every FlintFunction created from it (Flint keeps them for the session).
+//  The tree's tokens in turn view the unit's text, which the arena holds.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class SourceText;
+
+class AstArena
+{
+public:
+    AstArena() = default;
+    ~AstArena();
+
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    // Construct a T in the arena; it lives until the arena is destroyed
+    template <typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            void* memory = allocate(sizeof(Finalizer), alignof(Finalizer));
+            finalizers = new (memory) Finalizer{
+                [](void* p) { static_cast<T*>(p)->~T(); }, object, finalizers };
+        }
+        return object;
+    }
+
+    // Total bytes handed out so far (nodes plus bookkeeping)
+    size_t bytesAllocated() const { return allocated; }
+
+    // The text the nodes' tokens point into
+    std::shared_ptr<const SourceText> source;
+
+private:
+    // Destructor to run for a node whose members own memory outside the arena
+    struct Finalizer {
+        void (*destroy)(void*);
+        void* object;
+        Finalizer* next;
+    };
+
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+    size_t allocated = 0;
+    Finalizer* finalizers = nullptr;   // Most recently constructed first
+
+    void* allocate(size_t size, size_t alignment);
+};
@@ -4,19 +4,26 @@
 //  Parser.h – Token Stream → AST (Expressions & Statements)
 // ─────────────────────────────────────────────────────────────────────────────
 //  Implements a recursive-descent parser with Pratt-style precedence for
-//  constructing the AST from the list of Tokens produced by the Scanner.
+//  constructing the AST from the Tokens produced by the Scanner, which it
+//  pulls one at a time: the grammar needs a single token of lookahead, so
+//  only the current and previous tokens are held.
 //  Handles expressions (with full operator precedence and ternaries)
 //  and various statement types (let, if, while, for, return, etc.).
 // ─────────────────────────────────────────────────────────────────────────────
 
+#include <initializer_list>
 #include <iostream>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <unordered_map>
 #include "Flint/Scanner/TokenType.h"  // TokenType enum for matching
 #include "Flint/Scanner/Token.h"      // Token struct holding lexeme, type, literal
+#include "Flint/Scanner/Scanner.h"    // Source of the token stream
 #include "Flint/ASTNodes/ExpressionNode.h"     // ExprPtr and expression node variants
 #include "Flint/ASTNodes/Stmt.h"               // Statement variants
+#include "Flint/FlintString.h"                  // Pooled string literal constants
+#include "Flint/Parser/AstArena.h"              // Owns every node this parser builds
 
 class Parser {
 public:
@@ -31,10 +38,22 @@ public:
 
 private:
     //──────────────────────────────────────────────────────────────────────────
-    // Input tokens and cursor
+    // Input tokens: the one to consume next and the one consumed last
     //──────────────────────────────────────────────────────────────────────────
-    std::vector<Token> tokens;  // All tokens to process
-    int current = 0;            // Index of next token to consume
+    Scanner& scanner;           // Scans each token as it is needed
+    Token lookahead;            // peek()
+    Token consumed;             // previous()
+
+    AstArena& arena;            // Where every node of this unit is allocated
+
+    bool topLevel = false;      // Parsing a declaration of the unit's top level
+
+    //──────────────────────────────────────────────────────────────────────────
+    // String constant pool: each distinct literal becomes one shared,
+    // immutable FlintString that every Literal node with that text points to.
+    //──────────────────────────────────────────────────────────────────────────
+    std::unordered_map<std::string, Ref<FlintString>> stringConstants;
+    LiteralValue stringConstant(const LiteralValue& literal);
 
     //──────────────────────────────────────────────────────────────────────────
     // Expression Parsers (lowest → highest precedence)
@@ -57,30 +76,31 @@ private:
     //──────────────────────────────────────────────────────────────────────────
     // Statement Parsers (top-level and nested)
     //──────────────────────────────────────────────────────────────────────────
-    std::shared_ptr<Statement> declareStatement();     // `let`, `func`, `class` or fallback
-    std::shared_ptr<Statement> parseClassDeclaration();
-    std::shared_ptr<Statement> parseVarDeclaration();  // `let` statements
-    std::shared_ptr<Statement> parseFuncDeclaration(std::string&& kind); // `func` or getter
-    std::shared_ptr<Statement> parseStatement();       // Dispatch to specific stmts
-    std::shared_ptr<Statement> ifStatement();          // `if` syntax
-    std::shared_ptr<Statement> whileStatement();       // `while` loops
-    std::shared_ptr<Statement> forStatement();         // `for` loops (desugared)
-    std::shared_ptr<Statement> returnStatement();      // `return` in functions
-    std::shared_ptr<Statement> breakStatement();       // `break` in loops
-    std::shared_ptr<Statement> continueStatement();    // `continue` in loops
-    std::shared_ptr<Statement> printStatement();       // `print` builtin
-    std::shared_ptr<Statement> expressionStatement();  // Expressions as stmts
-    std::vector<std::shared_ptr<Statement>> blockStatement(); // `{ ... }` block
+    StmtPtr declareStatement();     // `let`, `func`, `class` or fallback
+    StmtPtr parseClassDeclaration();
+    StmtPtr parseVarDeclaration();  // `let` statements
+    StmtPtr parseFuncDeclaration(std::string&& kind); // `func` or getter
+    StmtPtr parseStatement();       // Dispatch to specific stmts
+    StmtPtr ifStatement();          // `if` syntax
+    StmtPtr whileStatement();       // `while` loops
+    StmtPtr forStatement();         // `for` loops
+    StmtPtr returnStatement();      // `return` in functions
+    StmtPtr breakStatement();       // `break` in loops
+    StmtPtr continueStatement();    // `continue` in loops
+    StmtPtr printStatement();       // `print` builtin
+    StmtPtr expressionStatement();  // Expressions as stmts
+    std::vector<StmtPtr> blockStatement(); // `{ ... }` block
+    void skipBody();                // A deferred body, up to its closing '}'
 
     //──────────────────────────────────────────────────────────────────────────
     // Token Utilities
     //──────────────────────────────────────────────────────────────────────────
-    bool match(const std::vector<TokenType>& types);   // If current matches any, consume
+    bool match(std::initializer_list<TokenType> types); // If current matches any, consume
     bool check(TokenType type);                        // Peek check without consuming
-    Token advance();                                   // Consume and return current
-    Token consume(TokenType type, const std::string& message); // Assert type or throw
-    Token peek() const;                                // Lookahead current token
-    Token previous() const;                            // Last consumed token
+    const Token& advance();                            // Consume and return current
+    const Token& consume(TokenType type, const std::string& message); // Assert type or throw
+    const Token& peek() const;                                // Lookahead current token
+    const Token& previous() const;                            // Last consumed token
     bool isAtEnd() const;                              // EOF reached?
 
     //──────────────────────────────────────────────────────────────────────────
@@ -95,24 +115,42 @@ private:
     void synchronize();                   // Discard tokens until statement boundary
 
     //──────────────────────────────────────────────────────────────────────────
-    // AST Factory Helpers (wrap nodes in shared_ptr)
+    // AST Factory Helpers (allocate nodes in the arena)
     //──────────────────────────────────────────────────────────────────────────
     template<typename T, typename... Args>
-    std::shared_ptr<ExpressionNode> makeExpr(Args&&... args);
+    ExprPtr makeExpr(Args&&... args);
 
     template<typename T, typename... Args>
-    std::shared_ptr<Statement> makeStmt(Args&&... args);
+    StmtPtr makeStmt(Args&&... args);
+    StmtPtr startingAt(size_t line, StmtPtr stmt);   // Sets the statement's line
 
 public:
     //──────────────────────────────────────────────────────────────────────────
     // parse
     //──────────────────────────────────────────────────────────────────────────
     // Entry point: returns a vector of top-level Statements for interpretation.
-    std::vector<std::shared_ptr<Statement>> parse();
+    // The nodes live in the arena passed to the constructor.
+    std::vector<StmtPtr> parse();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // parseBody
+    //──────────────────────────────────────────────────────────────────────────
+    // The body of a function whose parsing was deferred, with the scanner
+    // started at its '{' (see DeferredBody).
+    std::vector<StmtPtr> parseBody();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // deferBodies
+    //──────────────────────────────────────────────────────────────────────────
+    // Whether parse() skips the bodies of top-level functions and of the
+    // methods of top-level classes, checking only that their braces
+    // balance, and leaves them to be parsed on the first call (Flint::lazy).
+    bool deferBodies = false;
 
     //──────────────────────────────────────────────────────────────────────────
     // Constructor
     //──────────────────────────────────────────────────────────────────────────
-    explicit Parser(std::vector<Token> tokens)
-        : tokens(std::move(tokens)) {}
+    // The tokens' text must outlive the arena's use (see SourceText.h)
+    Parser(Scanner& scanner, AstArena& arena)
+        : scanner(scanner), lookahead(scanner.next()), consumed(lookahead), arena(arena) {}
 };
\ No newline at end of file
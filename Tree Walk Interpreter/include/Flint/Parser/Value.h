@@ -3,20 +3,29 @@
 // ─────────────────────────────────────────────────────────────────────────────
 //  Value.h – Runtime Value Representation for Flint
 // ─────────────────────────────────────────────────────────────────────────────
-//  Defines LiteralValue, a variant type that can hold any value produced
-//  or manipulated by Flint programs at runtime.
+//  Defines LiteralValue, the 8-byte NaN-boxed type that holds any value
+//  produced or manipulated by Flint programs at runtime.
+//
+//  Every double is stored as itself.  Everything else lives in the unused
+//  quiet-NaN space:
+//    - undefined (`nothing`), nil, false and true are small tag values
+//    - heap objects (FlintObject subclasses) are a 48-bit pointer with the
+//      sign bit set; the LiteralValue owns one reference to the object
 //
 //  Use cases:
 //    - Token literal values (numbers, strings, booleans, nothing)
-//    - Storage in variable environments
+//    - Storage in variable environments, arrays and instance fields
 //    - Results returned by expression evaluation
 // ─────────────────────────────────────────────────────────────────────────────
 
-#include <variant>
+#include <cstdint>
+#include <cstring>
+#include <variant>     // std::monostate, kept as the spelling of "undefined"
 #include <string>
 #include <memory>
 #include <vector>
 #include <iostream>
+#include "Flint/FlintObject.h"
 
 // Forward declarations for callable/class/instance types
 class FlintCallable;
@@ -25,17 +34,117 @@ class FlintInstance;
 class FlintArray;
 class FlintString;
 
+static_assert(sizeof(void*) == 8, "NaN-boxed values need 64-bit pointers");
+
+class LiteralValue
+{
+private:
+    static constexpr uint64_t SIGN_BIT      = 0x8000000000000000ull;
+    static constexpr uint64_t QNAN          = 0x7ffc000000000000ull;
+    static constexpr uint64_t CANONICAL_NAN = 0x7ff8000000000000ull;
+
+    static constexpr uint64_t UNDEFINED_BITS = QNAN | 1;  // `nothing`, unset values
+    static constexpr uint64_t NIL_BITS       = QNAN | 2;  // `let x;`, no return value
+    static constexpr uint64_t FALSE_BITS     = QNAN | 3;
+    static constexpr uint64_t TRUE_BITS      = QNAN | 4;
+    static constexpr uint64_t OBJECT_BITS    = SIGN_BIT | QNAN;
+
+    uint64_t bits;
+
+    void retain() const  { if (isObject()) asObject()->retain(); }
+    void release() const { if (isObject()) asObject()->release(); }
+
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // Construction: implicit from every primitive, and from Ref<T> objects
+    //──────────────────────────────────────────────────────────────────────────
+    LiteralValue() noexcept : bits(UNDEFINED_BITS) {}
+    LiteralValue(std::monostate) noexcept : bits(UNDEFINED_BITS) {}
+    LiteralValue(std::nullptr_t) noexcept : bits(NIL_BITS) {}
+    LiteralValue(bool value) noexcept : bits(value ? TRUE_BITS : FALSE_BITS) {}
+    LiteralValue(double value) noexcept
+    {
+        // Collapse every NaN to one pattern outside the tagged space
+        if (value != value) bits = CANONICAL_NAN;
+        else std::memcpy(&bits, &value, sizeof bits);
+    }
+
+    // Takes a new reference to `object`; a null object becomes nil
+    explicit LiteralValue(FlintObject* object) noexcept
+        : bits(object ? (OBJECT_BITS | reinterpret_cast<uintptr_t>(object)) : NIL_BITS)
+    {
+        retain();
+    }
+
+    template <typename T>
+    LiteralValue(const Ref<T>& object) noexcept
+        : LiteralValue(static_cast<FlintObject*>(object.get())) {}
+
+    // Raw pointers must not silently decay to bool; wrap them in a Ref
+    LiteralValue(const void*) = delete;
+
+    LiteralValue(const LiteralValue& other) noexcept : bits(other.bits) { retain(); }
+    LiteralValue(LiteralValue&& other) noexcept : bits(std::exchange(other.bits, UNDEFINED_BITS)) {}
+    ~LiteralValue() { release(); }
+
+    LiteralValue& operator=(const LiteralValue& other) noexcept
+    {
+        other.retain();
+        release();
+        bits = other.bits;
+        return *this;
+    }
+
+    LiteralValue& operator=(LiteralValue&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            bits = std::exchange(other.bits, UNDEFINED_BITS);
+        }
+        return *this;
+    }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Type tests
+    //──────────────────────────────────────────────────────────────────────────
+    bool isUndefined() const { return bits == UNDEFINED_BITS; }
+    bool isNil() const       { return bits == NIL_BITS; }
+    bool isNothing() const   { return isUndefined() || isNil(); }
+    bool isBool() const      { return bits == TRUE_BITS || bits == FALSE_BITS; }
+    bool isNumber() const    { return (bits & QNAN) != QNAN; }
+    bool isObject() const    { return (bits & OBJECT_BITS) == OBJECT_BITS; }
+
+    // True if this holds an object of class T (T::classof checks the type tag)
+    template <typename T>
+    bool is() const { return isObject() && T::classof(asObject()->type); }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Accessors (unchecked: test the type first)
+    //──────────────────────────────────────────────────────────────────────────
+    bool asBool() const { return bits == TRUE_BITS; }
+
+    double asNumber() const
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof value);
+        return value;
+    }
+
+    FlintObject* asObject() const
+    {
+        return reinterpret_cast<FlintObject*>(static_cast<uintptr_t>(bits & ~OBJECT_BITS));
+    }
+
+    // Borrowed pointer to the object if it is a T, nullptr otherwise
+    template <typename T>
+    T* as() const { return is<T>() ? static_cast<T*>(asObject()) : nullptr; }
+
+    // Owning reference to the object if it is a T, null otherwise
+    template <typename T>
+    Ref<T> ref() const { return Ref<T>(as<T>()); }
+
+    // Identity: same number bits, same tag, or the very same object
+    bool isSame(const LiteralValue& other) const { return bits == other.bits; }
+};
 
-// LiteralValue variant holds all primitive and object types:
-using LiteralValue = std::variant<
-    std::monostate,                // Default uninitialized state, signals absence of value
-    double,                        // Floating-point numeric literals (e.g., 3.14)
-    std::string,
-    std::shared_ptr<FlintString>,  // String literals (e.g., "hello world")
-    std::nullptr_t,                // ‘nothing’ keyword (null/nil equivalent)
-    bool,                          // Boolean literals: true or false
-    std::shared_ptr<FlintCallable>,// Functions or native-callable objects
-    std::shared_ptr<FlintClass>,   // Class definitions (for instantiation)
-    std::shared_ptr<FlintInstance>, // Object instances with fields and methods
-    std::shared_ptr<FlintArray>   // For arrays
->;
\ No newline at end of file
+static_assert(sizeof(LiteralValue) == 8, "LiteralValue must stay one machine word");
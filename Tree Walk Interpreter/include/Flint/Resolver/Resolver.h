@@ -6,16 +6,22 @@
 #include "Flint/Callables/Functions/FunctionType.h"
 #include "Flint/Callables/Classes/ClassType.h"
 
-class Interpreter;
+// Per-name bookkeeping inside a scope: initialization state and assigned slot
+struct ScopeVariable
+{
+    bool defined; // False while the variable's own initializer is being resolved
+    int slot;     // Index of the variable in its Environment's slot array
+};
 
 // Responsible for performing static resolution of variable scopes and bindings
 class Resolver
 {
 private:
-    std::shared_ptr<Interpreter> interpreter; // Reference to the interpreter to inform about resolved variables
-    std::vector<std::unordered_map<std::string, bool>> scopes; // Stack of scopes for variables, each map holds variable declarations in the current scope
+    std::vector<std::unordered_map<Symbol, ScopeVariable>> scopes; // Stack of scopes for variables, each map holds variable declarations in the current scope
     FunctionType currentFunction; // Tracks the current function type to detect invalid returns or recursion
     ClassType currentClass; // Tracks the current class context to validate 'this' and methods
+    std::vector<bool*> frames;  // isCaptured flags of the enclosing functions and block scopes
+    int loopDepth = 0;          // Loops enclosing the current statement within its function
 
 public:
 
@@ -27,7 +33,7 @@ public:
     void operator()(const IfStmt& stmt);                       // Resolves condition, then, and else blocks
     void operator()(const BreakStmt& stmt);                    // Validates break context (e.g., inside loops)
     void operator()(const ContinueStmt& stmt);                 // Validates continue context
-    void operator()(const TryCatchContinueStmt& stmt);         // Resolves try-catch with custom "continue" recovery
+    void operator()(const ForStmt& stmt);                      // Resolves the loop's own scope and spots counted loops
 
     void operator()(const ExpressionStmt& exprStatement);      // Resolves simple expression statements
     void operator()(const LetStmt& letStatement);              // Handles variable declaration and optional initializer
@@ -42,37 +48,40 @@ public:
     void operator()(const Unary& expr);                        // Resolves unary operations
     void operator()(const Literal& expr);                      // Literals (no resolution needed)
     void operator()(const Grouping& expr);                     // Resolves grouped sub-expressions
-    void operator()(const Variable& expr, ExprPtr exprPtr);    // Resolves usage of a variable
-    void operator()(const Assignment& expr, ExprPtr exprPtr);  // Resolves assignment targets and values
+    void operator()(const Variable& expr);                     // Resolves usage of a variable
+    void operator()(const Assignment& expr);                   // Resolves assignment targets and values
     void operator()(const Lambda& expr);                       // Resolves lambda (anonymous) function expression
     void operator()(const Call& expr);                         // Resolves function/method calls
     void operator()(const Get& expr);                          // Resolves property access (obj.prop)
     void operator()(const Set& expr);                          // Resolves property assignments (obj.prop = value)
-    void operator()(const This& expr, ExprPtr exprPtr);        // Resolves 'this' keyword inside classes
-    void operator()(const Super& expr, ExprPtr exprPtr);       // Resolves 'super' keyword inside classes
+    void operator()(const This& expr);                         // Resolves 'this' keyword inside classes
+    void operator()(const Super& expr);                        // Resolves 'super' keyword inside classes
     void operator()(const Array& expr);
     void operator()(const GetIndex& expr);
     void operator()(const SetIndex& expr);
 
     // === Entry Points for Resolution ===
 
-    void resolve(std::vector<std::shared_ptr<Statement>> statements); // Entry for resolving a list of statements
-    void resolve(std::shared_ptr<Statement> stmt);                    // Entry for resolving a single statement
+    void resolve(const std::vector<StmtPtr>& statements); // Entry for resolving a list of statements
+    void resolve(StmtPtr stmt);                    // Entry for resolving a single statement
     void resolve(ExprPtr expr);                                       // Entry for resolving a single expression
-    void resolveLocal(ExprPtr expr, Token name);                      // Resolve a variable in the current/local scope
+    void resolveLocal(LocalSlot& local, const Token& name);           // Write a name's (depth, slot) into its AST node
     void resolveFunction(const FunctionStmt &stmt, FunctionType type);// Handle function-specific resolution context
+    void resolveDeferred(const FunctionStmt &stmt, FunctionType type, ClassType classType); // A deferred body, in its declaration's context
+    void captureEnclosingFrames();  // A closure is created here: every enclosing frame may escape
+    void resolveCountedLoop(const ForStmt& stmt, int slot);  // Fill in counterSlot/step if the loop counts `slot`
 
     // === Scope Management ===
 
     void beginScope();  // Begins a new local scope
     void endScope();    // Ends the current local scope
 
-    void declare(Token name); // Declares a variable (name only, before value)
-    void define(Token name);  // Defines a variable (after its value has been resolved)
+    int declare(const Token& name);  // Declares a variable (name only, before value); returns its slot or -1 if global
+    void define(const Token& name); // Defines a variable (after its value has been resolved)
 
     // === Constructor ===
 
-    Resolver(std::shared_ptr<Interpreter> interpreter) 
-        : interpreter(interpreter), currentFunction(FunctionType::NONE), 
+    Resolver() 
+        : currentFunction(FunctionType::NONE), 
           currentClass(ClassType::NONE) {}
 };
\ No newline at end of file
@@ -3,17 +3,23 @@
 // ─────────────────────────────────────────────────────────────────────────────
 //  Scanner.h – Lexical Analysis for Flint
 // ─────────────────────────────────────────────────────────────────────────────
-//  Converts raw source code into a sequence of Tokens for parsing.
+//  Converts raw source code into a sequence of Tokens for parsing, one at a
+//  time as the Parser asks for them, so a unit's tokens never all exist at
+//  once.
 //  Recognizes:
 //    - Single- and multi-character operators (e.g., +, -, ==)
 //    - Punctuation (parentheses, braces, semicolons)
 //    - Literals (identifiers, strings, numbers)
 //    - Keywords (let, print, if, etc.)
 //  Handles whitespace, comments, and reports invalid tokens.
+//
+//  The Scanner reads the source in place and its tokens view it: the caller
+//  keeps the text alive for as long as they are used (see SourceText.h).
 // ─────────────────────────────────────────────────────────────────────────────
 
+#include <optional>
 #include <string>
-#include <vector>
+#include <string_view>
 #include <unordered_map>
 #include "Token.h"   // Token struct: type, lexeme, literal, line
 #include "Flint/Parser/Value.h"   // LiteralValue variant for number/string literals
@@ -23,22 +29,27 @@ public:
     //──────────────────────────────────────────────────────────────────────────
     // Constructor
     //──────────────────────────────────────────────────────────────────────────
-    // @param source: full source code as a single string
-    explicit Scanner(const std::string& source);
+    // @param source: full source code, read in place (not copied)
+    explicit Scanner(std::string_view source);
+
+    // @param offset, line: where in `source` to start, and the line there
+    //                      (rescanning a function body the Parser deferred)
+    Scanner(std::string_view source, size_t offset, size_t line);
 
     //──────────────────────────────────────────────────────────────────────────
-    // scanTokens
+    // next
     //──────────────────────────────────────────────────────────────────────────
-    // Performs the full scanning pass and returns the list of Tokens.
-    std::vector<Token> scanTokens();
+    // Scans and returns the next Token; END_OF_FILE once the source is used
+    // up (and on every call after that).
+    Token next();
 
 private:
     //──────────────────────────────────────────────────────────────────────────
     // Core state
     //──────────────────────────────────────────────────────────────────────────
-    std::string source;                        // Source text
-    std::vector<Token> tokens;                 // Accumulated tokens
-    static std::unordered_map<std::string, TokenType> keywords;  // Keyword lookup
+    std::string_view source;                   // Source text
+    std::optional<Token> scanned;              // Token found by scanToken(), if any
+    static const std::unordered_map<std::string_view, TokenType> keywords;  // Keyword lookup
 
     size_t start = 0;    // Start of current lexeme
     size_t current = 0;  // Current position in source
@@ -47,7 +58,8 @@ private:
     //──────────────────────────────────────────────────────────────────────────
     // scanToken
     //──────────────────────────────────────────────────────────────────────────
-    // Scans a single token from the source at `current`.
+    // Scans a single lexeme from the source at `current`, leaving the token
+    // in `scanned` unless it was whitespace, a comment or an error.
     void scanToken();
 
     //──────────────────────────────────────────────────────────────────────────
@@ -0,0 +1,35 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  SourceText.h – The Text of One Compilation Unit
+// ─────────────────────────────────────────────────────────────────────────────
+//  A script file is mapped (see MappedFile.h) rather than copied into a
+//  string; a REPL line or an embedder's source is kept as a string.  Tokens
+//  are views into this text, so every AstArena built from it holds a
+//  reference, as does the TaskProgram that replays it on worker threads.
+//  Shared and immutable, hence safe to read from any thread.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include "Flint/MappedFile.h"
+
+class SourceText
+{
+public:
+    // The contents of the file at `path`, or null if it cannot be read
+    static std::shared_ptr<const SourceText> fromFile(const std::string& path);
+
+    static std::shared_ptr<const SourceText> fromString(std::string text);
+
+    std::string_view text() const { return view; }
+
+    explicit SourceText(std::string text);
+    explicit SourceText(std::unique_ptr<MappedFile> file);
+
+private:
+    std::unique_ptr<MappedFile> file;   // Or:
+    std::string owned;
+    std::string_view view;
+};
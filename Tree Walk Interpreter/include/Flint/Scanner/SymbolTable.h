@@ -0,0 +1,73 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  SymbolTable.h – Interned Names for Flint
+// ─────────────────────────────────────────────────────────────────────────────
+//  Every name the Scanner produces is interned here exactly once and given
+//  a small integer ID (Symbol).  Runtime name maps (globals, fields, methods,
+//  builtins) are keyed on that ID, so a lookup hashes one integer instead of
+//  a whole string.
+//
+//  The interned strings live for the whole process, so the string_views
+//  handed out by name() never dangle.  The table is shared by every
+//  interpreter in the process and safe to use from any thread: intern()
+//  takes a lock, name() does not.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using Symbol = uint32_t;
+
+// ─────────────────────────────────────────────────────────────
+//  Well-known symbols: interned first, in this order, by the
+//  SymbolTable constructor so the runtime can use them as constants.
+// ─────────────────────────────────────────────────────────────
+namespace Symbols {
+    constexpr Symbol INIT   = 0;  // "init"   class initializer
+    constexpr Symbol THIS   = 1;  // "this"
+    constexpr Symbol SUPER  = 2;  // "super"
+    constexpr Symbol LENGTH = 3;  // "length" string/array builtin
+    constexpr Symbol LOWER  = 4;  // "lower"  string builtin
+    constexpr Symbol UPPER  = 5;  // "upper"  string builtin
+    constexpr Symbol PUSH   = 6;  // "push"   array builtin
+    constexpr Symbol POP    = 7;  // "pop"    array builtin
+    constexpr Symbol X      = 8;  // "x"      vec3/quat component
+    constexpr Symbol Y      = 9;  // "y"
+    constexpr Symbol Z      = 10; // "z"
+    constexpr Symbol W      = 11; // "w"      quat component
+}
+
+class SymbolTable
+{
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // intern: return the ID of `text`, adding it to the table on first sight.
+    //──────────────────────────────────────────────────────────────────────────
+    static Symbol intern(std::string_view text);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // name: the interned text of a symbol (stable for the process lifetime).
+    //──────────────────────────────────────────────────────────────────────────
+    static std::string_view name(Symbol symbol);
+
+private:
+    SymbolTable();
+    static SymbolTable& instance();
+
+    // Names are stored in fixed-size blocks that are never moved or freed,
+    // so a reader can index them while intern() appends
+    static constexpr size_t BLOCK_SIZE = 4096;
+    static constexpr size_t MAX_BLOCKS = 4096;
+
+    std::atomic<std::string*> blocks[MAX_BLOCKS] = {};  // Stable storage, indexed by Symbol
+    std::unordered_map<std::string_view, Symbol> ids;    // Text → Symbol (views into `blocks`)
+    size_t count = 0;                                    // Names interned so far
+    std::mutex mutex;                                    // Guards ids, count and new blocks
+
+    Symbol add(std::string_view text);   // Caller holds `mutex`
+};
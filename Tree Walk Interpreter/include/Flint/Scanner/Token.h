@@ -6,37 +6,70 @@
 //  Declares the Token class, the fundamental unit output by the Scanner.
 //  Each Token encapsulates:
 //    - type: category from TokenType (keywords, operators, literals, etc.)
-//    - lexeme: the exact substring from the source code
+//    - lexeme: the exact source text
+//    - symbol: interned ID of the lexeme; the key of every runtime name map
 //    - literal: parsed runtime value for literal tokens (numbers, strings, bool, nil)
 //    - line: source line number for error reporting
+//    - offset: where the lexeme starts in the unit's SourceText
+//
+//  Tokens from the Scanner view the SourceText, which the AstArena they end
+//  up in keeps alive, and only names (identifiers, `this`, `super`) are
+//  interned.  Tokens made elsewhere (natives, the VM's errors) intern their
+//  lexeme, so it never dangles.
 //
 //  Used by Parser to recognize grammar constructs and by Interpreter for
 //  error diagnostics and literal evaluation.
 // ─────────────────────────────────────────────────────────────────────────────
 
 #include <string>
+#include <string_view>
 #include "Flint/Parser/Value.h"       // Defines LiteralValue: variant of supported literal types
 #include "TokenType.h"  // Enumerates all token categories (IDENTIFIER, NUMBER, PLUS, etc.)
+#include "SymbolTable.h" // Interned names: Symbol IDs and their stable text
 
 class Token {
 public:
+    static constexpr Symbol NO_SYMBOL = UINT32_MAX;   // `symbol` of a token that is not a name
+
     TokenType type;        // Token category (e.g., IDENTIFIER, PLUS, NUMBER)
-    std::string lexeme;    // Exact source substring (e.g., "let", "x", "42")
+    std::string_view lexeme; // Source text (e.g., "let", "x", "42")
+    Symbol symbol;         // Interned ID of `lexeme`, or NO_SYMBOL
+    uint32_t offset = 0;   // Of `lexeme` in the SourceText; 0 if not from the Scanner
     LiteralValue literal;  // Evaluated literal value; unused for non-literals
     size_t line;           // Line number in source text (for error messages)
 
     //──────────────────────────────────────────────────────────────────────────
-    // Constructor: initialize all token fields
+    // Constructor: interns the lexeme and initializes all token fields
     //──────────────────────────────────────────────────────────────────────────
     Token(TokenType type,
-          const std::string& lexeme,
+          std::string_view lexeme,
           LiteralValue literal,
           int line)
         : type(type)
+        , symbol(SymbolTable::intern(lexeme))
+        , literal(std::move(literal))
+        , line(line)
+    {
+        this->lexeme = SymbolTable::name(symbol);
+    }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Constructor used by the Scanner: `lexeme` is a view into the source
+    //──────────────────────────────────────────────────────────────────────────
+    Token(TokenType type,
+          std::string_view lexeme,
+          Symbol symbol,
+          uint32_t offset,
+          LiteralValue literal,
+          size_t line)
+        : type(type)
         , lexeme(lexeme)
-        , literal(literal)
+        , symbol(symbol)
+        , offset(offset)
+        , literal(std::move(literal))
         , line(line)
-    {}
+    {
+    }
 
     //──────────────────────────────────────────────────────────────────────────
     // toString: human-readable representation for debugging
@@ -0,0 +1,80 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Simd.h – Portable Lanes of Doubles for the Numeric Kernels
+// ─────────────────────────────────────────────────────────────────────────────
+//  A thin layer over the vector instructions the compiler was told it may
+//  use: AVX (4 doubles) when built with it, else SSE2 (2 doubles, always on
+//  x86-64), else NEON on AArch64 (2 doubles).  Kernels are written once
+//  against simd::Vector and finish the last few elements one at a time.
+//
+//  Without any of those, FLINT_SIMD is 0 and the kernels run their scalar
+//  loop for every element.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define FLINT_SIMD 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FLINT_SIMD 1
+#else
+#define FLINT_SIMD 0
+#endif
+
+#if FLINT_SIMD
+namespace simd {
+
+#if defined(__AVX__)
+using Vector = __m256d;
+constexpr size_t WIDTH = 4;
+
+inline Vector load(const double* p)        { return _mm256_loadu_pd(p); }
+inline void store(double* p, Vector v)     { _mm256_storeu_pd(p, v); }
+inline Vector splat(double x)              { return _mm256_set1_pd(x); }
+inline Vector add(Vector a, Vector b)      { return _mm256_add_pd(a, b); }
+inline Vector sub(Vector a, Vector b)      { return _mm256_sub_pd(a, b); }
+inline Vector mul(Vector a, Vector b)      { return _mm256_mul_pd(a, b); }
+inline Vector min(Vector a, Vector b)      { return _mm256_min_pd(a, b); }
+inline Vector max(Vector a, Vector b)      { return _mm256_max_pd(a, b); }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+using Vector = float64x2_t;
+constexpr size_t WIDTH = 2;
+
+inline Vector load(const double* p)        { return vld1q_f64(p); }
+inline void store(double* p, Vector v)     { vst1q_f64(p, v); }
+inline Vector splat(double x)              { return vdupq_n_f64(x); }
+inline Vector add(Vector a, Vector b)      { return vaddq_f64(a, b); }
+inline Vector sub(Vector a, Vector b)      { return vsubq_f64(a, b); }
+inline Vector mul(Vector a, Vector b)      { return vmulq_f64(a, b); }
+inline Vector min(Vector a, Vector b)      { return vminq_f64(a, b); }
+inline Vector max(Vector a, Vector b)      { return vmaxq_f64(a, b); }
+#else
+using Vector = __m128d;
+constexpr size_t WIDTH = 2;
+
+inline Vector load(const double* p)        { return _mm_loadu_pd(p); }
+inline void store(double* p, Vector v)     { _mm_storeu_pd(p, v); }
+inline Vector splat(double x)              { return _mm_set1_pd(x); }
+inline Vector add(Vector a, Vector b)      { return _mm_add_pd(a, b); }
+inline Vector sub(Vector a, Vector b)      { return _mm_sub_pd(a, b); }
+inline Vector mul(Vector a, Vector b)      { return _mm_mul_pd(a, b); }
+inline Vector min(Vector a, Vector b)      { return _mm_min_pd(a, b); }
+inline Vector max(Vector a, Vector b)      { return _mm_max_pd(a, b); }
+#endif
+
+// Fold the lanes of `v` into one value with `combine`
+template <typename Combine>
+inline double reduce(Vector v, Combine combine)
+{
+    double lanes[WIDTH];
+    store(lanes, v);
+    double result = lanes[0];
+    for (size_t i = 1; i < WIDTH; ++i) result = combine(result, lanes[i]);
+    return result;
+}
+
+} // namespace simd
+#endif
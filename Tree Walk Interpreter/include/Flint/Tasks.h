@@ -0,0 +1,82 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Tasks.h – spawn / await: Flint Functions Running on Other Threads
+// ─────────────────────────────────────────────────────────────────────────────
+//  spawn(fn, args...) queues a call of fn on the ThreadPool and returns a
+//  future; await(future) returns the call's result (or raises its error),
+//  and joinAll([futures]) awaits each in turn and returns an array.
+//
+//  A task runs in a worker context – a Flint of its own, one per pool thread
+//  and spawning program – because the spawner's objects cannot be touched
+//  from another thread (see Heap.h).  Hence:
+//    - fn must be a function declared at the top level of the program.  The
+//      worker replays the program's top-level function and class
+//      declarations (and nothing else), then calls its own copy of fn.
+//    - The task sees those functions and classes, and the natives, but not
+//      the program's global variables.
+//    - Arguments and results are copied: nil, booleans, numbers, strings,
+//      arrays and maps of those (maps keep their insertion order),
+//      Float64Arrays, vec3, quat and mat4.
+//
+//  A thread awaiting a task that has not started runs it itself, and
+//  otherwise helps with queued tasks meanwhile; so tasks make progress (and
+//  run in spawning order) even with `--threads=1`, where the pool has no
+//  workers.  A host controls the scheduler through ThreadPool::configure.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Flint/Parser/Value.h"
+#include "Flint/FlintObject.h"
+#include "Flint/Scanner/Token.h"
+
+enum class Engine;
+class SourceText;
+class Task;
+
+//──────────────────────────────────────────────────────────────────────────────
+// TaskProgram: the units a context has run, in order, for its worker
+// contexts to replay.  Shared by the context, its tasks and their workers.
+//──────────────────────────────────────────────────────────────────────────────
+class TaskProgram
+{
+public:
+    using Unit = std::shared_ptr<const SourceText>;
+
+    // Record a unit that compiled; the settings apply to workers created later
+    void add(Unit source, Engine engine, bool optimize);
+
+    // Units from `first` on, and the settings workers run them with
+    std::vector<Unit> unitsFrom(size_t first, Engine& engine, bool& optimize) const;
+
+private:
+    mutable std::mutex mutex;   // Guards everything below
+    std::vector<Unit> units;
+    Engine engine{};
+    bool optimize = true;
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// FlintFuture: what spawn() returns; await() it for the result.
+//──────────────────────────────────────────────────────────────────────────────
+class FlintFuture : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::FUTURE; }
+
+    const std::shared_ptr<Task> task;
+
+    explicit FlintFuture(std::shared_ptr<Task> task);
+
+    std::string toString() const override { return "<future>"; }
+};
+
+namespace Tasks {
+    // The natives: spawn(fn, args...), await(future), joinAll(futures)
+    LiteralValue spawn(const std::vector<LiteralValue>& args, const Token& paren);
+    LiteralValue await(const LiteralValue& future, const Token& paren);
+    LiteralValue joinAll(const LiteralValue& futures, const Token& paren);
+}
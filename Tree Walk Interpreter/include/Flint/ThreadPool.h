@@ -0,0 +1,152 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ThreadPool.h – Work-Stealing Pool for Native Bulk Kernels
+// ─────────────────────────────────────────────────────────────────────────────
+//  parallelFor splits a range into chunks and runs them on the workers and
+//  the calling thread.  Each worker pops chunks from the back of its own
+//  queue and, when that runs dry, steals from the front of the others, so a
+//  chunk that takes longer than the rest (or a nested parallelFor, as in the
+//  merge passes of parallelSort) does not leave the other cores idle.
+//
+//  submit() queues a job to run on its own, as spawn() does for Flint tasks
+//  (see Tasks.h); those are stolen the same way, and runOne() lets a
+//  waiting thread help with them.
+//
+//  Chunks of a parallelFor run native code only.  The interpreter's objects
+//  use plain (non-atomic) reference counts and belong to their thread's Heap,
+//  so a chunk must read raw data (doubles, string contents) and not create,
+//  copy or drop a LiteralValue holding an object.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    using Body = std::function<void(size_t begin, size_t end)>;
+
+    // The process-wide pool, started on first use
+    static ThreadPool& instance();
+
+    // Threads to use, the caller included (0: one per hardware thread).
+    // Only takes effect before the pool is first used.
+    static void configure(size_t threads);
+
+    // Threads taking part in a parallelFor, the caller included
+    size_t concurrency() const { return workers.size() + 1; }
+
+    // Run body(begin, end) over [0, count) in chunks of at least `grain`
+    // items, returning once every chunk has finished.  If any chunk throws,
+    // the first exception is rethrown here (the others still run to the end).
+    void parallelFor(size_t count, size_t grain, const Body& body);
+
+    // Queue `job` to run once on some thread of the pool: the back of this
+    // thread's queue on a worker, else spread over the queues.  It must not
+    // throw.
+    void submit(std::function<void()> job);
+
+    // Run one queued chunk or job, if there is any; false if there was none
+    bool runOne();
+
+    // Sort items[0, count) by `less`: sorted runs, one per thread, then
+    // merged pairwise.  T must be plain data (doubles, indices).  Not stable.
+    template <typename T, typename Less>
+    void sort(T* items, size_t count, Less less);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+private:
+    // One parallelFor call: its chunks count down `pending`
+    struct Batch {
+        const Body* body;
+        std::atomic<size_t> pending;
+        std::mutex mutex;               // Guards error
+        std::exception_ptr error;
+    };
+
+    // A chunk of `batch`, or a submitted job if batch is null
+    struct Task {
+        Batch* batch = nullptr;
+        size_t begin = 0, end = 0;
+        std::function<void()> job;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    explicit ThreadPool(size_t threads);
+
+    void workerLoop(size_t index);
+
+    // Take a task: from the back of queue `home`, else stolen from the
+    // front of another; false if every queue is empty
+    bool take(size_t home, Task& task);
+    void run(const Task& task);
+
+    static size_t requestedThreads;
+
+    std::vector<std::unique_ptr<Queue>> queues;    // One per thread; the last is the callers'
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};                 // Tasks waiting in any queue
+    std::atomic<size_t> nextQueue{0};              // Where the next submitted job goes
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
+
+template <typename T, typename Less>
+void ThreadPool::sort(T* items, size_t count, Less less)
+{
+    constexpr size_t MIN_RUN = 1 << 14;   // Shorter runs are not worth a thread
+
+    size_t runs = 1;
+    while (runs < concurrency()) runs *= 2;
+    if (runs == 1 || count < runs * MIN_RUN)
+    {
+        std::sort(items, items + count, less);
+        return;
+    }
+
+    size_t runLength = (count + runs - 1) / runs;
+    auto bound = [&](size_t run) { return std::min(run * runLength, count); };
+
+    parallelFor(runs, 1, [&](size_t begin, size_t end) {
+        for (size_t run = begin; run < end; ++run)
+            std::sort(items + bound(run), items + bound(run + 1), less);
+    });
+
+    // Merge neighboring runs into the other buffer, doubling their length
+    std::vector<T> buffer(count);
+    T* from = items;
+    T* to = buffer.data();
+    for (size_t width = 1; width < runs; width *= 2)
+    {
+        parallelFor(runs / (2 * width), 1, [&](size_t begin, size_t end) {
+            for (size_t pair = begin; pair < end; ++pair)
+            {
+                size_t lo = bound(2 * pair * width);
+                size_t mid = bound((2 * pair + 1) * width);
+                size_t hi = bound((2 * pair + 2) * width);
+                std::merge(from + lo, from + mid, from + mid, from + hi, to + lo, less);
+            }
+        });
+        std::swap(from, to);
+    }
+    if (from != items) std::copy(from, from + count, items);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  BytecodeCache.h – Compiled Scripts Kept on Disk (.flintc)
+// ─────────────────────────────────────────────────────────────────────────────
+//  With `--engine=vm`, runFile("lib.flint") saves the compiled script as
+//  "lib.flintc" next to it, and later runs load that instead of scanning,
+//  parsing, resolving and compiling the source again.  The file records a
+//  hash of the source it came from; when that no longer matches (or the
+//  file was made by another format version, or with another -O setting) it
+//  is ignored and written anew.
+//
+//  The file is mapped into memory and read where it lies: every table is a
+//  fixed-size record at a known offset, aligned for its fields, so loading
+//  copies the bytecode into the functions without decoding anything.  Only
+//  names are interned again, since Symbol IDs belong to the process.
+//
+//  Writing is best effort: an unwritable directory just means no cache.
+//  The new file replaces the old one by rename, so workers starting at the
+//  same time never read a half-written cache.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <string>
+#include <string_view>
+#include "Flint/VM/VMObjects.h"
+
+namespace BytecodeCache {
+    // Where the cache of the script at `sourcePath` lives
+    std::string pathFor(const std::string& sourcePath);
+
+    // The script compiled from `source`, or null if the cache at `path` is
+    // missing, stale, or unreadable
+    Ref<VMFunction> load(const std::string& path, std::string_view source, bool optimized);
+
+    // Save `script`, compiled from `source`; false if it could not be saved
+    bool store(const std::string& path, std::string_view source, bool optimized,
+               const Ref<VMFunction>& script);
+}
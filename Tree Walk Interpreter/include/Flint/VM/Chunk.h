@@ -0,0 +1,100 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Chunk.h – Bytecode for the Flint Virtual Machine
+// ─────────────────────────────────────────────────────────────────────────────
+//  A Chunk is the compiled body of one function (or of the top-level script):
+//    - code:      a flat stream of one-byte opcodes followed by their operands
+//    - lines:     the source line of every byte, for runtime error messages
+//    - constants: literal values and nested function prototypes
+//    - names:     interned identifiers used by global/property instructions
+//
+//  Operands are big-endian.  Constant, name and jump operands are 16 bits;
+//  local slots, upvalue indices and argument counts are 8 bits.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstdint>
+#include <vector>
+#include "Flint/Parser/Value.h"
+#include "Flint/Scanner/SymbolTable.h"
+
+//──────────────────────────────────────────────────────────────────────────────
+// OpCode: one VM instruction.  Operands and stack effect are listed alongside.
+//──────────────────────────────────────────────────────────────────────────────
+enum class OpCode : uint8_t
+{
+    CONSTANT,        // [u16 constant]             → value
+    NIL,             //                            → nil
+    TRUE,            //                            → true
+    FALSE,           //                            → false
+    POP,             // value                      →
+
+    GET_LOCAL,       // [u8 slot]                  → value
+    SET_LOCAL,       // [u8 slot]         value    → value
+    GET_UPVALUE,     // [u8 index]                 → value
+    SET_UPVALUE,     // [u8 index]        value    → value
+    DEFINE_GLOBAL,   // [u16 name]        value    →
+    GET_GLOBAL,      // [u16 name]                 → value
+    SET_GLOBAL,      // [u16 name]        value    → value
+
+    GET_PROPERTY,    // [u16 name]        object   → value
+    SET_PROPERTY,    // [u16 name]  object value   → value
+    GET_SUPER,       // [u16 name]  this superclass → bound method
+    GET_INDEX,       //             array index    → value
+    SET_INDEX,       //       array index value    → value
+
+    EQUAL,           // a b → bool
+    NOT_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    ADD,             // a b → a + b (numbers, or concatenation with a string)
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    MODULO,
+    NOT,             // a → !a
+    NEGATE,          // a → -a
+
+    JUMP,            // [u16 offset]  forward
+    JUMP_IF_FALSE,   // [u16 offset]  forward, leaves the condition on the stack
+    LOOP,            // [u16 offset]  backward
+
+    CALL,            // [u8 argc]                  callee args → result
+    INVOKE,          // [u16 name][u8 argc]        receiver args → result
+    TAIL_CALL,       // CALL whose frame replaces the caller's (`return f(...)`)
+    TAIL_INVOKE,     // INVOKE likewise; both are followed by RETURN
+    SUPER_INVOKE,    // [u16 name][u8 argc]        this args superclass → result
+    CLOSURE,         // [u16 function] then [u8 isLocal][u8 index] per upvalue
+    CLOSE_UPVALUE,   // value →  (hoists the captured stack slot to the heap)
+    RETURN,          // result → (to the caller)
+
+    ARRAY,           // [u16 count]                elements → array
+    CLASS,           // [u16 name]                 → class
+    INHERIT,         // superclass class → superclass
+    METHOD,          // [u16 name]  class closure → class
+    STATIC_METHOD,   // [u16 name]  class closure → class
+
+    ERROR,           // [u16 constant]  raises a RuntimeError with that message
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// Chunk
+//──────────────────────────────────────────────────────────────────────────────
+struct Chunk
+{
+    std::vector<uint8_t> code;
+    std::vector<int> lines;               // Parallel to `code`
+    std::vector<LiteralValue> constants;
+    std::vector<Symbol> names;
+
+    // Append one byte tagged with its source line
+    void write(uint8_t byte, int line);
+
+    // Add a constant and return its index
+    int addConstant(LiteralValue value);
+
+    // Index of `name` in the names table, added on first use
+    int addName(Symbol name);
+};
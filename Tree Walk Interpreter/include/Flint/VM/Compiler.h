@@ -0,0 +1,146 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Compiler.h – AST to Bytecode Compiler for the Flint VM
+// ─────────────────────────────────────────────────────────────────────────────
+//  Walks the statements produced by the Parser (and checked by the Resolver)
+//  and emits one VMFunction per function body.  The front end is shared with
+//  the tree-walking interpreter; only the back end differs.
+//
+//  Variables are resolved again here, because the VM keeps locals in stack
+//  slots and captures them through upvalues instead of chaining Environments:
+//    - locals of the function being compiled → GET_LOCAL / SET_LOCAL
+//    - locals of an enclosing function       → GET_UPVALUE / SET_UPVALUE
+//    - everything else                       → GET_GLOBAL / SET_GLOBAL
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <memory>
+#include <vector>
+#include "Flint/ASTNodes/Stmt.h"
+#include "Flint/ASTNodes/ExpressionNode.h"
+#include "Flint/VM/Chunk.h"
+#include "Flint/VM/VMObjects.h"
+
+class Compiler
+{
+public:
+    // Compile a whole program (or one REPL line) into the script function.
+    // Errors are reported through Flint::error.
+    Ref<VMFunction> compile(const std::vector<StmtPtr>& statements);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Statement visitors
+    //──────────────────────────────────────────────────────────────────────────
+    void operator()(const ExpressionStmt& stmt);
+    void operator()(const FunctionStmt& stmt);
+    void operator()(const WhileStmt& stmt);
+    void operator()(const ReturnStmt& stmt);
+    void operator()(const BreakStmt& stmt);
+    void operator()(const ContinueStmt& stmt);
+    void operator()(const ForStmt& stmt);
+    void operator()(const IfStmt& stmt);
+    void operator()(const LetStmt& stmt);
+    void operator()(const BlockStmt& stmt);
+    void operator()(const ClassStmt& stmt);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Expression visitors
+    //──────────────────────────────────────────────────────────────────────────
+    void operator()(const Binary& expr);
+    void operator()(const Logical& expr);
+    void operator()(const Conditional& expr);
+    void operator()(const Unary& expr);
+    void operator()(const Literal& expr);
+    void operator()(const Grouping& expr);
+    void operator()(const Variable& expr);
+    void operator()(const Assignment& expr);
+    void operator()(const Lambda& expr);
+    void operator()(const Call& expr);
+    void operator()(const Get& expr);
+    void operator()(const Set& expr);
+    void operator()(const This& expr);
+    void operator()(const Super& expr);
+    void operator()(const Array& expr);
+    void operator()(const GetIndex& expr);
+    void operator()(const SetIndex& expr);
+
+private:
+    enum class FunctionKind { SCRIPT, FUNCTION, METHOD, INITIALIZER };
+
+    // A local variable living in a stack slot of the current frame
+    struct Local {
+        Symbol name;
+        int depth;              // Scope depth that declared it
+        bool isCaptured;        // Closed over by an inner function
+    };
+
+    // Where a closure finds a captured variable when it is created
+    struct Upvalue {
+        uint8_t index;          // Local slot or upvalue index of the enclosing function
+        bool isLocal;           // True: enclosing function's local; false: its upvalue
+    };
+
+    // `break` target: forward jumps patched once the loop is complete
+    struct Loop {
+        int scopeDepth;
+        std::vector<int> breakJumps;
+    };
+
+    // `continue` target: either the loop start (while) or the end of the
+    // for-loop body, so the increment runs
+    struct ContinueTarget {
+        int scopeDepth;
+        int loopStart;          // -1 means "jump forward", collected in `jumps`
+        std::vector<int> jumps;
+    };
+
+    // Per-function compilation state; `enclosing` links to the outer function
+    struct FunctionState {
+        FunctionState* enclosing;
+        Ref<VMFunction> function;
+        FunctionKind kind;
+        std::vector<Local> locals;
+        std::vector<Upvalue> upvalues;
+        std::vector<Loop> loops;
+        std::vector<ContinueTarget> continues;
+        int scopeDepth = 0;
+    };
+
+    FunctionState* current = nullptr;
+    int line = 0;               // Source line stamped on emitted code
+    bool tailCall = false;      // The Call about to be compiled is a return's value
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Traversal
+    //──────────────────────────────────────────────────────────────────────────
+    void compile(StmtPtr stmt);
+    void compile(const ExprPtr& expr);
+    void function(const FunctionStmt& stmt, FunctionKind kind);
+    void namedVariable(Symbol name, bool assign);
+    void defineVariable(const Token& name);
+    void popLocalsAbove(int depth);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Scopes and variable resolution
+    //──────────────────────────────────────────────────────────────────────────
+    void beginScope();
+    void endScope();
+    void addLocal(Symbol name);
+    int resolveLocal(FunctionState& state, Symbol name);
+    int resolveUpvalue(FunctionState& state, Symbol name);
+    int addUpvalue(FunctionState& state, uint8_t index, bool isLocal);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Emission
+    //──────────────────────────────────────────────────────────────────────────
+    Chunk& chunk() { return current->function->chunk; }
+    void setLine(const Token& token) { line = static_cast<int>(token.line); }
+    void emit(uint8_t byte);
+    void emit(OpCode op) { emit(static_cast<uint8_t>(op)); }
+    void emitShort(int value);
+    void emitConstant(LiteralValue value);
+    void emitName(OpCode op, Symbol name);
+    int emitJump(OpCode op);
+    void patchJump(int offset);
+    void emitLoop(int loopStart);
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  VM.h – Stack-Based Bytecode Virtual Machine for Flint
+// ─────────────────────────────────────────────────────────────────────────────
+//  Executes the VMFunctions produced by the Compiler.  Selected with
+//  `flint --engine=vm file.flint`; the tree-walking Interpreter remains the
+//  default engine.
+//
+//  Values live on one contiguous stack.  Each call pushes a CallFrame whose
+//  `slots` window starts at the callee (or receiver) followed by the
+//  arguments, so parameters and locals are plain array accesses.
+//
+//  Natives and the builtin string/array methods are shared with the
+//  Interpreter, which the VM keeps as their host.  Runtime errors are the
+//  same RuntimeErrors, reported through Flint::runtimeError; like the
+//  Interpreter, the VM then resumes with the next top-level statement.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "Flint/Parser/Value.h"
+#include "Flint/Scanner/Token.h"
+#include "Flint/VM/VMObjects.h"
+#include "Flint/Callables/Functions/BuiltInFunction.h"
+#include "Flint/Interpreter/Interpreter.h"
+
+class FlintCallable;
+
+class VM : private Interpreter::CallbackRunner
+{
+public:
+    // Registers the VM as the host's CallbackRunner, until destroyed
+    explicit VM(Interpreter& host);
+    ~VM();
+
+    // Run a compiled script; globals persist across calls (REPL lines)
+    void interpret(Ref<VMFunction> script);
+
+    // Call `callee` to completion on this stack, from the host or a builtin.
+    // If it throws, the frames and values it left are unwound first.
+    LiteralValue callFunction(const LiteralValue& callee, ValueSpan arguments);
+
+    // Define (or replace) a global, as the host's Flint::define does
+    void define(Symbol name, LiteralValue value) { globals.insert_or_assign(name, std::move(value)); }
+
+    // A global defined by the scripts run so far, or nullptr
+    const LiteralValue* global(Symbol name) const
+    {
+        auto it = globals.find(name);
+        return it != globals.end() ? &it->second : nullptr;
+    }
+
+private:
+    struct CallFrame {
+        Ref<VMClosure> closure;
+        const uint8_t* ip;
+        LiteralValue* slots;        // Slot 0: callee or receiver, then arguments
+        bool profiled;              // Entered in the host's profiler, to be left on return
+    };
+
+    static constexpr size_t SLOTS_PER_FRAME = 64;
+
+    Interpreter& host;                                  // Passed to natives and builtins
+    const int framesMax;                                // The script plus the host's call depth limit
+    const size_t stackMax;
+    std::unordered_map<Symbol, LiteralValue> globals;
+
+    std::unique_ptr<LiteralValue[]> stack;
+    LiteralValue* stackTop;
+    std::vector<CallFrame> frames;
+    int frameCount = 0;
+    Ref<VMUpvalue> openUpvalues;                        // Sorted by slot, highest first
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Execution
+    //──────────────────────────────────────────────────────────────────────────
+
+    // Run until the frame count drops back to `exitDepth`
+    void run(int exitDepth);
+
+    // Skip to the next top-level statement after an error; false at the end
+    bool recover();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Calls
+    //──────────────────────────────────────────────────────────────────────────
+    void callValue(int argCount);
+    void call(VMClosure* closure, int argCount);
+
+    // If a call made the frame above `caller`, move it into the caller's place
+    void replaceCaller(int caller);
+
+    // Leave the profile entry of `frame`, if it has one
+    void endProfile(CallFrame& frame);
+
+    // Pop every frame above the first `depth`
+    void dropFrames(int depth);
+    void callNative(FlintCallable* callable, int argCount);
+
+    // A builtin calling `callee` back: run it to completion on this stack
+    LiteralValue runCallback(const LiteralValue& callee,
+        const std::vector<LiteralValue>& arguments, const Token& paren) override;
+    void invoke(Symbol name, int argCount);
+    void invokeFromClass(VMClass* klass, Symbol name, int argCount);
+    template <typename Receiver>
+    void invokeBuiltin(Receiver& receiver, const BuiltinMethod<Receiver>& method,
+                       Symbol name, int argCount);
+
+    // Call a zero-argument method (a getter) to completion and return its value
+    LiteralValue callGetter(VMClosure* getter, const LiteralValue& receiver);
+
+    void getProperty(Symbol name);
+
+    // vec3/quat/mat4 operands: pop both, push `op` applied to them
+    void mathOperation(TokenType op, std::string_view lexeme);
+    void bindMethod(VMClass* klass, Symbol name);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Upvalues
+    //──────────────────────────────────────────────────────────────────────────
+    Ref<VMUpvalue> captureUpvalue(LiteralValue* slot);
+    void closeUpvalues(LiteralValue* last);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Stack
+    //──────────────────────────────────────────────────────────────────────────
+    void push(LiteralValue value);
+    LiteralValue pop() { return std::move(*--stackTop); }
+    LiteralValue& peek(int distance) { return stackTop[-1 - distance]; }
+    void popN(int count);
+    void resetStack();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // Errors
+    //──────────────────────────────────────────────────────────────────────────
+
+    // Token carrying the current source line (and `lexeme`) for RuntimeErrors
+    Token errorToken(std::string_view lexeme = "") const;
+    [[noreturn]] void error(const std::string& message, std::string_view lexeme = "") const;
+
+    // The host's checkBudget() at the current source line, once a step is
+    // due for it (loop back-edges and calls; see Interpreter::Budget)
+    void checkBudget() const;
+};
@@ -0,0 +1,209 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  VMObjects.h – Runtime Objects of the Bytecode VM
+// ─────────────────────────────────────────────────────────────────────────────
+//  The VM shares values, strings, arrays and native functions with the
+//  tree-walking interpreter, but functions and classes are represented
+//  differently: a function is compiled code plus captured upvalues instead of
+//  an AST node plus an Environment.
+//
+//    VMFunction    – compiled prototype (a Chunk, arity, upvalue count)
+//    VMUpvalue     – one captured variable; points into the VM stack while
+//                    the variable is live, then owns the value ("closed")
+//    VMClosure     – a VMFunction together with its upvalues
+//    VMClass       – method tables, flattened across inheritance
+//    VMInstance    – fields of one object of a VMClass
+//    VMBoundMethod – a method closure paired with its receiver
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Flint/FlintObject.h"
+#include "Flint/Parser/Value.h"
+#include "Flint/VM/Chunk.h"
+
+//──────────────────────────────────────────────────────────────────────────────
+// VMFunction: the compiled form of a function, method, lambda or script.
+//──────────────────────────────────────────────────────────────────────────────
+class VMFunction : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VM_FUNCTION; }
+
+    int arity = 0;
+    int upvalueCount = 0;
+    bool isGetter = false;       // Invoked on property access, like FunctionStmt::isGetter
+    std::string name;            // Empty for lambdas and the top-level script
+    int line = 0;                // Of the declaration, as FunctionStmt::line (profiles)
+    Chunk chunk;
+
+    // Script only: offset of each top-level statement, so the VM can resume
+    // with the next statement after a runtime error (as the interpreter does)
+    std::vector<size_t> statementStarts;
+
+    VMFunction() : FlintObject(ObjectType::VM_FUNCTION) {}
+
+protected:
+    // Constants are strings and nested prototypes, which cannot form a cycle
+    void trace(Tracer& trace) const override { for (const auto& c : chunk.constants) trace(c); }
+
+public:
+
+    std::string toString() const override
+    {
+        return name.empty() ? "<lambda>" : "<fn " + name + ">";
+    }
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// VMUpvalue: `location` points at the stack slot while it is open and at
+// `closed` once the enclosing function has returned.
+//──────────────────────────────────────────────────────────────────────────────
+class VMUpvalue : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VM_UPVALUE; }
+
+    LiteralValue* location;
+    LiteralValue closed;
+    Ref<VMUpvalue> next;         // Next open upvalue, lower on the stack
+
+    explicit VMUpvalue(LiteralValue* slot)
+        : FlintObject(ObjectType::VM_UPVALUE), location(slot) {}
+
+protected:
+    // While open, the value belongs to the VM stack, not to the upvalue
+    void trace(Tracer& trace) const override { trace(closed); trace(next); }
+    void clearReferences() override { closed = nullptr; next = nullptr; }
+
+public:
+
+    std::string toString() const override { return "<upvalue>"; }
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// VMClosure
+//──────────────────────────────────────────────────────────────────────────────
+class VMClosure : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VM_CLOSURE; }
+
+    Ref<VMFunction> function;
+    std::vector<Ref<VMUpvalue>> upvalues;
+
+    explicit VMClosure(Ref<VMFunction> function)
+        : FlintObject(ObjectType::VM_CLOSURE), function(std::move(function))
+    {
+        upvalues.resize(this->function->upvalueCount);
+    }
+
+protected:
+    void trace(Tracer& trace) const override
+    {
+        trace(function);
+        for (const auto& upvalue : upvalues) trace(upvalue);
+    }
+    void clearReferences() override { upvalues.clear(); }
+
+public:
+
+    std::string toString() const override { return function->toString(); }
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// VMClass: instance methods include inherited ones (copied down by INHERIT),
+// so a lookup never walks the superclass chain.  Static methods are not
+// inherited, matching FlintClass::get.
+//──────────────────────────────────────────────────────────────────────────────
+class VMClass : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VM_CLASS; }
+
+    const std::string name;
+    std::unordered_map<Symbol, Ref<VMClosure>> methods;
+    std::unordered_map<Symbol, Ref<VMClosure>> staticMethods;
+    Ref<VMClosure> initializer;  // Cached methods[init], null if there is none
+
+    explicit VMClass(std::string name)
+        : FlintObject(ObjectType::VM_CLASS), name(std::move(name)) {}
+
+protected:
+    void trace(Tracer& trace) const override
+    {
+        for (const auto& [name, method] : methods) trace(method);
+        for (const auto& [name, method] : staticMethods) trace(method);
+        trace(initializer);
+    }
+    void clearReferences() override
+    {
+        methods.clear();
+        staticMethods.clear();
+        initializer = nullptr;
+    }
+
+public:
+
+    VMClosure* findMethod(Symbol name) const
+    {
+        auto it = methods.find(name);
+        return it != methods.end() ? it->second.get() : nullptr;
+    }
+
+    std::string toString() const override { return name; }
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// VMInstance
+//──────────────────────────────────────────────────────────────────────────────
+class VMInstance : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VM_INSTANCE; }
+
+    Ref<VMClass> klass;
+    std::unordered_map<Symbol, LiteralValue> fields;
+
+    explicit VMInstance(Ref<VMClass> klass)
+        : FlintObject(ObjectType::VM_INSTANCE), klass(std::move(klass)) {}
+
+protected:
+    void trace(Tracer& trace) const override
+    {
+        trace(klass);
+        for (const auto& [name, value] : fields) trace(value);
+    }
+    void clearReferences() override { fields.clear(); }
+
+public:
+
+    std::string toString() const override { return klass->name + " instance"; }
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// VMBoundMethod: created only when a method is used as a value
+// (`let f = obj.method;`); `obj.method()` is dispatched by INVOKE instead.
+//──────────────────────────────────────────────────────────────────────────────
+class VMBoundMethod : public FlintObject
+{
+public:
+    static bool classof(ObjectType type) { return type == ObjectType::VM_BOUND_METHOD; }
+
+    LiteralValue receiver;
+    Ref<VMClosure> method;
+
+    VMBoundMethod(LiteralValue receiver, Ref<VMClosure> method)
+        : FlintObject(ObjectType::VM_BOUND_METHOD),
+          receiver(std::move(receiver)), method(std::move(method)) {}
+
+protected:
+    void trace(Tracer& trace) const override { trace(receiver); trace(method); }
+    void clearReferences() override { receiver = nullptr; }
+
+public:
+
+    std::string toString() const override { return method->toString(); }
+};
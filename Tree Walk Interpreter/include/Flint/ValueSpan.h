@@ -0,0 +1,37 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ValueSpan.h – A Non-Owning View of Call Arguments
+// ─────────────────────────────────────────────────────────────────────────────
+//  Arguments handed in from C++ (see Embedding.h) live wherever the caller
+//  keeps them – usually a local array – and are read in place, so a call
+//  from the host does not build a std::vector first.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <vector>
+#include "Flint/Parser/Value.h"
+
+class ValueSpan
+{
+public:
+    ValueSpan() = default;
+    ValueSpan(const LiteralValue* data, size_t size) : first(data), count(size) {}
+
+    template <size_t N>
+    ValueSpan(const LiteralValue (&values)[N]) : first(values), count(N) {}
+
+    ValueSpan(const std::vector<LiteralValue>& values) : first(values.data()), count(values.size()) {}
+
+    const LiteralValue* data() const { return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const LiteralValue& operator[](size_t i) const { return first[i]; }
+    const LiteralValue* begin() const { return first; }
+    const LiteralValue* end() const { return first + count; }
+
+private:
+    const LiteralValue* first = nullptr;
+    size_t count = 0;
+};
@@ -6,15 +6,17 @@
 //  Environment::define
 // ─────────────────────────────────────────────────────────────────────────────
 //  Adds a new variable to the current environment/scope.
-//  - @param name  : variable name as a string
+//  - @param name  : interned variable name
 //  - @param value : associated LiteralValue
 //
 //  This does not check for redefinition or shadowing—each environment maintains
 //  its own local variables independently.
 // ─────────────────────────────────────────────────────────────────────────────
-void Environment::define(std::string name, LiteralValue value)
+void Environment::define(Symbol name, LiteralValue value)
 {
-    values[name] = value;
+    auto [it, added] = index.try_emplace(name, static_cast<uint32_t>(named.size()));
+    if (added) named.push_back(Named{name, std::move(value)});
+    else       named[it->second].value = std::move(value);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -31,36 +33,45 @@ void Environment::define(std::string name, LiteralValue value)
 //      - `std::monostate` (declared but uninitialized variables)
 //      - `nullptr` explicitly assigned
 // ─────────────────────────────────────────────────────────────────────────────
-LiteralValue Environment::get(Token name)
+LiteralValue Environment::get(const Token& name)
 {
-    if (values.count(name.lexeme)) 
+    uint32_t cached = NOT_CACHED;
+    return getIndexed(name, cached);
+}
+
+const LiteralValue& Environment::getIndexed(const Token& name, uint32_t& cached)
+{
+    auto it = index.find(name.symbol);
+    if (it != index.end()) 
     {
+        const LiteralValue& value = named[it->second].value;
+
         // Check if variable exists but is uninitialized
-        if(std::holds_alternative<std::nullptr_t>(values[name.lexeme]) 
-            || std::holds_alternative<std::monostate>(values[name.lexeme]))
+        if(value.isNothing())
         {
-            throw RuntimeError(name, "Variable '" + name.lexeme + "' has no value assigned to it.");
+            throw RuntimeError(name, "Variable '" + std::string(name.lexeme) + "' has no value assigned to it.");
         }
-        return values[name.lexeme];
+        cached = it->second;
+        return value;
     }
     // Recursively check enclosing scopes
-    if(enclosing) return enclosing -> get(name);
+    if(enclosing) return enclosing -> getIndexed(name, cached);
 
-    throw RuntimeError(name, "Unknown variable '" + name.lexeme + "'.");
+    throw RuntimeError(name, "Unknown variable '" + std::string(name.lexeme) + "'.");
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Environment::getAt
 // ─────────────────────────────────────────────────────────────────────────────
-//  Efficient variable lookup when scope depth is known (via resolver).
+//  Efficient variable lookup when scope depth and slot are known (via resolver).
 //  - @param distance : number of environments to go outward
-//  - @param name     : variable token (for key lookup)
+//  - @param slot     : index into that environment's slot array
 //
-//  Bypasses recursive search by jumping directly to ancestor environment.
+//  Bypasses both the recursive search and any name hashing.
 // ─────────────────────────────────────────────────────────────────────────────
-LiteralValue Environment::getAt(int distance, Token name)
+const LiteralValue& Environment::getAt(int distance, int slot)
 {
-    return ancestors(distance)->values[name.lexeme];
+    return ancestors(distance)->slots[slot];
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -70,13 +81,14 @@ LiteralValue Environment::getAt(int distance, Token name)
 //  - @param distance : number of steps to climb enclosing scopes
 //
 //  Returns:
-//      shared_ptr to the target ancestor environment
+//      non-owning pointer to the target ancestor environment (walking raw
+//      pointers avoids touching reference counts on every hop)
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Environment> Environment::ancestors(int distance)
+Environment* Environment::ancestors(int distance)
 {
-    std::shared_ptr<Environment> environment = shared_from_this();
+    Environment* environment = this;
     for(int i = 0; i < distance; i++) 
-        environment = environment->enclosing;
+        environment = environment->enclosing.get();
     return environment;
 }
 
@@ -84,15 +96,15 @@ std::shared_ptr<Environment> Environment::ancestors(int distance)
 //  Environment::getOptional
 // ─────────────────────────────────────────────────────────────────────────────
 //  Safe lookup that returns std::optional instead of throwing errors.
-//  - @param name : variable name (string)
+//  - @param name : interned variable name
 //
 //  Returns:
 //      std::optional<LiteralValue> — nullopt if variable not found.
 // ─────────────────────────────────────────────────────────────────────────────
-std::optional<LiteralValue> Environment::getOptional(const std::string& name) const 
+std::optional<LiteralValue> Environment::getOptional(Symbol name) const 
 {
-    if (values.find(name) != values.end()) {
-        return values.at(name);
+    if (const LiteralValue* value = lookup(name)) {
+        return *value;
     }
     if (enclosing) {
         return enclosing->getOptional(name);
@@ -104,7 +116,7 @@ std::optional<LiteralValue> Environment::getOptional(const std::string& name) co
 //  Environment::assign
 // ─────────────────────────────────────────────────────────────────────────────
 //  Reassigns value to a variable, searching through enclosing scopes.
-//  - @param name  : variable token (includes lexeme for key + error context)
+//  - @param name  : variable token (symbol is the key, lexeme the error context)
 //  - @param value : new LiteralValue
 //
 //  Throws:
@@ -112,34 +124,62 @@ std::optional<LiteralValue> Environment::getOptional(const std::string& name) co
 //
 //  Supports mutation of outer scopes (closure support).
 // ─────────────────────────────────────────────────────────────────────────────
-void Environment::assign(Token name, LiteralValue value)
+void Environment::assign(const Token& name, LiteralValue value)
 {
-    if(values.count(name.lexeme))
+    uint32_t cached = NOT_CACHED;
+    assignIndexed(name, std::move(value), cached);
+}
+
+void Environment::assignIndexed(const Token& name, LiteralValue value, uint32_t& cached)
+{
+    auto it = index.find(name.symbol);
+    if(it != index.end())
     {
-        values[name.lexeme] = value;
+        named[it->second].value = std::move(value);
+        cached = it->second;
         return;
     }
 
     if(enclosing) 
     {
-        enclosing->assign(name, value);
+        enclosing->assignIndexed(name, std::move(value), cached);
         return;
     }
 
-    throw RuntimeError(name, "Undefined variable '" + name.lexeme + "'.");
+    throw RuntimeError(name, "Undefined variable '" + std::string(name.lexeme) + "'.");
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Environment::assignAt
 // ─────────────────────────────────────────────────────────────────────────────
-//  Efficient value assignment at known distance (used with resolver).
+//  Efficient value assignment at known distance and slot (used with resolver).
 //  - @param distance : scope depth
-//  - @param name     : variable token
+//  - @param slot     : index into that environment's slot array
 //  - @param value    : value to set
 //
-//  Avoids recursive lookup.
+//  Avoids recursive lookup and name hashing.
+// ─────────────────────────────────────────────────────────────────────────────
+void Environment::assignAt(int distance, int slot, LiteralValue value)
+{
+    ancestors(distance)->slots[slot] = std::move(value);
+}
+// ─────────────────────────────────────────────────────────────────────────────
+//  Environment::trace / clearReferences
+// ─────────────────────────────────────────────────────────────────────────────
+//  The references the cycle collector follows: every variable, plus the
+//  enclosing scope.
 // ─────────────────────────────────────────────────────────────────────────────
-void Environment::assignAt(int distance, Token name, LiteralValue value)
+void Environment::trace(Tracer& trace) const
 {
-    ancestors(distance)->values[name.lexeme] = value;
-}
\ No newline at end of file
+    for (const Named& global : named) trace(global.value);
+    for (const LiteralValue& value : slots) trace(value);
+    trace(enclosing);
+}
+
+void Environment::clearReferences()
+{
+    named.clear();
+    index.clear();
+    slots.clear();
+    enclosing.reset();
+}
@@ -2,79 +2,274 @@
 // Entry point and core runtime for the Flint language interpreter.
 //
 // This file provides:
-//   • A command‑line entry point (`main`) to run a Flint script file.
+//   • The command line (`Flint::main`, called from main.cpp).
 //   • A REPL (`runPrompt`) for interactive line-by-line input.
-//   • Script file loading and in-memory buffering.
+//   • Script file loading (memory-mapped, see SourceText).
 //   • High-level integration between the scanner, parser, and interpreter.
-//   • Static error tracking and runtime diagnostics.
+//   • Per-context error tracking and runtime diagnostics.
 // ─────────────────────────────────────────────────────────────────────────────
 
+#include <algorithm>             // remove_if over statements
+#include <cstdio>                // setvbuf on stdout
+#include <iomanip>               // setw in the --stats table
 #include <iostream>              // Standard input/output
-#include <fstream>               // File stream handling
-#include <sstream>               // String stream utilities
 #include <stdexcept>            // Exception classes
 #include <vector>               // Token container
 
 #include "Flint/Scanner/Scanner.h"     // Lexer/tokenizer
+#include "Flint/Scanner/SourceText.h"  // Mapped or owned source text
 #include "Flint/Flint.h"         // Flint runtime system
 #include "Flint/Parser/Parser.h"       // AST parser
 #include "Flint/Interpreter/Evaluator.h"
 #include "Flint/Interpreter/Interpreter.h"
 #include "Flint/Resolver/Resolver.h"
+#include "Flint/Optimizer/Optimizer.h"
+#include "Flint/VM/Compiler.h"
+#include "Flint/VM/VM.h"
+#include "Flint/VM/BytecodeCache.h"
+#include "Flint/ThreadPool.h"
+#include "Flint/Tasks.h"
+#include "Flint/Embedding.h"
+#include "Flint/Interpreter/Profiler.h"
 
+#if __has_include(<unistd.h>)
+#include <unistd.h>              // isatty
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Current Context
+// ─────────────────────────────────────────────────────────────────────────────
+// The scanner, parser, resolver and both engines report errors through the
+// static Flint::error/runtimeError, which flag whichever context is running
+// on the calling thread.  This helps us exit with appropriate error codes
+// from `main()` or halt REPL processing when needed.
 // ─────────────────────────────────────────────────────────────────────────────
-// Global Interpreter State Flags
+thread_local Flint* Flint::current = nullptr;
+
+Flint::Flint() : Flint(std::make_shared<TaskProgram>()) {}
+
+Flint::Flint(std::shared_ptr<TaskProgram> program)
+    : program(std::move(program)), treeWalker(std::make_unique<Interpreter>()) {}
+
 // ─────────────────────────────────────────────────────────────────────────────
-// These track whether a syntax error or runtime error occurred during execution.
-// This helps us exit with appropriate error codes from `main()` or halt REPL
-// processing when needed.
+// Engines first, then a collection to free the cycles they leave behind
+// (closures and the environments holding them), while the ASTs those
+// functions point into are still alive.
 // ─────────────────────────────────────────────────────────────────────────────
-bool Flint::hadError = false;
-bool Flint::hadRuntimeError = false;
-const std::shared_ptr<Interpreter> Flint::interpreter = std::make_shared<Interpreter>();
+Flint::~Flint()
+{
+    vm.reset();
+    treeWalker.reset();
+    Heap::collect();
+}
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Entry Point: main()
+// Flint::main
 // ─────────────────────────────────────────────────────────────────────────────
-// Runs Flint in either batch mode (file passed via CLI) or interactive mode.
-// You can later add CLI flags for debugging, profiling, etc.
+// Consumes `--option` flags, then runs the first remaining argument as a
+// script, or starts the REPL if there is none.
 // ─────────────────────────────────────────────────────────────────────────────
-int main(int argc, char const *argv[])
+void Flint::main(const std::vector<std::string>& args)
 {
-    if (argc > 1)
+    Flint flint;
+    std::vector<std::string> files;
+    size_t gcThreshold = Heap::DEFAULT_THRESHOLD;
+    double gcGrowth = Heap::DEFAULT_GROWTH;
+    size_t maxDepth = Interpreter::DEFAULT_MAX_CALL_DEPTH;
+    size_t threads = 0;   // One per hardware thread
+    Interpreter::Budget budget;   // No limit
+    std::string profilePath;   // Empty: no profile
+
+    auto usage = [](const std::string& problem, const std::string& arg) {
+        std::cerr << problem << ": " << arg << "\n"
+                  << "Usage: flint [--engine=tree|vm|closure] [-O|-O0] [--no-cache] [--lazy] [--profile[=FILE]] [--stats]"
+                     " [--gc-threshold=N] [--gc-growth=F] [--max-depth=N] [--threads=N]"
+                     " [--max-steps=N] [--time-limit=MS] [script]\n";
+        exit(64);
+    };
+
+    for (const std::string& arg : args)
     {
-        std::cout << "running file.. " << argv[1] << std::endl;
-        Flint::runFile(argv[1]);
+        if (arg == "--engine=tree") flint.engine = Engine::TREE_WALK;
+        else if (arg == "--engine=vm") flint.engine = Engine::VM;
+        else if (arg == "--engine=closure") flint.engine = Engine::CLOSURE;
+        else if (arg == "-O") flint.optimize = true;
+        else if (arg == "-O0") flint.optimize = false;
+        else if (arg == "--no-cache") flint.cache = false;
+        else if (arg == "--lazy") flint.lazy = true;
+        else if (arg == "--stats") flint.stats = true;
+        else if (arg == "--profile") profilePath = "flint.folded";
+        else if (arg.rfind("--profile=", 0) == 0)
+        {
+            // Collapsed stacks for flamegraph.pl / speedscope
+            profilePath = arg.substr(arg.find('=') + 1);
+            if (profilePath.empty()) usage("Invalid value", arg);
+        }
+        else if (arg.rfind("--gc-threshold=", 0) == 0 || arg.rfind("--gc-growth=", 0) == 0)
+        {
+            // Live-object count of the first collection / growth factor after each
+            bool threshold = arg.rfind("--gc-threshold=", 0) == 0;
+            std::string value = arg.substr(arg.find('=') + 1);
+            size_t used = 0;
+            try {
+                if (threshold) gcThreshold = std::stoul(value, &used);
+                else gcGrowth = std::stod(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != value.size() || gcGrowth < 1.0)
+                usage("Invalid value", arg);
+        }
+        else if (arg.rfind("--max-depth=", 0) == 0)
+        {
+            // Deepest nesting of calls before "Stack overflow."
+            std::string value = arg.substr(arg.find('=') + 1);
+            size_t used = 0;
+            try {
+                maxDepth = std::stoul(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != value.size() || maxDepth == 0)
+                usage("Invalid value", arg);
+        }
+        else if (arg.rfind("--threads=", 0) == 0)
+        {
+            // Threads for parallel array kernels, this one included
+            std::string value = arg.substr(arg.find('=') + 1);
+            size_t used = 0;
+            try {
+                threads = std::stoul(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != value.size() || threads == 0)
+                usage("Invalid value", arg);
+        }
+        else if (arg.rfind("--max-steps=", 0) == 0 || arg.rfind("--time-limit=", 0) == 0)
+        {
+            // Execution budget of each run: loop iterations and calls / milliseconds
+            bool steps = arg.rfind("--max-steps=", 0) == 0;
+            std::string value = arg.substr(arg.find('=') + 1);
+            size_t used = 0;
+            unsigned long long limit = 0;
+            try {
+                limit = std::stoull(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != value.size() || limit == 0)
+                usage("Invalid value", arg);
+            if (steps) budget.steps = limit;
+            else budget.time = std::chrono::milliseconds(limit);
+        }
+        else if (arg.rfind("-", 0) == 0) usage("Unknown option", arg);
+        else files.push_back(arg);
+    }
+
+    // print() output to a pipe or a file is written in large blocks; to a
+    // terminal it stays line by line.  std::cerr and scan() flush it first.
+#if __has_include(<unistd.h>)
+    if (!isatty(STDOUT_FILENO)) std::setvbuf(stdout, nullptr, _IOFBF, 1 << 16);
+#endif
+
+    Heap::configure(gcThreshold, gcGrowth);
+    flint.interpreter().limitCallDepth(maxDepth);
+    flint.interpreter().setBudget(budget);
+    ThreadPool::configure(threads);
+    if (!profilePath.empty()) flint.profileTo(profilePath);
+
+    if (!files.empty())
+    {
+        std::cout << "running file.. " << files[0] << std::endl;
+        flint.runFile(files[0]);
     }
     else
     {
-        Flint::runPrompt();
+        flint.runPrompt();
+        flint.reportProfile();
+        if (flint.stats) reportStats(std::cerr);
     }
-    return 0;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Flint::runFile
 // ─────────────────────────────────────────────────────────────────────────────
-// Reads entire file contents into a string buffer before executing.
+// Maps the file (read as-is, in binary) and runs it; the tokens and AST
+// view the mapping instead of a copy.
 // Terminates with different exit codes for compile/runtime errors.
-// Uses binary mode for consistent cross-platform file reading.
 // ─────────────────────────────────────────────────────────────────────────────
 void Flint::runFile(const std::string& path)
 {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    std::shared_ptr<const SourceText> source = SourceText::fromFile(path);
+    if (!source) {
         std::cerr << "Error: Could not open source file: " << path << "\n";
         exit(74);
     }
-    std::stringstream buffer;
-    buffer << file.rdbuf(); // Read entire file into buffer
-    std::string source = buffer.str();
 
-    run(source);
+    if (cache && engine == Engine::VM)
+    {
+        std::string cachePath = BytecodeCache::pathFor(path);
+        execute(std::move(source), false, &cachePath);
+    }
+    else run(std::move(source));
 
-    if (hadError) exit(65);          // Syntax error
-    if (hadRuntimeError) exit(70);   // Runtime error
+    reportProfile();
+    if (stats) reportStats(std::cerr);
+    if (compileFailed) exit(65);     // Syntax error
+    if (runtimeFailed) exit(70);     // Runtime error
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Profiling
+// ─────────────────────────────────────────────────────────────────────────────
+void Flint::profileTo(std::string path)
+{
+    profiler = std::make_unique<Profiler>();
+    profilePath = std::move(path);
+    treeWalker->profiler = profiler.get();   // The VM reads it from its host
+}
+
+void Flint::reportProfile()
+{
+    if (!profiler) return;
+    profiler->report(std::cerr);
+    if (profiler->writeCollapsed(profilePath))
+        std::cerr << "Collapsed stacks written to " << profilePath << "\n";
+    else
+        std::cerr << "Error: Could not write profile: " << profilePath << "\n";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Allocation counts (`--stats`)
+// ─────────────────────────────────────────────────────────────────────────────
+void Flint::reportStats(std::ostream& out)
+{
+    auto row = [&out](const char* kind, const Heap::Counts& c) {
+        out << std::left << std::setw(16) << kind << std::right
+            << std::setw(12) << c.allocated << std::setw(10) << c.live
+            << std::setw(11) << c.peakLive << std::setw(12) << c.bytes
+            << std::setw(12) << c.peakBytes << "\n";
+    };
+
+    std::ios flags(nullptr);
+    flags.copyfmt(out);
+
+    out << "── allocations ──\n"
+        << std::left << std::setw(16) << "kind" << std::right
+        << std::setw(12) << "allocated" << std::setw(10) << "live"
+        << std::setw(11) << "peak live" << std::setw(12) << "bytes"
+        << std::setw(12) << "peak bytes" << "\n";
+    for (size_t kind = 0; kind < Heap::KINDS; ++kind) {
+        const Heap::Counts& counts = Heap::counts(static_cast<uint8_t>(kind));
+        if (counts.allocated) row(Heap::kindName(static_cast<uint8_t>(kind)), counts);
+    }
+    row("total", Heap::totals());
+
+    Heap::Stats heap = Heap::stats();
+    out << "collections: " << heap.collections << ", freed by the collector: "
+        << heap.collected << "\n";
+    out.copyfmt(flags);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -95,8 +290,7 @@ void Flint::runPrompt()
             break;
 
         run(line);
-        hadError = false;         // Reset between REPL runs
-        hadRuntimeError = false;
+        clearErrors();            // Reset between REPL runs
     }
 }
 
@@ -107,26 +301,158 @@ void Flint::runPrompt()
 //   1. Lexing (Scanner) → Token stream
 //   2. Parsing (Parser) → AST
 //   3. Resolving → Variable scope resolution
-//   4. Interpreting (Interpreter) → Execute program
+//   4. Optimizing → Constant folding and dead-branch removal (unless -O0)
+//   5. Interpreting (Interpreter) → Execute program, or with --engine=vm,
+//      compiling to bytecode (Compiler) and running it on the VM; with
+//      --engine=closure the Interpreter lowers it first (ClosureCompiler)
 //
 // Short-circuits if a compile-time error is detected at any step.
+// Errors reported meanwhile flag this context (see `current`).
+//
+// Given a cache path, steps 1–5 (up to the bytecode) are skipped when the
+// cache holds this source's script, and their result is saved otherwise.
 // ─────────────────────────────────────────────────────────────────────────────
-void Flint::run(const std::string& source) 
+void Flint::run(const std::string& source) { execute(SourceText::fromString(source), false); }
+
+void Flint::run(std::shared_ptr<const SourceText> source) { execute(std::move(source), false); }
+
+void Flint::declare(std::shared_ptr<const SourceText> source) { execute(std::move(source), true); }
+
+void Flint::execute(std::shared_ptr<const SourceText> source, bool declarationsOnly, const std::string* cachePath)
 {
-    auto scanner = std::make_unique<Scanner>(source);
-    auto tokens  = scanner->scanTokens();
-    
-    auto parser  = std::make_unique<Parser>(tokens);
+    Use use(this);
+
+    if (cachePath)
+    {
+        if (Ref<VMFunction> script = BytecodeCache::load(*cachePath, source->text(), optimize))
+        {
+            program->add(std::move(source), engine, optimize);
+            if (!vm) vm = std::make_unique<VM>(*treeWalker);
+            vm->interpret(script);
+            return;
+        }
+    }
+
+    // The parser pulls tokens from the scanner as it goes; both view the
+    // text, which the arena keeps alive for the tokens in the tree
+    auto arena   = std::make_unique<AstArena>();
+    arena->source = source;
+    auto scanner = std::make_unique<Scanner>(source->text());
+    auto parser  = std::make_unique<Parser>(*scanner, *arena);
+    parser->deferBodies = lazy && engine != Engine::VM && !declarationsOnly;
     auto statements = parser->parse();
 
-    if (hadError) return; // Stop if syntax error occurred
+    if (compileFailed) return; // Stop if syntax error occurred
 
-    auto resolver = std::make_unique<Resolver>(interpreter);
+    auto resolver = std::make_unique<Resolver>();
     resolver->resolve(statements); // Perform static scope resolution
 
-    if (hadError) return;
+    if (compileFailed) return;
+
+    if (declarationsOnly)
+    {
+        statements.erase(std::remove_if(statements.begin(), statements.end(), [](StmtPtr s) {
+            return !std::holds_alternative<FunctionStmt>(*s) && !std::holds_alternative<ClassStmt>(*s);
+        }), statements.end());
+    }
+    else program->add(source, engine, optimize);   // Before running: it may spawn tasks
+
+    if (optimize) Optimizer(*arena, *treeWalker).optimize(statements);
+
+    if (engine == Engine::VM)
+    {
+        Compiler compiler;
+        Ref<VMFunction> script = compiler.compile(statements);
+        if (compileFailed) return;
+        if (cachePath) BytecodeCache::store(*cachePath, source->text(), optimize, script);
+
+        if (!vm) vm = std::make_unique<VM>(*treeWalker);
+        vm->interpret(script);
+        return;           // Compiled code does not refer to the AST
+    }
+
+    // Functions created while interpreting point into the tree, and may
+    // outlive this call (REPL), so the arena stays alive for the session
+    programs.push_back(std::move(arena));
+    if (engine == Engine::CLOSURE) treeWalker->lowerToClosures();
+    treeWalker->interpret(statements); // Finally, run the program
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Flint::compileBody
+// ─────────────────────────────────────────────────────────────────────────────
+// Steps 1–4 of run() for one deferred body: the scanner starts again at its
+// '{', and the new nodes go into the unit's arena.  A body with errors stays
+// deferred, marked as failed, so later calls fail without reporting again.
+// ─────────────────────────────────────────────────────────────────────────────
+void Flint::compileBody(const FunctionStmt& function)
+{
+    DeferredBody* deferred = function.deferred;
+    if (!deferred->failed)
+    {
+        Use use(this);
+        bool failedBefore = compileFailed;
+        compileFailed = false;
+
+        Scanner scanner(deferred->arena->source->text(), deferred->offset, deferred->line);
+        Parser parser(scanner, *deferred->arena);
+        function.body = parser.parseBody();
+
+        // Not deferred any more: the Resolver resolves the body now
+        function.deferred = nullptr;
+        if (!compileFailed) Resolver().resolveDeferred(function, deferred->type, deferred->classType);
+        if (!compileFailed && deferred->optimize)
+            Optimizer(*deferred->arena, *treeWalker).optimize(function.body);
+
+        deferred->failed = compileFailed;
+        compileFailed = compileFailed || failedBefore;
+        if (!deferred->failed) return;
+        function.deferred = deferred;
+    }
+    throw RuntimeError(*function.name,
+        "Cannot call '" + std::string(function.name->lexeme) + "': its body has errors.");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Flint::global / Flint::call / Flint::define / Flint::function
+// ─────────────────────────────────────────────────────────────────────────────
+// Globals live in whichever engine ran the program: the VM keeps its own.
+// Values the VM created are called on the VM, everything else (including
+// the natives both engines share) through the tree-walker.
+// ─────────────────────────────────────────────────────────────────────────────
+LiteralValue Flint::global(Symbol name) const
+{
+    const LiteralValue* value = engine == Engine::VM
+        ? (vm ? vm->global(name) : nullptr)
+        : treeWalker->globalEnvironment()->lookup(name);
+    return value ? *value : LiteralValue();
+}
+
+LiteralValue Flint::call(const LiteralValue& callee, ValueSpan args, const Token& where)
+{
+    Use use(this);
+    if (vm && !callee.is<FlintCallable>()) return vm->callFunction(callee, args);
+    return treeWalker->invoke(callee, args, where);
+}
+
+void Flint::define(std::string_view name, LiteralValue value)
+{
+    Symbol symbol = SymbolTable::intern(name);
+    if (vm) vm->define(symbol, value);
+    treeWalker->globalEnvironment()->define(symbol, std::move(value));   // Copied by a VM created later
+}
+
+FunctionHandle Flint::function(std::string_view name)
+{
+    Symbol symbol = SymbolTable::intern(name);
+    LiteralValue callee = global(symbol);
+    if (!callee.isObject()) return {};
 
-    interpreter->interpret(statements); // Finally, run the program
+    ObjectType type = callee.asObject()->type;
+    bool callable = callee.is<FlintCallable>() || type == ObjectType::VM_CLOSURE ||
+                    type == ObjectType::VM_CLASS || type == ObjectType::VM_BOUND_METHOD;
+    if (!callable) return {};
+    return FunctionHandle(this, std::move(callee), Token(TokenType::IDENTIFIER, name, nullptr, 0));
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -143,24 +469,24 @@ void Flint::error(int line, const std::string& message)
 }
 
 // Emit error at a specific token (e.g., during parsing/resolution)
-void Flint::error(Token token, const std::string& message)
+void Flint::error(const Token& token, const std::string& message)
 {
     if (token.type == TokenType::END_OF_FILE)
         report(token.line, "at end of file", message);
     else
-        report(token.line, "at '" + token.lexeme + "'", message);
+        report(token.line, "at '" + std::string(token.lexeme) + "'", message);
 }
 
 // Log runtime error (thrown by Interpreter or built-in functions)
 void Flint::runtimeError(RuntimeError error)
 {
     std::cerr << "[line " << error.token.line << "] Runtime error: " << error.what() << std::endl;
-    hadRuntimeError = true;
+    if (current) current->runtimeFailed = true;
 }
 
 // Shared internal error reporting mechanism
 void Flint::report(int line, const std::string& where, const std::string& message)
 {
     std::cerr << "[line " << line << "] Error " << where << ": " << message << std::endl;
-    hadError = true;
+    if (current) current->compileFailed = true;
 }
\ No newline at end of file
@@ -1,39 +1,254 @@
+#include <algorithm>
+#include <cmath>
 #include "Flint/FlintArray.h"
+#include "Flint/FlintString.h"
+#include "Flint/Interpreter/Evaluator.h"
+#include "Flint/ThreadPool.h"
 #include "Flint/Exceptions/RuntimeError.h"
 
-FlintArray::FlintArray(std::vector<LiteralValue> elems) : elements(std::move(elems))
+FlintArray::FlintArray(std::vector<LiteralValue> elems) 
+    : FlintObject(ObjectType::ARRAY), elements(std::move(elems))
 {
-    builtInFunctions["push"] = std::make_shared<BuiltinFunction>([this](Interpreter&,
-                 const std::vector<LiteralValue>& args, const Token& token) {
+}
+
+// ─────────────────────────────────────────────────────────────
+// Helpers for the higher-order methods.  Callbacks run Flint
+// code, which may push to or pop from the very array being
+// walked: loops visit the elements present when they started
+// (minus any popped since) and copy each one out before the call.
+// ─────────────────────────────────────────────────────────────
+namespace {
+
+// An index argument: negative counts back from `size`; clamped to [0, size]
+size_t position(const LiteralValue& value, size_t size, const Token& token, const char* method)
+{
+    if (!value.isNumber())
+        throw RuntimeError(token, std::string(method) + "() expects numeric indices.");
+    double index = std::trunc(value.asNumber());
+    if (index < 0) index += static_cast<double>(size);
+    return static_cast<size_t>(std::clamp(index, 0.0, static_cast<double>(size)));
+}
+
+// Ordering without a comparator: numbers by value, strings by content
+bool naturalLess(const LiteralValue& a, const LiteralValue& b, const Token& token)
+{
+    if (a.isNumber() && b.isNumber()) return a.asNumber() < b.asNumber();
+    FlintString* x = a.as<FlintString>();
+    FlintString* y = b.as<FlintString>();
+    if (x && y) return x->value < y->value;
+    throw RuntimeError(token, "sort() without a comparator needs all numbers or all strings.");
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────
+// The builtin method table shared by every array.
+// ─────────────────────────────────────────────────────────────
+const std::unordered_map<Symbol, BuiltinMethod<FlintArray>>& FlintArray::builtInFunctions()
+{
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintArray>> table = {
+        { Symbols::PUSH, { 1, [](FlintArray& self, Interpreter&,
+                                 const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
                 if (args.size() != 1)
                     throw RuntimeError(token, "push() takes exactly one argument.");
-                (this)->elements.push_back(args[0]);
+                self.elements.push_back(args[0]);
                 return nullptr;
-            }, 1);
-    
-    builtInFunctions["pop"] = std::make_shared<BuiltinFunction>([this](Interpreter&, 
-                const std::vector<LiteralValue>& args, const Token& token) {
-                
-                if (!args.empty()) 
+            } } },
+
+        { Symbols::POP, { 0, [](FlintArray& self, Interpreter&,
+                                const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args.empty())
                     throw RuntimeError(token, "pop() takes no arguments.");
-                if (this->elements.empty())
+                if (self.elements.empty())
                     throw RuntimeError(token, "Cannot pop from empty array.");
-                auto val = this->elements.back();
-                this->elements.pop_back();
+                auto val = std::move(self.elements.back());
+                self.elements.pop_back();
                 return val;
-            }, 0);
+            } } },
 
-    builtInFunctions["length"] = std::make_shared<BuiltinFunction>([this](Interpreter&, 
-            const std::vector<LiteralValue>& args, const Token& token) {
-
-                if(!args.empty()) 
+        { Symbols::LENGTH, { 0, [](FlintArray& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if(!args.empty())
                     throw RuntimeError(token, "length() takes no arguments.");
-                return LiteralValue(static_cast<double>(this -> elements.size()));
-            }, 0);
+                return LiteralValue(static_cast<double>(self.elements.size()));
+            } } },
+
+        // reserve(n): make room for n elements without reallocating
+        { SymbolTable::intern("reserve"), { 1, [](FlintArray& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args[0].isNumber() || args[0].asNumber() < 0 || args[0].asNumber() > 1e9)
+                    throw RuntimeError(token, "reserve() expects a non-negative count.");
+                self.elements.reserve(static_cast<size_t>(args[0].asNumber()));
+                return nullptr;
+            } } },
+
+        // indexOf(value): first index holding a value equal to it (as ==), or -1
+        { SymbolTable::intern("indexOf"), { 1, [](FlintArray& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token&) -> LiteralValue {
+                for (size_t i = 0; i < self.elements.size(); ++i)
+                    if (Evaluator::isEqual(self.elements[i], args[0])) return static_cast<double>(i);
+                return -1.0;
+            } } },
+
+        // slice(start?, end?): a copy of [start, end); negative indices count from the end
+        { SymbolTable::intern("slice"), { -1, [](FlintArray& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.size() > 2)
+                    throw RuntimeError(token, "slice() takes at most two arguments.");
+                size_t size = self.elements.size();
+                size_t start = args.size() > 0 ? position(args[0], size, token, "slice") : 0;
+                size_t end = args.size() > 1 ? position(args[1], size, token, "slice") : size;
+                if (end < start) end = start;
+                return makeRef<FlintArray>(std::vector<LiteralValue>(
+                    self.elements.begin() + start, self.elements.begin() + end));
+            } } },
+
+        // forEach(fn): fn(element) for every element
+        { SymbolTable::intern("forEach"), { 1, [](FlintArray& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::vector<LiteralValue> argument(1);
+                for (size_t i = 0, n = self.elements.size(); i < std::min(n, self.elements.size()); ++i)
+                {
+                    argument[0] = self.elements[i];
+                    interpreter.callback(args[0], argument, token);
+                }
+                return nullptr;
+            } } },
+
+        // map(fn): a new array of fn(element)
+        { SymbolTable::intern("map"), { 1, [](FlintArray& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::vector<LiteralValue> results;
+                results.reserve(self.elements.size());
+                std::vector<LiteralValue> argument(1);
+                for (size_t i = 0, n = self.elements.size(); i < std::min(n, self.elements.size()); ++i)
+                {
+                    argument[0] = self.elements[i];
+                    results.push_back(interpreter.callback(args[0], argument, token));
+                }
+                return makeRef<FlintArray>(std::move(results));
+            } } },
+
+        // filter(fn): a new array of the elements for which fn(element) is truthy
+        { SymbolTable::intern("filter"), { 1, [](FlintArray& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::vector<LiteralValue> results;
+                results.reserve(self.elements.size());
+                std::vector<LiteralValue> argument(1);
+                for (size_t i = 0, n = self.elements.size(); i < std::min(n, self.elements.size()); ++i)
+                {
+                    argument[0] = self.elements[i];
+                    if (Evaluator::isTruthy(interpreter.callback(args[0], argument, token)))
+                        results.push_back(std::move(argument[0]));
+                }
+                results.shrink_to_fit();
+                return makeRef<FlintArray>(std::move(results));
+            } } },
+
+        // reduce(fn, initial?): fold left with fn(accumulator, element);
+        // without `initial` the first element starts the fold
+        { SymbolTable::intern("reduce"), { -1, [](FlintArray& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.empty() || args.size() > 2)
+                    throw RuntimeError(token, "reduce() takes a function and an optional initial value.");
+                size_t i = 0;
+                std::vector<LiteralValue> arguments(2);
+                if (args.size() == 2)
+                    arguments[0] = args[1];
+                else if (self.elements.empty())
+                    throw RuntimeError(token, "Cannot reduce an empty array without an initial value.");
+                else
+                    arguments[0] = self.elements[i++];
+
+                for (size_t n = self.elements.size(); i < std::min(n, self.elements.size()); ++i)
+                {
+                    arguments[1] = self.elements[i];
+                    LiteralValue accumulator = interpreter.callback(args[0], arguments, token);
+                    arguments[0] = std::move(accumulator);
+                }
+                return std::move(arguments[0]);
+            } } },
+
+        // sort(less?): sorts in place, stably.  less(a, b) returns true (or a
+        // negative number) when a goes before b; without it, numbers and
+        // strings sort ascending.  The sort works on a copy, so an error in
+        // the comparator leaves the array as it was.
+        { SymbolTable::intern("sort"), { -1, [](FlintArray& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.size() > 1)
+                    throw RuntimeError(token, "sort() takes at most one argument.");
+
+                std::vector<LiteralValue> sorted = self.elements;
+                if (args.empty())
+                {
+                    std::stable_sort(sorted.begin(), sorted.end(),
+                        [&](const LiteralValue& a, const LiteralValue& b) { return naturalLess(a, b, token); });
+                }
+                else
+                {
+                    std::vector<LiteralValue> pair(2);
+                    std::stable_sort(sorted.begin(), sorted.end(),
+                        [&](const LiteralValue& a, const LiteralValue& b) {
+                            pair[0] = a;
+                            pair[1] = b;
+                            LiteralValue order = interpreter.callback(args[0], pair, token);
+                            return order.isNumber() ? order.asNumber() < 0 : Evaluator::isTruthy(order);
+                        });
+                }
+                self.elements = std::move(sorted);
+                return nullptr;
+            } } },
+
+        // parallelSort(): like sort() without a comparator (not stable),
+        // on every thread of the pool.  Numbers are sorted as raw doubles and
+        // strings through their indices, so the sorting threads never touch
+        // a reference count.
+        { SymbolTable::intern("parallelSort"), { 0, [](FlintArray& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::vector<LiteralValue>& elements = self.elements;
+                bool numbers = std::all_of(elements.begin(), elements.end(),
+                                           [](const LiteralValue& e) { return e.isNumber(); });
+                if (numbers)
+                {
+                    std::vector<double> values(elements.size());
+                    for (size_t i = 0; i < values.size(); ++i) values[i] = elements[i].asNumber();
+                    ThreadPool::instance().sort(values.data(), values.size(), [](double a, double b) {
+                        return a < b || (a == a && b != b);   // NaNs last
+                    });
+                    for (size_t i = 0; i < values.size(); ++i) elements[i] = values[i];
+                    return nullptr;
+                }
+
+                if (!std::all_of(elements.begin(), elements.end(),
+                                 [](const LiteralValue& e) { return e.is<FlintString>(); }))
+                    throw RuntimeError(token, "parallelSort() needs all numbers or all strings.");
+
+                std::vector<size_t> order(elements.size());
+                for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+                ThreadPool::instance().sort(order.data(), order.size(), [&](size_t a, size_t b) {
+                    return elements[a].as<FlintString>()->value < elements[b].as<FlintString>()->value;
+                });
+
+                std::vector<LiteralValue> sorted;
+                sorted.reserve(elements.size());
+                for (size_t i : order) sorted.push_back(std::move(elements[i]));
+                elements = std::move(sorted);
+                return nullptr;
+            } } },
+    };
+    return table;
 }
 
-LiteralValue FlintArray::getInBuiltFunction(Token name)
+const BuiltinMethod<FlintArray>* FlintArray::findBuiltin(Symbol name)
 {
-    if (builtInFunctions.count(name.lexeme)) return builtInFunctions[name.lexeme];
-    throw RuntimeError(name, "array has no function named " + name.lexeme + ".");
-}
\ No newline at end of file
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintArray::getInBuiltFunction(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintArray>>(Ref<FlintArray>(this), *method, name.symbol);
+    throw RuntimeError(name, "array has no function named " + std::string(name.lexeme) + ".");
+}
@@ -9,65 +9,46 @@
 //
 // 1. Creates a new instance of the class.
 // 2. Looks for an "init" method (constructor), if present.
-// 3. If found, binds it to the instance and calls it with args.
+// 3. If found, calls it with the instance as 'this' (no bound copy).
 // 4. Returns the created instance as the result of the call.
 // ─────────────────────────────────────────────────────────────
 LiteralValue FlintClass::call(Interpreter &interpreter, 
         const std::vector<LiteralValue> &args, const Token &paren)
 {
-    // Create a shared_ptr to this class object (as a callable class)
-    auto instPtr = FlintInstance::shared_from_this();
-
-    // Cast the base instance to the derived FlintClass
-    auto sharedThis = std::static_pointer_cast<FlintClass>(instPtr);
-
     // Create the actual object (instance of the class)
-    std::shared_ptr<FlintInstance> instance = std::make_shared<FlintInstance>(sharedThis);
-
-    // Look for an "init" method (constructor)
-    std::shared_ptr<FlintFunction> initializer = findMethod("init");
+    LiteralValue instance(makeRef<FlintInstance>(Ref<FlintClass>(this)));
 
-    if (initializer != nullptr) 
+    // Run the "init" method (constructor), if there is one
+    if (initializer) 
     {
-        // Bind the init method to this instance and call it
-        std::get<std::shared_ptr<FlintCallable>>(initializer->bind(instance))->call(interpreter, args, paren);
+        initializer->callMethod(interpreter, instance, args, paren);
     }
 
     // Return the created instance as the result of the "call"
     return instance;
 }
 
-// ─────────────────────────────────────────────────────────────
-// Looks up a method by name in the class's instanceMethods map.
-// Used to retrieve methods like "init", or user-defined ones.
-// Returns nullptr if not found.
-// ─────────────────────────────────────────────────────────────
-std::shared_ptr<FlintFunction> FlintClass::findMethod(std::string name) const
+// Looks up a static method; these are not inherited.
+Ref<FlintFunction> FlintClass::findClassMethod(Symbol name) const
 {
-    if (instanceMethods.count(name)) {
-        return instanceMethods.at(name);
-    }
-
-    if (superClass)
-    {
-        return superClass -> findMethod(name);
-    }
-    return nullptr;
+    auto it = classMethods.find(name);
+    return it != classMethods.end() ? it->second : nullptr;
 }
 
 // ─────────────────────────────────────────────────────────────
 // Gets a static/class-level method or property.
 // Only allows access to class-level (not instance-level) members.
 //
+// The method is bound to the class, which is its 'this'.
 // Throws RuntimeError if the property is not found.
 // ─────────────────────────────────────────────────────────────
-LiteralValue FlintClass::get(Token name, Interpreter& interpreter)
+LiteralValue FlintClass::get(const Token& name, Interpreter& interpreter)
 {
-    if (classMethods.find(name.lexeme) != classMethods.end()) {
-        return classMethods[name.lexeme];
+    if (Ref<FlintFunction> method = findClassMethod(name.symbol)) {
+        return method->bind(LiteralValue(this));
     }
 
-    throw RuntimeError(name, "Undefined static property '" + name.lexeme + "'.");
+    throw RuntimeError(name, "Undefined static property '" + std::string(name.lexeme) + "'.");
 }
 
 // ─────────────────────────────────────────────────────────────
@@ -77,7 +58,23 @@ LiteralValue FlintClass::get(Token name, Interpreter& interpreter)
 // ─────────────────────────────────────────────────────────────
 int FlintClass::arity() const
 {
-    std::shared_ptr<FlintFunction> initializer = findMethod("init");
-    if (initializer) return initializer->arity();
-    return 0;
-}
\ No newline at end of file
+    return initializer ? initializer->arity() : 0;
+}
+// ─────────────────────────────────────────────────────────────
+// Cycle collector hooks.  Method closures hold the environment
+// the class was declared in, which usually holds the class.
+// ─────────────────────────────────────────────────────────────
+void FlintClass::trace(Tracer& trace) const
+{
+    for (const auto& [name, method] : instanceMethods) trace(method);
+    for (const auto& [name, method] : classMethods) trace(method);
+    trace(superClass);
+}
+
+void FlintClass::clearReferences()
+{
+    instanceMethods.clear();
+    classMethods.clear();
+    superClass = nullptr;
+    initializer = nullptr;
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "Flint/FlintFile.h"
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintString.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+FlintFile::FlintFile(std::FILE* file, std::string path, bool writing)
+    : FlintObject(ObjectType::FILE_HANDLE), file(file), path(std::move(path)), writing(writing)
+{
+    if (writing) std::setvbuf(file, nullptr, _IOFBF, BUFFER_SIZE);
+    else {
+        // Reads go through `buffer`, or straight into the caller's memory
+        std::setvbuf(file, nullptr, _IONBF, 0);
+        buffer.resize(BUFFER_SIZE);
+    }
+}
+
+FlintFile::~FlintFile()
+{
+    close();
+}
+
+LiteralValue FlintFile::open(const std::vector<LiteralValue>& args, const Token& paren)
+{
+    if (args.empty() || args.size() > 2 || !args[0].is<FlintString>()
+        || (args.size() == 2 && !args[1].is<FlintString>()))
+        throw RuntimeError(paren, "open() expects a path and optionally a mode (\"r\", \"w\" or \"a\").");
+
+    const std::string& path = args[0].as<FlintString>()->value;
+    std::string mode = args.size() == 2 ? args[1].as<FlintString>()->value : "r";
+    if (mode != "r" && mode != "w" && mode != "a")
+        throw RuntimeError(paren, "open() mode must be \"r\", \"w\" or \"a\".");
+
+    std::FILE* file = std::fopen(path.c_str(), (mode + "b").c_str());
+    if (!file)
+        throw RuntimeError(paren, "Could not open file '" + path + "': " + std::strerror(errno) + ".");
+    return makeRef<FlintFile>(file, path, mode != "r");
+}
+
+void FlintFile::close()
+{
+    if (!file) return;
+    std::fclose(file);
+    file = nullptr;
+    buffer = {};
+}
+
+void FlintFile::expect(bool forWriting, const Token& where) const
+{
+    if (!file) throw RuntimeError(where, "File '" + path + "' is closed.");
+    if (forWriting != writing)
+        throw RuntimeError(where, "File '" + path + "' is not open for " +
+                                  (forWriting ? "writing." : "reading."));
+}
+
+// ─────────────────────────────────────────────────────────────
+// Reading
+// ─────────────────────────────────────────────────────────────
+bool FlintFile::fill()
+{
+    begin = 0;
+    end = std::fread(buffer.data(), 1, buffer.size(), file);
+    return end != 0;
+}
+
+bool FlintFile::readLine(std::string& line, const Token& where)
+{
+    expect(false, where);
+    line.clear();
+    bool any = false;
+    while (begin < end || fill())
+    {
+        any = true;
+        const char* start = buffer.data() + begin;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', end - begin));
+        if (!newline) {
+            line.append(start, end - begin);
+            begin = end;
+            continue;
+        }
+        line.append(start, newline - start);
+        begin += newline - start + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        return true;
+    }
+    return any;
+}
+
+size_t FlintFile::read(char* into, size_t size, const Token& where)
+{
+    expect(false, where);
+    size_t done = std::min(size, end - begin);
+    std::memcpy(into, buffer.data() + begin, done);
+    begin += done;
+
+    // Large requests skip the buffer; small ones refill it
+    if (size - done >= buffer.size())
+        done += std::fread(into + done, 1, size - done, file);
+    while (done < size && fill()) {
+        size_t part = std::min(size - done, end);
+        std::memcpy(into + done, buffer.data(), part);
+        begin = part;
+        done += part;
+    }
+    return done;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Writing
+// ─────────────────────────────────────────────────────────────
+void FlintFile::write(std::string_view text, const Token& where)
+{
+    expect(true, where);
+    if (std::fwrite(text.data(), 1, text.size(), file) != text.size())
+        throw RuntimeError(where, "Could not write to file '" + path + "': " + std::strerror(errno) + ".");
+}
+
+// ─────────────────────────────────────────────────────────────
+// The builtin method table shared by every handle.
+// ─────────────────────────────────────────────────────────────
+const std::unordered_map<Symbol, BuiltinMethod<FlintFile>>& FlintFile::builtInFunctions()
+{
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintFile>> table = {
+        // readLine(): the next line as a string, or nil at the end of the file
+        { SymbolTable::intern("readLine"), { 0, [](FlintFile& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::string line;
+                if (!self.readLine(line, token)) return nullptr;
+                return makeRef<FlintString>(std::move(line));
+            } } },
+
+        // forEachLine(fn): fn(line) for every line left; returns how many there were
+        { SymbolTable::intern("forEachLine"), { 1, [](FlintFile& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                Ref<FlintFile> keep(&self);   // The callback may drop the last other reference
+                std::vector<LiteralValue> argument(1);
+                std::string line;
+                double count = 0;
+                while (self.readLine(line, token)) {
+                    argument[0] = makeRef<FlintString>(line);
+                    interpreter.callback(args[0], argument, token);
+                    ++count;
+                }
+                return count;
+            } } },
+
+        // read(n): up to n bytes as a string, or nil at the end of the file
+        { SymbolTable::intern("read"), { 1, [](FlintFile& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args[0].isNumber() || args[0].asNumber() < 1)
+                    throw RuntimeError(token, "read() expects a positive number of bytes.");
+                std::string chunk(static_cast<size_t>(args[0].asNumber()), '\0');
+                chunk.resize(self.read(chunk.data(), chunk.size(), token));
+                if (chunk.empty()) return nullptr;
+                return makeRef<FlintString>(std::move(chunk));
+            } } },
+
+        // readInto(array): fills a Float64Array from the start with the raw
+        // doubles (in this machine's byte order) that follow in the file, as
+        // many as fit; returns how many it read.  A partial number at the
+        // end of the file is left unread.
+        { SymbolTable::intern("readInto"), { 1, [](FlintFile& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                FlintFloat64Array* target = args[0].as<FlintFloat64Array>();
+                if (!target) throw RuntimeError(token, "readInto() expects a Float64Array.");
+                self.expect(false, token);
+                if (target->elements.empty()) return 0.0;
+                char* into = reinterpret_cast<char*>(target->elements.data());
+                size_t bytes = self.read(into, target->elements.size() * sizeof(double), token);
+
+                // A partial number means the end of the file, where the
+                // buffer has been consumed: move its bytes back there, and
+                // zero the element they were read into
+                if (size_t partial = bytes % sizeof(double)) {
+                    std::memcpy(self.buffer.data(), into + bytes - partial, partial);
+                    self.begin = 0;
+                    self.end = partial;
+                    target->elements[bytes / sizeof(double)] = 0.0;
+                }
+                return static_cast<double>(bytes / sizeof(double));
+            } } },
+
+        // write(values...): each value's text, as print() shows it
+        { SymbolTable::intern("write"), { -1, [](FlintFile& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::string text;
+                for (const LiteralValue& arg : args) Interpreter::appendTo(text, arg);
+                self.write(text, token);
+                return nullptr;
+            } } },
+
+        { SymbolTable::intern("flush"), { 0, [](FlintFile& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                self.expect(true, token);
+                std::fflush(self.file);
+                return nullptr;
+            } } },
+
+        // close(): may be called more than once
+        { SymbolTable::intern("close"), { 0, [](FlintFile& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                self.close();
+                return nullptr;
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintFile>* FlintFile::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintFile::getInBuiltFunction(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintFile>>(Ref<FlintFile>(this), *method, name.symbol);
+    throw RuntimeError(name, "file has no function named " + std::string(name.lexeme) + ".");
+}
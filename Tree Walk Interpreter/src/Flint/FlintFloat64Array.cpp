@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <cmath>
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintArray.h"
+#include "Flint/Simd.h"
+#include "Flint/ThreadPool.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+FlintFloat64Array::FlintFloat64Array(std::vector<double> elements)
+    : FlintObject(ObjectType::FLOAT64_ARRAY), elements(std::move(elements))
+{
+}
+
+std::string FlintFloat64Array::toString() const
+{
+    std::string out = "[";
+    for (size_t i = 0; i < elements.size(); ++i) {
+        Interpreter::appendTo(out, LiteralValue(elements[i]));
+        if (i + 1 < elements.size()) out += ", ";
+    }
+    out += "]";
+    return out;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Kernels.  Each runs two vectors' worth of elements per step
+// (two independent accumulators hide the add latency), then
+// finishes the remainder one element at a time.  Reductions
+// therefore add in a different order than a left-to-right loop
+// and may differ from it in the last bits.
+// ─────────────────────────────────────────────────────────────
+namespace {
+
+template <typename Combine>
+double reduce(const double* p, size_t n, double identity, Combine combine)
+{
+    size_t i = 0;
+    double result = identity;
+#if FLINT_SIMD
+    if (n >= 2 * simd::WIDTH)
+    {
+        simd::Vector a = simd::splat(identity), b = a;
+        for (; i + 2 * simd::WIDTH <= n; i += 2 * simd::WIDTH) {
+            a = combine(a, simd::load(p + i));
+            b = combine(b, simd::load(p + i + simd::WIDTH));
+        }
+        result = simd::reduce(combine(a, b), combine);
+    }
+#endif
+    for (; i < n; ++i) result = combine(result, p[i]);
+    return result;
+}
+
+double dot(const double* x, const double* y, size_t n)
+{
+    size_t i = 0;
+    double result = 0.0;
+#if FLINT_SIMD
+    if (n >= 2 * simd::WIDTH)
+    {
+        simd::Vector a = simd::splat(0.0), b = a;
+        for (; i + 2 * simd::WIDTH <= n; i += 2 * simd::WIDTH) {
+            a = simd::add(a, simd::mul(simd::load(x + i), simd::load(y + i)));
+            b = simd::add(b, simd::mul(simd::load(x + i + simd::WIDTH), simd::load(y + i + simd::WIDTH)));
+        }
+        result = simd::reduce(simd::add(a, b), [](auto l, auto r) { return l + r; });
+    }
+#endif
+    for (; i < n; ++i) result += x[i] * y[i];
+    return result;
+}
+
+// p[i] = combine(p[i], q[i]) for every i
+template <typename Combine>
+void combineInPlace(double* p, const double* q, size_t n, Combine combine)
+{
+    size_t i = 0;
+#if FLINT_SIMD
+    for (; i + simd::WIDTH <= n; i += simd::WIDTH)
+        simd::store(p + i, combine(simd::load(p + i), simd::load(q + i)));
+#endif
+    for (; i < n; ++i) p[i] = combine(p[i], q[i]);
+}
+
+// p[i] = combine(p[i], k) for every i
+template <typename Combine>
+void combineInPlace(double* p, double k, size_t n, Combine combine)
+{
+    size_t i = 0;
+#if FLINT_SIMD
+    simd::Vector kv = simd::splat(k);
+    for (; i + simd::WIDTH <= n; i += simd::WIDTH)
+        simd::store(p + i, combine(simd::load(p + i), kv));
+#endif
+    for (; i < n; ++i) p[i] = combine(p[i], k);
+}
+
+// Overloads so one lambda serves both the vector and the scalar loop
+#if FLINT_SIMD
+inline simd::Vector plus(simd::Vector a, simd::Vector b)  { return simd::add(a, b); }
+inline simd::Vector times(simd::Vector a, simd::Vector b) { return simd::mul(a, b); }
+inline simd::Vector lesser(simd::Vector a, simd::Vector b)  { return simd::min(a, b); }
+inline simd::Vector greater(simd::Vector a, simd::Vector b) { return simd::max(a, b); }
+#endif
+inline double plus(double a, double b)    { return a + b; }
+inline double times(double a, double b)   { return a * b; }
+inline double lesser(double a, double b)  { return b < a ? b : a; }
+inline double greater(double a, double b) { return b > a ? b : a; }
+
+// ─────────────────────────────────────────────────────────────
+// Large arrays are split into GRAIN-element chunks run on the
+// ThreadPool.  A reduction combines per-chunk results in chunk
+// order, so its value depends on the length only, never on the
+// number of threads.
+// ─────────────────────────────────────────────────────────────
+constexpr size_t GRAIN = 1 << 15;   // 256 KB of doubles per chunk
+
+template <typename Combine>
+double reduceAll(const double* p, size_t n, double identity, Combine combine)
+{
+    if (n < 2 * GRAIN) return reduce(p, n, identity, combine);
+
+    size_t chunks = (n + GRAIN - 1) / GRAIN;
+    std::vector<double> partial(chunks);
+    ThreadPool::instance().parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+            partial[c] = reduce(p + c * GRAIN, std::min(GRAIN, n - c * GRAIN), identity, combine);
+    });
+    return reduce(partial.data(), chunks, identity, combine);
+}
+
+double dotAll(const double* x, const double* y, size_t n)
+{
+    if (n < 2 * GRAIN) return dot(x, y, n);
+
+    size_t chunks = (n + GRAIN - 1) / GRAIN;
+    std::vector<double> partial(chunks);
+    ThreadPool::instance().parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+            partial[c] = dot(x + c * GRAIN, y + c * GRAIN, std::min(GRAIN, n - c * GRAIN));
+    });
+    return reduce(partial.data(), chunks, 0.0, [](auto a, auto b) { return plus(a, b); });
+}
+
+// kernel(begin, end) over [0, n), in parallel chunks for large n
+template <typename Kernel>
+void forAll(size_t n, Kernel kernel)
+{
+    if (n < 2 * GRAIN) kernel(size_t(0), n);
+    else ThreadPool::instance().parallelFor(n, GRAIN, kernel);
+}
+
+// Ascending, with NaNs last (plain < is not a strict weak order with NaN)
+bool ascending(double a, double b) { return a < b || (a == a && b != b); }
+
+double number(const LiteralValue& value, const Token& token, const char* message)
+{
+    if (!value.isNumber()) throw RuntimeError(token, message);
+    return value.asNumber();
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────
+// The builtin method table shared by every Float64Array.
+// ─────────────────────────────────────────────────────────────
+const std::unordered_map<Symbol, BuiltinMethod<FlintFloat64Array>>& FlintFloat64Array::builtInFunctions()
+{
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintFloat64Array>> table = {
+        { Symbols::LENGTH, { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args.empty())
+                    throw RuntimeError(token, "length() takes no arguments.");
+                return static_cast<double>(self.elements.size());
+            } } },
+
+        { SymbolTable::intern("sum"), { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args.empty())
+                    throw RuntimeError(token, "sum() takes no arguments.");
+                return reduceAll(self.elements.data(), self.elements.size(), 0.0,
+                              [](auto a, auto b) { return plus(a, b); });
+            } } },
+
+        { SymbolTable::intern("min"), { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args.empty())
+                    throw RuntimeError(token, "min() takes no arguments.");
+                if (self.elements.empty())
+                    throw RuntimeError(token, "Cannot take the min of an empty Float64Array.");
+                return reduceAll(self.elements.data(), self.elements.size(), self.elements[0],
+                              [](auto a, auto b) { return lesser(a, b); });
+            } } },
+
+        { SymbolTable::intern("max"), { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args.empty())
+                    throw RuntimeError(token, "max() takes no arguments.");
+                if (self.elements.empty())
+                    throw RuntimeError(token, "Cannot take the max of an empty Float64Array.");
+                return reduceAll(self.elements.data(), self.elements.size(), self.elements[0],
+                              [](auto a, auto b) { return greater(a, b); });
+            } } },
+
+        { SymbolTable::intern("dot"), { 1, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.size() != 1)
+                    throw RuntimeError(token, "dot() takes exactly one argument.");
+                FlintFloat64Array* other = args[0].as<FlintFloat64Array>();
+                if (!other)
+                    throw RuntimeError(token, "dot() expects a Float64Array.");
+                if (other->elements.size() != self.elements.size())
+                    throw RuntimeError(token, "dot() expects a Float64Array of the same length.");
+                return dotAll(self.elements.data(), other->elements.data(), self.elements.size());
+            } } },
+
+        { SymbolTable::intern("scale"), { 1, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.size() != 1)
+                    throw RuntimeError(token, "scale() takes exactly one argument.");
+                double k = number(args[0], token, "scale() expects a number.");
+                double* p = self.elements.data();
+                forAll(self.elements.size(), [&](size_t begin, size_t end) {
+                    combineInPlace(p + begin, k, end - begin, [](auto a, auto b) { return times(a, b); });
+                });
+                return nullptr;
+            } } },
+
+        { SymbolTable::intern("add"), { 1, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.size() != 1)
+                    throw RuntimeError(token, "add() takes exactly one argument.");
+                auto sum = [](auto a, auto b) { return plus(a, b); };
+                double* p = self.elements.data();
+                if (FlintFloat64Array* other = args[0].as<FlintFloat64Array>()) {
+                    if (other->elements.size() != self.elements.size())
+                        throw RuntimeError(token, "add() expects a Float64Array of the same length.");
+                    const double* q = other->elements.data();
+                    forAll(self.elements.size(), [&](size_t begin, size_t end) {
+                        combineInPlace(p + begin, q + begin, end - begin, sum);
+                    });
+                } else {
+                    double k = number(args[0], token, "add() expects a number or a Float64Array.");
+                    forAll(self.elements.size(), [&](size_t begin, size_t end) {
+                        combineInPlace(p + begin, k, end - begin, sum);
+                    });
+                }
+                return nullptr;
+            } } },
+
+        { SymbolTable::intern("fill"), { 1, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.size() != 1)
+                    throw RuntimeError(token, "fill() takes exactly one argument.");
+                double value = number(args[0], token, "fill() expects a number.");
+                double* p = self.elements.data();
+                forAll(self.elements.size(), [&](size_t begin, size_t end) {
+                    std::fill(p + begin, p + end, value);
+                });
+                return nullptr;
+            } } },
+
+        // sort(): ascending in place, NaNs last
+        { SymbolTable::intern("sort"), { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::sort(self.elements.begin(), self.elements.end(), ascending);
+                return nullptr;
+            } } },
+
+        // parallelSort(): the same, on every thread of the pool
+        { SymbolTable::intern("parallelSort"), { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                ThreadPool::instance().sort(self.elements.data(), self.elements.size(), ascending);
+                return nullptr;
+            } } },
+
+        { SymbolTable::intern("toArray"), { 0, [](FlintFloat64Array& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (!args.empty())
+                    throw RuntimeError(token, "toArray() takes no arguments.");
+                std::vector<LiteralValue> elements(self.elements.begin(), self.elements.end());
+                return makeRef<FlintArray>(std::move(elements));
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintFloat64Array>* FlintFloat64Array::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintFloat64Array::getInBuiltFunction(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintFloat64Array>>(Ref<FlintFloat64Array>(this), *method, name.symbol);
+    throw RuntimeError(name, "Float64Array has no function named " + std::string(name.lexeme) + ".");
+}
+
+LiteralValue FlintFloat64Array::construct(const LiteralValue& from, const Token& paren)
+{
+    if (from.isNumber())
+    {
+        double length = from.asNumber();
+        if (length < 0 || length != std::floor(length))
+            throw RuntimeError(paren, "Float64Array() length must be a non-negative integer.");
+        return makeRef<FlintFloat64Array>(std::vector<double>(static_cast<size_t>(length), 0.0));
+    }
+
+    if (FlintFloat64Array* other = from.as<FlintFloat64Array>())
+        return makeRef<FlintFloat64Array>(other->elements);
+
+    if (FlintArray* array = from.as<FlintArray>())
+    {
+        std::vector<double> elements;
+        elements.reserve(array->elements.size());
+        for (const LiteralValue& element : array->elements)
+            elements.push_back(number(element, paren, "Float64Array() elements must be numbers."));
+        return makeRef<FlintFloat64Array>(std::move(elements));
+    }
+
+    throw RuntimeError(paren, "Float64Array() expects a length, an array or a Float64Array.");
+}
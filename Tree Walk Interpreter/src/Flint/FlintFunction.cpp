@@ -1,43 +1,92 @@
 #include "Flint/Callables/Functions/FlintFunction.h"
+#include "Flint/Flint.h"
 
 // Executes the function body and returns the result
 LiteralValue FlintFunction::call(Interpreter &interpreter, 
         const std::vector<LiteralValue> &args, const Token &paren)
 {
-    // Create a new environment enclosing the closure (the environment where the function was defined)
-    std::shared_ptr<Environment> environment = std::make_shared<Environment>(closure);
-    
-    // Define parameters in the new environment with corresponding argument values
-    for (size_t i = 0; i < declaration->params.size(); ++i) {
-        environment->define(declaration->params.at(i).lexeme, args.at(i));
-    }
+    return callMethod(interpreter, receiver, args, paren);
+}
 
-    // Prepare interpreter flags for this call (clear any previous state)
-    interpreter.returning = false;
-    interpreter.returnValue = nullptr;
-    interpreter.breaking = false;
-    interpreter.continuing = false;
+LiteralValue FlintFunction::callMethod(Interpreter &interpreter, const LiteralValue &self,
+        const std::vector<LiteralValue> &args, const Token &paren)
+{
+    return invoke(interpreter, self, [&](size_t i) { return args.at(i); }, paren);
+}
 
+LiteralValue FlintFunction::execute(Interpreter &interpreter,
+        const std::shared_ptr<Environment> &environment, const LiteralValue &self)
+{
     // Execute the function body in the new environment
-    interpreter.executeBlock(declaration->body, environment);
+    Completion completion = interpreter.executeBody(*declaration, environment);
 
-    // If a return was signaled, capture it and clear the flag
-    if (interpreter.returning) {
-        LiteralValue rv = interpreter.returnValue;
-        interpreter.returning = false;
+    if (completion == Completion::RETURN && interpreter.tailCall.callee.isObject())
+        return runTailCalls(interpreter);
+    return result(interpreter, completion, self);
+}
+
+void FlintFunction::compileBody() const
+{
+    declaration->deferred->context->compileBody(*declaration);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Each tail call gets a frame of its own, released before the next one runs;
+// the caller's frame (still held by invoke) is the only one that stays.
+// ─────────────────────────────────────────────────────────────────────────────
+LiteralValue FlintFunction::runTailCalls(Interpreter &interpreter)
+{
+    Interpreter::TailCall call;
+    while (true)
+    {
+        call.callee = std::move(interpreter.tailCall.callee);
+        call.receiver = std::move(interpreter.tailCall.receiver);
+        call.arguments.swap(interpreter.tailCall.arguments);
+        interpreter.tailCall.callee = nullptr;
+        interpreter.tailCall.receiver = nullptr;
+
+        FlintFunction& function = *call.callee.as<FlintFunction>();
+        const FunctionStmt& declaration = *function.declaration;
+        interpreter.step(declaration.line);   // A call, like any other
+        if (declaration.deferred) function.compileBody();
+        if (interpreter.profiler)
+            interpreter.profiler->replace(&declaration, [&] { return function.profileName(); });
+
+        Interpreter::Frame frame(interpreter, function.closure,
+                                 declaration.slotCount, declaration.isCaptured);
+        Environment& environment = *frame.environment();
+
+        int slot = 0;
+        if (declaration.hasReceiver) environment.defineAt(slot++, call.receiver);
+        for (LiteralValue& argument : call.arguments)
+            environment.defineAt(slot++, std::move(argument));
+        call.arguments.clear();
+
+        Completion completion = interpreter.executeBody(declaration, frame.environment());
+        if (completion != Completion::RETURN || !interpreter.tailCall.callee.isObject())
+            return function.result(interpreter, completion, call.receiver);
+    }
+}
+
+LiteralValue FlintFunction::result(Interpreter &interpreter, Completion completion,
+        const LiteralValue &self) const
+{
+    // If a return was signaled, take its value out of the register
+    if (completion == Completion::RETURN) {
+        LiteralValue rv = std::move(interpreter.returnValue);
         interpreter.returnValue = nullptr;
 
-        if (isInitializer) {
+        if (declaration->isInitializer) {
             // Initializers always return 'this'
-            return closure->getAt(0, Token{TokenType::IDENTIFIER, "this", nullptr, 0});
+            return self;
         }
 
         return rv;
     }
 
     // If no return was encountered and it's an initializer, return 'this'
-    if (isInitializer) {
-        return closure->getAt(0, Token{TokenType::IDENTIFIER, "this", nullptr, 0});
+    if (declaration->isInitializer) {
+        return self;
     }
 
     // Otherwise return null (i.e., no explicit return value)
@@ -45,26 +94,27 @@ LiteralValue FlintFunction::call(Interpreter &interpreter,
 }
 
 // Returns the number of parameters the function expects
-int FlintFunction::arity() const { return static_cast<int>(declaration->params.size()); }
+int FlintFunction::arity() const { return declaration->arity; }
 
 // String representation of the function (used for debugging or printing)
 std::string FlintFunction::toString() const
 {
     if (declaration->name.has_value())
-        return "<fn " + declaration->name->lexeme + ">";
+        return "<fn " + std::string(declaration->name->lexeme) + ">";
     else
         return "<lambda>";  // anonymous function
 }
 
-// Binds the function to an instance by injecting 'this' into the environment
+std::string FlintFunction::profileName() const
+{
+    std::string name = declaration->name ? std::string(declaration->name->lexeme) : "<lambda>";
+    return name + ":" + std::to_string(declaration->line);
+}
+
+// Binds the function to an instance: a copy that remembers its receiver
 LiteralValue FlintFunction::bind(LiteralValue instance)
 {
-    // Create new environment enclosing the original closure
-    std::shared_ptr<Environment> environment = std::make_shared<Environment>(closure);
-    
-    // Define 'this' in the new environment to point to the instance
-    environment->define("this", instance);
-
-    // Return a new FlintFunction with the bound environment
-    return std::make_shared<FlintFunction>(declaration, environment, isInitializer);
+    Ref<FlintFunction> bound = makeRef<FlintFunction>(declaration, closure);
+    bound->receiver = std::move(instance);
+    return bound;
 }
@@ -3,57 +3,128 @@
 #include "Flint/Exceptions/RuntimeError.h"
 #include "Flint/Callables/Functions/FlintFunction.h"
 
+// Out of line so Ref<FlintClass> is destroyed where FlintClass is complete
+FlintInstance::FlintInstance(Ref<FlintClass> klass)
+    : FlintObject(ObjectType::INSTANCE), klass(std::move(klass)),
+      shape(this->klass->rootShape()) {}
+
+FlintInstance::~FlintInstance() = default;
+
 // Convert the instance to string representation (e.g., "MyClass instance")
 std::string FlintInstance::toString() const {
     return klass->toString() + " instance";
 }
 
 // Access a field or method from the instance
-LiteralValue FlintInstance::get(Token name, Interpreter& interpreter)
+LiteralValue FlintInstance::get(const Token& name, Interpreter& interpreter, PropertyCache& cache)
 {
+    // Fast path: this site has already seen an instance of this shape
+    if (const PropertyCache::Entry* hit = cache.lookup(shape->id))
+    {
+        if (hit->slot >= 0) return slots[hit->slot];
+        return bindMethod(hit->method, name, interpreter);
+    }
+
     // Check if the requested property is a field of the instance
-    if (fields.count(name.lexeme)) 
-        return fields[name.lexeme];
+    int slot = shape->find(name.symbol);
+    if (slot >= 0)
+    {
+        cache.add({ shape->id, slot, nullptr, nullptr });
+        return slots[slot];
+    }
 
     // Otherwise, check if it's a method in the class
-    LiteralValue method = klass->findMethod(name.lexeme);
+    FlintFunction* method = klass->findMethod(name.symbol);
 
-    // Ensure the method is a callable type
-    if (std::holds_alternative<std::shared_ptr<FlintCallable>>(method)) 
+    // If neither field nor method is found, throw a runtime error
+    if (!method)
+        throw RuntimeError(name, "Undefined property '" + std::string(name.lexeme) + "'.");
+
+    // Methods never change after the class is created, so the shape
+    // (which implies the class) is enough to cache the lookup
+    cache.add({ shape->id, -1, nullptr, method });
+    return bindMethod(method, name, interpreter);
+}
+
+FlintFunction* FlintInstance::findMethod(const Token& name, PropertyCache& cache)
+{
+    FlintFunction* method;
+    if (const PropertyCache::Entry* hit = cache.lookup(shape->id))
     {
-        auto callable = std::get<std::shared_ptr<FlintCallable>>(method);
-        if (callable) 
+        method = hit->method;  // Null for a field
+    }
+    else
+    {
+        int slot = shape->find(name.symbol);
+        if (slot >= 0)
         {
-            // Try to cast the callable to a FlintFunction
-            auto fn = std::dynamic_pointer_cast<FlintFunction>(callable);
-            if (fn) 
-            {
-                // Bind the method to the current instance
-                auto bound = fn->bind(shared_from_this());
-
-                // If it's a getter (zero-arg method called like a field)
-                if (fn->declaration->isGetter) 
-                {
-                    // `bound` is a LiteralValue; extract the callable and invoke it immediately
-                    auto boundFn = std::get<std::shared_ptr<FlintCallable>>(bound);
-                    return boundFn->call(interpreter, {}, name);
-                }
-
-                // Return the bound method for normal access (without calling it yet)
-                return bound;
-            }
-
-            // If it's some other type of callable, return as-is
-            return callable;
+            cache.add({ shape->id, slot, nullptr, nullptr });
+            return nullptr;
         }
+
+        method = klass->findMethod(name.symbol);
+        if (!method) return nullptr;
+        cache.add({ shape->id, -1, nullptr, method });
     }
 
-    // If neither field nor method is found, throw a runtime error
-    throw RuntimeError(name, "Undefined property '" + name.lexeme + "'.");
+    return method && !method->declaration->isGetter ? method : nullptr;
+}
+
+LiteralValue FlintInstance::bindMethod(FlintFunction* method, const Token& name, Interpreter& interpreter)
+{
+    // Bind the method to the current instance
+    LiteralValue bound = method->bind(LiteralValue(this));
+
+    // If it's a getter (zero-arg method called like a field)
+    if (method->declaration->isGetter) 
+    {
+        // `bound` is a LiteralValue; extract the callable and invoke it immediately
+        return bound.as<FlintCallable>()->call(interpreter, {}, name);
+    }
+
+    // Return the bound method for normal access (without calling it yet)
+    return bound;
 }
 
 // Set or define a field on the instance
-void FlintInstance::set(Token name, LiteralValue object)
+void FlintInstance::set(const Token& name, LiteralValue object, PropertyCache& cache)
 {
-    fields[name.lexeme] = object;
-}
\ No newline at end of file
+    if (const PropertyCache::Entry* hit = cache.lookup(shape->id))
+    {
+        if (hit->next)
+        {
+            // Cached transition: the new field goes in the next slot
+            shape = hit->next;
+            slots.push_back(std::move(object));
+        }
+        else
+        {
+            slots[hit->slot] = std::move(object);
+        }
+        return;
+    }
+
+    int slot = shape->find(name.symbol);
+    if (slot >= 0)
+    {
+        cache.add({ shape->id, slot, nullptr, nullptr });
+        slots[slot] = std::move(object);
+        return;
+    }
+
+    // New field: move to the child shape that has it
+    Shape* next = shape->withField(name.symbol);
+    cache.add({ shape->id, shape->slotCount(), next, nullptr });
+    shape = next;
+    slots.push_back(std::move(object));
+}
+
+// Cycle collector hooks: the class, and every field value
+void FlintInstance::trace(Tracer& trace) const
+{
+    trace(klass);
+    for (const LiteralValue& value : slots) trace(value);
+}
+
+// The fields go; the class stays, since a cycle through it is broken at its methods
+void FlintInstance::clearReferences() { slots.clear(); }
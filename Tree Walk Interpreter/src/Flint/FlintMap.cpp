@@ -0,0 +1,266 @@
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include "Flint/FlintMap.h"
+#include "Flint/FlintArray.h"
+#include "Flint/FlintString.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+// ─────────────────────────────────────────────────────────────
+// Keys: hashed and compared by value for numbers and strings,
+// by identity for everything else.
+// ─────────────────────────────────────────────────────────────
+namespace {
+
+// splitmix64's finalizer: every input bit reaches the low bits
+// the table is indexed by
+size_t mix(uint64_t x)
+{
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<size_t>(x);
+}
+
+size_t hashOf(const LiteralValue& key)
+{
+    if (key.isNumber()) {
+        double number = key.asNumber();
+        if (number == 0) number = 0;              // -0 is the same key as 0
+        uint64_t bits;
+        std::memcpy(&bits, &number, sizeof bits);
+        return mix(bits);
+    }
+    if (FlintString* str = key.as<FlintString>())
+        return mix(std::hash<std::string_view>{}(str->value));
+    if (key.isBool()) return mix(key.asBool() ? 1 : 2);
+    return mix(reinterpret_cast<uintptr_t>(key.asObject()));
+}
+
+bool sameKey(const LiteralValue& a, const LiteralValue& b)
+{
+    if (a.isNumber() && b.isNumber()) return a.asNumber() == b.asNumber();
+    FlintString* x = a.as<FlintString>();
+    FlintString* y = b.as<FlintString>();
+    if (x && y) return x->value == y->value;
+    return a.isSame(b);
+}
+
+// Keeps a map's entries in place while Flint code runs over them
+struct Walk {
+    uint32_t& walkers;
+    explicit Walk(uint32_t& walkers) : walkers(walkers) { ++walkers; }
+    ~Walk() { --walkers; }
+};
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────
+// The table
+// ─────────────────────────────────────────────────────────────
+size_t FlintMap::slotOf(const LiteralValue& key, size_t hash) const
+{
+    if (slots.empty()) return 0;
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        uint32_t at = slots[i];
+        if (at == EMPTY) return slots.size();
+        if (at != REMOVED && items[at].hash == hash && sameKey(items[at].key, key)) return i;
+    }
+}
+
+const LiteralValue* FlintMap::find(const LiteralValue& key) const
+{
+    if (key.isNothing()) return nullptr;
+    size_t slot = slotOf(key, hashOf(key));
+    return slot < slots.size() ? &items[slots[slot]].value : nullptr;
+}
+
+void FlintMap::set(const LiteralValue& key, LiteralValue value, const Token& where)
+{
+    if (key.isNothing()) throw RuntimeError(where, "Map keys cannot be nil.");
+    if (key.isNumber() && key.asNumber() != key.asNumber())
+        throw RuntimeError(where, "Map keys cannot be NaN.");
+
+    size_t hash = hashOf(key);
+    size_t slot = slotOf(key, hash);
+    if (slot < slots.size()) {
+        items[slots[slot]].value = std::move(value);
+        return;
+    }
+
+    // Every entry, holes included, holds a slot: keep a quarter free
+    if ((items.size() + 1) * 4 > slots.size() * 3) rebuild();
+
+    size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while (slots[i] != EMPTY && slots[i] != REMOVED) i = (i + 1) & mask;
+    slots[i] = static_cast<uint32_t>(items.size());
+    // -0 is stored as 0, the key keys() hands back
+    items.push_back(Entry{key.isNumber() && key.asNumber() == 0 ? LiteralValue(0.0) : key,
+                          std::move(value), hash});
+    ++count;
+}
+
+bool FlintMap::remove(const LiteralValue& key)
+{
+    if (key.isNothing()) return false;
+    size_t slot = slotOf(key, hashOf(key));
+    if (slot == slots.size()) return false;
+
+    Entry& entry = items[slots[slot]];
+    slots[slot] = REMOVED;
+    LiteralValue value = std::move(entry.value);   // Released once the map is consistent
+    entry.key = LiteralValue();
+    --count;
+
+    if (walkers == 0 && items.size() > 16 && count < items.size() / 2) rebuild();
+    return true;
+}
+
+void FlintMap::rebuild()
+{
+    if (walkers == 0 && count < items.size()) {
+        size_t kept = 0;
+        for (Entry& entry : items)
+            if (!entry.key.isUndefined()) items[kept++] = std::move(entry);
+        items.resize(kept);
+    }
+
+    size_t capacity = 8;
+    while ((items.size() + 1) * 2 > capacity) capacity *= 2;   // Half full at most
+    slots.assign(capacity, EMPTY);
+
+    size_t mask = capacity - 1;
+    for (size_t at = 0; at < items.size(); ++at) {
+        if (items[at].key.isUndefined()) continue;
+        size_t i = items[at].hash & mask;
+        while (slots[i] != EMPTY) i = (i + 1) & mask;
+        slots[i] = static_cast<uint32_t>(at);
+    }
+}
+
+void FlintMap::trace(Tracer& trace) const
+{
+    for (const Entry& entry : items) {
+        trace(entry.key);
+        trace(entry.value);
+    }
+}
+
+void FlintMap::clearReferences()
+{
+    items.clear();
+    slots.clear();
+    count = 0;
+}
+
+std::string FlintMap::toString() const
+{
+    Printing printing(this);
+    if (printing.recurring) return "{...}";
+    std::string out = "{";
+    bool first = true;
+    for (const Entry& entry : items) {
+        if (entry.key.isUndefined()) continue;
+        if (!first) out += ", ";
+        first = false;
+        Interpreter::appendTo(out, entry.key);
+        out += ": ";
+        Interpreter::appendTo(out, entry.value);
+    }
+    return out + "}";
+}
+
+// ─────────────────────────────────────────────────────────────
+// The builtin method table shared by every map.
+// ─────────────────────────────────────────────────────────────
+const std::unordered_map<Symbol, BuiltinMethod<FlintMap>>& FlintMap::builtInFunctions()
+{
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintMap>> table = {
+        { SymbolTable::intern("size"), { 0, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                return static_cast<double>(self.count);
+            } } },
+
+        { SymbolTable::intern("has"), { 1, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                return self.find(args[0]) != nullptr;
+            } } },
+
+        // get(key, fallback?): the value under key, else fallback (nil by default)
+        { SymbolTable::intern("get"), { -1, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (args.empty() || args.size() > 2)
+                    throw RuntimeError(token, "get() expects a key and optionally a fallback.");
+                if (const LiteralValue* value = self.find(args[0])) return *value;
+                return args.size() == 2 ? args[1] : LiteralValue(nullptr);
+            } } },
+
+        // remove(key): whether there was an entry to remove
+        { SymbolTable::intern("remove"), { 1, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                return self.remove(args[0]);
+            } } },
+
+        { SymbolTable::intern("clear"), { 0, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                if (self.walkers) throw RuntimeError(token, "Cannot clear a map inside its forEach().");
+                std::vector<Entry> dropped = std::move(self.items);
+                self.clearReferences();
+                return nullptr;
+            } } },
+
+        // keys() / values(): arrays, in insertion order
+        { SymbolTable::intern("keys"), { 0, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::vector<LiteralValue> keys;
+                keys.reserve(self.count);
+                for (const Entry& entry : self.items)
+                    if (!entry.key.isUndefined()) keys.push_back(entry.key);
+                return makeRef<FlintArray>(std::move(keys));
+            } } },
+
+        { SymbolTable::intern("values"), { 0, [](FlintMap& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                std::vector<LiteralValue> values;
+                values.reserve(self.count);
+                for (const Entry& entry : self.items)
+                    if (!entry.key.isUndefined()) values.push_back(entry.value);
+                return makeRef<FlintArray>(std::move(values));
+            } } },
+
+        // forEach(fn): fn(key, value) in insertion order.  Entries added
+        // meanwhile are visited too; removed ones are skipped.
+        { SymbolTable::intern("forEach"), { 1, [](FlintMap& self, Interpreter& interpreter,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                Ref<FlintMap> keep(&self);
+                Walk walk(self.walkers);
+                std::vector<LiteralValue> pair(2);
+                for (size_t i = 0; i < self.items.size(); ++i)
+                {
+                    if (self.items[i].key.isUndefined()) continue;
+                    pair[0] = self.items[i].key;
+                    pair[1] = self.items[i].value;
+                    interpreter.callback(args[0], pair, token);
+                }
+                return nullptr;
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintMap>* FlintMap::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintMap::getInBuiltFunction(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintMap>>(Ref<FlintMap>(this), *method, name.symbol);
+    throw RuntimeError(name, "Map has no function named " + std::string(name.lexeme) + ".");
+}
@@ -0,0 +1,548 @@
+#include <cmath>
+#include "Flint/FlintMath.h"
+#include "Flint/Simd.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+FlintVec3::FlintVec3(double x, double y, double z)
+    : FlintObject(ObjectType::VEC3), v{ x, y, z, 0.0 }
+{
+}
+
+FlintQuat::FlintQuat(double x, double y, double z, double w)
+    : FlintObject(ObjectType::QUAT), q{ x, y, z, w }
+{
+}
+
+FlintMat4::FlintMat4()
+    : FlintObject(ObjectType::MAT4), m{ 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 }
+{
+}
+
+// ─────────────────────────────────────────────────────────────
+// Lane helpers: every array here is a whole number of SIMD
+// vectors long (4 or 16 doubles), so there is no scalar tail.
+// ─────────────────────────────────────────────────────────────
+namespace {
+
+#if FLINT_SIMD
+inline simd::Vector plus(simd::Vector a, simd::Vector b)  { return simd::add(a, b); }
+inline simd::Vector times(simd::Vector a, simd::Vector b) { return simd::mul(a, b); }
+inline simd::Vector minus(simd::Vector a, simd::Vector b) { return simd::sub(a, b); }
+#endif
+inline double plus(double a, double b)  { return a + b; }
+inline double times(double a, double b) { return a * b; }
+inline double minus(double a, double b) { return a - b; }
+
+// out[i] = op(a[i], b[i]) for the first N elements
+template <size_t N, typename Op>
+inline void lanes(double* out, const double* a, const double* b, Op op)
+{
+#if FLINT_SIMD
+    for (size_t i = 0; i < N; i += simd::WIDTH)
+        simd::store(out + i, op(simd::load(a + i), simd::load(b + i)));
+#else
+    for (size_t i = 0; i < N; ++i) out[i] = op(a[i], b[i]);
+#endif
+}
+
+// out[i] = a[i] * k for the first N elements
+template <size_t N>
+inline void scaled(double* out, const double* a, double k)
+{
+#if FLINT_SIMD
+    simd::Vector kv = simd::splat(k);
+    for (size_t i = 0; i < N; i += simd::WIDTH)
+        simd::store(out + i, simd::mul(simd::load(a + i), kv));
+#else
+    for (size_t i = 0; i < N; ++i) out[i] = a[i] * k;
+#endif
+}
+
+// out = a * b, all column-major: column j of out is a's columns weighted by
+// column j of b.  `out` must not alias `a` or `b`.
+inline void multiply(double* out, const double* a, const double* b)
+{
+    for (size_t j = 0; j < 4; ++j)
+    {
+#if FLINT_SIMD
+        for (size_t i = 0; i < 4; i += simd::WIDTH)
+        {
+            simd::Vector sum = simd::mul(simd::load(a + i), simd::splat(b[j * 4]));
+            for (size_t k = 1; k < 4; ++k)
+                sum = simd::add(sum, simd::mul(simd::load(a + k * 4 + i), simd::splat(b[j * 4 + k])));
+            simd::store(out + j * 4 + i, sum);
+        }
+#else
+        for (size_t i = 0; i < 4; ++i)
+        {
+            double sum = 0;
+            for (size_t k = 0; k < 4; ++k) sum += a[k * 4 + i] * b[j * 4 + k];
+            out[j * 4 + i] = sum;
+        }
+#endif
+    }
+}
+
+double dot3(const double* a, const double* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+void cross3(double* out, const double* a, const double* b)
+{
+    double x = a[1] * b[2] - a[2] * b[1];
+    double y = a[2] * b[0] - a[0] * b[2];
+    double z = a[0] * b[1] - a[1] * b[0];
+    out[0] = x; out[1] = y; out[2] = z;
+}
+
+// out = a ∘ b (Hamilton product: apply b, then a)
+void compose(double* out, const double* a, const double* b)
+{
+    double x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+    double y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+    double z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+    double w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+    out[0] = x; out[1] = y; out[2] = z; out[3] = w;
+}
+
+// The vector v rotated by the unit quaternion q: v + w·t + q.xyz × t,
+// where t = 2 (q.xyz × v)
+Ref<FlintVec3> rotate(const double* q, const double* v)
+{
+    double t[3], u[3];
+    cross3(t, q, v);
+    t[0] *= 2; t[1] *= 2; t[2] *= 2;
+    cross3(u, q, t);
+    return makeRef<FlintVec3>(v[0] + q[3] * t[0] + u[0],
+                              v[1] + q[3] * t[1] + u[1],
+                              v[2] + q[3] * t[2] + u[2]);
+}
+
+// The point (x, y, z, w) transformed by the column-major matrix m
+Ref<FlintVec3> transform(const double* m, const double* v, double w)
+{
+    double out[4];
+    for (size_t i = 0; i < 4; ++i)
+        out[i] = m[i] * v[0] + m[4 + i] * v[1] + m[8 + i] * v[2] + m[12 + i] * w;
+    return makeRef<FlintVec3>(out[0], out[1], out[2]);
+}
+
+Ref<FlintMat4> product(const FlintMat4& a, const double* b)
+{
+    auto result = makeRef<FlintMat4>();
+    multiply(result->m, a.m, b);
+    return result;
+}
+
+std::string number(double value) { return Interpreter::stringify(LiteralValue(value)); }
+
+double numberArg(const LiteralValue& value, const Token& token, const char* method)
+{
+    if (!value.isNumber()) throw RuntimeError(token, std::string(method) + "() expects a number.");
+    return value.asNumber();
+}
+
+template <typename T>
+T& objectArg(const LiteralValue& value, const Token& token, const char* method, const char* type)
+{
+    T* object = value.as<T>();
+    if (!object) throw RuntimeError(token, std::string(method) + "() expects a " + type + ".");
+    return *object;
+}
+
+FlintVec3& vec3Arg(const LiteralValue& value, const Token& token, const char* method)
+{
+    return objectArg<FlintVec3>(value, token, method, "vec3");
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// vec3
+// ─────────────────────────────────────────────────────────────────────────────
+std::string FlintVec3::toString() const
+{
+    return "vec3(" + number(v[0]) + ", " + number(v[1]) + ", " + number(v[2]) + ")";
+}
+
+const std::unordered_map<Symbol, BuiltinMethod<FlintVec3>>& FlintVec3::builtInFunctions()
+{
+    using Args = const std::vector<LiteralValue>&;
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintVec3>> table = {
+        { SymbolTable::intern("dot"), { 1, [](FlintVec3& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                return dot3(self.v, vec3Arg(args[0], token, "dot").v);
+            } } },
+
+        { SymbolTable::intern("cross"), { 1, [](FlintVec3& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                auto result = makeRef<FlintVec3>(0, 0, 0);
+                cross3(result->v, self.v, vec3Arg(args[0], token, "cross").v);
+                return result;
+            } } },
+
+        { Symbols::LENGTH, { 0, [](FlintVec3& self, Interpreter&, Args, const Token&) -> LiteralValue {
+                return std::sqrt(dot3(self.v, self.v));
+            } } },
+
+        { SymbolTable::intern("lengthSquared"), { 0, [](FlintVec3& self, Interpreter&, Args, const Token&) -> LiteralValue {
+                return dot3(self.v, self.v);
+            } } },
+
+        { SymbolTable::intern("normalized"), { 0, [](FlintVec3& self, Interpreter&, Args, const Token& token) -> LiteralValue {
+                double length = std::sqrt(dot3(self.v, self.v));
+                if (length == 0)
+                    throw RuntimeError(token, "Cannot normalize a zero-length vec3.");
+                auto result = makeRef<FlintVec3>(0, 0, 0);
+                scaled<4>(result->v, self.v, 1 / length);
+                return result;
+            } } },
+
+        { SymbolTable::intern("distance"), { 1, [](FlintVec3& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                double d[4];
+                lanes<4>(d, self.v, vec3Arg(args[0], token, "distance").v, [](auto a, auto b) { return minus(a, b); });
+                return std::sqrt(dot3(d, d));
+            } } },
+
+        // a.lerp(b, t) = a + (b - a) * t
+        { SymbolTable::intern("lerp"), { 2, [](FlintVec3& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                const FlintVec3& other = vec3Arg(args[0], token, "lerp");
+                double t = numberArg(args[1], token, "lerp");
+                auto result = makeRef<FlintVec3>(0, 0, 0);
+                for (size_t i = 0; i < 3; ++i)
+                    result->v[i] = self.v[i] + (other.v[i] - self.v[i]) * t;
+                return result;
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintVec3>* FlintVec3::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintVec3::get(const Token& name)
+{
+    switch (name.symbol)
+    {
+        case Symbols::X: return v[0];
+        case Symbols::Y: return v[1];
+        case Symbols::Z: return v[2];
+        default: break;
+    }
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintVec3>>(Ref<FlintVec3>(this), *method, name.symbol);
+    throw RuntimeError(name, "vec3 has no property named " + std::string(name.lexeme) + ".");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// quat
+// ─────────────────────────────────────────────────────────────────────────────
+std::string FlintQuat::toString() const
+{
+    return "quat(" + number(q[0]) + ", " + number(q[1]) + ", " +
+           number(q[2]) + ", " + number(q[3]) + ")";
+}
+
+LiteralValue FlintQuat::fromAxisAngle(const FlintVec3& axis, double angle)
+{
+    double length = std::sqrt(dot3(axis.v, axis.v));
+    if (length == 0) return makeRef<FlintQuat>(0, 0, 0, 1);
+
+    double s = std::sin(angle / 2) / length;
+    return makeRef<FlintQuat>(axis.v[0] * s, axis.v[1] * s, axis.v[2] * s, std::cos(angle / 2));
+}
+
+const std::unordered_map<Symbol, BuiltinMethod<FlintQuat>>& FlintQuat::builtInFunctions()
+{
+    using Args = const std::vector<LiteralValue>&;
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintQuat>> table = {
+        { SymbolTable::intern("conjugate"), { 0, [](FlintQuat& self, Interpreter&, Args, const Token&) -> LiteralValue {
+                return makeRef<FlintQuat>(-self.q[0], -self.q[1], -self.q[2], self.q[3]);
+            } } },
+
+        { Symbols::LENGTH, { 0, [](FlintQuat& self, Interpreter&, Args, const Token&) -> LiteralValue {
+                const double* q = self.q;
+                return std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            } } },
+
+        { SymbolTable::intern("normalized"), { 0, [](FlintQuat& self, Interpreter&, Args, const Token& token) -> LiteralValue {
+                const double* q = self.q;
+                double length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+                if (length == 0)
+                    throw RuntimeError(token, "Cannot normalize a zero-length quat.");
+                auto result = makeRef<FlintQuat>(0, 0, 0, 0);
+                scaled<4>(result->q, q, 1 / length);
+                return result;
+            } } },
+
+        { SymbolTable::intern("rotate"), { 1, [](FlintQuat& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                return rotate(self.q, vec3Arg(args[0], token, "rotate").v);
+            } } },
+
+        // Spherical interpolation along the shorter arc; t = 0 is self, 1 is other
+        { SymbolTable::intern("slerp"), { 2, [](FlintQuat& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                const double* a = self.q;
+                double b[4];
+                const double* other = objectArg<FlintQuat>(args[0], token, "slerp", "quat").q;
+                double t = numberArg(args[1], token, "slerp");
+
+                double cosine = a[0] * other[0] + a[1] * other[1] + a[2] * other[2] + a[3] * other[3];
+                double sign = cosine < 0 ? -1 : 1;
+                for (size_t i = 0; i < 4; ++i) b[i] = other[i] * sign;
+                cosine *= sign;
+
+                double wa = 1 - t, wb = t;
+                if (cosine < 0.9995)   // Otherwise nearly parallel: plain lerp is accurate
+                {
+                    double theta = std::acos(cosine), s = std::sin(theta);
+                    wa = std::sin((1 - t) * theta) / s;
+                    wb = std::sin(t * theta) / s;
+                }
+
+                auto result = makeRef<FlintQuat>(0, 0, 0, 0);
+                double* r = result->q;
+                for (size_t i = 0; i < 4; ++i) r[i] = a[i] * wa + b[i] * wb;
+                double length = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+                scaled<4>(r, r, 1 / length);
+                return result;
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintQuat>* FlintQuat::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintQuat::get(const Token& name)
+{
+    switch (name.symbol)
+    {
+        case Symbols::X: return q[0];
+        case Symbols::Y: return q[1];
+        case Symbols::Z: return q[2];
+        case Symbols::W: return q[3];
+        default: break;
+    }
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintQuat>>(Ref<FlintQuat>(this), *method, name.symbol);
+    throw RuntimeError(name, "quat has no property named " + std::string(name.lexeme) + ".");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// mat4
+// ─────────────────────────────────────────────────────────────────────────────
+std::string FlintMat4::toString() const
+{
+    std::string out = "mat4(";
+    for (size_t row = 0; row < 4; ++row)
+    {
+        out += "[";
+        for (size_t column = 0; column < 4; ++column)
+        {
+            out += number(m[column * 4 + row]);
+            if (column < 3) out += ", ";
+        }
+        out += row < 3 ? "], " : "]";
+    }
+    return out + ")";
+}
+
+const std::unordered_map<Symbol, BuiltinMethod<FlintMat4>>& FlintMat4::builtInFunctions()
+{
+    using Args = const std::vector<LiteralValue>&;
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintMat4>> table = {
+        // m.get(row, column)
+        { SymbolTable::intern("get"), { 2, [](FlintMat4& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                double row = numberArg(args[0], token, "get"), column = numberArg(args[1], token, "get");
+                if (row < 0 || row > 3 || column < 0 || column > 3)
+                    throw RuntimeError(token, "mat4 index out of bounds.");
+                return self.m[static_cast<size_t>(column) * 4 + static_cast<size_t>(row)];
+            } } },
+
+        { SymbolTable::intern("transpose"), { 0, [](FlintMat4& self, Interpreter&, Args, const Token&) -> LiteralValue {
+                auto result = makeRef<FlintMat4>();
+                for (size_t row = 0; row < 4; ++row)
+                    for (size_t column = 0; column < 4; ++column)
+                        result->m[row * 4 + column] = self.m[column * 4 + row];
+                return result;
+            } } },
+
+        // Inverse by cofactors (the transposed adjugate over the determinant)
+        { SymbolTable::intern("inverse"), { 0, [](FlintMat4& self, Interpreter&, Args, const Token& token) -> LiteralValue {
+                const double* a = self.m;
+                double inv[16];
+                inv[0]  =  a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+                inv[4]  = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+                inv[8]  =  a[4] * a[9]  * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+                inv[12] = -a[4] * a[9]  * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+                inv[1]  = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+                inv[5]  =  a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+                inv[9]  = -a[0] * a[9]  * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+                inv[13] =  a[0] * a[9]  * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+                inv[2]  =  a[1] * a[6]  * a[15] - a[1] * a[7]  * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7]  - a[13] * a[3] * a[6];
+                inv[6]  = -a[0] * a[6]  * a[15] + a[0] * a[7]  * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7]  + a[12] * a[3] * a[6];
+                inv[10] =  a[0] * a[5]  * a[15] - a[0] * a[7]  * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7]  - a[12] * a[3] * a[5];
+                inv[14] = -a[0] * a[5]  * a[14] + a[0] * a[6]  * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6]  + a[12] * a[2] * a[5];
+                inv[3]  = -a[1] * a[6]  * a[11] + a[1] * a[7]  * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9]  * a[2] * a[7]  + a[9]  * a[3] * a[6];
+                inv[7]  =  a[0] * a[6]  * a[11] - a[0] * a[7]  * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8]  * a[2] * a[7]  - a[8]  * a[3] * a[6];
+                inv[11] = -a[0] * a[5]  * a[11] + a[0] * a[7]  * a[9]  + a[4] * a[1] * a[11] - a[4] * a[3] * a[9]  - a[8]  * a[1] * a[7]  + a[8]  * a[3] * a[5];
+                inv[15] =  a[0] * a[5]  * a[10] - a[0] * a[6]  * a[9]  - a[4] * a[1] * a[10] + a[4] * a[2] * a[9]  + a[8]  * a[1] * a[6]  - a[8]  * a[2] * a[5];
+
+                double determinant = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+                if (determinant == 0)
+                    throw RuntimeError(token, "Cannot invert a singular mat4.");
+
+                auto result = makeRef<FlintMat4>();
+                scaled<16>(result->m, inv, 1 / determinant);
+                return result;
+            } } },
+
+        // m.translate(v) = m * T(v), and so on: each applies its transform first
+        { SymbolTable::intern("translate"), { 1, [](FlintMat4& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                const double* v = vec3Arg(args[0], token, "translate").v;
+                double t[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  v[0], v[1], v[2], 1 };
+                return product(self, t);
+            } } },
+
+        { SymbolTable::intern("scale"), { 1, [](FlintMat4& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                const double* v = vec3Arg(args[0], token, "scale").v;
+                double s[16] = { v[0], 0, 0, 0,  0, v[1], 0, 0,  0, 0, v[2], 0,  0, 0, 0, 1 };
+                return product(self, s);
+            } } },
+
+        { SymbolTable::intern("rotate"), { 1, [](FlintMat4& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                const double* q = objectArg<FlintQuat>(args[0], token, "rotate", "quat").q;
+                double x = q[0], y = q[1], z = q[2], w = q[3];
+                double r[16] = {
+                    1 - 2 * (y * y + z * z), 2 * (x * y + w * z),     2 * (x * z - w * y),     0,
+                    2 * (x * y - w * z),     1 - 2 * (x * x + z * z), 2 * (y * z + w * x),     0,
+                    2 * (x * z + w * y),     2 * (y * z - w * x),     1 - 2 * (x * x + y * y), 0,
+                    0,                       0,                       0,                       1,
+                };
+                return product(self, r);
+            } } },
+
+        // Like m * v, but for a direction: translation does not apply
+        { SymbolTable::intern("transformDirection"), { 1, [](FlintMat4& self, Interpreter&, Args args, const Token& token) -> LiteralValue {
+                return transform(self.m, vec3Arg(args[0], token, "transformDirection").v, 0);
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintMat4>* FlintMat4::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintMat4::get(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintMat4>>(Ref<FlintMat4>(this), *method, name.symbol);
+    throw RuntimeError(name, "mat4 has no property named " + std::string(name.lexeme) + ".");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Operators
+// ─────────────────────────────────────────────────────────────────────────────
+LiteralValue FlintMath::binary(TokenType op, const LiteralValue& left,
+                               const LiteralValue& right, const Token& where)
+{
+    if (op == TokenType::EQUAL_EQUAL) return equal(left, right);
+    if (op == TokenType::BANG_EQUAL)  return !equal(left, right);
+
+    FlintVec3* lv = left.as<FlintVec3>();
+    FlintVec3* rv = right.as<FlintVec3>();
+
+    if (lv && rv)
+    {
+        auto result = makeRef<FlintVec3>(0, 0, 0);
+        switch (op)
+        {
+            case TokenType::PLUS:  lanes<4>(result->v, lv->v, rv->v, [](auto a, auto b) { return plus(a, b); });  return result;
+            case TokenType::MINUS: lanes<4>(result->v, lv->v, rv->v, [](auto a, auto b) { return minus(a, b); }); return result;
+            case TokenType::STAR:  lanes<4>(result->v, lv->v, rv->v, [](auto a, auto b) { return times(a, b); }); return result;
+            default: break;
+        }
+    }
+    else if (lv && right.isNumber() && (op == TokenType::STAR || op == TokenType::SLASH))
+    {
+        double k = right.asNumber();
+        if (op == TokenType::SLASH)
+        {
+            if (k == 0) throw RuntimeError(where, "divide by zero? seriously? who gave this kid a computer.");
+            k = 1 / k;
+        }
+        auto result = makeRef<FlintVec3>(0, 0, 0);
+        scaled<4>(result->v, lv->v, k);
+        return result;
+    }
+    else if (rv && left.isNumber() && op == TokenType::STAR)
+    {
+        auto result = makeRef<FlintVec3>(0, 0, 0);
+        scaled<4>(result->v, rv->v, left.asNumber());
+        return result;
+    }
+    else if (op == TokenType::STAR)
+    {
+        if (FlintQuat* lq = left.as<FlintQuat>())
+        {
+            if (FlintQuat* rq = right.as<FlintQuat>())
+            {
+                auto result = makeRef<FlintQuat>(0, 0, 0, 0);
+                compose(result->q, lq->q, rq->q);
+                return result;
+            }
+            if (rv) return rotate(lq->q, rv->v);
+        }
+        else if (FlintMat4* lm = left.as<FlintMat4>())
+        {
+            if (FlintMat4* rm = right.as<FlintMat4>()) return product(*lm, rm->m);
+            if (rv) return transform(lm->m, rv->v, 1);
+            if (right.isNumber())
+            {
+                auto result = makeRef<FlintMat4>();
+                scaled<16>(result->m, lm->m, right.asNumber());
+                return result;
+            }
+        }
+    }
+
+    throw RuntimeError(where, "Unsupported operands " + Interpreter::stringify(left) + " " +
+                              std::string(where.lexeme) + " " + Interpreter::stringify(right) + ".");
+}
+
+LiteralValue FlintMath::negate(const LiteralValue& value, const Token& where)
+{
+    if (FlintVec3* vec = value.as<FlintVec3>())
+    {
+        auto result = makeRef<FlintVec3>(0, 0, 0);
+        scaled<4>(result->v, vec->v, -1);
+        return result;
+    }
+    throw RuntimeError(where, "Only numbers and vec3 can be negated.");
+}
+
+bool FlintMath::equal(const LiteralValue& left, const LiteralValue& right)
+{
+    auto same = [](const double* a, const double* b, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            if (a[i] != b[i]) return false;
+        return true;
+    };
+
+    if (FlintVec3* a = left.as<FlintVec3>())
+        if (FlintVec3* b = right.as<FlintVec3>()) return same(a->v, b->v, 3);
+    if (FlintQuat* a = left.as<FlintQuat>())
+        if (FlintQuat* b = right.as<FlintQuat>()) return same(a->q, b->q, 4);
+    if (FlintMat4* a = left.as<FlintMat4>())
+        if (FlintMat4* b = right.as<FlintMat4>()) return same(a->m, b->m, 16);
+    return false;
+}
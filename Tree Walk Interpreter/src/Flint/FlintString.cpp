@@ -4,60 +4,73 @@
 #include "Flint/Exceptions/RuntimeError.h"
 
 FlintString::FlintString(std::string value)
-  : value(std::move(value))
+  : FlintObject(ObjectType::STRING), value(std::move(value))
 {
+}
 
-    builtInFunctions["lower"] = std::make_shared<BuiltinFunction>(
-        [this](Interpreter&,
-                   const std::vector<LiteralValue>& args,
-                   const Token& token
-                 ) -> LiteralValue {
+Ref<FlintString> FlintString::concat(const LiteralValue& a, const LiteralValue& b)
+{
+    // Enough for a number; other values grow the buffer themselves
+    auto size = [](const LiteralValue& v) -> size_t {
+        FlintString* str = v.as<FlintString>();
+        return str ? str->value.size() : 24;
+    };
+    std::string text;
+    text.reserve(size(a) + size(b));
+    Interpreter::appendTo(text, a);
+    Interpreter::appendTo(text, b);
+    return makeRef<FlintString>(std::move(text));
+}
+
+// ─────────────────────────────────────────────────────────────
+// The builtin method table shared by every string.
+// ─────────────────────────────────────────────────────────────
+const std::unordered_map<Symbol, BuiltinMethod<FlintString>>& FlintString::builtInFunctions()
+{
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintString>> table = {
+        { Symbols::LOWER, { 0, [](FlintString& self, Interpreter&,
+                                  const std::vector<LiteralValue>& args,
+                                  const Token& token) -> LiteralValue {
             if (!args.empty())
                 throw RuntimeError(token, "lower takes no arguments");
-            std::transform(
-                this->value.begin(), this->value.end(),
-                this->value.begin(),
-                ::tolower
-            );
-            // wrap the mutated string back into a LiteralValue
-            return LiteralValue(shared_from_this());
-        },
-        /*arity=*/0
-    );
+            // strings are immutable: return a lowered copy
+            std::string lowered = self.value;
+            std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
+            return LiteralValue(makeRef<FlintString>(std::move(lowered)));
+        } } },
 
-    builtInFunctions["upper"] = std::make_shared<BuiltinFunction>(
-        [this](Interpreter&,
-                   const std::vector<LiteralValue>& args,
-                   const Token& token
-                 ) -> LiteralValue {
+        { Symbols::UPPER, { 0, [](FlintString& self, Interpreter&,
+                                  const std::vector<LiteralValue>& args,
+                                  const Token& token) -> LiteralValue {
             if (!args.empty())
                 throw RuntimeError(token, "upper takes no arguments");
-            std::transform(
-                this->value.begin(), this->value.end(),
-                this->value.begin(),
-                ::toupper
-            );
-            return LiteralValue(shared_from_this());
-        },
-        0
-    );
+            std::string uppered = self.value;
+            std::transform(uppered.begin(), uppered.end(), uppered.begin(), ::toupper);
+            return LiteralValue(makeRef<FlintString>(std::move(uppered)));
+        } } },
 
-    builtInFunctions["length"] = std::make_shared<BuiltinFunction>(
-        [this](Interpreter&,
-                   const std::vector<LiteralValue>& args,
-                   const Token& token
-                 ) -> LiteralValue {
+        { Symbols::LENGTH, { 0, [](FlintString& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args,
+                                   const Token& token) -> LiteralValue {
             if (!args.empty())
                 throw RuntimeError(token, "length takes no arguments");
             // return a number wrapped as a LiteralValue
-            return LiteralValue(static_cast<double>(this->value.length()));
-        },
-        0
-    );
+            return LiteralValue(static_cast<double>(self.value.length()));
+        } } },
+    };
+    return table;
 }
-LiteralValue FlintString::getInBuiltFunction(Token name)
+
+const BuiltinMethod<FlintString>* FlintString::findBuiltin(Symbol name)
 {
-    if(builtInFunctions.count(name.lexeme)) return builtInFunctions[name.lexeme];
-    throw RuntimeError(name, "string has no function " + name.lexeme + ".");
-    return nullptr;
-}
\ No newline at end of file
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintString::getInBuiltFunction(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintString>>(Ref<FlintString>(this), *method, name.symbol);
+    throw RuntimeError(name, "string has no function " + std::string(name.lexeme) + ".");
+}
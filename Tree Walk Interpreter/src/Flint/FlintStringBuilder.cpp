@@ -0,0 +1,52 @@
+#include "Flint/FlintStringBuilder.h"
+#include "Flint/FlintString.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+// ─────────────────────────────────────────────────────────────
+// The builtin method table shared by every builder.
+// ─────────────────────────────────────────────────────────────
+const std::unordered_map<Symbol, BuiltinMethod<FlintStringBuilder>>& FlintStringBuilder::builtInFunctions()
+{
+    static const std::unordered_map<Symbol, BuiltinMethod<FlintStringBuilder>> table = {
+        // append(values...): add each value's text; returns the builder
+        { SymbolTable::intern("append"), { -1, [](FlintStringBuilder& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                for (const LiteralValue& arg : args) Interpreter::appendTo(self.buffer, arg);
+                return Ref<FlintStringBuilder>(&self);
+            } } },
+
+        { Symbols::LENGTH, { 0, [](FlintStringBuilder& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                return static_cast<double>(self.buffer.size());
+            } } },
+
+        // toString(): the text as a string; the builder keeps it
+        { SymbolTable::intern("toString"), { 0, [](FlintStringBuilder& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                return makeRef<FlintString>(self.buffer);
+            } } },
+
+        // clear(): empty the builder, keeping its capacity; returns the builder
+        { SymbolTable::intern("clear"), { 0, [](FlintStringBuilder& self, Interpreter&,
+                                   const std::vector<LiteralValue>& args, const Token& token) -> LiteralValue {
+                self.buffer.clear();
+                return Ref<FlintStringBuilder>(&self);
+            } } },
+    };
+    return table;
+}
+
+const BuiltinMethod<FlintStringBuilder>* FlintStringBuilder::findBuiltin(Symbol name)
+{
+    auto& table = builtInFunctions();
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+}
+
+LiteralValue FlintStringBuilder::getInBuiltFunction(const Token& name)
+{
+    if (auto method = findBuiltin(name.symbol))
+        return makeRef<BuiltinFunction<FlintStringBuilder>>(Ref<FlintStringBuilder>(this), *method, name.symbol);
+    throw RuntimeError(name, "StringBuilder has no function named " + std::string(name.lexeme) + ".");
+}
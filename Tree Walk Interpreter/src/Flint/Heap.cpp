@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <atomic>
+#include "Flint/Heap.h"
+#include "Flint/Environment.h"
+#include "Flint/FlintObject.h"
+
+// Settings of heaps created from now on (see Heap::configure)
+static std::atomic<size_t> defaultThreshold{Heap::DEFAULT_THRESHOLD};
+static std::atomic<double> defaultGrowth{Heap::DEFAULT_GROWTH};
+
+// A plain pointer, so it is still readable while the thread's (and, on the
+// main thread, the program's) other objects are destroyed
+static thread_local Heap* threadHeap = nullptr;
+
+// Frees the thread's heap when the thread ends, or – if objects are still
+// alive then (other thread_locals, or the program's statics) – once the last
+// of them has unregistered
+struct Heap::Reaper {
+    ~Reaper()
+    {
+        if (!threadHeap) return;
+        threadHeap->orphaned = true;
+        threadHeap->releaseIfOrphaned();
+    }
+};
+
+void Heap::releaseIfOrphaned()
+{
+    if (!orphaned || collecting || !objects.empty()) return;
+    threadHeap = nullptr;
+    delete this;
+}
+
+Heap& Heap::instance()
+{
+    if (!threadHeap)
+    {
+        static thread_local Reaper reaper;
+        (void)reaper;
+        threadHeap = new Heap();
+    }
+    return *threadHeap;
+}
+
+Heap::Heap()
+    : threshold(defaultThreshold.load()), growth(defaultGrowth.load()),
+      nextCollection(threshold) {}
+
+Collectable::Collectable() { Heap::instance().track(this); }
+
+Collectable::~Collectable() { Heap::instance().untrack(this); }
+
+void Tracer::operator()(const LiteralValue& value)
+{
+    if (value.isObject()) visit(value.asObject());
+}
+
+void Tracer::operator()(const std::shared_ptr<Environment>& environment)
+{
+    if (environment) visit(environment.get());
+}
+
+// ─────────────────────────────────────────────────────────────
+// Registers a new node.  A due collection runs first, before
+// the node is in the list, so it never sees a half-built object.
+// ─────────────────────────────────────────────────────────────
+void Heap::track(Collectable* node)
+{
+    if (objects.size() >= nextCollection && !collecting) run();
+
+    node->heapIndex = static_cast<uint32_t>(objects.size());
+    objects.push_back(node);
+}
+
+void Heap::untrack(Collectable* node)
+{
+    Collectable* last = objects.back();
+    objects[node->heapIndex] = last;
+    last->heapIndex = node->heapIndex;
+    objects.pop_back();
+    if (orphaned) releaseIfOrphaned();
+}
+
+void Heap::configure(size_t threshold, double growth)
+{
+    defaultThreshold.store(threshold);
+    defaultGrowth.store(growth);
+
+    Heap& heap = instance();
+    heap.threshold = threshold;
+    heap.growth = growth;
+    heap.nextCollection = std::max(threshold, heap.objects.size());
+}
+
+// Neither creates a heap: a thread with none has nothing to collect
+size_t Heap::collect() { return threadHeap ? threadHeap->run() : 0; }
+
+Heap::Stats Heap::stats()
+{
+    if (!threadHeap) return { 0, defaultThreshold.load(), 0, 0 };
+    const Heap& heap = *threadHeap;
+    return { heap.objects.size(), heap.nextCollection, heap.collections, heap.collected };
+}
+
+// ─────────────────────────────────────────────────────────────
+// Allocation counts
+// ─────────────────────────────────────────────────────────────
+const Heap::Counts& Heap::counts(uint8_t kind)
+{
+    static const Counts none;
+    return threadHeap ? threadHeap->kinds[kind] : none;
+}
+
+Heap::Counts Heap::totals()
+{
+    return threadHeap ? threadHeap->total : Counts{};
+}
+
+const char* Heap::kindName(uint8_t kind)
+{
+    // In ObjectType order
+    static const char* const names[] = {
+        "string", "StringBuilder", "array", "Map", "Float64Array", "vec3", "quat", "mat4", "future", "file",
+        "instance", "vm function", "vm upvalue", "vm closure", "vm class",
+        "vm instance", "vm bound method", "function", "native", "builtin", "class",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == size_t(ObjectType::CLASS) + 1,
+                  "a name for every ObjectType");
+    static_assert(size_t(ObjectType::CLASS) < ENVIRONMENT, "ObjectType fits the kinds");
+
+    if (kind == ENVIRONMENT) return "environment";
+    return kind < sizeof(names) / sizeof(names[0]) ? names[kind] : nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────
+// One collection (see Heap.h for the outline).
+// ─────────────────────────────────────────────────────────────
+size_t Heap::run()
+{
+    collecting = true;
+    std::vector<Collectable*> worklist;
+
+    // 1–2. Count the references that come from outside the heap
+    for (Collectable* node : objects)
+    {
+        size_t count = node->referenceCount();
+        node->gcRefs = count == 0 ? PINNED : static_cast<int32_t>(std::min<size_t>(count, PINNED));
+    }
+    Tracer subtract(Tracer::Mode::SUBTRACT, worklist);
+    for (Collectable* node : objects)
+        node->trace(subtract);
+
+    // 3. Mark everything reachable from those roots
+    for (Collectable* node : objects)
+    {
+        if (node->gcRefs > 0)
+        {
+            node->gcRefs = REACHABLE;
+            worklist.push_back(node);
+        }
+    }
+    Tracer mark(Tracer::Mode::MARK, worklist);
+    while (!worklist.empty())
+    {
+        Collectable* node = worklist.back();
+        worklist.pop_back();
+        node->trace(mark);
+    }
+
+    // 4. The rest is garbage: only referenced from inside cycles.  Pin it
+    // all first, so breaking one object apart cannot free another while it
+    // is still being cleared, then let the reference counts free it.
+    std::vector<Collectable*> garbage;
+    for (Collectable* node : objects)
+        if (node->gcRefs != REACHABLE) garbage.push_back(node);
+
+    for (Collectable* node : garbage) node->pin();
+    for (Collectable* node : garbage) node->clearReferences();
+    for (Collectable* node : garbage) node->unpin();
+
+    collections++;
+    collected += garbage.size();
+    nextCollection = std::max(threshold, static_cast<size_t>(objects.size() * growth));
+    collecting = false;
+    size_t freed = garbage.size();
+    if (orphaned) releaseIfOrphaned();
+    return freed;
+}
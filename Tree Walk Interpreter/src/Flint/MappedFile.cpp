@@ -0,0 +1,53 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "Flint/MappedFile.h"
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FLINT_HAS_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+{
+#if defined(FLINT_HAS_MMAP)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        opened = true;
+        if (info.st_size > 0)
+        {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                bytes = static_cast<const unsigned char*>(mapping);
+                length = static_cast<size_t>(info.st_size);
+                mapped = true;
+            }
+            else opened = false;
+        }
+    }
+    ::close(fd);
+    if (opened) return;   // Else read it, as where there is no mmap
+#endif
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return;
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    words.resize((contents.size() + 7) / 8);
+    if (!contents.empty()) std::memcpy(words.data(), contents.data(), contents.size());
+    bytes = reinterpret_cast<const unsigned char*>(words.data());
+    length = contents.size();
+    opened = true;
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(FLINT_HAS_MMAP)
+    if (mapped) ::munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+}
@@ -0,0 +1,24 @@
+#include "Flint/Callables/Classes/Shape.h"
+
+std::atomic<uint32_t> Shape::nextId{1};
+
+Shape::Shape() : id(nextId++) {}
+
+// A child shape: every field of `parent`, then `name` in the next slot
+Shape::Shape(const Shape& parent, Symbol name)
+    : id(nextId++), slots(parent.slots)
+{
+    slots.emplace(name, parent.slotCount());
+}
+
+// ─────────────────────────────────────────────────────────────
+// Follows (or creates) the transition for adding field `name`.
+// The child is owned by this shape, so the whole tree lives as
+// long as the class that owns its root.
+// ─────────────────────────────────────────────────────────────
+Shape* Shape::withField(Symbol name)
+{
+    std::unique_ptr<Shape>& child = transitions[name];
+    if (!child) child.reset(new Shape(*this, name));
+    return child.get();
+}
@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include "Flint/Tasks.h"
+#include "Flint/Flint.h"
+#include "Flint/FlintArray.h"
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintMap.h"
+#include "Flint/FlintMath.h"
+#include "Flint/FlintString.h"
+#include "Flint/ThreadPool.h"
+#include "Flint/Callables/Functions/FlintFunction.h"
+#include "Flint/Exceptions/RuntimeError.h"
+#include "Flint/Exceptions/BudgetExceeded.h"
+#include "Flint/VM/VMObjects.h"
+
+void TaskProgram::add(Unit source, Engine engine, bool optimize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    units.push_back(std::move(source));
+    this->engine = engine;
+    this->optimize = optimize;
+}
+
+std::vector<TaskProgram::Unit> TaskProgram::unitsFrom(size_t first, Engine& engine, bool& optimize) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    engine = this->engine;
+    optimize = this->optimize;
+    if (first >= units.size()) return {};
+    return std::vector<Unit>(units.begin() + first, units.end());
+}
+
+namespace {
+
+// ─────────────────────────────────────────────────────────────
+// TaskValue: a value copied out of one thread's heap, holding
+// no objects, so it can be rebuilt in another thread's.
+// ─────────────────────────────────────────────────────────────
+struct TaskValue
+{
+    enum class Kind : uint8_t { NIL, BOOL, NUMBER, STRING, ARRAY, MAP, FLOAT64_ARRAY, VEC3, QUAT, MAT4 };
+
+    Kind kind = Kind::NIL;
+    double number = 0;               // NUMBER; BOOL as 0 or 1
+    std::string text;                // STRING
+    std::vector<TaskValue> items;    // ARRAY; MAP as key, value, key, ... in insertion order
+    std::vector<double> numbers;     // FLOAT64_ARRAY and the math types' components
+
+    // Throws at `where` for a value that cannot be copied; `path` holds
+    // the arrays and maps being copied, to catch one that contains itself
+    static TaskValue copy(const LiteralValue& value, const Token& where,
+                          std::vector<const FlintObject*>& path);
+
+    // `where` is reported if a rebuilt map refuses a key (it never does:
+    // the keys were keys of a map already)
+    LiteralValue rebuild(const Token& where) const;
+};
+
+TaskValue TaskValue::copy(const LiteralValue& value, const Token& where,
+                          std::vector<const FlintObject*>& path)
+{
+    TaskValue out;
+    if (value.isNothing()) return out;
+    if (value.isBool()) {
+        out.kind = Kind::BOOL;
+        out.number = value.asBool() ? 1 : 0;
+    }
+    else if (value.isNumber()) {
+        out.kind = Kind::NUMBER;
+        out.number = value.asNumber();
+    }
+    else if (FlintString* string = value.as<FlintString>()) {
+        out.kind = Kind::STRING;
+        out.text = string->value;
+    }
+    else if (FlintArray* array = value.as<FlintArray>()) {
+        if (std::find(path.begin(), path.end(), array) != path.end())
+            throw RuntimeError(where, "Cannot pass an array that contains itself to or from a task.");
+        out.kind = Kind::ARRAY;
+        out.items.reserve(array->elements.size());
+        path.push_back(array);
+        for (const LiteralValue& element : array->elements)
+            out.items.push_back(copy(element, where, path));
+        path.pop_back();
+    }
+    else if (FlintMap* map = value.as<FlintMap>()) {
+        if (std::find(path.begin(), path.end(), map) != path.end())
+            throw RuntimeError(where, "Cannot pass a map that contains itself to or from a task.");
+        out.kind = Kind::MAP;
+        out.items.reserve(map->size() * 2);
+        path.push_back(map);
+        for (const FlintMap::Entry& entry : map->entries()) {
+            if (entry.key.isUndefined()) continue;   // Removed
+            out.items.push_back(copy(entry.key, where, path));
+            out.items.push_back(copy(entry.value, where, path));
+        }
+        path.pop_back();
+    }
+    else if (FlintFloat64Array* packed = value.as<FlintFloat64Array>()) {
+        out.kind = Kind::FLOAT64_ARRAY;
+        out.numbers = packed->elements;
+    }
+    else if (FlintVec3* vec = value.as<FlintVec3>()) {
+        out.kind = Kind::VEC3;
+        out.numbers.assign(vec->v, vec->v + 3);
+    }
+    else if (FlintQuat* quat = value.as<FlintQuat>()) {
+        out.kind = Kind::QUAT;
+        out.numbers.assign(quat->q, quat->q + 4);
+    }
+    else if (FlintMat4* mat = value.as<FlintMat4>()) {
+        out.kind = Kind::MAT4;
+        out.numbers.assign(mat->m, mat->m + 16);
+    }
+    else {
+        throw RuntimeError(where, "Only nil, booleans, numbers, strings, arrays, maps, "
+                                  "Float64Arrays, vec3, quat and mat4 can be passed to or from a task.");
+    }
+    return out;
+}
+
+LiteralValue TaskValue::rebuild(const Token& where) const
+{
+    switch (kind)
+    {
+        case Kind::NIL:    return nullptr;
+        case Kind::BOOL:   return number != 0;
+        case Kind::NUMBER: return number;
+        case Kind::STRING: return makeRef<FlintString>(text);
+        case Kind::ARRAY: {
+            std::vector<LiteralValue> elements;
+            elements.reserve(items.size());
+            for (const TaskValue& item : items) elements.push_back(item.rebuild(where));
+            return makeRef<FlintArray>(std::move(elements));
+        }
+        case Kind::MAP: {
+            Ref<FlintMap> map = makeRef<FlintMap>();
+            for (size_t i = 0; i + 1 < items.size(); i += 2)
+                map->set(items[i].rebuild(where), items[i + 1].rebuild(where), where);
+            return map;
+        }
+        case Kind::FLOAT64_ARRAY: return makeRef<FlintFloat64Array>(numbers);
+        case Kind::VEC3: return makeRef<FlintVec3>(numbers[0], numbers[1], numbers[2]);
+        case Kind::QUAT: return makeRef<FlintQuat>(numbers[0], numbers[1], numbers[2], numbers[3]);
+        case Kind::MAT4: {
+            Ref<FlintMat4> mat = makeRef<FlintMat4>();
+            std::copy(numbers.begin(), numbers.end(), mat->m);
+            return mat;
+        }
+    }
+    return nullptr;
+}
+
+TaskValue copyValue(const LiteralValue& value, const Token& where)
+{
+    std::vector<const FlintObject*> path;
+    return TaskValue::copy(value, where, path);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Worker contexts of this thread, one per program it has run
+// tasks of.  `loaded` counts the program's units replayed so far;
+// new ones are replayed before the next task, unless a task is
+// still running in the context (one awaiting another).
+// ─────────────────────────────────────────────────────────────
+struct Worker
+{
+    std::weak_ptr<TaskProgram> program;
+    std::unique_ptr<Flint> context;
+    size_t loaded = 0;
+    size_t running = 0;
+};
+
+thread_local std::vector<std::unique_ptr<Worker>> workers;
+
+Worker& workerFor(const std::shared_ptr<TaskProgram>& program)
+{
+    Worker* worker = nullptr;
+    for (const std::unique_ptr<Worker>& candidate : workers)
+        if (candidate->program.lock() == program) worker = candidate.get();
+
+    if (!worker)
+    {
+        // Programs nobody holds any more have no tasks left to run
+        workers.erase(std::remove_if(workers.begin(), workers.end(),
+            [](const std::unique_ptr<Worker>& old) { return old->program.expired(); }), workers.end());
+
+        workers.push_back(std::make_unique<Worker>());
+        worker = workers.back().get();
+        worker->program = program;
+        worker->context = std::make_unique<Flint>(program);
+    }
+
+    if (worker->running == 0)
+    {
+        Engine engine;
+        bool optimize;
+        std::vector<TaskProgram::Unit> units = program->unitsFrom(worker->loaded, engine, optimize);
+        worker->context->engine = engine;
+        worker->context->optimize = optimize;
+        for (const TaskProgram::Unit& unit : units) worker->context->declare(unit);
+        worker->loaded += units.size();
+    }
+    return *worker;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────
+// Task: one spawn() call.  Whichever thread first claims it – a
+// pool thread taking its job, or a thread awaiting it – runs it.
+// ─────────────────────────────────────────────────────────────
+class Task
+{
+public:
+    std::shared_ptr<TaskProgram> program;
+    Symbol function;
+    std::vector<TaskValue> arguments;
+    size_t line;                       // Of the spawn() call
+
+    // What was left of the spawner's budget when it spawned the task: the
+    // task may take as many steps, and must end by the same deadline
+    Interpreter::Budget budget;
+    std::chrono::steady_clock::time_point spawned;
+
+    std::atomic<bool> claimed{false};
+
+    std::mutex mutex;                  // Guards everything below
+    std::condition_variable finished;
+    bool done = false;
+    bool failed = false;
+    bool outOfBudget = false;          // It failed by running out of budget
+    TaskValue result;
+    std::string error;
+
+    void run();
+
+private:
+    void finish(TaskValue value, bool failed, std::string error, bool outOfBudget = false);
+};
+
+void Task::run()
+{
+    try {
+        Worker& worker = workerFor(program);
+
+        // A task run while another is running in the same context (awaiting
+        // it) shares that one's run, and with it its budget
+        if (worker.running == 0)
+        {
+            Interpreter::Budget left = budget;
+            if (left.time.count() > 0)
+                left.time = std::max(std::chrono::nanoseconds(1), budget.time -
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - spawned));
+            worker.context->interpreter().setBudget(left);
+        }
+
+        struct Running {
+            Worker& worker;
+            explicit Running(Worker& worker) : worker(worker) { ++worker.running; }
+            ~Running() { --worker.running; }
+        } running(worker);
+
+        Token where(TokenType::IDENTIFIER, "spawn", nullptr, static_cast<int>(line));
+        LiteralValue callee = worker.context->global(function);
+        if (!callee.is<FlintFunction>() && !callee.is<VMClosure>())
+            throw RuntimeError(where, "'" + std::string(SymbolTable::name(function)) +
+                                      "' is not a function in the task's program.");
+
+        std::vector<LiteralValue> values;
+        values.reserve(arguments.size());
+        for (const TaskValue& argument : arguments) values.push_back(argument.rebuild(where));
+
+        finish(copyValue(worker.context->call(callee, values, where), where), false, "");
+    } catch (const BudgetExceeded& thrown) {
+        finish({}, true, thrown.what(), true);
+    } catch (const RuntimeError& thrown) {
+        finish({}, true, "Task failed (line " + std::to_string(thrown.token.line) + "): " + thrown.what());
+    } catch (const std::exception& thrown) {
+        finish({}, true, std::string("Task failed: ") + thrown.what());
+    }
+}
+
+void Task::finish(TaskValue value, bool failed, std::string error, bool outOfBudget)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = std::move(value);
+        this->failed = failed;
+        this->outOfBudget = outOfBudget;
+        this->error = std::move(error);
+        done = true;
+    }
+    finished.notify_all();
+}
+
+FlintFuture::FlintFuture(std::shared_ptr<Task> task)
+    : FlintObject(ObjectType::FUTURE), task(std::move(task)) {}
+
+// ─────────────────────────────────────────────────────────────
+// spawn(fn, args...): checks that `fn` is what the program's own
+// global of that name holds – the workers look it up by name –
+// and copies the arguments before queueing the call.
+// ─────────────────────────────────────────────────────────────
+LiteralValue Tasks::spawn(const std::vector<LiteralValue>& args, const Token& paren)
+{
+    Flint* context = Flint::running();
+    if (args.empty() || !context)
+        throw RuntimeError(paren, "spawn() expects a function and its arguments.");
+
+    Symbol name = 0;
+    bool named = false;
+    if (FlintFunction* function = args[0].as<FlintFunction>()) {
+        named = function->declaration->name.has_value();
+        if (named) name = function->declaration->name->symbol;
+    } else if (VMClosure* closure = args[0].as<VMClosure>()) {
+        named = !closure->function->name.empty();
+        if (named) name = SymbolTable::intern(closure->function->name);
+    }
+    if (!named || !context->global(name).isSame(args[0]))
+        throw RuntimeError(paren, "spawn() can only run a function declared at the top level.");
+
+    auto task = std::make_shared<Task>();
+    task->program = context->taskProgram();
+    task->function = name;
+    task->line = paren.line;
+    task->budget = context->interpreter().remainingBudget();
+    task->spawned = std::chrono::steady_clock::now();
+    for (size_t i = 1; i < args.size(); ++i) task->arguments.push_back(copyValue(args[i], paren));
+
+    ThreadPool::instance().submit([task] {
+        if (!task->claimed.exchange(true)) task->run();
+    });
+    return makeRef<FlintFuture>(std::move(task));
+}
+
+// ─────────────────────────────────────────────────────────────
+// await(future): runs the task here if no thread has started it;
+// otherwise helps with queued work until it is done, as long as
+// the awaiting run's deadline allows.  A task that ran out of
+// budget ends the awaiting run as well.
+// ─────────────────────────────────────────────────────────────
+LiteralValue Tasks::await(const LiteralValue& future, const Token& paren)
+{
+    FlintFuture* awaited = future.as<FlintFuture>();
+    if (!awaited) throw RuntimeError(paren, "await() expects a future returned by spawn().");
+    Task& task = *awaited->task;
+
+    if (!task.claimed.exchange(true)) task.run();
+
+    Flint* context = Flint::running();
+    ThreadPool& pool = ThreadPool::instance();
+    std::unique_lock<std::mutex> lock(task.mutex);
+    while (!task.done)
+    {
+        lock.unlock();
+        bool helped = pool.runOne();
+        lock.lock();
+        if (!helped) task.finished.wait_for(lock, std::chrono::milliseconds(1), [&] { return task.done; });
+        if (!task.done && context) context->interpreter().checkDeadline(paren.line);
+    }
+
+    if (task.outOfBudget) throw BudgetExceeded(paren, task.error);
+    if (task.failed) throw RuntimeError(paren, task.error);
+    return task.result.rebuild(paren);
+}
+
+LiteralValue Tasks::joinAll(const LiteralValue& futures, const Token& paren)
+{
+    FlintArray* array = futures.as<FlintArray>();
+    if (!array) throw RuntimeError(paren, "joinAll() expects an array of futures.");
+
+    std::vector<LiteralValue> pending = array->elements;
+    std::vector<LiteralValue> results;
+    results.reserve(pending.size());
+    for (const LiteralValue& future : pending) results.push_back(await(future, paren));
+    return makeRef<FlintArray>(std::move(results));
+}
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include "Flint/ThreadPool.h"
+
+size_t ThreadPool::requestedThreads = 0;
+
+// Index of the pool queue owned by this thread; none for non-workers
+static thread_local size_t workerIndex = SIZE_MAX;
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool(requestedThreads ? requestedThreads
+                                            : std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+void ThreadPool::configure(size_t threads) { requestedThreads = threads; }
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    for (size_t i = 0; i < threads; ++i) queues.push_back(std::make_unique<Queue>());
+    for (size_t i = 0; i + 1 < threads; ++i) workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+// ─────────────────────────────────────────────────────────────
+// Deals the chunks out over every queue, wakes the workers, then
+// helps – with this batch's chunks or anyone else's – until its
+// last chunk is done.
+// ─────────────────────────────────────────────────────────────
+void ThreadPool::parallelFor(size_t count, size_t grain, const Body& body)
+{
+    if (count == 0) return;
+
+    // A few chunks per thread, so stealing can even out uneven ones
+    size_t chunks = std::min((count + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1),
+                             concurrency() * 4);
+    if (chunks <= 1 || workers.empty())
+    {
+        body(0, count);
+        return;
+    }
+
+    Batch batch;
+    batch.body = &body;
+    batch.pending.store(chunks);
+
+    queued.fetch_add(chunks);
+    size_t size = count / chunks, extra = count % chunks, begin = 0;
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        size_t end = begin + size + (i < extra ? 1 : 0);
+        Queue& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({ &batch, begin, end });
+        begin = end;
+    }
+    {
+        // Taking the lock orders this after any worker's check of `queued`
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+
+    size_t home = workerIndex != SIZE_MAX ? workerIndex : queues.size() - 1;
+    Task task;
+    while (batch.pending.load(std::memory_order_acquire) > 0)
+    {
+        if (take(home, task)) run(task);
+        else std::this_thread::yield();
+    }
+
+    if (batch.error) std::rethrow_exception(batch.error);
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+    size_t home = workerIndex != SIZE_MAX ? workerIndex : nextQueue.fetch_add(1) % queues.size();
+    queued.fetch_add(1);
+    {
+        Queue& queue = *queues[home];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({ nullptr, 0, 0, std::move(job) });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::runOne()
+{
+    Task task;
+    if (!take(workerIndex != SIZE_MAX ? workerIndex : queues.size() - 1, task)) return false;
+    run(task);
+    return true;
+}
+
+bool ThreadPool::take(size_t home, Task& task)
+{
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        bool own = i == 0;
+        Queue& queue = *queues[(home + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        if (own) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+// The decrement is the last use of the batch: once it reaches zero the
+// caller may return and destroy it
+void ThreadPool::run(const Task& task)
+{
+    if (!task.batch)
+    {
+        task.job();
+        return;
+    }
+
+    try {
+        (*task.batch->body)(task.begin, task.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(task.batch->mutex);
+        if (!task.batch->error) task.batch->error = std::current_exception();
+    }
+    task.batch->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    workerIndex = index;
+    Task task;
+    for (;;)
+    {
+        if (take(index, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping) return;
+    }
+}
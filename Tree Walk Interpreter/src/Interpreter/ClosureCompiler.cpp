@@ -0,0 +1,854 @@
+#include <cmath>
+#include "Flint/Interpreter/ClosureCompiler.h"
+#include "Flint/Interpreter/Evaluator.h"
+#include "Flint/Exceptions/RuntimeError.h"
+#include "Flint/Callables/Functions/FlintFunction.h"
+#include "Flint/Callables/Classes/FlintInstance.h"
+#include "Flint/FlintArray.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// The interpreter's state, as lowered nodes see it
+// ─────────────────────────────────────────────────────────────────────────────
+struct ClosureCompiler::Access {
+    static std::shared_ptr<Environment>& environment(const Interpreter& interpreter)
+    {
+        return interpreter.environment;
+    }
+    static Environment& globals(const Interpreter& interpreter) { return *interpreter.globals; }
+    static const Evaluator& evaluator(const Interpreter& interpreter) { return *interpreter.evaluator; }
+};
+
+namespace {
+
+using Access = ClosureCompiler::Access;
+
+Environment& scope(const Evaluator& evaluator)
+{
+    return *Access::environment(evaluator.interpreter);
+}
+
+// Runs in `frame` for as long as it lives (Interpreter::executeBlock)
+class EnterScope {
+public:
+    EnterScope(const Interpreter& interpreter, const std::shared_ptr<Environment>& frame)
+        : current(Access::environment(interpreter)), previous(std::move(current))
+    {
+        current = frame;
+    }
+    ~EnterScope() { current = std::move(previous); }
+
+    EnterScope(const EnterScope&) = delete;
+    EnterScope& operator=(const EnterScope&) = delete;
+
+private:
+    std::shared_ptr<Environment>& current;
+    std::shared_ptr<Environment> previous;
+};
+
+// Anything but a normal completion ends the list early
+Completion runAll(const std::vector<const LoweredStmt*>& statements, const Evaluator& evaluator)
+{
+    for (const LoweredStmt* statement : statements)
+    {
+        Completion completion = statement->execute(evaluator);
+        if (completion != Completion::NORMAL) return completion;
+    }
+    return Completion::NORMAL;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Values and variables
+// ─────────────────────────────────────────────────────────────
+struct Constant final : LoweredExpr {
+    LiteralValue value;
+    explicit Constant(LiteralValue value) : value(std::move(value)) {}
+    LiteralValue run(const Evaluator&) const override { return value; }
+};
+
+// A local of the current scope, of an enclosing one, or a global
+struct LocalHere final : LoweredExpr {
+    int slot;
+    explicit LocalHere(int slot) : slot(slot) {}
+    LiteralValue run(const Evaluator& evaluator) const override { return scope(evaluator).at(slot); }
+};
+
+struct LocalOuter final : LoweredExpr {
+    LocalSlot local;
+    explicit LocalOuter(LocalSlot local) : local(local) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return scope(evaluator).getAt(local.depth, local.slot);
+    }
+};
+
+// By the index the site last found the global at, as the Evaluator reads it
+struct GlobalRead final : LoweredExpr {
+    const Token& name;
+    const LocalSlot& local;
+    GlobalRead(const Token& name, const LocalSlot& local) : name(name), local(local) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return Access::globals(evaluator.interpreter).getCached(name, local.global);
+    }
+};
+
+struct Assign final : LoweredExpr {
+    const Assignment& expr;
+    const LoweredExpr* value;
+    Assign(const Assignment& expr, const LoweredExpr* value) : expr(expr), value(value) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue result = value->run(evaluator);
+        if (!expr.local.isGlobal())
+            scope(evaluator).assignAt(expr.local.depth, expr.local.slot, result);
+        else
+            Access::globals(evaluator.interpreter).assignCached(expr.name, result, expr.local.global);
+        return result;
+    }
+};
+
+struct AssignHere final : LoweredExpr {
+    int slot;
+    const LoweredExpr* value;
+    AssignHere(int slot, const LoweredExpr* value) : slot(slot), value(value) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue result = value->run(evaluator);
+        scope(evaluator).defineAt(slot, result);
+        return result;
+    }
+};
+
+// ─────────────────────────────────────────────────────────────
+// Operators
+// A Binary with a fast path runs it on two numbers (a zero divisor
+// excepted); anything else goes to Evaluator::binaryOperation with
+// the operands it evaluated.
+// ─────────────────────────────────────────────────────────────
+struct Add          { static double apply(double a, double b) { return a + b; } };
+struct Subtract     { static double apply(double a, double b) { return a - b; } };
+struct Multiply     { static double apply(double a, double b) { return a * b; } };
+struct Divide       { static double apply(double a, double b) { return a / b; } };
+struct Modulo       { static double apply(double a, double b) { return std::fmod(a, b); } };
+struct Less         { static bool apply(double a, double b) { return a < b; } };
+struct LessEqual    { static bool apply(double a, double b) { return a <= b; } };
+struct Greater      { static bool apply(double a, double b) { return a > b; } };
+struct GreaterEqual { static bool apply(double a, double b) { return a >= b; } };
+struct Equal        { static bool apply(double a, double b) { return a == b; } };
+struct NotEqual     { static bool apply(double a, double b) { return a != b; } };
+
+template <typename Op>
+constexpr bool divides = std::is_same_v<Op, Divide> || std::is_same_v<Op, Modulo>;
+
+// Operands: any lowered expression, a local of the current scope, a number
+struct Operand {
+    const LoweredExpr* code;
+    LiteralValue get(const Evaluator& evaluator) const { return code->run(evaluator); }
+};
+struct SlotOperand {
+    int slot;
+    LiteralValue get(const Evaluator& evaluator) const { return scope(evaluator).at(slot); }
+};
+struct NumberOperand {
+    LiteralValue value;
+    const LiteralValue& get(const Evaluator&) const { return value; }
+};
+
+template <typename Op, typename Left, typename Right>
+struct Arithmetic final : LoweredExpr {
+    const Binary& expr;
+    Left left;
+    Right right;
+    Arithmetic(const Binary& expr, Left left, Right right)
+        : expr(expr), left(std::move(left)), right(std::move(right)) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue a = left.get(evaluator);
+        LiteralValue b = right.get(evaluator);
+        if (a.isNumber() && b.isNumber() && (!divides<Op> || b.asNumber() != 0))
+            return Op::apply(a.asNumber(), b.asNumber());
+        return evaluator.binaryOperation(expr, a, b);
+    }
+};
+
+struct GenericBinary final : LoweredExpr {
+    const Binary& expr;
+    const LoweredExpr* left;
+    const LoweredExpr* right;
+    GenericBinary(const Binary& expr, const LoweredExpr* left, const LoweredExpr* right)
+        : expr(expr), left(left), right(right) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue a = left->run(evaluator);
+        return evaluator.binaryOperation(expr, a, right->run(evaluator));
+    }
+};
+
+template <bool Or>
+struct LogicalNode final : LoweredExpr {
+    const LoweredExpr* left;
+    const LoweredExpr* right;
+    LogicalNode(const LoweredExpr* left, const LoweredExpr* right) : left(left), right(right) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue value = left->run(evaluator);
+        if (Evaluator::isTruthy(value) == Or) return value;
+        return right->run(evaluator);
+    }
+};
+
+struct ConditionalNode final : LoweredExpr {
+    const LoweredExpr* condition;
+    const LoweredExpr* left;
+    const LoweredExpr* right;
+    ConditionalNode(const LoweredExpr* condition, const LoweredExpr* left, const LoweredExpr* right)
+        : condition(condition), left(left), right(right) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return Evaluator::isTruthy(condition->run(evaluator)) ? left->run(evaluator)
+                                                              : right->run(evaluator);
+    }
+};
+
+struct Negate final : LoweredExpr {
+    const Unary& expr;
+    const LoweredExpr* right;
+    Negate(const Unary& expr, const LoweredExpr* right) : expr(expr), right(right) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue value = right->run(evaluator);
+        if (value.isNumber()) return -value.asNumber();
+        return evaluator.unaryOperation(expr, value);
+    }
+};
+
+struct Not final : LoweredExpr {
+    const LoweredExpr* right;
+    explicit Not(const LoweredExpr* right) : right(right) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return !Evaluator::isTruthy(right->run(evaluator));
+    }
+};
+
+// ─────────────────────────────────────────────────────────────
+// Functions, calls and objects
+// ─────────────────────────────────────────────────────────────
+struct LambdaNode final : LoweredExpr {
+    const FunctionStmt* function;
+    explicit LambdaNode(const FunctionStmt* function) : function(function) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return makeRef<FlintFunction>(function, Access::environment(evaluator.interpreter));
+    }
+};
+
+template <bool Tail>
+struct CallNode final : LoweredExpr {
+    const Call& expr;
+    const LoweredExpr* object;
+    const LoweredExpr* callee;
+    std::vector<const LoweredExpr*> arguments;
+    CallNode(const Call& expr, const LoweredExpr* object, const LoweredExpr* callee,
+             std::vector<const LoweredExpr*> arguments)
+        : expr(expr), object(object), callee(callee), arguments(std::move(arguments)) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return evaluator.call<Tail>(expr, LoweredCall{evaluator, object, callee, arguments});
+    }
+};
+
+struct GetNode final : LoweredExpr {
+    const Get& expr;
+    const LoweredExpr* object;
+    GetNode(const Get& expr, const LoweredExpr* object) : expr(expr), object(object) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        return evaluator.getProperty(object->run(evaluator), expr);
+    }
+};
+
+struct SetNode final : LoweredExpr {
+    const Set& expr;
+    const LoweredExpr* object;
+    const LoweredExpr* value;
+    SetNode(const Set& expr, const LoweredExpr* object, const LoweredExpr* value)
+        : expr(expr), object(object), value(value) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue target = object->run(evaluator);
+        FlintInstance* instance = target.as<FlintInstance>();
+        if (!instance) throw RuntimeError(expr.name, "Only instances have fields.");
+
+        LiteralValue result = value->run(evaluator);
+        instance->set(expr.name, result, expr.cache);
+        return result;
+    }
+};
+
+// No operands to lower: the Evaluator's visitor runs directly
+struct SuperNode final : LoweredExpr {
+    const Super& expr;
+    explicit SuperNode(const Super& expr) : expr(expr) {}
+    LiteralValue run(const Evaluator& evaluator) const override { return evaluator(expr); }
+};
+
+struct ArrayNode final : LoweredExpr {
+    std::vector<const LoweredExpr*> elements;
+    explicit ArrayNode(std::vector<const LoweredExpr*> elements) : elements(std::move(elements)) {}
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        std::vector<LiteralValue> values;
+        values.reserve(elements.size());
+        for (const LoweredExpr* element : elements) values.push_back(element->run(evaluator));
+        return makeRef<FlintArray>(std::move(values));
+    }
+};
+
+// Arrays read and written in bounds directly; everything else (and
+// every error) through the Evaluator's index operations
+struct GetIndexNode final : LoweredExpr {
+    const GetIndex& expr;
+    const LoweredExpr* array;
+    const LoweredExpr* index;
+    GetIndexNode(const GetIndex& expr, const LoweredExpr* array, const LoweredExpr* index)
+        : expr(expr), array(array), index(index) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue target = array->run(evaluator);
+        LiteralValue at = index->run(evaluator);
+        if (FlintArray* arr = target.as<FlintArray>(); arr && at.isNumber()) {
+            int i = static_cast<int>(at.asNumber());
+            if (i >= 0 && i < static_cast<int>(arr->elements.size())) return arr->elements[i];
+        }
+        return evaluator.getIndexOperation(expr, target, at);
+    }
+};
+
+struct SetIndexNode final : LoweredExpr {
+    const SetIndex& expr;
+    const LoweredExpr* array;
+    const LoweredExpr* index;
+    const LoweredExpr* value;
+    SetIndexNode(const SetIndex& expr, const LoweredExpr* array, const LoweredExpr* index,
+                 const LoweredExpr* value)
+        : expr(expr), array(array), index(index), value(value) {}
+
+    LiteralValue run(const Evaluator& evaluator) const override
+    {
+        LiteralValue target = array->run(evaluator);
+        LiteralValue at = index->run(evaluator);
+        LiteralValue result = value->run(evaluator);
+        if (FlintArray* arr = target.as<FlintArray>(); arr && at.isNumber()) {
+            int i = static_cast<int>(at.asNumber());
+            if (i >= 0 && i < static_cast<int>(arr->elements.size())) {
+                arr->elements[i] = result;
+                return result;
+            }
+        }
+        return evaluator.setIndexOperation(expr, target, at, result);
+    }
+};
+
+// ─────────────────────────────────────────────────────────────
+// Statements
+// ─────────────────────────────────────────────────────────────
+struct Sequence final : LoweredStmt {
+    std::vector<const LoweredStmt*> statements;
+    Sequence(size_t line, std::vector<const LoweredStmt*> statements)
+        : LoweredStmt(line), statements(std::move(statements)) {}
+    Completion run(const Evaluator& evaluator) const override { return runAll(statements, evaluator); }
+};
+
+struct ExpressionStatement final : LoweredStmt {
+    const LoweredExpr* expression;
+    ExpressionStatement(size_t line, const LoweredExpr* expression)
+        : LoweredStmt(line), expression(expression) {}
+    Completion run(const Evaluator& evaluator) const override
+    {
+        expression->run(evaluator);
+        return Completion::NORMAL;
+    }
+};
+
+struct FunctionNode final : LoweredStmt {
+    const FunctionStmt& stmt;
+    explicit FunctionNode(const FunctionStmt& stmt) : LoweredStmt(stmt.line), stmt(stmt) {}
+    Completion run(const Evaluator& evaluator) const override
+    {
+        const Interpreter& interpreter = evaluator.interpreter;
+        interpreter.declare(*stmt.name, stmt.slot,
+                            makeRef<FlintFunction>(&stmt, Access::environment(interpreter)));
+        return Completion::NORMAL;
+    }
+};
+
+// The Interpreter's visitor runs it; its methods' bodies are lowered
+// when they are first called
+struct ClassNode final : LoweredStmt {
+    const ClassStmt& stmt;
+    explicit ClassNode(const ClassStmt& stmt) : LoweredStmt(stmt.line), stmt(stmt) {}
+    Completion run(const Evaluator& evaluator) const override { return evaluator.interpreter(stmt); }
+};
+
+struct LetNode final : LoweredStmt {
+    struct Declaration {
+        const Token& name;
+        int slot;                    // -1: a global
+        const LoweredExpr* value;    // nullptr: nil
+    };
+    std::vector<Declaration> declarations;
+    LetNode(size_t line, std::vector<Declaration> declarations)
+        : LoweredStmt(line), declarations(std::move(declarations)) {}
+
+    Completion run(const Evaluator& evaluator) const override
+    {
+        for (const Declaration& declaration : declarations)
+        {
+            LiteralValue value = declaration.value ? declaration.value->run(evaluator)
+                                                   : LiteralValue(nullptr);
+            evaluator.interpreter.declare(declaration.name, declaration.slot, std::move(value));
+        }
+        return Completion::NORMAL;
+    }
+};
+
+struct LetHere final : LoweredStmt {
+    int slot;
+    const LoweredExpr* value;
+    LetHere(size_t line, int slot, const LoweredExpr* value)
+        : LoweredStmt(line), slot(slot), value(value) {}
+    Completion run(const Evaluator& evaluator) const override
+    {
+        LiteralValue result = value ? value->run(evaluator) : LiteralValue(nullptr);
+        scope(evaluator).defineAt(slot, std::move(result));
+        return Completion::NORMAL;
+    }
+};
+
+struct BlockNode final : LoweredStmt {
+    const BlockStmt& stmt;
+    std::vector<const LoweredStmt*> statements;
+    BlockNode(const BlockStmt& stmt, std::vector<const LoweredStmt*> statements)
+        : LoweredStmt(stmt.line), stmt(stmt), statements(std::move(statements)) {}
+
+    Completion run(const Evaluator& evaluator) const override
+    {
+        const Interpreter& interpreter = evaluator.interpreter;
+        Interpreter::Frame frame(interpreter, Access::environment(interpreter),
+                                 stmt.slotCount, stmt.isCaptured);
+        EnterScope enter(interpreter, frame.environment());
+        return runAll(statements, evaluator);
+    }
+};
+
+struct IfNode final : LoweredStmt {
+    const LoweredExpr* condition;
+    const LoweredStmt* thenBranch;
+    const LoweredStmt* elseBranch;
+    IfNode(size_t line, const LoweredExpr* condition, const LoweredStmt* thenBranch,
+           const LoweredStmt* elseBranch)
+        : LoweredStmt(line), condition(condition), thenBranch(thenBranch), elseBranch(elseBranch) {}
+
+    Completion run(const Evaluator& evaluator) const override
+    {
+        if (Evaluator::isTruthy(condition->run(evaluator))) return thenBranch->execute(evaluator);
+        if (elseBranch) return elseBranch->execute(evaluator);
+        return Completion::NORMAL;
+    }
+};
+
+struct WhileNode final : LoweredStmt {
+    const LoweredExpr* condition;
+    const LoweredStmt* body;
+    WhileNode(size_t line, const LoweredExpr* condition, const LoweredStmt* body)
+        : LoweredStmt(line), condition(condition), body(body) {}
+
+    Completion run(const Evaluator& evaluator) const override
+    {
+        while (Evaluator::isTruthy(condition->run(evaluator)))
+        {
+            evaluator.interpreter.step(line);
+            Completion completion = body->execute(evaluator);
+            if (completion == Completion::RETURN) return completion;
+            if (completion == Completion::BREAK) break;
+        }
+        return Completion::NORMAL;
+    }
+};
+
+// Interpreter::operator()(ForStmt), executeFor and forCondition: a counted
+// loop compares and bumps its counter in place while it holds a number
+struct ForNode final : LoweredStmt {
+    const ForStmt& stmt;
+    const LoweredStmt* initializer;
+    const LoweredExpr* condition;
+    const LoweredExpr* increment;
+    const LoweredStmt* body;
+    const Binary* test;            // The condition of a counted loop
+    const LoweredExpr* limit;      // Its right operand
+
+    ForNode(const ForStmt& stmt, const LoweredStmt* initializer, const LoweredExpr* condition,
+            const LoweredExpr* increment, const LoweredStmt* body, const Binary* test,
+            const LoweredExpr* limit)
+        : LoweredStmt(stmt.line), stmt(stmt), initializer(initializer), condition(condition),
+          increment(increment), body(body), test(test), limit(limit) {}
+
+    Completion run(const Evaluator& evaluator) const override
+    {
+        if (!stmt.hasScope) return loop(evaluator);
+
+        const Interpreter& interpreter = evaluator.interpreter;
+        Interpreter::Frame frame(interpreter, Access::environment(interpreter),
+                                 stmt.slotCount, stmt.isCaptured);
+        EnterScope enter(interpreter, frame.environment());
+        return loop(evaluator);
+    }
+
+    Completion loop(const Evaluator& evaluator) const
+    {
+        if (initializer) initializer->execute(evaluator);
+
+        while (!condition || holds(evaluator))
+        {
+            evaluator.interpreter.step(stmt.line);
+
+            // `continue` only skips the rest of the body; the increment still runs
+            Completion completion = body->execute(evaluator);
+            if (completion == Completion::RETURN) return completion;
+            if (completion == Completion::BREAK) break;
+
+            if (!increment) continue;
+
+            if (stmt.counterSlot >= 0)
+            {
+                Environment& environment = scope(evaluator);
+                const LiteralValue& counter = environment.at(stmt.counterSlot);
+                if (counter.isNumber())
+                {
+                    environment.defineAt(stmt.counterSlot, counter.asNumber() + stmt.step);
+                    continue;
+                }
+            }
+            increment->run(evaluator);
+        }
+        return Completion::NORMAL;
+    }
+
+    bool holds(const Evaluator& evaluator) const
+    {
+        if (!test) return Evaluator::isTruthy(condition->run(evaluator));
+
+        LiteralValue counter = scope(evaluator).at(stmt.counterSlot);
+        LiteralValue bound = limit->run(evaluator);
+        if (!counter.isNumber() || !bound.isNumber())
+            return Evaluator::isTruthy(evaluator.binaryOperation(*test, counter, bound));
+
+        double i = counter.asNumber(), n = bound.asNumber();
+        switch (test->op.type)
+        {
+            case TokenType::LESS:          return i < n;
+            case TokenType::LESS_EQUAL:    return i <= n;
+            case TokenType::GREATER:       return i > n;
+            case TokenType::GREATER_EQUAL: return i >= n;
+            default: return Evaluator::isTruthy(evaluator.binaryOperation(*test, counter, bound));
+        }
+    }
+};
+
+// The value waits in returnValue until the call that is returning takes
+// it; a returned call was lowered as a tail call
+struct ReturnNode final : LoweredStmt {
+    const LoweredExpr* value;      // nullptr: nil
+    ReturnNode(size_t line, const LoweredExpr* value) : LoweredStmt(line), value(value) {}
+    Completion run(const Evaluator& evaluator) const override
+    {
+        evaluator.interpreter.returnValue = value ? value->run(evaluator) : LiteralValue(nullptr);
+        return Completion::RETURN;
+    }
+};
+
+template <typename Node, Completion Jump>
+struct JumpNode final : LoweredStmt {
+    const Node& stmt;
+    explicit JumpNode(const Node& stmt) : LoweredStmt(stmt.line), stmt(stmt) {}
+    Completion run(const Evaluator&) const override
+    {
+        if (!stmt.insideLoop)
+            throw RuntimeError(stmt.keyword, Jump == Completion::BREAK
+                ? "Cannot use 'break' outside of a loop" : "Cannot use 'continue' outside of a loop");
+        return Jump;
+    }
+};
+
+// The slot of `expr` if it reads a local of the current scope, else -1
+int slotHere(ExprPtr expr)
+{
+    const Variable* variable = std::get_if<Variable>(expr);
+    return variable && variable->local.depth == 0 ? variable->local.slot : -1;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Entry points
+// ─────────────────────────────────────────────────────────────────────────────
+const LoweredStmt* ClosureCompiler::lower(const Statement& statement)
+{
+    return std::visit([this](const auto& stmt) { return lowerStmt(stmt); }, statement);
+}
+
+Completion ClosureCompiler::runBody(const Interpreter& interpreter, const FunctionStmt& function,
+    const std::shared_ptr<Environment>& frame)
+{
+    if (!function.lowered) function.lowered = make<Sequence>(function.line, lower(function.body));
+
+    EnterScope enter(interpreter, frame);
+    return function.lowered->run(Access::evaluator(interpreter));
+}
+
+const LoweredExpr* ClosureCompiler::lower(ExprPtr expr)
+{
+    if (!expr) return make<Constant>(std::monostate{});
+    return std::visit([this](const auto& node) { return lowerExpr(node); }, *expr);
+}
+
+std::vector<const LoweredStmt*> ClosureCompiler::lower(const std::vector<StmtPtr>& statements)
+{
+    std::vector<const LoweredStmt*> lowered;
+    lowered.reserve(statements.size());
+    for (StmtPtr statement : statements) lowered.push_back(lower(*statement));
+    return lowered;
+}
+
+std::vector<const LoweredExpr*> ClosureCompiler::lower(const std::vector<ExprPtr>& expressions)
+{
+    std::vector<const LoweredExpr*> lowered;
+    lowered.reserve(expressions.size());
+    for (ExprPtr expression : expressions) lowered.push_back(lower(expression));
+    return lowered;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Expressions
+// ─────────────────────────────────────────────────────────────────────────────
+const LoweredExpr* ClosureCompiler::lowerRead(const Token& name, const LocalSlot& local)
+{
+    if (local.isGlobal()) return make<GlobalRead>(name, local);
+    if (local.depth == 0) return make<LocalHere>(local.slot);
+    return make<LocalOuter>(local);
+}
+
+// The operands a node is specialized for: a local of the current scope
+// on the left, one or a number on the right
+template <typename Op>
+const LoweredExpr* ClosureCompiler::lowerArithmetic(const Binary& expr)
+{
+    const Literal* literal = std::get_if<Literal>(expr.right);
+    bool number = literal && literal->value.isNumber();
+    int left = slotHere(expr.left);
+    int right = slotHere(expr.right);
+
+    if (left >= 0)
+    {
+        if (number)
+            return make<Arithmetic<Op, SlotOperand, NumberOperand>>(
+                expr, SlotOperand{left}, NumberOperand{literal->value});
+        if (right >= 0)
+            return make<Arithmetic<Op, SlotOperand, SlotOperand>>(
+                expr, SlotOperand{left}, SlotOperand{right});
+        return make<Arithmetic<Op, SlotOperand, Operand>>(
+            expr, SlotOperand{left}, Operand{lower(expr.right)});
+    }
+
+    const LoweredExpr* code = lower(expr.left);
+    if (number)
+        return make<Arithmetic<Op, Operand, NumberOperand>>(
+            expr, Operand{code}, NumberOperand{literal->value});
+    return make<Arithmetic<Op, Operand, Operand>>(expr, Operand{code}, Operand{lower(expr.right)});
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Binary& expr)
+{
+    switch (expr.op.type)
+    {
+        case TokenType::PLUS:          return lowerArithmetic<Add>(expr);
+        case TokenType::MINUS:         return lowerArithmetic<Subtract>(expr);
+        case TokenType::STAR:          return lowerArithmetic<Multiply>(expr);
+        case TokenType::SLASH:         return lowerArithmetic<Divide>(expr);
+        case TokenType::MODULO:        return lowerArithmetic<Modulo>(expr);
+        case TokenType::LESS:          return lowerArithmetic<Less>(expr);
+        case TokenType::LESS_EQUAL:    return lowerArithmetic<LessEqual>(expr);
+        case TokenType::GREATER:       return lowerArithmetic<Greater>(expr);
+        case TokenType::GREATER_EQUAL: return lowerArithmetic<GreaterEqual>(expr);
+        case TokenType::EQUAL_EQUAL:   return lowerArithmetic<Equal>(expr);
+        case TokenType::BANG_EQUAL:    return lowerArithmetic<NotEqual>(expr);
+        default:
+        {
+            const LoweredExpr* left = lower(expr.left);
+            return make<GenericBinary>(expr, left, lower(expr.right));
+        }
+    }
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Logical& expr)
+{
+    const LoweredExpr* left = lower(expr.left);
+    if (expr.op.type == TokenType::OR) return make<LogicalNode<true>>(left, lower(expr.right));
+    return make<LogicalNode<false>>(left, lower(expr.right));
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Conditional& expr)
+{
+    const LoweredExpr* condition = lower(expr.condition);
+    const LoweredExpr* left = lower(expr.left);
+    return make<ConditionalNode>(condition, left, lower(expr.right));
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Unary& expr)
+{
+    if (expr.op.type == TokenType::MINUS) return make<Negate>(expr, lower(expr.right));
+    if (expr.op.type == TokenType::BANG) return make<Not>(lower(expr.right));
+    return make<Constant>(std::monostate{});
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Literal& expr) { return make<Constant>(expr.value); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Grouping& expr) { return lower(expr.expression); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Variable& expr) { return lowerRead(expr.name, expr.local); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Assignment& expr)
+{
+    const LoweredExpr* value = lower(expr.value);
+    if (expr.local.depth == 0) return make<AssignHere>(expr.local.slot, value);
+    return make<Assign>(expr, value);
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Lambda& expr) { return make<LambdaNode>(expr.function); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Call& expr) { return lowerCall<false>(expr); }
+
+template <bool Tail>
+const LoweredExpr* ClosureCompiler::lowerCall(const Call& expr)
+{
+    const LoweredExpr* object = nullptr;
+    const LoweredExpr* callee = nullptr;
+    if (const Get* get = std::get_if<Get>(expr.callee)) object = lower(get->object);
+    else if (!std::holds_alternative<Super>(*expr.callee)) callee = lower(expr.callee);
+    return make<CallNode<Tail>>(expr, object, callee, lower(expr.arguments));
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Get& expr) { return make<GetNode>(expr, lower(expr.object)); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Set& expr)
+{
+    const LoweredExpr* object = lower(expr.object);
+    return make<SetNode>(expr, object, lower(expr.value));
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const This& expr) { return lowerRead(expr.keyword, expr.local); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Super& expr) { return make<SuperNode>(expr); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const Array& expr) { return make<ArrayNode>(lower(expr.elements)); }
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const GetIndex& expr)
+{
+    const LoweredExpr* array = lower(expr.array);
+    return make<GetIndexNode>(expr, array, lower(expr.index));
+}
+
+const LoweredExpr* ClosureCompiler::lowerExpr(const SetIndex& expr)
+{
+    const LoweredExpr* array = lower(expr.array);
+    const LoweredExpr* index = lower(expr.index);
+    return make<SetIndexNode>(expr, array, index, lower(expr.value));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Statements
+// ─────────────────────────────────────────────────────────────────────────────
+const LoweredStmt* ClosureCompiler::lowerStmt(const ExpressionStmt& stmt)
+{
+    return make<ExpressionStatement>(stmt.line, lower(stmt.expression));
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const FunctionStmt& stmt) { return make<FunctionNode>(stmt); }
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const WhileStmt& stmt)
+{
+    const LoweredExpr* condition = lower(stmt.condition);
+    return make<WhileNode>(stmt.line, condition, lower(*stmt.statement));
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const ReturnStmt& stmt)
+{
+    const LoweredExpr* value = nullptr;
+    if (const Call* call = stmt.val ? std::get_if<Call>(stmt.val) : nullptr) value = lowerCall<true>(*call);
+    else if (stmt.val) value = lower(stmt.val);
+    return make<ReturnNode>(stmt.line, value);
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const BreakStmt& stmt)
+{
+    return make<JumpNode<BreakStmt, Completion::BREAK>>(stmt);
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const ContinueStmt& stmt)
+{
+    return make<JumpNode<ContinueStmt, Completion::CONTINUE>>(stmt);
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const ForStmt& stmt)
+{
+    const LoweredStmt* initializer = stmt.initializer ? lower(*stmt.initializer) : nullptr;
+    const LoweredExpr* condition = stmt.condition ? lower(stmt.condition) : nullptr;
+    const LoweredExpr* increment = stmt.increment ? lower(stmt.increment) : nullptr;
+    const LoweredStmt* body = lower(*stmt.body);
+
+    const Binary* test = stmt.counterSlot >= 0 ? std::get_if<Binary>(stmt.condition) : nullptr;
+    const LoweredExpr* limit = test ? lower(test->right) : nullptr;
+    return make<ForNode>(stmt, initializer, condition, increment, body, test, limit);
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const IfStmt& stmt)
+{
+    const LoweredExpr* condition = lower(stmt.condition);
+    const LoweredStmt* thenBranch = lower(*stmt.thenBranch);
+    const LoweredStmt* elseBranch = stmt.elseBranch ? lower(*stmt.elseBranch) : nullptr;
+    return make<IfNode>(stmt.line, condition, thenBranch, elseBranch);
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const LetStmt& stmt)
+{
+    auto valueOf = [this](ExprPtr initializer) { return initializer ? lower(initializer) : nullptr; };
+
+    if (stmt.declarations.size() == 1 && !stmt.slots.empty())
+        return make<LetHere>(stmt.line, stmt.slots[0], valueOf(stmt.declarations[0].second));
+
+    std::vector<LetNode::Declaration> declarations;
+    for (size_t i = 0; i < stmt.declarations.size(); ++i)
+    {
+        const auto& [name, initializer] = stmt.declarations[i];
+        declarations.push_back({name, stmt.slots.empty() ? -1 : stmt.slots[i], valueOf(initializer)});
+    }
+    return make<LetNode>(stmt.line, std::move(declarations));
+}
+
+// A block that declares nothing has no scope of its own
+const LoweredStmt* ClosureCompiler::lowerStmt(const BlockStmt& stmt)
+{
+    if (!stmt.hasScope) return make<Sequence>(stmt.line, lower(stmt.statements));
+    return make<BlockNode>(stmt, lower(stmt.statements));
+}
+
+const LoweredStmt* ClosureCompiler::lowerStmt(const ClassStmt& stmt) { return make<ClassNode>(stmt); }
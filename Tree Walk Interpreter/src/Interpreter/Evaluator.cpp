@@ -8,19 +8,89 @@
 #include "Flint/Callables/Classes/FlintInstance.h"
 #include "Flint/Callables/Classes/FlintClass.h"
 #include "Flint/FlintArray.h"
+#include "Flint/FlintFile.h"
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintMap.h"
+#include "Flint/FlintStringBuilder.h"
+#include "Flint/FlintMath.h"
 #include "Flint/Callables/Functions/BuiltInFunction.h"
 #include "Flint/FlintString.h"
+#include "Flint/Interpreter/ClosureCompiler.h"
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Binary Expression Evaluation
 // Handles expressions like a + b, x > y, etc.
+//
+// A quickened site (see Binary::Quickened) runs its specialized operation
+// behind a single guard.  Sites that are not specialized, and operands
+// that fail the guard, go to binaryOperation, the generic path.
 // ─────────────────────────────────────────────────────────────────────────────
 LiteralValue Evaluator::operator()(const Binary& expr) const 
 {
+    using Q = Binary::Quickened;
+
     LiteralValue left = evaluate(expr.left);
     LiteralValue right = evaluate(expr.right);
+    bool numbers = left.isNumber() && right.isNumber();
+
+    switch (expr.quickened)
+    {
+        case Q::ADD_NUMBERS:           if (numbers) return left.asNumber() + right.asNumber(); break;
+        case Q::SUBTRACT_NUMBERS:      if (numbers) return left.asNumber() - right.asNumber(); break;
+        case Q::MULTIPLY_NUMBERS:      if (numbers) return left.asNumber() * right.asNumber(); break;
+        case Q::LESS_NUMBERS:          if (numbers) return left.asNumber() < right.asNumber(); break;
+        case Q::LESS_EQUAL_NUMBERS:    if (numbers) return left.asNumber() <= right.asNumber(); break;
+        case Q::GREATER_NUMBERS:       if (numbers) return left.asNumber() > right.asNumber(); break;
+        case Q::GREATER_EQUAL_NUMBERS: if (numbers) return left.asNumber() >= right.asNumber(); break;
+        case Q::EQUAL_NUMBERS:         if (numbers) return left.asNumber() == right.asNumber(); break;
+        case Q::NOT_EQUAL_NUMBERS:     if (numbers) return left.asNumber() != right.asNumber(); break;
+
+        // A zero divisor passes the guard but needs the generic error
+        case Q::DIVIDE_NUMBERS:
+            if (numbers && right.asNumber() != 0) return left.asNumber() / right.asNumber();
+            break;
+        case Q::MODULO_NUMBERS:
+            if (numbers && right.asNumber() != 0) return std::fmod(left.asNumber(), right.asNumber());
+            break;
+
+        case Q::CONCAT_STRINGS:
+        {
+            FlintString* lstr = left.as<FlintString>();
+            FlintString* rstr = right.as<FlintString>();
+            if (!lstr || !rstr) break;
+
+            std::string text;
+            text.reserve(lstr->value.size() + rstr->value.size());
+            text += lstr->value;
+            text += rstr->value;
+            return makeRef<FlintString>(std::move(text));
+        }
+
+        case Q::UNSEEN:
+            expr.quickened = quicken(expr, left, right);
+            return binaryOperation(expr, left, right);
+
+        case Q::GENERIC:
+            return binaryOperation(expr, left, right);
+    }
+
+    // Guard failed: this site sees more than one kind of operand
+    if (!(numbers && expr.quickened <= Q::NOT_EQUAL_NUMBERS))
+        expr.quickened = Q::GENERIC;
+    return binaryOperation(expr, left, right);
+}
+
+// Generic binary operation: dispatches on the operator, then on the operand types
+LiteralValue Evaluator::binaryOperation(const Binary& expr,
+    const LiteralValue& left, const LiteralValue& right) const
+{
     std::string message;
 
+    // vec3/quat/mat4 have their own operators; '+' with a string still concatenates
+    if ((FlintMath::isMath(left) || FlintMath::isMath(right)) && expr.op.type != TokenType::COMMA
+        && !(expr.op.type == TokenType::PLUS && (left.is<FlintString>() || right.is<FlintString>())))
+        return FlintMath::binary(expr.op.type, left, right, expr.op);
+
     switch (expr.op.type) 
     {
         // Comma expression: evaluate both but return the right value
@@ -29,24 +99,11 @@ LiteralValue Evaluator::operator()(const Binary& expr) const
             
         // Arithmetic + string concatenation
         case TokenType::PLUS:
-            if(std::holds_alternative<double>(left) && std::holds_alternative<double>(right))
-                return std::get<double>(left) + std::get<double>(right);
-            // If either is a string, convert both to strings and concatenate
-            else if (std::holds_alternative<std::shared_ptr<FlintString>>(left) || 
-                std::holds_alternative<std::shared_ptr<FlintString>>(right))
-            {
-                // Convert left to string if it's not already
-                std::string lstr = std::holds_alternative<std::shared_ptr<FlintString>>(left) 
-                                   ? std::get<std::shared_ptr<FlintString>>(left)->value
-                                   : Interpreter::stringify(left);  // fallback to number, bool, etc.
-
-                // Convert right to string if it's not already
-                std::string rstr = std::holds_alternative<std::shared_ptr<FlintString>>(right) 
-                                   ? std::get<std::shared_ptr<FlintString>>(right)->value
-                                   : Interpreter::stringify(right);
-
-                return std::make_shared<FlintString>(lstr + rstr);
-            }
+            if(left.isNumber() && right.isNumber())
+                return left.asNumber() + right.asNumber();
+            // If either is a string, concatenate the text of both
+            else if (left.is<FlintString>() || right.is<FlintString>())
+                return FlintString::concat(left, right);
 
             message = "Operands to '+' must be both numbers or at least one string.";;
             throw RuntimeError(expr.op, message); 
@@ -54,55 +111,55 @@ LiteralValue Evaluator::operator()(const Binary& expr) const
         // Arithmetic operations
         case TokenType::MINUS:
             checkOperandType(expr.op, left, right);
-            return std::get<double>(left) - std::get<double>(right);
+            return left.asNumber() - right.asNumber();
 
         case TokenType::STAR:
             checkOperandType(expr.op, left, right);
-            return std::get<double>(left) * std::get<double>(right);
+            return left.asNumber() * right.asNumber();
 
         case TokenType::SLASH:
             checkOperandType(expr.op, left, right);
-            if (std::get<double>(right) == 0) {
+            if (right.asNumber() == 0) {
                 message = "divide by zero? seriously? who gave this kid a computer.";
                 throw RuntimeError(expr.op, message);
             }
-            return std::get<double>(left) / std::get<double>(right);
+            return left.asNumber() / right.asNumber();
 
         case TokenType::MODULO:
             checkOperandType(expr.op, left, right);
-            if (std::get<double>(right) == 0) {
+            if (right.asNumber() == 0) {
                 message = "divide by zero? seriously? who gave this kid a computer.";
                 throw RuntimeError(expr.op, message);
             }
-            return std::fmod(std::get<double>(left), std::get<double>(right));
+            return std::fmod(left.asNumber(), right.asNumber());
 
         // Comparison operators
         case TokenType::GREATER:
-            if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right))
-                return std::get<double>(left) > std::get<double>(right);
-            if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right))
-                return std::get<std::string>(left) > std::get<std::string>(right);
+            if (left.isNumber() && right.isNumber())
+                return left.asNumber() > right.asNumber();
+            if (left.is<FlintString>() && right.is<FlintString>())
+                return left.as<FlintString>()->value > right.as<FlintString>()->value;
             throw RuntimeError(expr.op, message);
 
         case TokenType::GREATER_EQUAL:
-            if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right))
-                return std::get<double>(left) >= std::get<double>(right);
-            if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right))
-                return std::get<std::string>(left) >= std::get<std::string>(right);
+            if (left.isNumber() && right.isNumber())
+                return left.asNumber() >= right.asNumber();
+            if (left.is<FlintString>() && right.is<FlintString>())
+                return left.as<FlintString>()->value >= right.as<FlintString>()->value;
             throw RuntimeError(expr.op, message);
 
         case TokenType::LESS:
-            if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right))
-                return std::get<double>(left) < std::get<double>(right);
-            if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right))
-                return std::get<std::string>(left) < std::get<std::string>(right);
+            if (left.isNumber() && right.isNumber())
+                return left.asNumber() < right.asNumber();
+            if (left.is<FlintString>() && right.is<FlintString>())
+                return left.as<FlintString>()->value < right.as<FlintString>()->value;
             throw RuntimeError(expr.op, message);
 
         case TokenType::LESS_EQUAL:
-            if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right))
-                return std::get<double>(left) <= std::get<double>(right);
-            if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right))
-                return std::get<std::string>(left) <= std::get<std::string>(right);
+            if (left.isNumber() && right.isNumber())
+                return left.asNumber() <= right.asNumber();
+            if (left.is<FlintString>() && right.is<FlintString>())
+                return left.as<FlintString>()->value <= right.as<FlintString>()->value;
             throw RuntimeError(expr.op, message);
 
         // Equality
@@ -118,6 +175,38 @@ LiteralValue Evaluator::operator()(const Binary& expr) const
     return std::monostate{}; // Fallback for unsupported operators
 }
 
+// Chooses the specialization matching the operand types of a site's first
+// evaluation.  A zero divisor later does not undo a division site's
+// specialization; that one evaluation just takes the generic path to its error.
+Binary::Quickened Evaluator::quicken(const Binary& expr,
+    const LiteralValue& left, const LiteralValue& right)
+{
+    using Q = Binary::Quickened;
+
+    if (left.isNumber() && right.isNumber())
+    {
+        switch (expr.op.type)
+        {
+            case TokenType::PLUS:          return Q::ADD_NUMBERS;
+            case TokenType::MINUS:         return Q::SUBTRACT_NUMBERS;
+            case TokenType::STAR:          return Q::MULTIPLY_NUMBERS;
+            case TokenType::SLASH:         return Q::DIVIDE_NUMBERS;
+            case TokenType::MODULO:        return Q::MODULO_NUMBERS;
+            case TokenType::LESS:          return Q::LESS_NUMBERS;
+            case TokenType::LESS_EQUAL:    return Q::LESS_EQUAL_NUMBERS;
+            case TokenType::GREATER:       return Q::GREATER_NUMBERS;
+            case TokenType::GREATER_EQUAL: return Q::GREATER_EQUAL_NUMBERS;
+            case TokenType::EQUAL_EQUAL:   return Q::EQUAL_NUMBERS;
+            case TokenType::BANG_EQUAL:    return Q::NOT_EQUAL_NUMBERS;
+            default:                       return Q::GENERIC;
+        }
+    }
+    if (expr.op.type == TokenType::PLUS && left.is<FlintString>() && right.is<FlintString>())
+        return Q::CONCAT_STRINGS;
+
+    return Q::GENERIC;
+}
+
 LiteralValue Evaluator::operator()(const Logical& expr) const
 {
     LiteralValue left = evaluate(expr.left);
@@ -148,12 +237,16 @@ LiteralValue Evaluator::operator()(const Conditional& expr) const
 // ─────────────────────────────────────────────────────────────────────────────
 LiteralValue Evaluator::operator()(const Unary& expr) const 
 {
-    LiteralValue right = evaluate(expr.right);
+    return unaryOperation(expr, evaluate(expr.right));
+}
 
+LiteralValue Evaluator::unaryOperation(const Unary& expr, const LiteralValue& right) const
+{
     if (expr.op.type == TokenType::MINUS)
     {
+        if (FlintMath::isMath(right)) return FlintMath::negate(right, expr.op);
         checkOperandType(expr.op, right);
-        return -std::get<double>(right);
+        return -right.asNumber();
     }
 
     if (expr.op.type == TokenType::BANG)
@@ -167,10 +260,8 @@ LiteralValue Evaluator::operator()(const Unary& expr) const
 // ─────────────────────────────────────────────────────────────────────────────
 LiteralValue Evaluator::operator()(const Literal& expr) const 
 {
-    if(auto strPtr = std::get_if<std::string>(&expr.value))
-    {
-        return std::make_shared<FlintString>(*strPtr);
-    }
+    // String literals are pooled FlintString constants built by the Parser,
+    // so this is a reference-count bump, never an allocation.
     return expr.value;
 }
 
@@ -185,24 +276,22 @@ LiteralValue Evaluator::operator()(const Grouping& expr) const
 // ─────────────────────────────────────────────────────────────────────────────
 // Variable Lookup via current Interpreter's environment
 // ─────────────────────────────────────────────────────────────────────────────
-LiteralValue Evaluator::operator()(const Variable& expr, ExprPtr exprPtr) const
+LiteralValue Evaluator::operator()(const Variable& expr) const
 {
-    return lookUpVariable(expr.name, exprPtr);
+    return lookUpVariable(expr.name, expr.local);
 }
 
-LiteralValue Evaluator::operator()(const Assignment& expr, ExprPtr exprPtr) const
+LiteralValue Evaluator::operator()(const Assignment& expr) const
 {
     LiteralValue val = evaluate(expr.value);
-    auto it = interpreter.locals.find(exprPtr);
 
-    if(it != interpreter.locals.end())
+    if(!expr.local.isGlobal())
     {
-        int distance = it -> second;
-        interpreter.environment -> assignAt(distance, expr.name, val);
+        interpreter.environment -> assignAt(expr.local.depth, expr.local.slot, val);
     }
     else
     {
-        interpreter.globals -> assign(expr.name, val);
+        interpreter.globals -> assignCached(expr.name, val, expr.local.global);
     }
 
     return val;
@@ -210,28 +299,126 @@ LiteralValue Evaluator::operator()(const Assignment& expr, ExprPtr exprPtr) cons
 
 LiteralValue Evaluator::operator()(const Lambda& expr) const
 {
-    std::shared_ptr<FlintFunction> fn = std::make_shared<FlintFunction>
-        (expr.function, interpreter.environment, false);
-    return fn;
+    return makeRef<FlintFunction>(expr.function, interpreter.environment);
 }
 
+// The parts of a Call as the tree walker evaluates them: from the nodes
+namespace {
+struct CallParts {
+    const Evaluator& evaluator;
+    const Call& expr;
+
+    LiteralValue object() const { return evaluator.evaluate(std::get<Get>(*expr.callee).object); }
+    LiteralValue callee() const { return evaluator.evaluate(expr.callee); }
+    LiteralValue argument(size_t i) const { return evaluator.evaluate(expr.arguments[i]); }
+};
+} // namespace
+
 LiteralValue Evaluator::operator()(const Call& expr) const
 {
-    LiteralValue callee = evaluate(expr.callee);
+    return call<false>(expr, CallParts{*this, expr});
+}
+
+LiteralValue Evaluator::tailCall(const Call& expr) const
+{
+    return call<true>(expr, CallParts{*this, expr});
+}
+
+template <bool Tail, typename Parts>
+LiteralValue Evaluator::call(const Call& expr, const Parts& parts) const
+{
+    LiteralValue callee;
+
+    // obj.method(args): methods are called with the receiver as 'this' and
+    // builtins dispatch straight from their shared method table, so no
+    // bound callable is materialized for the call.
+    if (auto getExpr = std::get_if<Get>(expr.callee))
+    {
+        LiteralValue object = parts.object();
+
+        if (FlintInstance* instance = object.as<FlintInstance>()) {
+            if (FlintFunction* method = instance->findMethod(getExpr->name, getExpr->cache))
+                return Tail ? deferCall(object, *method, expr, parts) : invokeMethod(object, *method, expr, parts);
+        }
+        else if (FlintString* str = object.as<FlintString>()) {
+            if (auto method = FlintString::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*str, *method, expr, parts);
+        }
+        else if (FlintArray* arr = object.as<FlintArray>()) {
+            if (auto method = FlintArray::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*arr, *method, expr, parts);
+        }
+        else if (FlintFloat64Array* arr = object.as<FlintFloat64Array>()) {
+            if (auto method = FlintFloat64Array::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*arr, *method, expr, parts);
+        }
+        else if (FlintStringBuilder* builder = object.as<FlintStringBuilder>()) {
+            if (auto method = FlintStringBuilder::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*builder, *method, expr, parts);
+        }
+        else if (FlintFile* file = object.as<FlintFile>()) {
+            if (auto method = FlintFile::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*file, *method, expr, parts);
+        }
+        else if (FlintMap* map = object.as<FlintMap>()) {
+            if (auto method = FlintMap::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*map, *method, expr, parts);
+        }
+        else if (FlintVec3* vec = object.as<FlintVec3>()) {
+            if (auto method = FlintVec3::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*vec, *method, expr, parts);
+        }
+        else if (FlintQuat* quat = object.as<FlintQuat>()) {
+            if (auto method = FlintQuat::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*quat, *method, expr, parts);
+        }
+        else if (FlintMat4* mat = object.as<FlintMat4>()) {
+            if (auto method = FlintMat4::findBuiltin(getExpr->name.symbol))
+                return invokeBuiltin(*mat, *method, expr, parts);
+        }
+        else if (FlintClass* klass = object.as<FlintClass>()) {
+            if (Ref<FlintFunction> method = klass->findClassMethod(getExpr->name.symbol))
+                return Tail ? deferCall(object, *method, expr, parts) : invokeMethod(object, *method, expr, parts);
+        }
+
+        callee = getProperty(object, *getExpr);
+    }
+    else if (auto superExpr = std::get_if<Super>(expr.callee))
+    {
+        // super.method(args): same, with the current 'this' as receiver
+        FlintFunction* method;
+        const LiteralValue& object = superReceiver(*superExpr, method);
+        return Tail ? deferCall(object, *method, expr, parts) : invokeMethod(object, *method, expr, parts);
+    }
+    else
+    {
+        callee = parts.callee();
+    }
+
+    // User functions (and bound methods) get their arguments evaluated
+    // straight into the new frame
+    if (FlintFunction* function = callee.as<FlintFunction>())
+    {
+        if (expr.arguments.size() == function -> arity())
+        {
+            if constexpr (Tail) return deferCall(function->boundReceiver(), *function, expr, parts);
+            return function->invoke(interpreter, function->boundReceiver(),
+                [&](size_t i) { return parts.argument(i); }, expr.paren);
+        }
+    }
    
     std::vector<LiteralValue> arguments;
+    arguments.reserve(expr.arguments.size());
 
-    for (ExprPtr argument : expr.arguments)
+    for (size_t i = 0; i < expr.arguments.size(); ++i)
     {
-        arguments.emplace_back(evaluate(argument));
+        arguments.emplace_back(parts.argument(i));
     }
 
-    if(!std::holds_alternative<std::shared_ptr<FlintCallable>>(callee))
+    FlintCallable* function = callee.as<FlintCallable>();
+    if(!function)
         throw RuntimeError(expr.paren, 
             "Call to other types except classes and functions is not valid!");
-    
-    std::shared_ptr<FlintCallable> function = std::get<
-        std::shared_ptr<FlintCallable>>(callee);
 
     if(function -> arity() != -1 && arguments.size() != function -> arity()) 
     {
@@ -244,67 +431,161 @@ LiteralValue Evaluator::operator()(const Call& expr) const
     return result;
 }
 
+template <typename Parts>
+LiteralValue Evaluator::invokeMethod(const LiteralValue& receiver, 
+    FlintFunction& method, const Call& expr, const Parts& parts) const
+{
+    if(expr.arguments.size() != method.arity()) 
+    {
+        // Arguments are still evaluated (for their side effects) before the error
+        for (size_t i = 0; i < expr.arguments.size(); ++i) parts.argument(i);
+
+        throw RuntimeError(expr.paren, 
+        "Function expects " + std::to_string(method.arity()) + 
+        " arguments but got " + std::to_string(expr.arguments.size()));
+    }
+
+    return method.invoke(interpreter, receiver,
+        [&](size_t i) { return parts.argument(i); }, expr.paren);
+}
+
+// The arguments are evaluated before anything is stored: they may run
+// calls (and tail calls) of their own
+template <typename Parts>
+LiteralValue Evaluator::deferCall(const LiteralValue& receiver,
+    FlintFunction& function, const Call& expr, const Parts& parts) const
+{
+    if(expr.arguments.size() != function.arity())
+        return invokeMethod(receiver, function, expr, parts);   // Reports the mismatch
+
+    std::vector<LiteralValue> arguments;
+    arguments.reserve(expr.arguments.size());
+    for (size_t i = 0; i < expr.arguments.size(); ++i)
+        arguments.emplace_back(parts.argument(i));
+
+    Interpreter::TailCall& call = interpreter.tailCall;
+    call.callee = Ref<FlintFunction>(&function);
+    call.receiver = receiver;
+    call.arguments = std::move(arguments);
+    return nullptr;
+}
+
+template <typename Receiver, typename Parts>
+LiteralValue Evaluator::invokeBuiltin(Receiver& receiver, 
+    const BuiltinMethod<Receiver>& method, const Call& expr, const Parts& parts) const
+{
+    std::vector<LiteralValue> arguments;
+    arguments.reserve(expr.arguments.size());
+
+    for (size_t i = 0; i < expr.arguments.size(); ++i)
+    {
+        arguments.emplace_back(parts.argument(i));
+    }
+
+    if(method.arity != -1 && arguments.size() != method.arity) 
+    {
+        throw RuntimeError(expr.paren, 
+        "Function expects " + std::to_string(method.arity) + 
+        " arguments but got " + std::to_string(arguments.size()));
+    }
+
+    Profiler::Scope profile(interpreter.profiler, &method, [&] {
+        return builtinName<Receiver>(std::get<Get>(*expr.callee).name.symbol);
+    });
+    return method.fn(receiver, interpreter, arguments, expr.paren);
+}
+
 LiteralValue Evaluator::operator()(const Get& expr) const
 {
-    LiteralValue val = evaluate(expr.object);
+    return getProperty(evaluate(expr.object), expr);
+}
 
+LiteralValue Evaluator::getProperty(const LiteralValue& val, const Get& expr) const
+{
     // Handle string properties and methods
-    if (auto strPtr = std::get_if<std::shared_ptr<FlintString>>(&val)) {
-        return strPtr -> get() -> getInBuiltFunction(expr.name);
+    if (FlintString* str = val.as<FlintString>()) {
+        return str -> getInBuiltFunction(expr.name);
     }
 
     // Handle array properties and methods
-    if (auto arrPtr = std::get_if<std::shared_ptr<FlintArray>>(&val)) {
-        return arrPtr -> get() -> getInBuiltFunction(expr.name);
+    if (FlintArray* arr = val.as<FlintArray>()) {
+        return arr -> getInBuiltFunction(expr.name);
+    }
+    if (FlintFloat64Array* arr = val.as<FlintFloat64Array>()) {
+        return arr -> getInBuiltFunction(expr.name);
+    }
+    if (FlintStringBuilder* builder = val.as<FlintStringBuilder>()) {
+        return builder -> getInBuiltFunction(expr.name);
+    }
+    if (FlintFile* file = val.as<FlintFile>()) {
+        return file -> getInBuiltFunction(expr.name);
+    }
+    if (FlintMap* map = val.as<FlintMap>()) {
+        return map -> getInBuiltFunction(expr.name);
     }
 
+    // Math value components (.x/.y/.z/.w) and methods
+    if (FlintVec3* vec = val.as<FlintVec3>()) return vec -> get(expr.name);
+    if (FlintQuat* quat = val.as<FlintQuat>()) return quat -> get(expr.name);
+    if (FlintMat4* mat = val.as<FlintMat4>()) return mat -> get(expr.name);
+
     // Object/class/instance property access
-    if (std::holds_alternative<std::shared_ptr<FlintCallable>>(val)) {
-        auto classPtr = std::dynamic_pointer_cast<FlintClass>(std::get<std::shared_ptr<FlintCallable>>(val));
-        if (classPtr)
-            return classPtr->get(expr.name, interpreter);
+    if (FlintClass* klass = val.as<FlintClass>()) {
+        return klass->get(expr.name, interpreter);
     }
-    else if (std::holds_alternative<std::shared_ptr<FlintInstance>>(val)) {
-        return std::get<std::shared_ptr<FlintInstance>>(val)->get(expr.name, interpreter);
+    if (FlintInstance* instance = val.as<FlintInstance>()) {
+        return instance->get(expr.name, interpreter, expr.cache);
     }
-                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                         
+
     throw RuntimeError(expr.name, "Only instances, strings, or arrays have properties.");
 }
 
 LiteralValue Evaluator::operator()(const Set& expr) const
 {
     LiteralValue object = evaluate(expr.object);
-    if(!std::holds_alternative<std::shared_ptr<FlintInstance>>(object))
+    FlintInstance* instance = object.as<FlintInstance>();
+    if(!instance)
     {
         throw RuntimeError(expr.name, "Only instances have fields.");
     }
 
     LiteralValue value = evaluate(expr.value);
-    std::get<std::shared_ptr<FlintInstance>>(object) -> set(expr.name, value);
+    instance -> set(expr.name, value, expr.cache);
     return value;
 }
 
-LiteralValue Evaluator::operator()(const This& expr, ExprPtr exprPtr) const
+LiteralValue Evaluator::operator()(const This& expr) const
 {
-    return lookUpVariable(expr.keyword, exprPtr);
+    return lookUpVariable(expr.keyword, expr.local);
 }
 
-LiteralValue Evaluator::operator()(const Super& expr, ExprPtr exprPtr) const
+const LiteralValue& Evaluator::superReceiver(const Super& expr, FlintFunction*& method) const
 {
-    int distance = interpreter.locals[exprPtr];
-    std::shared_ptr<FlintClass> superClass = std::get<std::shared_ptr<FlintClass>>
-        (interpreter.environment -> getAt(distance, expr.keyword));
-    std::shared_ptr<FlintInstance> object = std::get<std::shared_ptr<FlintInstance>>
-        (interpreter.environment -> getAt(distance - 1, 
-            Token{ TokenType::THIS, "this", nullptr, 0 })
-        );
-    
-    std::shared_ptr<FlintFunction> method = superClass -> findMethod(expr.method.lexeme);
-
-    if (!method) {
-      throw RuntimeError(expr.method,
-          "Undefined property '" + expr.method.lexeme + "'.");
+    // 'super' and 'this' both live in slot 0 of their (adjacent) scopes:
+    // 'super' in the class scope, 'this' in the method's own frame
+    Environment* frame = interpreter.environment -> ancestors(expr.local.depth - 1);
+    FlintClass* superClass = frame -> enclosing -> at(0).as<FlintClass>();
+
+    // A class's root shape identifies it for good, so the site caches the
+    // method per superclass as Get sites cache per shape
+    uint32_t id = superClass -> rootShape() -> id;
+    if (const PropertyCache::Entry* hit = expr.cache.lookup(id)) {
+        method = hit->method;
+    } else {
+        method = superClass -> findMethod(expr.method.symbol);
+        if (!method) {
+          throw RuntimeError(expr.method,
+              "Undefined property '" + std::string(expr.method.lexeme) + "'.");
+        }
+        expr.cache.add({ id, -1, nullptr, method });
     }
+    return frame -> at(0);
+}
+
+LiteralValue Evaluator::operator()(const Super& expr) const
+{
+    FlintFunction* method;
+    const LiteralValue& object = superReceiver(expr, method);
     return method -> bind(object);
 }
 
@@ -316,68 +597,92 @@ LiteralValue Evaluator::operator()(const Array& expr) const
         elements.push_back(evaluate(e));
     }
 
-    return std::make_shared<FlintArray>(std::move(elements));
+    return makeRef<FlintArray>(std::move(elements));
 }
 
 LiteralValue Evaluator::evaluate(const ExprPtr& expr) const 
 {
     if (!expr) return std::monostate{};
 
-    LiteralValue result;
-    std::visit([&](auto& actualExpr) {
-        using T = std::decay_t<decltype(actualExpr)>;
-        if constexpr (std::is_same_v<T, Variable> || 
-            std::is_same_v<T, Assignment> || std::is_same_v<T, This> ||
-            std::is_same_v<T, Super>)
-            result = (*this)(actualExpr, expr);  // Pass ExprPtr
-        else
-            result = (*this)(actualExpr);        // Regular
-    }, *expr);
-
-    return result;
+    return std::visit(*this, *expr);
 }
 
 LiteralValue Evaluator::operator()(const GetIndex& expr) const
 {
-    LiteralValue arrVal = evaluate(expr.array);
-    LiteralValue indexVal = evaluate(expr.index);
+    LiteralValue array = evaluate(expr.array);
+    return getIndexOperation(expr, array, evaluate(expr.index));
+}
+
+LiteralValue Evaluator::getIndexOperation(const GetIndex& expr,
+    const LiteralValue& arrVal, const LiteralValue& indexVal) const
+{
+    if (FlintMap* map = arrVal.as<FlintMap>())
+    {
+        const LiteralValue* value = map -> find(indexVal);
+        return value ? *value : LiteralValue(nullptr);
+    }
 
-    if (auto arrPtr = std::get_if<std::shared_ptr<FlintArray>>(&arrVal))
+    if (FlintArray* arr = arrVal.as<FlintArray>())
     {
         checkOperandType(expr.bracket, indexVal);
-        int index = static_cast<int>(std::get<double>(indexVal));
-        if(index < 0 || index >= (int)(*arrPtr) -> elements.size())
+        int index = static_cast<int>(indexVal.asNumber());
+        if(index < 0 || index >= (int)arr -> elements.size())
             throw RuntimeError(expr.bracket, "Array index out of bounds \033[33m(why are you always reaching for things you can't have?)\033[0m");
-        return (*arrPtr) -> elements[index];
+        return arr -> elements[index];
     }
 
-    if (auto strPtr = std::get_if<std::shared_ptr<FlintString>>(&arrVal))
+    if (FlintFloat64Array* arr = arrVal.as<FlintFloat64Array>())
     {
         checkOperandType(expr.bracket, indexVal);
-        int index = static_cast<int>(std::get<double>(indexVal));
-        if(index < 0 || index >= (int)(*strPtr) -> value.length())
+        int index = static_cast<int>(indexVal.asNumber());
+        if(index < 0 || index >= (int)arr -> elements.size())
+            throw RuntimeError(expr.bracket, "Array index out of bounds \033[33m(why are you always reaching for things you can't have?)\033[0m");
+        return arr -> elements[index];
+    }
+
+    if (FlintString* str = arrVal.as<FlintString>())
+    {
+        checkOperandType(expr.bracket, indexVal);
+        int index = static_cast<int>(indexVal.asNumber());
+        if(index < 0 || index >= (int)str -> value.length())
             throw RuntimeError(expr.bracket, "String index out of bounds \033[33m(why are you always reaching for things you can't have?)\033[0m");
-        return std::string(1, (*strPtr) -> value[index]);
+        return makeRef<FlintString>(std::string(1, str -> value[index]));
     }
 
-    throw RuntimeError(expr.bracket, "Only arrays or strings can be indexed.");
+    throw RuntimeError(expr.bracket, "Only arrays, strings or maps can be indexed.");
 }
 
 LiteralValue Evaluator::operator()(const SetIndex& expr) const
 {
     auto arrVal = evaluate(expr.array);
     auto indexVal = evaluate(expr.index);
-    auto newVal = evaluate(expr.value);
+    return setIndexOperation(expr, arrVal, indexVal, evaluate(expr.value));
+}
 
-    if (auto arrPtr = std::get_if<std::shared_ptr<FlintArray>>(&arrVal)) {
+LiteralValue Evaluator::setIndexOperation(const SetIndex& expr, const LiteralValue& arrVal,
+    const LiteralValue& indexVal, const LiteralValue& newVal) const
+{
+    if (FlintArray* arr = arrVal.as<FlintArray>()) {
         checkOperandType(expr.bracket, indexVal);
-        int index = static_cast<int>(std::get<double>(indexVal));
-        if(index < 0 || index >= (int)(*arrPtr) -> elements.size())
+        int index = static_cast<int>(indexVal.asNumber());
+        if(index < 0 || index >= (int)arr -> elements.size())
             throw RuntimeError(expr.bracket, "Array index out of bounds.");
-        (*arrPtr)->elements[index] = newVal;
+        arr->elements[index] = newVal;
         return newVal;
     }
-    throw RuntimeError(expr.bracket, "Only arrays support indexed assignment.");
+    if (FlintFloat64Array* arr = arrVal.as<FlintFloat64Array>()) {
+        checkOperandType(expr.bracket, indexVal, newVal);
+        int index = static_cast<int>(indexVal.asNumber());
+        if(index < 0 || index >= (int)arr -> elements.size())
+            throw RuntimeError(expr.bracket, "Array index out of bounds.");
+        arr->elements[index] = newVal.asNumber();
+        return newVal;
+    }
+    if (FlintMap* map = arrVal.as<FlintMap>()) {
+        map->set(indexVal, newVal, expr.bracket);
+        return newVal;
+    }
+    throw RuntimeError(expr.bracket, "Only arrays and maps support indexed assignment.");
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -386,27 +691,17 @@ LiteralValue Evaluator::operator()(const SetIndex& expr) const
 //   • false, null, and nothing → false
 //   • everything else → true
 // ─────────────────────────────────────────────────────────────────────────────
-bool Evaluator::isTruthy(const LiteralValue& value) const 
+bool Evaluator::isTruthy(const LiteralValue& value)
 {
-    auto visitor = [] (auto&& val) -> bool
-    {
-        using T = std::decay_t<decltype(val)>;
-        if constexpr (std::is_same_v<T, std::monostate>)      return false;
-        else if constexpr (std::is_same_v<T, std::nullptr_t>) return false;
-        else if constexpr (std::is_same_v<T, bool>)           return val;
-        else if constexpr (std::is_same_v<T, double>)         return val != 0.0;
-        else if constexpr (std::is_same_v<T, int>)            return val != 0;
-        else if constexpr (std::is_same_v<T, std::string>)    return !val.empty();
-        else if constexpr (std::is_same_v<T, std::shared_ptr<FlintCallable>>) return static_cast<bool>(val);
-        else return true; // Fallback
-    };
-
-    return std::visit(visitor, value);
+    if (value.isNothing()) return false;
+    if (value.isBool())    return value.asBool();
+    if (value.isNumber())  return value.asNumber() != 0.0;
+    return true;  // Every object is truthy
 }
 
 std::string Evaluator::getMethodName(const ExprPtr& callee) const {
-    if (auto getExpr = std::get_if<Get>(callee.get())) {
-        return getExpr->name.lexeme;
+    if (auto getExpr = std::get_if<Get>(callee)) {
+        return std::string(getExpr->name.lexeme);
     }
     throw std::runtime_error("Method call is not in the expected format.");
 }
@@ -415,28 +710,30 @@ std::string Evaluator::getMethodName(const ExprPtr& callee) const {
 // Equality Check between LiteralValues
 // Used by == and != comparisons
 // ─────────────────────────────────────────────────────────────────────────────
-bool Evaluator::isEqual(const LiteralValue& left, const LiteralValue& right) const 
+bool Evaluator::isEqual(const LiteralValue& left, const LiteralValue& right)
 {
-    if (std::holds_alternative<std::monostate>(left) && std::holds_alternative<std::monostate>(right))
-        return true;
-    if (std::holds_alternative<std::nullptr_t>(left) && std::holds_alternative<std::nullptr_t>(right))
-        return true;
-    if (std::holds_alternative<std::monostate>(left) || std::holds_alternative<std::nullptr_t>(left))
-        return false;
+    // Numbers compare by value (so NaN != NaN); everything else by identity
+    if (left.isNumber() && right.isNumber())
+        return left.asNumber() == right.asNumber();
 
-    return left == right;
+    // Strings compare by content, whichever object holds the characters
+    FlintString* leftText = left.as<FlintString>();
+    FlintString* rightText = right.as<FlintString>();
+    if (leftText && rightText)
+        return leftText->value == rightText->value;
+
+    // Math values compare by components
+    if (FlintMath::isMath(left) && FlintMath::isMath(right))
+        return FlintMath::equal(left, right);
+
+    return left.isSame(right);
 }
 
-LiteralValue Evaluator::lookUpVariable(Token name, ExprPtr expr) const 
+LiteralValue Evaluator::lookUpVariable(const Token& name, const LocalSlot& local) const 
 {
-    auto it = interpreter.locals.find(expr);
-    if (it != interpreter.locals.end()) {
-        int distance = it->second;
-        auto val = interpreter.environment->getAt(distance, name);
-        return val;
-    }
-    auto val = interpreter.globals->get(name);
-    return val;
+    if (!local.isGlobal())
+        return interpreter.environment->getAt(local.depth, local.slot);
+    return interpreter.globals->getCached(name, local.global);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -446,8 +743,12 @@ LiteralValue Evaluator::lookUpVariable(Token name, ExprPtr expr) const
 template<typename... Operands>
 void Evaluator::checkOperandType(const Token& op, const Operands&... operands) const
 {
-    if ((... && std::holds_alternative<double>(operands))) return;
+    if ((... && operands.isNumber())) return;
 
     std::string message = "compiler is disappointed in you \033[33m(pls go touch grass)\033[0m";
     throw RuntimeError(op, message);
-}
\ No newline at end of file
+}
+
+// The closure engine's calls (see ClosureCompiler.h)
+template LiteralValue Evaluator::call<false, LoweredCall>(const Call&, const LoweredCall&) const;
+template LiteralValue Evaluator::call<true, LoweredCall>(const Call&, const LoweredCall&) const;
@@ -1,17 +1,38 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <chrono>
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>   // getrlimit: the size of the C++ stack
+#endif
+#if defined(__GLIBC__)
+#include <pthread.h>        // pthread_getattr_np: the size of this thread's
+#endif
 #include "Flint/Interpreter/Interpreter.h"
 #include "Flint/Flint.h"
 #include "Flint/Parser/Value.h"
 #include "Flint/ASTNodes/ExpressionNode.h"
 // removed includes for ReturnException/BreakException/ContinueException
 #include "Flint/Exceptions/RuntimeError.h"
+#include "Flint/Exceptions/BudgetExceeded.h"
 #include "Flint/Callables/FlintCallable.h"
 #include "Flint/Callables/Functions/NativeFunction.h"
 #include "Flint/Callables/Functions/FlintFunction.h"
 #include "Flint/Callables/Classes/FlintClass.h"
 #include "Flint/Callables/Classes/FlintInstance.h"
 #include "Flint/FlintArray.h"
+#include "Flint/FlintFile.h"
+#include "Flint/FlintMap.h"
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintMath.h"
 #include "Flint/FlintString.h"
+#include "Flint/FlintStringBuilder.h"
+#include "Flint/Tasks.h"
+#include "Flint/Interpreter/Profiler.h"
+#include "Flint/Interpreter/ClosureCompiler.h"
+#include "Flint/MappedFile.h"
+
+Profiler* profilerOf(const Interpreter& interpreter) { return interpreter.profiler; }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Global Interpreter State
@@ -24,17 +45,8 @@ Interpreter::Interpreter()
     environment = globals;
     evaluator = std::make_unique<Evaluator>(*this);
 
-    // Initialize control-flow flags
-    // NOTE: these are members of Interpreter; if you prefer, add them directly
-    // as mutable members in Interpreter.h. Here we rely on them existing.
-    returning = false;
-    returnValue = nullptr;
-    breaking = false;
-    continuing = false;
-    isInsideLoop = false;
-
     // Define clock()
-    globals -> define("clock", std::make_shared<NativeFunction>(
+    globals->define(SymbolTable::intern("clock"), makeRef<NativeFunction>(
     0,
     [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
         auto now = std::chrono::system_clock::now();
@@ -45,7 +57,7 @@ Interpreter::Interpreter()
     "clock"
     ));
 
-    globals -> define("scan", std::make_shared<NativeFunction>(
+    globals->define(SymbolTable::intern("scan"), makeRef<NativeFunction>(
         -1,
         [this](const std::vector<LiteralValue>& args, 
             const Token &paren) -> LiteralValue 
@@ -54,42 +66,78 @@ Interpreter::Interpreter()
             if(args.size() > 1) 
                 throw RuntimeError(paren, "scan() takes at most 1 argument.");
             
-            if(!args.empty() && !std::holds_alternative<std::string>(args[0]))
+            if(!args.empty() && !args[0].is<FlintString>())
                 throw RuntimeError(paren, "scan() expects string as prompt.");
             
             if(!args.empty())
-                std::cout << std::get<std::string>(args[0]);
+                std::cout << args[0].as<FlintString>()->value;
             
             std::string line;
             std::getline(std::cin, line);
             line.erase(line.find_last_not_of(" \t\n\r\f\v") + 1); // trim right
             line.erase(0, line.find_first_not_of(" \t\n\r\f\v")); // trim left
             return this -> isNumber(line) ? 
-                LiteralValue(std::stod(line)) : LiteralValue(line);
+                LiteralValue(std::stod(line)) : LiteralValue(makeRef<FlintString>(line));
         },
         "scan"
     ));
 
-    globals->define("print", std::make_shared<NativeFunction>(
+    globals->define(SymbolTable::intern("print"), makeRef<NativeFunction>(
     -1, // -1 means variadic
     [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        // One write of the whole line; std::cout (stdio's stdout) buffers it
+        std::string text;
         for (const auto& arg : args)
-            std::cout << Interpreter::stringify(arg);
+            Interpreter::appendTo(text, arg);
+        std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
         return nullptr;
     },
     "print"
     ));
 
-    globals->define("intDiv", std::make_shared<NativeFunction>(
+    // flush(): write out what print() has buffered
+    globals->define(SymbolTable::intern("flush"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        std::cout.flush();
+        return nullptr;
+    },
+    "flush"
+    ));
+
+    // open(path, mode?): a file handle (see FlintFile.h)
+    globals->define(SymbolTable::intern("open"), makeRef<NativeFunction>(
+    -1,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return FlintFile::open(args, paren);
+    },
+    "open"
+    ));
+
+    // readFile(path): the whole file as a string, copied once out of a
+    // mapping of it
+    globals->define(SymbolTable::intern("readFile"), makeRef<NativeFunction>(
+    1,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        if (!args[0].is<FlintString>()) throw RuntimeError(paren, "readFile() expects a path.");
+        const std::string& path = args[0].as<FlintString>()->value;
+        MappedFile file(path);
+        if (!file) throw RuntimeError(paren, "Could not read file '" + path + "'.");
+        return makeRef<FlintString>(std::string(file.text()));
+    },
+    "readFile"
+    ));
+
+    globals->define(SymbolTable::intern("intDiv"), makeRef<NativeFunction>(
     2,
     [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
-        if (!std::holds_alternative<double>(args[0]) 
-        || !std::holds_alternative<double>(args[1])) {
+        if (!args[0].isNumber() 
+        || !args[1].isNumber()) {
             throw RuntimeError(paren, "intDiv() expects two numbers.");
         }
 
-        int a = static_cast<int>(std::get<double>(args[0]));
-        int b = static_cast<int>(std::get<double>(args[1]));
+        int a = static_cast<int>(args[0].asNumber());
+        int b = static_cast<int>(args[1].asNumber());
 
         if (b == 0) throw RuntimeError(paren, "Division by zero.");
 
@@ -98,31 +146,31 @@ Interpreter::Interpreter()
     "intDiv"
     ));
 
-    globals -> define("toString", std::make_shared<NativeFunction>(
+    globals->define(SymbolTable::intern("toString"), makeRef<NativeFunction>(
         1,
         [this](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
             if(args.size() > 1) 
                 throw RuntimeError(paren, "toString() takes at most 1 argument.");
             
-            if(!std::holds_alternative<double>(args[0]))
+            if(!args[0].isNumber())
             {
                 throw RuntimeError(paren, "toString() takes a number as an argument.");
             }
 
-            return stringify(args[0]);
+            return makeRef<FlintString>(stringify(args[0]));
         },
         "toString"
     ));
 
 
-    globals->define("ord", std::make_shared<NativeFunction>(
+    globals->define(SymbolTable::intern("ord"), makeRef<NativeFunction>(
     1,
     [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
-        if (!std::holds_alternative<std::shared_ptr<FlintString>>(args[0])) {
+        if (!args[0].is<FlintString>()) {
             throw RuntimeError(paren, "ord() expects a string argument.");
         }
 
-        const std::string& str = std::get<std::shared_ptr<FlintString>>(args[0]) -> value;
+        const std::string& str = args[0].as<FlintString>() -> value;
         if (str.length() != 1) {
             throw RuntimeError(paren, "ord() expects a single character string.");
         }
@@ -132,22 +180,330 @@ Interpreter::Interpreter()
     "ord"
     ));
 
-    globals->define("chr", std::make_shared<NativeFunction>(
+    globals->define(SymbolTable::intern("chr"), makeRef<NativeFunction>(
     1,
     [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
-        if (!std::holds_alternative<double>(args[0])) {
+        if (!args[0].isNumber()) {
             throw RuntimeError(paren, "chr() expects a number.");
         }
 
-        int code = static_cast<int>(std::get<double>(args[0]));
+        int code = static_cast<int>(args[0].asNumber());
         if (code < 0 || code > 255) {
             throw RuntimeError(paren, "chr() argument must be in range 0–255.");
         }
 
-        return std::string(1, static_cast<char>(code));
+        return makeRef<FlintString>(std::string(1, static_cast<char>(code)));
     },
     "chr"
     ));
+
+    // gc(): collect reference cycles now; returns the number of objects freed
+    globals->define(SymbolTable::intern("gc"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return static_cast<double>(Heap::collect());
+    },
+    "gc"
+    ));
+
+    // heapSize(): number of live objects and environments
+    globals->define(SymbolTable::intern("heapSize"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return static_cast<double>(Heap::stats().liveObjects);
+    },
+    "heapSize"
+    ));
+
+    // memStats(): allocation counts of this thread's heap, one row per kind
+    // of object allocated so far and a last "total" row:
+    // [kind, allocated, live, peak live, bytes, peak bytes]
+    globals->define(SymbolTable::intern("memStats"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        auto row = [](const char* kind, const Heap::Counts& c) -> LiteralValue {
+            return makeRef<FlintArray>(std::vector<LiteralValue>{
+                makeRef<FlintString>(std::string(kind)), static_cast<double>(c.allocated),
+                static_cast<double>(c.live), static_cast<double>(c.peakLive),
+                static_cast<double>(c.bytes), static_cast<double>(c.peakBytes) });
+        };
+        std::vector<LiteralValue> rows;
+        for (size_t kind = 0; kind < Heap::KINDS; ++kind) {
+            const Heap::Counts& counts = Heap::counts(static_cast<uint8_t>(kind));
+            if (counts.allocated) rows.push_back(row(Heap::kindName(static_cast<uint8_t>(kind)), counts));
+        }
+        rows.push_back(row("total", Heap::totals()));
+        return makeRef<FlintArray>(std::move(rows));
+    },
+    "memStats"
+    ));
+
+    // Map(): empty hash map (see FlintMap.h)
+    globals->define(SymbolTable::intern("Map"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return makeRef<FlintMap>();
+    },
+    "Map"
+    ));
+
+    // StringBuilder(): empty text buffer, appended to in place
+    globals->define(SymbolTable::intern("StringBuilder"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return makeRef<FlintStringBuilder>();
+    },
+    "StringBuilder"
+    ));
+
+    // Float64Array(n | array): packed array of numbers, zero-filled or copied
+    globals->define(SymbolTable::intern("Float64Array"), makeRef<NativeFunction>(
+    1,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return FlintFloat64Array::construct(args[0], paren);
+    },
+    "Float64Array"
+    ));
+
+    // vec3(x, y, z), quat(x, y, z, w), quatAxisAngle(axis, angle), mat4(): math values
+    globals->define(SymbolTable::intern("vec3"), makeRef<NativeFunction>(
+    3,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        if (!args[0].isNumber() || !args[1].isNumber() || !args[2].isNumber())
+            throw RuntimeError(paren, "vec3() expects three numbers.");
+        return makeRef<FlintVec3>(args[0].asNumber(), args[1].asNumber(), args[2].asNumber());
+    },
+    "vec3"
+    ));
+
+    globals->define(SymbolTable::intern("quat"), makeRef<NativeFunction>(
+    4,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        for (const LiteralValue& arg : args)
+            if (!arg.isNumber()) throw RuntimeError(paren, "quat() expects four numbers.");
+        return makeRef<FlintQuat>(args[0].asNumber(), args[1].asNumber(),
+                                  args[2].asNumber(), args[3].asNumber());
+    },
+    "quat"
+    ));
+
+    globals->define(SymbolTable::intern("quatAxisAngle"), makeRef<NativeFunction>(
+    2,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        FlintVec3* axis = args[0].as<FlintVec3>();
+        if (!axis || !args[1].isNumber())
+            throw RuntimeError(paren, "quatAxisAngle() expects a vec3 and an angle in radians.");
+        return FlintQuat::fromAxisAngle(*axis, args[1].asNumber());
+    },
+    "quatAxisAngle"
+    ));
+
+    globals->define(SymbolTable::intern("mat4"), makeRef<NativeFunction>(
+    0,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return makeRef<FlintMat4>();
+    },
+    "mat4"
+    ));
+
+    // Tasks (see Tasks.h): spawn(fn, args...), await(future), joinAll(futures)
+    globals->define(SymbolTable::intern("spawn"), makeRef<NativeFunction>(
+    -1,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return Tasks::spawn(args, paren);
+    },
+    "spawn"
+    ));
+
+    globals->define(SymbolTable::intern("await"), makeRef<NativeFunction>(
+    1,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return Tasks::await(args[0], paren);
+    },
+    "await"
+    ));
+
+    globals->define(SymbolTable::intern("joinAll"), makeRef<NativeFunction>(
+    1,
+    [](const std::vector<LiteralValue>& args, const Token& paren) -> LiteralValue {
+        return Tasks::joinAll(args[0], paren);
+    },
+    "joinAll"
+    ));
+}
+
+Interpreter::~Interpreter() = default;
+
+void Interpreter::lowerToClosures()
+{
+    if (!closures) closures = std::make_unique<ClosureCompiler>();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Callbacks
+// Checked like a call expression: the arity must match exactly.
+// ─────────────────────────────────────────────────────────────────────────────
+LiteralValue Interpreter::callback(const LiteralValue& callee,
+    const std::vector<LiteralValue>& arguments, const Token& paren)
+{
+    if (FlintCallable* function = callee.as<FlintCallable>())
+    {
+        if (function->arity() != -1 && arguments.size() != static_cast<size_t>(function->arity()))
+            throw RuntimeError(paren, "Function expects " + std::to_string(function->arity()) +
+                                      " arguments but got " + std::to_string(arguments.size()));
+        return function->call(*this, arguments, paren);
+    }
+
+    if (callbackRunner && callee.isObject())
+        return callbackRunner->runCallback(callee, arguments, paren);
+
+    throw RuntimeError(paren, "Call to other types except classes and functions is not valid!");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Frame
+// A pooled frame is handed out as a non-owning shared_ptr (aliasing an empty
+// owner): no control block is allocated, and since nothing can capture it,
+// no reference outlives the call.  Frames are released in LIFO order.
+// ─────────────────────────────────────────────────────────────────────────────
+Interpreter::Frame::Frame(const Interpreter& interpreter,
+    std::shared_ptr<Environment> enclosing, int slotCount, bool captured)
+    : interpreter(interpreter), pooled(!captured)
+{
+    if (!pooled)
+    {
+        frame = std::make_shared<Environment>(std::move(enclosing), slotCount);
+        return;
+    }
+
+    auto& frames = interpreter.frames;
+    if (interpreter.frameDepth == frames.size())
+        frames.push_back(std::make_unique<Environment>());
+
+    Environment* environment = frames[interpreter.frameDepth++].get();
+    environment->reset(std::move(enclosing), slotCount);
+    frame = std::shared_ptr<Environment>(std::shared_ptr<Environment>(), environment);
+}
+
+Interpreter::Frame::~Frame()
+{
+    if (pooled) interpreter.frames[--interpreter.frameDepth]->clear();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// The C++ stack calls may use: three quarters of the calling thread's stack
+// (no more than the main thread's stack limit), leaving room for what runs
+// on top of the deepest call (natives, printing, error reporting).
+// Worked out once per thread.
+// ─────────────────────────────────────────────────────────────────────────────
+static std::uintptr_t measureStackBudget()
+{
+    std::uintptr_t size = 8 * 1024 * 1024;   // The usual default
+#if defined(_WIN32)
+    size = 1024 * 1024;
+#elif __has_include(<sys/resource.h>)
+    rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+        size = static_cast<std::uintptr_t>(limit.rlim_cur);
+#endif
+#if defined(__GLIBC__)
+    // Threads other than the main one usually get less
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+    {
+        void* lowest;
+        size_t threadSize;
+        if (pthread_attr_getstack(&attributes, &lowest, &threadSize) == 0)
+            size = std::min<std::uintptr_t>(size, threadSize);
+        pthread_attr_destroy(&attributes);
+    }
+#endif
+    return size - size / 4;
+}
+
+std::uintptr_t Interpreter::nativeStackBudget()
+{
+    static thread_local std::uintptr_t budget = measureStackBudget();
+    return budget;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// StackBase
+// The stack check measures from the first entry into the interpreter on this
+// call stack; entries nested in it (natives calling back) leave the mark alone.
+// ─────────────────────────────────────────────────────────────────────────────
+class Interpreter::StackBase {
+public:
+    StackBase(const Interpreter& interpreter, const void* base)
+        : interpreter(interpreter), outermost(interpreter.stackBase == 0)
+    {
+        if (!outermost) return;
+        interpreter.stackBase = reinterpret_cast<std::uintptr_t>(base);
+        interpreter.stackBudget = nativeStackBudget();   // Of whichever thread runs it this time
+    }
+    ~StackBase() { if (outermost) interpreter.stackBase = 0; }
+
+private:
+    const Interpreter& interpreter;
+    bool outermost;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Execution budget
+// A run takes its steps from `ticks`; only when a slice runs out does
+// checkBudget() look at what is left of the budget and at the clock.
+// ─────────────────────────────────────────────────────────────────────────────
+void Interpreter::startBudget() const
+{
+    stepsLeft = budget.steps;
+    deadline = std::chrono::steady_clock::now() + budget.time;
+    refillTicks();
+}
+
+void Interpreter::refillTicks() const
+{
+    uint64_t slice = budget.time.count() > 0 ? CLOCK_INTERVAL : NO_BUDGET;
+    if (budget.steps > 0)
+    {
+        slice = std::min(slice, stepsLeft);
+        stepsLeft -= slice;
+    }
+    ticks = slice;
+}
+
+void Interpreter::checkBudget(size_t line) const
+{
+    bool outOfSteps = budget.steps > 0 && stepsLeft == 0;
+    bool outOfTime = budget.time.count() > 0 && std::chrono::steady_clock::now() >= deadline;
+    if (outOfSteps || outOfTime) budgetExceeded(line, outOfSteps);
+    refillTicks();
+    --ticks;   // This step
+}
+
+void Interpreter::checkDeadline(size_t line) const
+{
+    if (runs > 0 && budget.time.count() > 0 && std::chrono::steady_clock::now() >= deadline)
+        budgetExceeded(line, false);
+}
+
+void Interpreter::budgetExceeded(size_t line, bool outOfSteps) const
+{
+    ticks = 0;   // Spent for the rest of the run: every later step fails too
+    throw BudgetExceeded(Token(TokenType::IDENTIFIER, "", nullptr, static_cast<int>(line)),
+        outOfSteps ? "Execution budget of " + std::to_string(budget.steps) + " steps exceeded."
+                   : "Execution time budget exceeded.");
+}
+
+Interpreter::Budget Interpreter::remainingBudget() const
+{
+    if (runs == 0) return budget;
+
+    Budget left;
+    if (budget.steps > 0) left.steps = std::max<uint64_t>(stepsLeft + ticks, 1);
+    if (budget.time.count() > 0)
+        left.time = std::max(std::chrono::nanoseconds(1),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()));
+    return left;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -155,59 +511,67 @@ Interpreter::Interpreter()
 // Entry point for executing parsed AST statements.
 // Executes each statement in order. If a runtime error occurs,
 // it is caught and forwarded to Flint's error reporting mechanism.
+// A run out of budget stops there.
 // ─────────────────────────────────────────────────────────────────────────────
-void Interpreter::interpret(std::vector<std::shared_ptr<Statement>> statements) const
+void Interpreter::interpret(const std::vector<StmtPtr>& statements) const
 {
-    for (std::shared_ptr<Statement> s : statements)
+    // Measure stack use from here (unless a native re-entered the interpreter)
+    char base;
+    StackBase entry(*this, &base);
+    Run run(*this);
+
+    for (StmtPtr s : statements)
     {
         try {
-            // clear control-flow flags per top-level statement
-            const_cast<Interpreter*>(this)->returning = false;
-            const_cast<Interpreter*>(this)->returnValue = nullptr;
-            const_cast<Interpreter*>(this)->breaking = false;
-            const_cast<Interpreter*>(this)->continuing = false;
-
-            execute(s);
+            if (closures) closures->lower(*s)->execute(*evaluator);
+            else execute(s);
+        } catch (const BudgetExceeded& error) {
+            Flint::runtimeError(error);
+            return;
         } catch (const RuntimeError& error) {
             Flint::runtimeError(error);
             // Continue with next statement
         }
     }
 }
+
+LiteralValue Interpreter::invoke(const LiteralValue& callee, ValueSpan arguments, const Token& paren)
+{
+    char base;
+    StackBase entry(*this, &base);
+    Run run(*this);
+
+    if (FlintFunction* function = callee.as<FlintFunction>())
+    {
+        if (arguments.size() != static_cast<size_t>(function->arity()))
+            throw RuntimeError(paren, "Function expects " + std::to_string(function->arity()) +
+                                      " arguments but got " + std::to_string(arguments.size()));
+        return function->invoke(*this, function->boundReceiver(),
+                                [&](int i) -> const LiteralValue& { return arguments[i]; }, paren);
+    }
+    return callback(callee, std::vector<LiteralValue>(arguments.begin(), arguments.end()), paren);
+}
 // ─────────────────────────────────────────────────────────────────────────────
 // execute()
 // Dispatches a statement using std::visit. This lets us call the appropriate
 // overloaded operator() based on which statement variant (Print, Let, etc.)
 // ─────────────────────────────────────────────────────────────────────────────
-void Interpreter::execute(std::shared_ptr<Statement> statement) const
+Completion Interpreter::execute(StmtPtr statement) const
 {
-    // If a return/break/continue was set by an earlier statement, don't execute more
-    if (const_cast<Interpreter*>(this)->returning ||
-        const_cast<Interpreter*>(this)->breaking)
-        return;
-
-    std::visit(*this, *statement.get());
+    if (profiler) profiler->at(std::visit([](const auto& stmt) { return stmt.line; }, *statement));
+    return std::visit(*this, *statement);
 }
 
-void Interpreter::executeBlock(std::vector<std::shared_ptr<Statement>> statements,
+Completion Interpreter::executeBlock(const std::vector<StmtPtr>& statements,
     std::shared_ptr<Environment> newEnv) const
 {
     auto previous = environment;
     environment = newEnv;
 
+    Completion completion;
     try
     {
-        for (const auto& statement : statements)
-        {
-            // Check flags before executing each statement so returns/breaks propagate
-            if (const_cast<Interpreter*>(this)->returning ||
-                const_cast<Interpreter*>(this)->breaking)
-                break;
-
-            execute(statement);
-            
-            if (const_cast<Interpreter*>(this)->continuing) break;
-        } 
+        completion = executeStatements(statements);
     }
     catch (...) 
     {
@@ -216,60 +580,72 @@ void Interpreter::executeBlock(std::vector<std::shared_ptr<Statement>> statement
     }
 
     environment = previous;
+    return completion;
+}
+
+Completion Interpreter::executeBody(const FunctionStmt& function,
+    const std::shared_ptr<Environment>& frame) const
+{
+    if (closures) return closures->runBody(*this, function, frame);
+    return executeBlock(function.body, frame);
 }
 
-void Interpreter::resolve(ExprPtr expr, int depth)
+// Anything but a normal completion ends the statement list early
+Completion Interpreter::executeStatements(const std::vector<StmtPtr>& statements) const
 {
-    locals[expr] = depth;
+    for (const auto& statement : statements)
+    {
+        Completion completion = execute(statement);
+        if (completion != Completion::NORMAL) return completion;
+    }
+    return Completion::NORMAL;
+}
+
+void Interpreter::declare(const Token& name, int slot, LiteralValue value) const
+{
+    if (slot < 0) environment->define(name.symbol, std::move(value));
+    else          environment->defineAt(slot, std::move(value));
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// stringify()
+// stringify() / appendTo()
 // Converts any LiteralValue into a human-readable string for output.
 // This is used by print statements.
 // Handles:
-//   • Numbers → trims trailing zeros
+//   • Numbers → the shortest text that reads back as the same double
+//               (std::to_chars): 3, 0.1, 0.30000000000000004, 1e+21
 //   • Strings → as-is
 //   • Booleans → true/false
 //   • nullptr / monostate → "NOTHING"
 // ─────────────────────────────────────────────────────────────────────────────
 std::string Interpreter::stringify(const LiteralValue& obj)
 {
-    auto func = [] (auto&& val) -> std::string 
-    {
-        using T = std::decay_t<decltype(val)>;
-
-        if constexpr (std::is_same_v<T, nullptr_t> || std::is_same_v<T, std::monostate>) return "NOTHING";
-        else if constexpr (std::is_same_v<T, bool>) return val ? "true" : "false";
-        else if constexpr (std::is_same_v<T, std::string>) return val;
-        else if constexpr (std::is_same_v<T, double>)
-        {
-            std::string text = std::to_string(val);
-            text.erase(text.find_last_not_of('0') + 1);  // Remove trailing zeroes
-            if (text.back() == '.') text.pop_back();     // Remove lone dot
-            return text;
-        }
-        else if constexpr (std::is_same_v<T, std::shared_ptr<FlintCallable>>) {
-            return val -> toString();  // call custom string method on function
-        }
-        else if constexpr (std::is_same_v<T, std::shared_ptr<FlintClass>>) {
-            return val -> toString();  // call custom string method on class
-        }
-        else if constexpr (std::is_same_v<T, std::shared_ptr<FlintInstance>>) {
-            return val -> toString();  // call custom string method on class
-        }
-        else if constexpr (std::is_same_v<T, std::shared_ptr<FlintArray>>) {
-            return val -> toString();
-        }
-        else if constexpr (std::is_same_v<T, std::shared_ptr<FlintString>>) {
-            return val -> value;
-        }
-        else {
-            return "<unknown>";
-        }
-    };
+    if (FlintString* str = obj.as<FlintString>()) return str->value;
+    std::string text;
+    appendTo(text, obj);
+    return text;
+}
 
-    return std::visit(func, obj);
+void Interpreter::appendTo(std::string& out, const LiteralValue& obj)
+{
+    if (obj.isNumber())
+    {
+        // Plain digits from 1e-6 up to 1e21, an exponent outside (as
+        // JavaScript prints numbers), so integers never turn into 1e+05
+        double number = obj.asNumber();
+        double magnitude = std::fabs(number);
+        std::chars_format format = number == 0 || (magnitude >= 1e-6 && magnitude < 1e21)
+                                 ? std::chars_format::fixed : std::chars_format::scientific;
+        char buffer[32];   // Enough for the longest of either, 1e21 - 1 included
+        char* end = std::to_chars(buffer, buffer + sizeof buffer, number, format).ptr;
+        out.append(buffer, end);
+    }
+    else if (obj.isNothing()) out += "NOTHING";
+    else if (obj.isBool()) out += obj.asBool() ? "true" : "false";
+    else if (FlintString* str = obj.as<FlintString>()) out += str->value;
+    // Arrays, instances, classes and every callable (including the bytecode
+    // VM's objects) describe themselves
+    else out += obj.asObject() -> toString();
 }
 
 bool Interpreter::isNumber(const std::string& str) 
@@ -284,103 +660,150 @@ bool Interpreter::isNumber(const std::string& str)
 // Statement Visitor Implementations
 // These overloads are invoked via std::visit inside execute().
 // ─────────────────────────────────────────────────────────────────────────────
-void Interpreter::operator()(const IfStmt& stmt) const
+Completion Interpreter::operator()(const IfStmt& stmt) const
 {
-    if(evaluator -> isTruthy(evaluator -> evaluate(stmt.condition))) execute(stmt.thenBranch);
-    else if(stmt.elseBranch) execute(stmt.elseBranch);
+    if(evaluator -> isTruthy(evaluator -> evaluate(stmt.condition))) return execute(stmt.thenBranch);
+    else if(stmt.elseBranch) return execute(stmt.elseBranch);
+    return Completion::NORMAL;
 }
 
-void Interpreter::operator()(const WhileStmt& stmt) const
+// The loop consumes break and continue; a return passes through
+Completion Interpreter::operator()(const WhileStmt& stmt) const
 {
-    bool previousInsideLoop = isInsideLoop;
-    isInsideLoop = true;
     while (evaluator -> isTruthy(evaluator -> evaluate(stmt.condition)))
     { 
-        // If a return/break is already set, stop the loop
-        if (const_cast<Interpreter*>(this)->returning) break;
-        if (const_cast<Interpreter*>(this)->breaking) {
-            // consuming the break here
-            const_cast<Interpreter*>(this)->breaking = false;
-            break;
-        }
-        if (const_cast<Interpreter*>(this)->continuing) {
-            // consume the continue and proceed to next iteration
-            const_cast<Interpreter*>(this)->continuing = false;
-            continue;
-        }
-
-        execute(stmt.statement);
-
-        // After executing the body, check flags and act accordingly
-        if (const_cast<Interpreter*>(this)->returning) break;
+        step(stmt.line);
+        Completion completion = execute(stmt.statement);
+        if (completion == Completion::RETURN) return completion;
+        if (completion == Completion::BREAK) break;
+    }
+    return Completion::NORMAL;
+}
 
-        if (const_cast<Interpreter*>(this)->breaking) {
-            const_cast<Interpreter*>(this)->breaking = false;
-            break;
-        }
+Completion Interpreter::operator()(const FunctionStmt &stmt) const
+{
+    Ref<FlintFunction> function = 
+        makeRef<FlintFunction>(&stmt, environment);
+    declare(*stmt.name, stmt.slot, function);
+    return Completion::NORMAL;
+}
 
-        if (const_cast<Interpreter*>(this)->continuing) {
-            const_cast<Interpreter*>(this)->continuing = false;
-            continue;
-        }
-    }
-    isInsideLoop = previousInsideLoop;
+// The value waits in returnValue until the call that is returning takes it.
+// Returning a call is a tail call (see TailCall).
+Completion Interpreter::operator()(const ReturnStmt &stmt) const
+{
+    if (!stmt.val) returnValue = nullptr;
+    else if (const Call* call = std::get_if<Call>(stmt.val)) returnValue = evaluator -> tailCall(*call);
+    else returnValue = evaluator -> evaluate(stmt.val);
+    return Completion::RETURN;
 }
 
-void Interpreter::operator()(const FunctionStmt &stmt) const
+Completion Interpreter::operator()(const BreakStmt& stmt) const
 {
-    std::shared_ptr<FunctionStmt> statmentPtr = std::make_shared<FunctionStmt>(stmt);
-    std::shared_ptr<FlintFunction> function = 
-        std::make_shared<FlintFunction>(statmentPtr, environment, false);
-    environment -> define(stmt.name -> lexeme, function);
+    if(!stmt.insideLoop) throw RuntimeError(stmt.keyword, "Cannot use 'break' outside of a loop");
+    return Completion::BREAK;
 }
 
-void Interpreter::operator()(const ReturnStmt &stmt) const
+Completion Interpreter::operator()(const ContinueStmt& stmt) const
 {
-    LiteralValue val = nullptr;
-    if(stmt.val) val = evaluator -> evaluate(stmt.val);
-     
-    // set interpreter-level return flag and value (no exceptions)
-    const_cast<Interpreter*>(this)->returning = true;
-    const_cast<Interpreter*>(this)->returnValue = val;
-    return;
+    if(!stmt.insideLoop) throw RuntimeError(stmt.keyword, "Cannot use 'continue' outside of a loop");
+    return Completion::CONTINUE;
 }
 
-void Interpreter::operator()(const BreakStmt& stmt) const
+// A `let` initializer gives the loop one scope for all its iterations
+Completion Interpreter::operator()(const ForStmt& stmt) const
 {
-    if(!isInsideLoop) throw RuntimeError(stmt.keyword, "Cannot use 'break' outside of a loop");
-    const_cast<Interpreter*>(this)->breaking = true;
-    return;
+    if (!stmt.hasScope) return executeFor(stmt);
+
+    Frame frame(*this, environment, stmt.slotCount, stmt.isCaptured);
+    auto previous = environment;
+    environment = frame.environment();
+
+    Completion completion;
+    try
+    {
+        completion = executeFor(stmt);
+    }
+    catch (...)
+    {
+        environment = previous;
+        throw;
+    }
+
+    environment = previous;
+    return completion;
 }
 
-void Interpreter::operator()(const ContinueStmt& stmt) const
+Completion Interpreter::executeFor(const ForStmt& stmt) const
 {
-    if(!isInsideLoop) throw RuntimeError(stmt.keyword, "Cannot use 'continue' outside of a loop");
-    const_cast<Interpreter*>(this)->continuing = true;
-    return;
+    if (stmt.initializer) execute(stmt.initializer);
+
+    while (!stmt.condition || forCondition(stmt))
+    {
+        step(stmt.line);
+
+        // `continue` only skips the rest of the body; the increment still runs
+        Completion completion = execute(stmt.body);
+        if (completion == Completion::RETURN) return completion;
+        if (completion == Completion::BREAK) break;
+
+        if (!stmt.increment) continue;
+
+        // Counted loop: bump the counter in place while it is a number
+        if (stmt.counterSlot >= 0)
+        {
+            const LiteralValue& counter = environment->getAt(0, stmt.counterSlot);
+            if (counter.isNumber())
+            {
+                environment->defineAt(stmt.counterSlot, counter.asNumber() + stmt.step);
+                continue;
+            }
+        }
+        evaluator->evaluate(stmt.increment);
+    }
+    return Completion::NORMAL;
 }
 
-void Interpreter::operator()(const TryCatchContinueStmt& stmt) const
+// ─────────────────────────────────────────────────────────────────────────────
+// A counted loop compares its counter with the limit without dispatching on
+// the Binary node; anything but two numbers takes the ordinary operator path
+// with the operands already evaluated.
+// ─────────────────────────────────────────────────────────────────────────────
+bool Interpreter::forCondition(const ForStmt& stmt) const
 {
-    // Execute the wrapped body. If it set the continuing flag, swallow it here
-    execute(stmt.body);
-    if (const_cast<Interpreter*>(this)->continuing) {
-        // swallow the continue so outer code (like increment) still runs
-        const_cast<Interpreter*>(this)->continuing = false;
+    const Binary* test = stmt.counterSlot >= 0 ? std::get_if<Binary>(stmt.condition) : nullptr;
+    if (!test) return Evaluator::isTruthy(evaluator->evaluate(stmt.condition));
+
+    LiteralValue counter = environment->getAt(0, stmt.counterSlot);
+    LiteralValue limit = evaluator->evaluate(test->right);
+    if (!counter.isNumber() || !limit.isNumber())
+        return Evaluator::isTruthy(evaluator->binaryOperation(*test, counter, limit));
+
+    double i = counter.asNumber(), n = limit.asNumber();
+    switch (test->op.type)
+    {
+        case TokenType::LESS:          return i < n;
+        case TokenType::LESS_EQUAL:    return i <= n;
+        case TokenType::GREATER:       return i > n;
+        case TokenType::GREATER_EQUAL: return i >= n;
+        default: return Evaluator::isTruthy(evaluator->binaryOperation(*test, counter, limit));
     }
 }
 
 // Expression statement: evaluates expression and discards result (side effects only)
-void Interpreter::operator()(const ExpressionStmt& exprStatement) const
+Completion Interpreter::operator()(const ExpressionStmt& exprStatement) const
 {
     evaluator->evaluate(exprStatement.expression);
+    return Completion::NORMAL;
 }
 
 // LET statement: evaluates right-hand expression and stores it in the environment
-void Interpreter::operator()(const LetStmt& letStatement) const
+Completion Interpreter::operator()(const LetStmt& letStatement) const
 {
-    for (const auto &[name, initializer] : letStatement.declarations)
+    const auto& slots = letStatement.slots;
+    for (size_t i = 0; i < letStatement.declarations.size(); ++i)
     {
+        const auto &[name, initializer] = letStatement.declarations[i];
         LiteralValue value = nullptr;
 
         if (initializer != nullptr)
@@ -388,63 +811,60 @@ void Interpreter::operator()(const LetStmt& letStatement) const
             value = evaluator -> evaluate(initializer);  // evaluate expression
         }
 
-        environment->define(name.lexeme, value);
+        declare(name, slots.empty() ? -1 : slots[i], value);
     }
+    return Completion::NORMAL;
 }
 
-void Interpreter::operator()(const BlockStmt& blockStatement) const
+Completion Interpreter::operator()(const BlockStmt& blockStatement) const
 {
-    auto env = std::make_shared<Environment>(environment);
-    executeBlock(blockStatement.statements, env);
+    // A block that declares nothing has no scope of its own (the Resolver
+    // resolved its body against the enclosing one)
+    if (!blockStatement.hasScope) return executeStatements(blockStatement.statements);
+
+    Frame frame(*this, environment, blockStatement.slotCount, blockStatement.isCaptured);
+    return executeBlock(blockStatement.statements, frame.environment());
 }
 
-void Interpreter::operator()(const ClassStmt& classStmt) const
+Completion Interpreter::operator()(const ClassStmt& classStmt) const
 {
     LiteralValue superClass = nullptr;
-    std::shared_ptr<FlintClass> convertedClass = nullptr;
+    Ref<FlintClass> convertedClass = nullptr;
 
     if(classStmt.superClass)
     {
         superClass = evaluator -> evaluate(classStmt.superClass);
-        if(!std::holds_alternative<std::shared_ptr<FlintCallable>>(superClass))
-        {
+        convertedClass = superClass.ref<FlintClass>();
+        if (!convertedClass) 
             throw RuntimeError(classStmt.name, "Superclass must be a class.");
-        }
-        else
-        {
-            convertedClass = std::dynamic_pointer_cast<FlintClass>(
-                std::get<std::shared_ptr<FlintCallable>>(superClass));
-            if (!convertedClass) 
-                throw RuntimeError(classStmt.name, "Superclass must be a class.");
-        }
     }
-    environment -> define(classStmt.name.lexeme, nullptr);
+    declare(classStmt.name, classStmt.slot, nullptr);
 
     if(convertedClass) {
-        environment =  std::make_shared<Environment>(environment);
-        environment -> define("super", convertedClass);
+        environment =  std::make_shared<Environment>(environment, 1);
+        environment -> defineAt(0, convertedClass);  // 'super' is slot 0
     }
-    std::unordered_map<std::string, std::shared_ptr<FlintFunction>> classMethods;
-    std::unordered_map<std::string, std::shared_ptr<FlintFunction>> instanceMethods;
+    std::unordered_map<Symbol, Ref<FlintFunction>> classMethods;
+    // Copy-down inheritance: the superclass's (already flat) table first,
+    // then this class's own methods over the ones they override
+    std::unordered_map<Symbol, Ref<FlintFunction>> instanceMethods;
+    if (convertedClass) instanceMethods = convertedClass -> methods();
     for(auto method : classStmt.classMethods)
     {
-        auto methodPtr = std::make_shared<FunctionStmt>
-            (std::get<FunctionStmt>(*method));
-        auto function = std::make_shared<FlintFunction>
-            (methodPtr, environment, methodPtr -> name -> lexeme == "init");
-        classMethods[methodPtr -> name -> lexeme] = function;
+        const FunctionStmt* methodPtr = &std::get<FunctionStmt>(*method);
+        auto function = makeRef<FlintFunction>(methodPtr, environment);
+        classMethods[methodPtr -> name -> symbol] = function;
     }
     for(auto method : classStmt.instanceMethods)
     {
-        auto methodPtr = std::make_shared<FunctionStmt>
-            (std::get<FunctionStmt>(*method));
-        auto function = std::make_shared<FlintFunction>
-            (methodPtr, environment, methodPtr -> name -> lexeme == "init");
-        instanceMethods[methodPtr -> name -> lexeme] = function;
+        const FunctionStmt* methodPtr = &std::get<FunctionStmt>(*method);
+        auto function = makeRef<FlintFunction>(methodPtr, environment);
+        instanceMethods[methodPtr -> name -> symbol] = function;
     }
-    std::shared_ptr<FlintCallable> klass = std::make_shared<FlintClass>
-        (classStmt.name.lexeme, instanceMethods, classMethods, convertedClass);
+    Ref<FlintClass> klass = makeRef<FlintClass>
+        (std::string(classStmt.name.lexeme), instanceMethods, classMethods, convertedClass);
 
     if (convertedClass) environment = environment -> enclosing;
-    environment -> assign(classStmt.name, klass);
+    declare(classStmt.name, classStmt.slot, klass);
+    return Completion::NORMAL;
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "Flint/Optimizer/Optimizer.h"
+#include "Flint/Exceptions/RuntimeError.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Optimizer
+// Simplifies the resolved AST of one unit without changing what it does
+// (see Optimizer.h).  The tree is walked bottom-up, so a parent sees its
+// children already folded.
+// ─────────────────────────────────────────────────────────────────────────────
+
+void Optimizer::optimize(std::vector<StmtPtr>& statements)
+{
+    for (StmtPtr& stmt : statements) optimize(stmt);
+}
+
+void Optimizer::optimize(StmtPtr& slot)
+{
+    if (StmtPtr replacement = std::visit(*this, *slot)) slot = replacement;
+}
+
+void Optimizer::optimize(ExprPtr& slot)
+{
+    if (!slot) return;
+    if (ExprPtr replacement = std::visit(*this, *slot)) slot = replacement;
+}
+
+const LiteralValue* Optimizer::constant(ExprPtr expr)
+{
+    const Literal* literal = std::get_if<Literal>(expr);
+    return literal ? &literal->value : nullptr;
+}
+
+template <typename Node>
+ExprPtr Optimizer::fold(const Node& node)
+{
+    try {
+        LiteralValue value = evaluator(node);
+        return arena.make<ExpressionNode>(std::in_place_type<Literal>, std::move(value));
+    } catch (const RuntimeError&) {
+        return nullptr;   // Leave it to fail at runtime, as written
+    }
+}
+
+StmtPtr Optimizer::emptyStatement()
+{
+    StmtPtr empty = arena.make<Statement>(std::in_place_type<BlockStmt>, std::vector<StmtPtr>{});
+    std::get<BlockStmt>(*empty).hasScope = false;
+    return empty;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Statements
+// ─────────────────────────────────────────────────────────────
+
+StmtPtr Optimizer::operator()(ExpressionStmt& stmt)
+{
+    optimize(stmt.expression);
+    return nullptr;
+}
+
+StmtPtr Optimizer::operator()(FunctionStmt& stmt)
+{
+    if (stmt.deferred) stmt.deferred->optimize = true;   // Once it is parsed
+    optimize(stmt.body);
+    return nullptr;
+}
+
+// A loop whose condition is a falsy literal never runs its body
+StmtPtr Optimizer::operator()(WhileStmt& stmt)
+{
+    optimize(stmt.condition);
+    optimize(stmt.statement);
+
+    const LiteralValue* condition = constant(stmt.condition);
+    if (condition && !Evaluator::isTruthy(*condition)) return emptyStatement();
+    return nullptr;
+}
+
+StmtPtr Optimizer::operator()(ReturnStmt& stmt)
+{
+    optimize(stmt.val);
+    return nullptr;
+}
+
+// A for loop keeps its initializer even when the condition is falsy; a
+// truthy literal condition is the same as none
+StmtPtr Optimizer::operator()(ForStmt& stmt)
+{
+    if (stmt.initializer) optimize(stmt.initializer);
+    if (stmt.condition)   optimize(stmt.condition);
+    optimize(stmt.body);
+    if (stmt.increment)   optimize(stmt.increment);
+
+    const LiteralValue* condition = stmt.condition ? constant(stmt.condition) : nullptr;
+    if (!condition) return nullptr;
+
+    if (Evaluator::isTruthy(*condition))
+        stmt.condition = nullptr;
+    else
+    {
+        stmt.body = emptyStatement();
+        stmt.increment = nullptr;
+    }
+    return nullptr;
+}
+
+// With a literal condition only one branch can run; it takes the if's place
+StmtPtr Optimizer::operator()(IfStmt& stmt)
+{
+    optimize(stmt.condition);
+    optimize(stmt.thenBranch);
+    if (stmt.elseBranch) optimize(stmt.elseBranch);
+
+    const LiteralValue* condition = constant(stmt.condition);
+    if (!condition) return nullptr;
+
+    if (Evaluator::isTruthy(*condition)) return stmt.thenBranch;
+    return stmt.elseBranch ? stmt.elseBranch : emptyStatement();
+}
+
+StmtPtr Optimizer::operator()(LetStmt& stmt)
+{
+    for (auto& [name, initializer] : stmt.declarations) optimize(initializer);
+    return nullptr;
+}
+
+StmtPtr Optimizer::operator()(BlockStmt& stmt)
+{
+    optimize(stmt.statements);
+    return nullptr;
+}
+
+// Methods are optimized in place: the class keeps pointing at the same nodes
+StmtPtr Optimizer::operator()(ClassStmt& stmt)
+{
+    for (StmtPtr method : stmt.instanceMethods) (*this)(std::get<FunctionStmt>(*method));
+    for (StmtPtr method : stmt.classMethods) (*this)(std::get<FunctionStmt>(*method));
+    return nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Expressions
+// ─────────────────────────────────────────────────────────────
+
+ExprPtr Optimizer::operator()(Binary& expr)
+{
+    optimize(expr.left);
+    optimize(expr.right);
+
+    if (!constant(expr.left)) return nullptr;
+
+    // `constant, x` only keeps the side effects (and value) of x
+    if (expr.op.type == TokenType::COMMA) return expr.right;
+
+    return constant(expr.right) ? fold(expr) : nullptr;
+}
+
+// A literal left operand decides the result: either it is the result
+// (short-circuit), or the right operand is
+ExprPtr Optimizer::operator()(Logical& expr)
+{
+    optimize(expr.left);
+    optimize(expr.right);
+
+    const LiteralValue* left = constant(expr.left);
+    if (!left) return nullptr;
+
+    bool shortCircuits = expr.op.type == TokenType::OR ? Evaluator::isTruthy(*left)
+                                                       : !Evaluator::isTruthy(*left);
+    return shortCircuits ? expr.left : expr.right;
+}
+
+ExprPtr Optimizer::operator()(Conditional& expr)
+{
+    optimize(expr.condition);
+    optimize(expr.left);
+    optimize(expr.right);
+
+    const LiteralValue* condition = constant(expr.condition);
+    if (!condition) return nullptr;
+    return Evaluator::isTruthy(*condition) ? expr.left : expr.right;
+}
+
+ExprPtr Optimizer::operator()(Unary& expr)
+{
+    optimize(expr.right);
+    return constant(expr.right) ? fold(expr) : nullptr;
+}
+
+// Parentheses only shape the parse; the node itself evaluates its inside
+ExprPtr Optimizer::operator()(Grouping& expr)
+{
+    optimize(expr.expression);
+    return expr.expression;
+}
+
+ExprPtr Optimizer::operator()(Assignment& expr)
+{
+    optimize(expr.value);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(Lambda& expr)
+{
+    (*this)(*expr.function);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(Call& expr)
+{
+    optimize(expr.callee);
+    for (ExprPtr& argument : expr.arguments) optimize(argument);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(Get& expr)
+{
+    optimize(expr.object);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(Set& expr)
+{
+    optimize(expr.object);
+    optimize(expr.value);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(Array& expr)
+{
+    for (ExprPtr& element : expr.elements) optimize(element);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(GetIndex& expr)
+{
+    optimize(expr.array);
+    optimize(expr.index);
+    return nullptr;
+}
+
+ExprPtr Optimizer::operator()(SetIndex& expr)
+{
+    optimize(expr.array);
+    optimize(expr.index);
+    optimize(expr.value);
+    return nullptr;
+}
@@ -0,0 +1,187 @@
+#include "Flint/Interpreter/Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Profiler.cpp – Call Timing, Line Sampling and the Reports
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+    double milliseconds(Profiler::Clock::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+}
+
+Profiler::Profiler(std::chrono::microseconds interval) : interval(interval)
+{
+    functions.push_back(Function{"<script>", 1});
+    functions[0].active = 1;
+    nodes.push_back(Node{0, 0});
+    stack.push_back(Frame{0, 0, Clock::now()});
+
+    sampler = std::thread([this] { sample(); });
+}
+
+Profiler::~Profiler()
+{
+    stop();
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// Calls
+//──────────────────────────────────────────────────────────────────────────────
+
+uint32_t Profiler::child(uint32_t node, uint32_t function)
+{
+    for (auto& [fn, id] : nodes[node].children)
+        if (fn == function) return id;
+    uint32_t id = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node{function, node});
+    nodes[node].children.emplace_back(function, id);
+    return id;
+}
+
+void Profiler::push(uint32_t function)
+{
+    if (stopped) return;
+    Function& fn = functions[function];
+    ++fn.calls;
+    ++fn.active;
+    uint32_t node = child(stack.back().node, function);
+    stack.push_back(Frame{node, function, Clock::now(), {},
+                          currentLine.load(std::memory_order_relaxed)});
+}
+
+void Profiler::leave()
+{
+    if (stopped || stack.size() <= 1) return;
+    Frame frame = stack.back();
+    stack.pop_back();
+
+    Clock::duration elapsed = Clock::now() - frame.start;
+    Clock::duration self = elapsed - frame.children;
+
+    Function& fn = functions[frame.function];
+    fn.exclusive += self;
+    if (--fn.active == 0) fn.inclusive += elapsed;
+    nodes[frame.node].self += self;
+
+    stack.back().children += elapsed;
+    at(frame.line);
+}
+
+void Profiler::unwindTo(size_t calls)
+{
+    while (depth() > calls) leave();
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// Lines
+//──────────────────────────────────────────────────────────────────────────────
+
+void Profiler::sample()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!wake.wait_for(lock, interval, [this] { return quit; })) {
+        uint32_t line = currentLine.load(std::memory_order_relaxed);
+        if (line != 0) ++lineSamples[line];
+        ++samples;
+    }
+}
+
+void Profiler::stop()
+{
+    if (stopped) return;
+    unwindTo(0);
+
+    Frame& script = stack.front();
+    total = Clock::now() - script.start;
+    Clock::duration self = total - script.children;
+    functions[0].inclusive = total;
+    functions[0].exclusive = self;
+    nodes[0].self = self;
+    stopped = true;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_one();
+    if (sampler.joinable()) sampler.join();
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// Reports
+//──────────────────────────────────────────────────────────────────────────────
+
+void Profiler::report(std::ostream& out)
+{
+    stop();
+
+    std::vector<const Function*> byTime;
+    for (const Function& fn : functions) byTime.push_back(&fn);
+    std::stable_sort(byTime.begin(), byTime.end(), [](const Function* a, const Function* b) {
+        return a->exclusive > b->exclusive;
+    });
+
+    double whole = std::max(milliseconds(total), 1e-9);
+    std::ios flags(nullptr);
+    flags.copyfmt(out);
+
+    out << "── profile: " << std::fixed << std::setprecision(2) << milliseconds(total) << " ms ──\n";
+    out << std::right << std::setw(10) << "calls"
+        << std::setw(13) << "incl ms" << std::setw(13) << "excl ms" << std::setw(8) << "excl %"
+        << "  function\n";
+    for (const Function* fn : byTime) {
+        out << std::setw(10) << fn->calls
+            << std::setw(13) << milliseconds(fn->inclusive)
+            << std::setw(13) << milliseconds(fn->exclusive)
+            << std::setw(7) << std::setprecision(1) << 100.0 * milliseconds(fn->exclusive) / whole << "%"
+            << std::setprecision(2) << "  " << fn->name << "\n";
+    }
+
+    if (!lineSamples.empty()) {
+        std::vector<std::pair<uint32_t, uint64_t>> lines(lineSamples.begin(), lineSamples.end());
+        std::sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        if (lines.size() > 20) lines.resize(20);
+
+        out << "── hottest lines (" << samples << " samples) ──\n";
+        out << std::setw(10) << "samples" << std::setw(8) << "%" << "  line\n";
+        for (auto& [line, count] : lines)
+            out << std::setw(10) << count
+                << std::setw(7) << std::setprecision(1) << 100.0 * count / std::max<uint64_t>(samples, 1) << "%"
+                << "  " << line << "\n";
+    }
+
+    out.copyfmt(flags);
+}
+
+bool Profiler::writeCollapsed(const std::string& path)
+{
+    stop();
+
+    std::ofstream out(path);
+    if (!out) return false;
+
+    // Depth first from the script, keeping the path to the current node
+    std::string prefix;
+    auto walk = [&](auto& self, uint32_t id) -> void {
+        const Node& node = nodes[id];
+        size_t length = prefix.size();
+        if (id != 0) prefix += ';';
+        prefix += functions[node.function].name;
+
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(node.self).count();
+        if (micros > 0) out << prefix << ' ' << micros << '\n';
+        for (auto& [fn, childId] : node.children) self(self, childId);
+
+        prefix.resize(length);
+    };
+    walk(walk, 0);
+
+    return static_cast<bool>(out);
+}
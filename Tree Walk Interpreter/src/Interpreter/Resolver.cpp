@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Flint/Resolver/Resolver.h"
 #include "Flint/Flint.h"
 
@@ -5,15 +6,32 @@
 // Resolver
 // Performs a static, lexical‐scope analysis of AST nodes to:
 //  • detect illegal uses (e.g., return outside function),
-//  • resolve each variable and “this” access to its lexical depth,
-//  • prepare the Interpreter’s locals map for fast lookups.
+//  • resolve each variable and “this” access to its lexical depth and slot,
+//  • record how many slots each block/function frame needs,
+//  • store each resolved address directly in its AST node for fast lookups.
 // ─────────────────────────────────────────────────────────────────────────────
 
-// BlockStmt: each block opens a new scope, resolves its statements, then closes.
+// BlockStmt: each block that declares something opens a new scope, resolves
+// its statements, then closes.  A block that declares nothing gets no scope,
+// so the interpreter runs it without creating an environment.
 void Resolver::operator()(const BlockStmt &stmt)
 {
+    stmt.hasScope = std::any_of(stmt.statements.begin(), stmt.statements.end(),
+        [](StmtPtr s) {
+            return std::holds_alternative<LetStmt>(*s) ||
+                   std::holds_alternative<FunctionStmt>(*s) ||
+                   std::holds_alternative<ClassStmt>(*s);
+        });
+    if (!stmt.hasScope) {
+        resolve(stmt.statements);
+        return;
+    }
+
     beginScope();              // push a fresh scope map
+    frames.push_back(&stmt.isCaptured);
     resolve(stmt.statements);  // resolve inner statements
+    stmt.slotCount = (int)scopes.back().size();  // frame size for the runtime
+    frames.pop_back();
     endScope();                // pop back to outer scope
 }
 
@@ -21,8 +39,10 @@ void Resolver::operator()(const BlockStmt &stmt)
 void Resolver::operator()(const LetStmt &stmt)
 {
     // Phase 1: declare all variables (marks them as 'declared but uninitialized')
+    stmt.slots.clear();
     for (auto& [name, initializer] : stmt.declarations) {
-        declare(name);
+        int slot = declare(name);
+        if (slot >= 0) stmt.slots.push_back(slot);
     }
     // Phase 2: resolve initializers, then mark as defined
     for (auto& [name, initializer] : stmt.declarations) {
@@ -35,8 +55,9 @@ void Resolver::operator()(const LetStmt &stmt)
 // FunctionStmt: declare the function name, then resolve its body
 void Resolver::operator()(const FunctionStmt &stmt)
 {
+    captureEnclosingFrames();
     if (stmt.name.has_value()) {
-        declare(stmt.name.value());  // makes the name visible in outer scope
+        stmt.slot = declare(stmt.name.value());  // makes the name visible in outer scope
         define(stmt.name.value());   // marks it ready for calls (allows recursion)
     }
     resolveFunction(stmt, FunctionType::FUNCTION);
@@ -57,10 +78,64 @@ void Resolver::operator()(const IfStmt &stmt)
         resolve(stmt.elseBranch);
 }
 
-// TryCatchContinueStmt: we only care about body (we’ll catch ContinueExceptions at runtime)
-void Resolver::operator()(const TryCatchContinueStmt &stmt)
+// ForStmt: a `let` initializer gets one scope for the whole loop.  Resolved
+// in execution order (initializer, condition, body, increment).
+void Resolver::operator()(const ForStmt &stmt)
 {
+    const LetStmt* let = stmt.initializer ? std::get_if<LetStmt>(stmt.initializer) : nullptr;
+    stmt.hasScope = let != nullptr;
+    if (stmt.hasScope) {
+        beginScope();
+        frames.push_back(&stmt.isCaptured);
+    }
+
+    if (stmt.initializer) resolve(stmt.initializer);
+    if (stmt.condition)   resolve(stmt.condition);
+    loopDepth++;
     resolve(stmt.body);
+    loopDepth--;
+    if (stmt.increment)   resolve(stmt.increment);
+
+    stmt.counterSlot = -1;
+    if (stmt.hasScope) {
+        stmt.slotCount = (int)scopes.back().size();
+        frames.pop_back();
+        endScope();
+
+        if (let->declarations.size() == 1 && let->slots.size() == 1)
+            resolveCountedLoop(stmt, let->slots[0]);
+    }
+}
+
+// Spots `for (let i = a; i <op> n; i = i ± step)` with a numeric literal step,
+// where both `i`s in the condition and increment are the loop's slot
+void Resolver::resolveCountedLoop(const ForStmt& stmt, int slot)
+{
+    auto isCounter = [slot](ExprPtr expr) {
+        const Variable* variable = expr ? std::get_if<Variable>(expr) : nullptr;
+        return variable && variable->local.depth == 0 && variable->local.slot == slot;
+    };
+
+    const Binary* test = stmt.condition ? std::get_if<Binary>(stmt.condition) : nullptr;
+    if (!test || !isCounter(test->left)) return;
+    switch (test->op.type) {
+        case TokenType::LESS: case TokenType::LESS_EQUAL:
+        case TokenType::GREATER: case TokenType::GREATER_EQUAL: break;
+        default: return;
+    }
+
+    const Assignment* update = stmt.increment ? std::get_if<Assignment>(stmt.increment) : nullptr;
+    if (!update || update->local.depth != 0 || update->local.slot != slot) return;
+
+    const Binary* sum = std::get_if<Binary>(update->value);
+    if (!sum || !isCounter(sum->left)) return;
+    if (sum->op.type != TokenType::PLUS && sum->op.type != TokenType::MINUS) return;
+
+    const Literal* step = std::get_if<Literal>(sum->right);
+    if (!step || !step->value.isNumber()) return;
+
+    stmt.counterSlot = slot;
+    stmt.step = sum->op.type == TokenType::PLUS ? step->value.asNumber() : -step->value.asNumber();
 }
 
 // ReturnStmt: ensure we're inside a function; initializers forbid return
@@ -78,25 +153,29 @@ void Resolver::operator()(const ReturnStmt &stmt)
 void Resolver::operator()(const WhileStmt &stmt)
 {
     resolve(stmt.condition);
+    loopDepth++;
     resolve(stmt.statement);
+    loopDepth--;
 }
 
-// ContinueStmt & BreakStmt: no resolution needed, runtime handled
-void Resolver::operator()(const ContinueStmt &stmt) { /* nothing */ }
-void Resolver::operator()(const BreakStmt &stmt)    { /* nothing */ }
+// ContinueStmt & BreakStmt: record whether a loop encloses them; outside one
+// they are a runtime error, as in the bytecode VM
+void Resolver::operator()(const ContinueStmt &stmt) { stmt.insideLoop = loopDepth > 0; }
+void Resolver::operator()(const BreakStmt &stmt)    { stmt.insideLoop = loopDepth > 0; }
 
 // ClassStmt: handles static & instance methods, sets up ‘this’ binding
 void Resolver::operator()(const ClassStmt& classStatement)
 {
     auto enclosing = currentClass;
     currentClass = ClassType::CLASS;
+    captureEnclosingFrames();  // Methods close over the declaring scope
 
-    declare(classStatement.name);  // placeholder so class name is in scope
+    classStatement.slot = declare(classStatement.name);  // placeholder so class name is in scope
     define(classStatement.name);   // now resolvable inside methods
 
     if (classStatement.superClass && 
-        std::get<Variable>(*classStatement.superClass).name.lexeme == 
-        classStatement.name.lexeme) {
+        std::get<Variable>(*classStatement.superClass).name.symbol == 
+        classStatement.name.symbol) {
         
         Flint::error(std::get<Variable>
             (*classStatement.superClass).name, "A class can't inherit from itself.");
@@ -106,47 +185,42 @@ void Resolver::operator()(const ClassStmt& classStatement)
         currentClass = ClassType::SUBCLASS;
         resolve(classStatement.superClass);
         beginScope();
-        scopes.back()["super"] = true;
+        scopes.back()[Symbols::SUPER] = { true, 0 };
     }
 
-    // ‘this’ is valid within instance‐method scopes
-    beginScope();
-    scopes.back()["this"] = true;
-
+    // ‘this’ is declared by resolveFunction in each method's own frame
     // Resolve class (static) methods
     for (auto&& m : classStatement.classMethods) {
-        FunctionStmt method = std::get<FunctionStmt>(*m);
+        const FunctionStmt& method = std::get<FunctionStmt>(*m);
         auto type = FunctionType::METHOD;
-        if (method.name->lexeme == "init") type = FunctionType::INITIALIZER;
+        if (method.name->symbol == Symbols::INIT) type = FunctionType::INITIALIZER;
         resolveFunction(method, type);
     }
     // Resolve instance methods
     for (auto&& m : classStatement.instanceMethods) {
-        FunctionStmt method = std::get<FunctionStmt>(*m);
+        const FunctionStmt& method = std::get<FunctionStmt>(*m);
         auto type = FunctionType::METHOD;
-        if (method.name->lexeme == "init") type = FunctionType::INITIALIZER;
+        if (method.name->symbol == Symbols::INIT) type = FunctionType::INITIALIZER;
         resolveFunction(method, type);
     }
 
-    endScope();
-
     if (classStatement.superClass) endScope();
     currentClass = enclosing;
 }
 
 // Variable expr: check for self‐reference in initializer, then record its depth
-void Resolver::operator()(const Variable &expr, ExprPtr exprPtr)
+void Resolver::operator()(const Variable &expr)
 {
     if (!scopes.empty()) {
         auto &scope = scopes.back();
-        auto it = scope.find(expr.name.lexeme);
+        auto it = scope.find(expr.name.symbol);
         // if declared but not yet defined → illegal read in its own init
-        if (it != scope.end() && !it->second)
+        if (it != scope.end() && !it->second.defined)
             Flint::error(expr.name,
-                "Cannot read local variable '" + expr.name.lexeme +
+                "Cannot read local variable '" + std::string(expr.name.lexeme) +
                 "' in its own initializer.");
     }
-    resolveLocal(exprPtr, expr.name);
+    resolveLocal(expr.local, expr.name);
 }
 
 // Binary expr: resolve subexpressions
@@ -171,10 +245,10 @@ void Resolver::operator()(const Grouping &expr)
 }
 
 // Assignment expr: resolve RHS, then register the write at correct depth
-void Resolver::operator()(const Assignment &expr, ExprPtr exprPtr)
+void Resolver::operator()(const Assignment &expr)
 {
     resolve(expr.value);
-    resolveLocal(exprPtr, expr.name);
+    resolveLocal(expr.local, expr.name);
 }
 
 // Literal expr: nothing to do
@@ -198,7 +272,8 @@ void Resolver::operator()(const Conditional &expr)
 // Lambda expr: treat as a function body with its own scope
 void Resolver::operator()(const Lambda &expr)
 {
-    resolveFunction(*expr.function.get(), FunctionType::LAMBDA);
+    captureEnclosingFrames();
+    resolveFunction(*expr.function, FunctionType::LAMBDA);
 }
 
 // Unary expr: resolve the single operand
@@ -221,16 +296,16 @@ void Resolver::operator()(const Set& expr)
 }
 
 // This expr: ensure within a class, then record it
-void Resolver::operator()(const This& expr, ExprPtr exprPtr)
+void Resolver::operator()(const This& expr)
 {
     if (currentClass == ClassType::NONE)
         Flint::error(expr.keyword,
                      "Use of 'this' outside a class is not allowed.");
-    resolveLocal(exprPtr, expr.keyword);
+    resolveLocal(expr.local, expr.keyword);
 }
 
 // Super expr: resolve super keyword for super classes
-void Resolver::operator()(const Super& expr, ExprPtr exprPtr)
+void Resolver::operator()(const Super& expr)
 {
     if (currentClass == ClassType::NONE)
         Flint::error(expr.keyword,
@@ -241,7 +316,7 @@ void Resolver::operator()(const Super& expr, ExprPtr exprPtr)
             "Use of 'super' inside a class with no super class is not allowed."
         );
     
-    resolveLocal(exprPtr, expr.keyword);
+    resolveLocal(expr.local, expr.keyword);
 }
 
 void Resolver::operator()(const Array& expr) 
@@ -264,17 +339,19 @@ void Resolver::operator()(const SetIndex& expr)
     resolve(expr.value);
 }
 
-// resolveLocal: find the nearest scope containing the name and tell
-// the interpreter the lexical distance for fast lookups at runtime.
-void Resolver::resolveLocal(ExprPtr expr, Token name)
+// resolveLocal: find the nearest scope containing the name and write its
+// lexical distance and slot into the AST node for fast lookups at runtime.
+void Resolver::resolveLocal(LocalSlot& local, const Token& name)
 {
     for (int i = scopes.size() - 1; i >= 0; --i) {
-        if (scopes[i].count(name.lexeme)) {
-            interpreter->resolve(expr, (int)scopes.size() - 1 - i);
+        auto it = scopes[i].find(name.symbol);
+        if (it != scopes[i].end()) {
+            local = LocalSlot{ (int)scopes.size() - 1 - i, it->second.slot };
             return;
         }
     }
     // if not found, it's global
+    local = LocalSlot{};
 }
 
 // resolveFunction: open a new scope for parameters + body, remember
@@ -285,36 +362,85 @@ void Resolver::resolveFunction(const FunctionStmt &stmt, FunctionType type)
         Flint::error(*stmt.name,
             "Use of getter/setter outside a class.");
 
+    // Methods receive 'this' in slot 0 of their frame, ahead of the
+    // parameters, so calling one needs no separate bound environment
+    stmt.hasReceiver = type == FunctionType::METHOD || type == FunctionType::INITIALIZER;
+    stmt.isInitializer = type == FunctionType::INITIALIZER;
+    stmt.arity = (int)stmt.params.size();
+
+    // A deferred body is resolved on the first call, by resolveDeferred
+    if (stmt.deferred) {
+        stmt.deferred->type = type;
+        stmt.deferred->classType = currentClass;
+        return;
+    }
+
     auto enclosing = currentFunction;
+    int enclosingLoopDepth = loopDepth;
     currentFunction = type;
+    loopDepth = 0;   // A loop outside the function is not one break can leave
+    frames.push_back(&stmt.isCaptured);
 
     beginScope();
+    if (stmt.hasReceiver) scopes.back()[Symbols::THIS] = { true, 0 };
+
     for (auto& param : stmt.params) {
         declare(param);
         define(param);
     }
     resolve(stmt.body);
+    stmt.slotCount = (int)scopes.back().size();  // parameters + body locals
     endScope();
 
+    frames.pop_back();
     currentFunction = enclosing;
+    loopDepth = enclosingLoopDepth;
+}
+
+// resolveDeferred: the body of a function the Parser deferred (see
+// DeferredBody), once it has been parsed.  Its declaration was at the top
+// level, so the same context is only the class around it, if any, and a
+// subclass's 'super' scope.
+void Resolver::resolveDeferred(const FunctionStmt &stmt, FunctionType type, ClassType classType)
+{
+    currentClass = classType;
+    if (classType == ClassType::SUBCLASS) {
+        beginScope();
+        scopes.back()[Symbols::SUPER] = { true, 0 };
+    }
+    resolveFunction(stmt, type);
+    if (classType == ClassType::SUBCLASS) endScope();
+    currentClass = ClassType::NONE;
+}
+
+// captureEnclosingFrames: the closure about to be created holds the current
+// environment, and with it every enclosing function frame and block scope,
+// so none of those may come from the Interpreter's reusable frame stack.
+void Resolver::captureEnclosingFrames()
+{
+    for (bool* captured : frames)
+        *captured = true;
 }
 
 // declare: add a name to the current scope as 'declared but not yet defined'
-void Resolver::declare(Token name)
+// and give it the next free slot.  Globals have no slot (-1).
+int Resolver::declare(const Token& name)
 {
-    if (scopes.empty()) return;
+    if (scopes.empty()) return -1;
     auto &scope = scopes.back();
-    if (scope.count(name.lexeme))
+    if (scope.count(name.symbol))
         Flint::error(name,
-            "Variable '" + name.lexeme + "' already declared in this scope.");
-    scope[name.lexeme] = false;
+            "Variable '" + std::string(name.lexeme) + "' already declared in this scope.");
+    int slot = (int)scope.size();
+    scope[name.symbol] = { false, slot };
+    return slot;
 }
 
 // define: mark a name in the current scope as fully initialized
-void Resolver::define(Token name)
+void Resolver::define(const Token& name)
 {
     if (scopes.empty()) return;
-    scopes.back()[name.lexeme] = true;
+    scopes.back()[name.symbol].defined = true;
 }
 
 // scope management
@@ -322,28 +448,17 @@ void Resolver::beginScope() { scopes.emplace_back(); }
 void Resolver::endScope()   { scopes.pop_back(); }
 
 // Convenience overloads to kick off resolution on lists or single nodes
-void Resolver::resolve(std::vector<std::shared_ptr<Statement>> statements)
+void Resolver::resolve(const std::vector<StmtPtr>& statements)
 {
     for (auto& stmt : statements) resolve(stmt);
 }
 
-void Resolver::resolve(std::shared_ptr<Statement> statement)
+void Resolver::resolve(StmtPtr statement)
 {
-    std::visit(*this, *statement.get());
+    std::visit(*this, *statement);
 }
 
 void Resolver::resolve(ExprPtr expr)
 {
-    std::visit([&](auto& actualExpr) {
-        using T = std::decay_t<decltype(actualExpr)>;
-        if constexpr (std::is_same_v<T, Variable> ||
-                      std::is_same_v<T, Assignment> ||
-                      std::is_same_v<T, This> ||
-                      std::is_same_v<T, Super>)
-        {
-            (*this)(actualExpr, expr);
-        } else {
-            (*this)(actualExpr);
-        }
-    }, *expr);
+    std::visit(*this, *expr);
 }
\ No newline at end of file
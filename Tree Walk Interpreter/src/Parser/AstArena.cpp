@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <cstdint>
+#include "Flint/Parser/AstArena.h"
+
+// Run the pending destructors (newest first, so parents go before the
+// children they were built from), then drop every block at once.
+AstArena::~AstArena()
+{
+    for (Finalizer* f = finalizers; f; f = f->next)
+        f->destroy(f->object);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Bump-allocates `size` bytes at `alignment`.  Requests that do
+// not fit in the current block start a new one; oversized ones
+// get a block of their own.
+// ─────────────────────────────────────────────────────────────
+void* AstArena::allocate(size_t size, size_t alignment)
+{
+    auto align = [alignment](std::byte* p) {
+        auto address = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(alignment - 1));
+    };
+
+    std::byte* start = cursor ? align(cursor) : nullptr;
+    if (!start || start + size > limit)
+    {
+        size_t blockSize = std::max(BLOCK_SIZE, size + alignment);
+        blocks.emplace_back(new std::byte[blockSize]);
+        cursor = blocks.back().get();
+        limit = cursor + blockSize;
+        start = align(cursor);
+    }
+
+    cursor = start + size;
+    allocated += size;
+    return start;
+}
@@ -6,30 +6,46 @@
 // Entry point: parse a sequence of statements until EOF.
 // Returns a vector of Statement AST nodes for interpretation.
 // ─────────────────────────────────────────────────────────────────────────────
-std::vector<std::shared_ptr<Statement>> Parser::parse()
+std::vector<StmtPtr> Parser::parse()
 {
-    std::vector<std::shared_ptr<Statement>> statements;
+    std::vector<StmtPtr> statements;
     // Keep consuming top‑level declarations/statements until we hit END_OF_FILE
     while (!isAtEnd()) {
+        topLevel = true;
         statements.push_back(declareStatement());
     }
     return statements;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// A deferred function body, from its '{'.  A syntax error in it has been
+// reported by the time this returns.
+// ─────────────────────────────────────────────────────────────────────────────
+std::vector<StmtPtr> Parser::parseBody()
+{
+    try {
+        consume(TokenType::LEFT_BRACE, "Expected '{' to start function body.");
+        return blockStatement();
+    } catch (ParseError error) {
+        return {};
+    }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Top‑level “declaration or statement” parser.
 // Distinguishes class/func/let from other statements.
 // Uses exception-based error recovery to skip bad tokens.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::declareStatement()
+StmtPtr Parser::declareStatement()
 {
+    size_t line = peek().line;
     try {
         if (match({ TokenType::CLASS }))
-            return parseClassDeclaration();
+            return startingAt(line, parseClassDeclaration());
         if (match({ TokenType::FUNC }))
-            return parseFuncDeclaration("function");
+            return startingAt(line, parseFuncDeclaration("function"));
         if (match({ TokenType::LET }) && check(TokenType::IDENTIFIER))
-            return parseVarDeclaration();
+            return startingAt(line, parseVarDeclaration());
         // Fallback: parse as a normal statement
         return parseStatement();
     } catch (ParseError error) {
@@ -44,7 +60,7 @@ std::shared_ptr<Statement> Parser::declareStatement()
 // Parse class name, then member declarations until '}'.
 // Collects instance vs. static methods separately.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::parseClassDeclaration()
+StmtPtr Parser::parseClassDeclaration()
 {
     // Require an identifier for the class name
     Token name = consume(TokenType::IDENTIFIER, "Expected an identifier for class name.");
@@ -58,8 +74,8 @@ std::shared_ptr<Statement> Parser::parseClassDeclaration()
 
     consume(TokenType::LEFT_BRACE, "Expected '{' at the start of class body.");
 
-    std::vector<std::shared_ptr<Statement>> instanceMethods;
-    std::vector<std::shared_ptr<Statement>> classMethods;
+    std::vector<StmtPtr> instanceMethods;
+    std::vector<StmtPtr> classMethods;
 
     // Loop until we see the closing brace
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
@@ -81,7 +97,7 @@ std::shared_ptr<Statement> Parser::parseClassDeclaration()
 // let a = 1, b, c = foo();
 // Parses one or more comma‑separated declarations.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::parseVarDeclaration()
+StmtPtr Parser::parseVarDeclaration()
 {
     std::vector<std::pair<Token, ExprPtr>> declarations;
 
@@ -108,7 +124,7 @@ std::shared_ptr<Statement> Parser::parseVarDeclaration()
 // function foo(...) { ... }  
 // or a “getter” if no parens follow the name.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::parseFuncDeclaration(std::string&& kind)
+StmtPtr Parser::parseFuncDeclaration(std::string&& kind)
 {
     Token name = consume(TokenType::IDENTIFIER, "Expected " + kind + " name.");
 
@@ -137,40 +153,54 @@ std::shared_ptr<Statement> Parser::parseFuncDeclaration(std::string&& kind)
 
     // Parse the function body as a block
     consume(TokenType::LEFT_BRACE, "Expected '{' to start " + kind + " body.");
+
+    // Deferred bodies: only those whose enclosing scope is the globals (and
+    // a superclass's), which is all resolving them on their own must replay
+    if (deferBodies && topLevel) {
+        const Token& brace = previous();
+        DeferredBody* deferred = arena.make<DeferredBody>(
+            DeferredBody{ Flint::running(), &arena, brace.offset, brace.line });
+        skipBody();
+        StmtPtr function = makeStmt<FunctionStmt>(name, params, std::vector<StmtPtr>{}, isGetter);
+        std::get<FunctionStmt>(*function).deferred = deferred;
+        return startingAt(name.line, function);
+    }
     auto body = blockStatement();
 
-    return makeStmt<FunctionStmt>(name, params, body, isGetter);
+    // Methods are not statements of their own: their line is the name's
+    return startingAt(name.line, makeStmt<FunctionStmt>(name, params, body, isGetter));
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Dispatch based on leading token: if/for/while/etc.
 // Otherwise parse as an expression statement.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::parseStatement()
+StmtPtr Parser::parseStatement()
 {
-    if      (match({ TokenType::IF }))       return ifStatement();
-    else if (match({ TokenType::FOR }))      return forStatement();
-    else if (match({ TokenType::WHILE }))    return whileStatement();
-    else if (match({ TokenType::RETURN }))   return returnStatement();
-    else if (match({ TokenType::BREAK }))    return breakStatement();
-    else if (match({ TokenType::CONTINUE })) return continueStatement();
+    size_t line = peek().line;
+    if      (match({ TokenType::IF }))       return startingAt(line, ifStatement());
+    else if (match({ TokenType::FOR }))      return startingAt(line, forStatement());
+    else if (match({ TokenType::WHILE }))    return startingAt(line, whileStatement());
+    else if (match({ TokenType::RETURN }))   return startingAt(line, returnStatement());
+    else if (match({ TokenType::BREAK }))    return startingAt(line, breakStatement());
+    else if (match({ TokenType::CONTINUE })) return startingAt(line, continueStatement());
     else if (match({ TokenType::LEFT_BRACE }))
-        return makeStmt<BlockStmt>(blockStatement());
+        return startingAt(line, makeStmt<BlockStmt>(blockStatement()));
 
-    return expressionStatement();
+    return startingAt(line, expressionStatement());
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // if (cond) thenBranch else elseBranch
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::ifStatement()
+StmtPtr Parser::ifStatement()
 {
     consume(TokenType::LEFT_PAREN,  "Expected '(' after 'if'.");
     ExprPtr condition = expression();
     consume(TokenType::RIGHT_PAREN, "Expected ')' after if condition.");
 
     auto thenBranch = parseStatement();
-    std::shared_ptr<Statement> elseBranch = nullptr;
+    StmtPtr elseBranch = nullptr;
     if (match({ TokenType::ELSE })) {
         elseBranch = parseStatement();
     }
@@ -181,7 +211,7 @@ std::shared_ptr<Statement> Parser::ifStatement()
 // ─────────────────────────────────────────────────────────────────────────────
 // while (cond) body
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::whileStatement()
+StmtPtr Parser::whileStatement()
 {
     consume(TokenType::LEFT_PAREN,  "Expected '(' after 'while'.");
     ExprPtr condition = expression();
@@ -194,7 +224,7 @@ std::shared_ptr<Statement> Parser::whileStatement()
 // ─────────────────────────────────────────────────────────────────────────────
 // return expr? ;
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::returnStatement()
+StmtPtr Parser::returnStatement()
 {
     Token keyword = previous();
     ExprPtr value = nullptr;
@@ -208,7 +238,7 @@ std::shared_ptr<Statement> Parser::returnStatement()
 // ─────────────────────────────────────────────────────────────────────────────
 // break ;
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::breakStatement()
+StmtPtr Parser::breakStatement()
 {
     Token keyword = previous();
     consume(TokenType::SEMICOLON, "Expected ';' after break.");
@@ -218,7 +248,7 @@ std::shared_ptr<Statement> Parser::breakStatement()
 // ─────────────────────────────────────────────────────────────────────────────
 // continue ;
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::continueStatement()
+StmtPtr Parser::continueStatement()
 {
     Token keyword = previous();
     consume(TokenType::SEMICOLON, "Expected ';' after continue.");
@@ -227,16 +257,14 @@ std::shared_ptr<Statement> Parser::continueStatement()
 
 // ─────────────────────────────────────────────────────────────────────────────
 // for ( init; cond; incr ) body
-// Transforms into:
-// { init; while(cond) { body; incr; } }
-// Wraps body in TryCatchContinue to handle continue properly.
+// Every clause is optional; a missing condition loops forever.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::forStatement()
+StmtPtr Parser::forStatement()
 {
     consume(TokenType::LEFT_PAREN,  "Expected '(' after 'for'.");
 
     // Parse initializer (let, expression, or empty)
-    std::shared_ptr<Statement> initializer;
+    StmtPtr initializer;
     if      (match({ TokenType::SEMICOLON })) initializer = nullptr;
     else if (match({ TokenType::LET      })) initializer = parseVarDeclaration();
     else                                       initializer = expressionStatement();
@@ -256,43 +284,18 @@ std::shared_ptr<Statement> Parser::forStatement()
     consume(TokenType::RIGHT_PAREN, "Expected ')' after for clauses.");
 
     // Parse the loop body
-    auto body = parseStatement();
-
-    // If there's an increment, execute it after each iteration
-    if (increment) {
-        body = makeStmt<BlockStmt>(
-            std::vector<std::shared_ptr<Statement>>{
-                makeStmt<TryCatchContinueStmt>(body),
-                makeStmt<ExpressionStmt>(increment)
-            }
-        );
-    } else {
-        // Still catch continues so they don't skip the increment
-        body = makeStmt<TryCatchContinueStmt>(body);
-    }
-
-    // Default condition to true if omitted
-    if (!condition) {
-        condition = makeExpr<Literal>(true);
-    }
-    // Build a while loop around the body
-    body = makeStmt<WhileStmt>(condition, body);
+    StmtPtr body = parseStatement();
 
-    // If there was an initializer, wrap everything in a block
-    if (initializer) {
-        body = makeStmt<BlockStmt>(
-            std::vector<std::shared_ptr<Statement>>{ initializer, body }
-        );
-    }
-    return body;
+    return makeStmt<ForStmt>(initializer, condition, increment, body);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Parses a sequence '{ ... }' into a vector of statements.
 // ─────────────────────────────────────────────────────────────────────────────
-std::vector<std::shared_ptr<Statement>> Parser::blockStatement()
+std::vector<StmtPtr> Parser::blockStatement()
 {
-    std::vector<std::shared_ptr<Statement>> statements;
+    topLevel = false;
+    std::vector<StmtPtr> statements;
     // Keep parsing declarations/statements until '}'
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
         statements.push_back(declareStatement());
@@ -301,11 +304,25 @@ std::vector<std::shared_ptr<Statement>> Parser::blockStatement()
     return statements;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Skips a deferred body after its '{', matching braces until the one that
+// closes it.  Strings and comments were already taken apart by the Scanner,
+// so a brace token is always a real one.
+// ─────────────────────────────────────────────────────────────────────────────
+void Parser::skipBody()
+{
+    for (int depth = 1; depth > 0; advance()) {
+        if (isAtEnd()) throw error(peek(), "Expect '}' at end of block.");
+        if (check(TokenType::LEFT_BRACE)) ++depth;
+        else if (check(TokenType::RIGHT_BRACE)) --depth;
+    }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // expr;
 // Parses a standalone expression followed by semicolon.
 // ─────────────────────────────────────────────────────────────────────────────
-std::shared_ptr<Statement> Parser::expressionStatement()
+StmtPtr Parser::expressionStatement()
 {
     ExprPtr expr = expression();
     consume(TokenType::SEMICOLON, "Expected ';' after expression.");
@@ -448,7 +465,7 @@ ExprPtr Parser::comparison()
     if (match({ TokenType::LESS, TokenType::LESS_EQUAL,
                 TokenType::GREATER, TokenType::GREATER_EQUAL })) {
         Token op = previous();
-        error(op, "Missing left-hand operand before '" + op.lexeme + "'.");
+        error(op, "Missing left-hand operand before '" + std::string(op.lexeme) + "'.");
         return term();
     }
 
@@ -484,7 +501,7 @@ ExprPtr Parser::factor()
     // Early error if operator without left operand
     if (match({ TokenType::STAR, TokenType::SLASH, TokenType::MODULO })) {
         Token op = previous();
-        error(op, "Missing left-hand operand before '" + op.lexeme + "'.");
+        error(op, "Missing left-hand operand before '" + std::string(op.lexeme) + "'.");
         return unary();
     }
 
@@ -576,8 +593,9 @@ ExprPtr Parser::primary()
     if (match({ TokenType::FALSE }))   return makeExpr<Literal>(false);
     if (match({ TokenType::TRUE  }))   return makeExpr<Literal>(true);
     if (match({ TokenType::NOTHING })) return makeExpr<Literal>(std::monostate{});
-    if (match({ TokenType::NUMBER, TokenType::STRING }))
-        return makeExpr<Literal>(previous().literal);
+    if (match({ TokenType::NUMBER }))  return makeExpr<Literal>(previous().literal);
+    if (match({ TokenType::STRING }))
+        return makeExpr<Literal>(stringConstant(previous().literal));
     if (match({ TokenType::FUNC }))    return lambda();
     if (match({ TokenType::THIS }))    return makeExpr<This>(previous());
     if (match({ TokenType::SUPER })) {
@@ -618,6 +636,7 @@ ExprPtr Parser::primary()
 // ─────────────────────────────────────────────────────────────────────────────
 ExprPtr Parser::lambda()
 {
+    size_t line = previous().line;   // 'func'
     consume(TokenType::LEFT_PAREN, "Expected '(' after 'func'.");
     std::vector<Token> params;
     if (!check(TokenType::RIGHT_PAREN)) {
@@ -632,14 +651,15 @@ ExprPtr Parser::lambda()
     consume(TokenType::LEFT_BRACE,  "Expected '{' before lambda body.");
     auto body = blockStatement();
     // Lambdas have no name, so pass nullopt
-    auto fnStmt = std::make_shared<FunctionStmt>(std::nullopt, params, body);
+    auto fnStmt = arena.make<FunctionStmt>(std::nullopt, std::move(params), std::move(body));
+    fnStmt->line = line;
     return makeExpr<Lambda>(fnStmt);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // match/check/advance/consume implement the basic token‐stream API.
 // ─────────────────────────────────────────────────────────────────────────────
-bool Parser::match(const std::vector<TokenType>& types)
+bool Parser::match(std::initializer_list<TokenType> types)
 {
     for (auto t : types) {
         if (check(t)) {
@@ -656,13 +676,18 @@ bool Parser::check(TokenType type)
     return peek().type == type;
 }
 
-Token Parser::advance()
+// The returned token stays valid until the next advance()
+const Token& Parser::advance()
 {
-    if (!isAtEnd()) current++;
+    if (!isAtEnd())
+    {
+        consumed = std::move(lookahead);
+        lookahead = scanner.next();
+    }
     return previous();
 }
 
-Token Parser::consume(TokenType type, const std::string& message)
+const Token& Parser::consume(TokenType type, const std::string& message)
 {
     if (check(type)) return advance();
     throw error(peek(), message);
@@ -693,18 +718,39 @@ void Parser::synchronize()
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// AST node constructors: wrap raw data into shared‐ptr AST nodes.
+// AST node constructors: build each node in place, in the arena.
 // ─────────────────────────────────────────────────────────────────────────────
 template<typename T, typename... Args>
 ExprPtr Parser::makeExpr(Args&&... args)
 {
-    return std::make_shared<ExpressionNode>(T(std::forward<Args>(args)...));
+    return arena.make<ExpressionNode>(std::in_place_type<T>, std::forward<Args>(args)...);
 }
 
 template<typename T, typename... Args>
-std::shared_ptr<Statement> Parser::makeStmt(Args&&... args)
+StmtPtr Parser::makeStmt(Args&&... args)
+{
+    return arena.make<Statement>(std::in_place_type<T>, std::forward<Args>(args)...);
+}
+
+// Records the line a statement starts on
+StmtPtr Parser::startingAt(size_t line, StmtPtr stmt)
+{
+    std::visit([line](auto& node) { node.line = line; }, *stmt);
+    return stmt;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Returns the pooled FlintString for a string literal token; the first token
+// seen with a given text supplies the shared object.  Literal nodes share it; evaluating one never
+// allocates.
+// ─────────────────────────────────────────────────────────────────────────────
+LiteralValue Parser::stringConstant(const LiteralValue& literal)
 {
-    return std::make_shared<Statement>(T(std::forward<Args>(args)...));
+    FlintString* text = literal.as<FlintString>();
+    auto it = stringConstants.find(text->value);
+    if (it == stringConstants.end())
+        it = stringConstants.emplace(text->value, Ref<FlintString>(text)).first;
+    return it->second;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -724,12 +770,12 @@ bool Parser::isAtEnd() const
     return peek().type == TokenType::END_OF_FILE;
 }
 
-Token Parser::peek() const
+const Token& Parser::peek() const
 {
-    return tokens.at(current);
+    return lookahead;
 }
 
-Token Parser::previous() const
+const Token& Parser::previous() const
 {
-    return tokens.at(current - 1);
+    return consumed;
 }
\ No newline at end of file
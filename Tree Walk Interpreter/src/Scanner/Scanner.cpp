@@ -7,14 +7,16 @@
 // The scanner also handles whitespace, comments, and error reporting.
 // ------------------------------------------------------------
 
+#include <charconv>
 #include "Flint/Scanner/Scanner.h"
 #include "Flint/Flint.h"
+#include "Flint/FlintString.h"
 
 // ---------------------------------------------------------------------------
 // Static map of reserved keywords mapped to their TokenTypes.
 // If an identifier matches one of these, it’s emitted as that keyword token.
 // ---------------------------------------------------------------------------
-std::unordered_map<std::string, TokenType> Scanner::keywords = 
+const std::unordered_map<std::string_view, TokenType> Scanner::keywords = 
 {
     {"and",      TokenType::AND},
     {"or",       TokenType::OR},
@@ -36,29 +38,34 @@ std::unordered_map<std::string, TokenType> Scanner::keywords =
 };
 
 // ---------------------------------------------------------------------------
-// Scanner constructor stores the source code string.
+// Scanner constructor keeps a view of the source code.
 // ---------------------------------------------------------------------------
-Scanner::Scanner(const std::string& source)
-{
-    this->source = source;
-}
+Scanner::Scanner(std::string_view source) : source(source) {}
+
+Scanner::Scanner(std::string_view source, size_t offset, size_t line)
+    : source(source), start(offset), current(offset), line(line) {}
 
 // ---------------------------------------------------------------------------
-// Main scanner loop: tokenizes the entire source code into tokens.
-// Adds an EOF token at the end to signal end-of-input.
+// Main scanner loop: scans lexemes until one yields a token.
+// Returns an EOF token at the end to signal end-of-input.
 // ---------------------------------------------------------------------------
-std::vector<Token> Scanner::scanTokens()
+Token Scanner::next()
 {
-    // Continue until we've consumed every character
     while (!isAtEnd())
     {
         start = current;     // mark beginning of next lexeme
-        scanToken();         // scan one token
+        scanToken();         // scan one lexeme
+        if (scanned)
+        {
+            Token token = std::move(*scanned);
+            scanned.reset();
+            return token;
+        }
     }
 
-    // Append end-of-file token so parser knows when to stop
-    tokens.push_back(Token(TokenType::END_OF_FILE, "", std::monostate{}, line));
-    return tokens;
+    // End-of-file token so parser knows when to stop
+    return Token(TokenType::END_OF_FILE, "", Token::NO_SYMBOL, static_cast<uint32_t>(current),
+                 std::monostate{}, line);
 }
 
 // ---------------------------------------------------------------------------
@@ -204,7 +211,7 @@ bool Scanner::isAlphaNumeric(char c) const
 bool Scanner::match(char expected)
 {
     if (isAtEnd()) return false;
-    if (source.at(current) != expected) return false;
+    if (source[current] != expected) return false;
 
     current++;
     return true;
@@ -215,7 +222,7 @@ bool Scanner::match(char expected)
 // ---------------------------------------------------------------------------
 char Scanner::peek() const
 {
-    return isAtEnd() ? '\0' : source.at(current);
+    return isAtEnd() ? '\0' : source[current];
 }
 
 // ---------------------------------------------------------------------------
@@ -223,7 +230,7 @@ char Scanner::peek() const
 // ---------------------------------------------------------------------------
 char Scanner::peekNext() const
 {
-    return (current + 1 >= source.length()) ? '\0' : source.at(current + 1);
+    return (current + 1 >= source.length()) ? '\0' : source[current + 1];
 }
 
 // ---------------------------------------------------------------------------
@@ -273,7 +280,7 @@ void Scanner::string()
     }
 
     // emit the STRING token with its extracted value
-    addToken(TokenType::STRING, value);
+    addToken(TokenType::STRING, makeRef<FlintString>(std::move(value)));
 }
 
 // ---------------------------------------------------------------------------
@@ -321,9 +328,10 @@ void Scanner::number()
         while (isDigit(peek())) advance();
     }
 
-    // convert text to double
-    std::string text = source.substr(start, current - start);
-    addToken(TokenType::NUMBER, std::stod(text));
+    // convert text to double, in place
+    double value = 0;
+    std::from_chars(source.data() + start, source.data() + current, value);
+    addToken(TokenType::NUMBER, value);
 }
 
 // ---------------------------------------------------------------------------
@@ -334,7 +342,7 @@ void Scanner::identifier()
 {
     while (isAlphaNumeric(peek())) advance();
 
-    std::string text = source.substr(start, current - start);
+    std::string_view text(source.data() + start, current - start);
     auto it = keywords.find(text);
 
     // if it's a keyword, use its type; otherwise IDENTIFIER
@@ -347,11 +355,12 @@ void Scanner::identifier()
 
 // ---------------------------------------------------------------------------
 // Advances the cursor by one and returns the consumed character.
+// Callers check isAtEnd() (or peek()) first.
 // ---------------------------------------------------------------------------
 char Scanner::advance()
 {
     current++;
-    return source.at(current - 1);
+    return source[current - 1];
 }
 
 // ---------------------------------------------------------------------------
@@ -364,10 +373,15 @@ void Scanner::addToken(TokenType type)
 
 // ---------------------------------------------------------------------------
 // Adds a token with an associated literal value (e.g., number, string).
-// Extracts the lexeme text and stores line number.
+// The lexeme stays a view into the source; only names are interned.
 // ---------------------------------------------------------------------------
 void Scanner::addToken(TokenType type, LiteralValue literal)
 {
-    std::string lexeme = source.substr(start, current - start);
-    tokens.push_back(Token(type, lexeme, literal, line));
+    std::string_view lexeme(source.data() + start, current - start);
+    Symbol symbol = Token::NO_SYMBOL;
+    if (type == TokenType::IDENTIFIER) symbol = SymbolTable::intern(lexeme);
+    else if (type == TokenType::THIS)  symbol = Symbols::THIS;
+    else if (type == TokenType::SUPER) symbol = Symbols::SUPER;
+
+    scanned.emplace(type, lexeme, symbol, static_cast<uint32_t>(start), std::move(literal), line);
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "Flint/Scanner/SourceText.h"
+
+SourceText::SourceText(std::string text) : owned(std::move(text)), view(owned) {}
+
+SourceText::SourceText(std::unique_ptr<MappedFile> file) : file(std::move(file)), view(this->file->text()) {}
+
+std::shared_ptr<const SourceText> SourceText::fromFile(const std::string& path)
+{
+    auto file = std::make_unique<MappedFile>(path);
+    if (!*file) return nullptr;
+    return std::make_shared<const SourceText>(std::move(file));
+}
+
+std::shared_ptr<const SourceText> SourceText::fromString(std::string text)
+{
+    return std::make_shared<const SourceText>(std::move(text));
+}
@@ -0,0 +1,72 @@
+// ---------------------------------------------------------------------------
+// Implements the process-wide symbol table used to intern identifier,
+// field and method names.  See SymbolTable.h for the rationale.
+// ---------------------------------------------------------------------------
+
+#include <stdexcept>
+#include "Flint/Scanner/SymbolTable.h"
+
+// ---------------------------------------------------------------------------
+// Pre-interns the well-known symbols so their IDs match the constants
+// declared in the Symbols namespace.
+// ---------------------------------------------------------------------------
+SymbolTable::SymbolTable()
+{
+    for (const char* known : { "init", "this", "super", "length",
+                               "lower", "upper", "push", "pop",
+                               "x", "y", "z", "w" })
+        add(known);
+}
+
+SymbolTable& SymbolTable::instance()
+{
+    static SymbolTable table;
+    return table;
+}
+
+// ---------------------------------------------------------------------------
+// Looks the text up and, on a miss, copies it into stable storage.
+// Blocks are allocated whole and never relocated, so the views used as map
+// keys stay valid.
+// ---------------------------------------------------------------------------
+Symbol SymbolTable::intern(std::string_view text)
+{
+    SymbolTable& table = instance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.ids.find(text);
+    if (it != table.ids.end()) return it->second;
+    return table.add(text);
+}
+
+Symbol SymbolTable::add(std::string_view text)
+{
+    if (count == BLOCK_SIZE * MAX_BLOCKS) throw std::length_error("Too many distinct names.");
+
+    std::string* block = blocks[count / BLOCK_SIZE].load(std::memory_order_relaxed);
+    if (!block)
+    {
+        block = new std::string[BLOCK_SIZE];
+        blocks[count / BLOCK_SIZE].store(block, std::memory_order_release);
+    }
+
+    Symbol symbol = static_cast<Symbol>(count++);
+    std::string& name = block[symbol % BLOCK_SIZE];
+    name = text;
+    ids.emplace(name, symbol);
+    return symbol;
+}
+
+// ---------------------------------------------------------------------------
+// A symbol reaches another thread only through something that orders its
+// interning before the read (the lock in intern, or whatever handed the
+// value over), so the slot is already filled in.
+// ---------------------------------------------------------------------------
+std::string_view SymbolTable::name(Symbol symbol)
+{
+    SymbolTable& table = instance();
+    const std::string* block = symbol / BLOCK_SIZE < MAX_BLOCKS
+        ? table.blocks[symbol / BLOCK_SIZE].load(std::memory_order_acquire) : nullptr;
+    if (!block) throw std::out_of_range("Unknown symbol.");
+    return block[symbol % BLOCK_SIZE];
+}
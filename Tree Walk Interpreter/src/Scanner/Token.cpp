@@ -10,6 +10,7 @@
 #include <sstream>  // For building the output string
 #include <iomanip>  // For controlling float precision
 #include "Flint/Scanner/Token.h"
+#include "Flint/FlintString.h"
 
 std::string Token::toString() const
 {
@@ -21,42 +22,32 @@ std::string Token::toString() const
     // 2) Print the line number where this token was found
     ss << line << " ";
 
-    // 3) Format the literal variant into a string
-    //    We use std::visit to handle each possible type in the union.
-    auto formatLiteral = [](auto&& val) -> std::string {
-        using T = std::decay_t<decltype(val)>;
-
+    // 3) Format the literal value into a string
+    auto formatLiteral = [](const LiteralValue& val) -> std::string {
         // String literals: wrap in quotes
-        if constexpr (std::is_same_v<T, std::string>) {
-            return "\"" + val + "\"";
+        if (FlintString* str = val.as<FlintString>()) {
+            return "\"" + str->value + "\"";
         }
         // Floating-point numbers: fixed notation with two decimals
-        else if constexpr (std::is_same_v<T, double>) {
+        if (val.isNumber()) {
             std::ostringstream r;
-            r << std::fixed << std::setprecision(2) << val;
+            r << std::fixed << std::setprecision(2) << val.asNumber();
             return r.str();
         }
-        // Integers: plain decimal
-        else if constexpr (std::is_same_v<T, int>) {
-            return std::to_string(val);
-        }
         // Booleans: "true" or "false"
-        else if constexpr (std::is_same_v<T, bool>) {
-            return val ? "true" : "false";
+        if (val.isBool()) {
+            return val.asBool() ? "true" : "false";
         }
-        // nullptr_t and monostate: represent absence of value
-        else if constexpr (std::is_same_v<T, std::nullptr_t> ||
-                           std::is_same_v<T, std::monostate>) {
+        // nil and undefined: represent absence of value
+        if (val.isNothing()) {
             return "nothing";
         }
         // Other types should not occur here; fallback safely
-        else {
-            return "unknown";
-        }
+        return "unknown";
     };
 
     // 4) Append the formatted literal to the output
-    ss << std::visit(formatLiteral, literal);
+    ss << formatLiteral(literal);
 
     // 5) Return the assembled string
     return ss.str();
@@ -0,0 +1,408 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include "Flint/VM/BytecodeCache.h"
+#include "Flint/FlintString.h"
+#include "Flint/MappedFile.h"
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ─────────────────────────────────────────────────────────────
+// File layout.  Offsets are from the start of the file and are
+// multiples of 8, so every record can be read in place.
+//
+//   Header
+//   FunctionRecord[functionCount]       function 0 is the script
+//   per function: code, lines, constants, names, statement starts
+//   StringRecord[stringCount], then the string bytes
+// ─────────────────────────────────────────────────────────────
+constexpr char MAGIC[8] = { 'F', 'L', 'I', 'N', 'T', 'C', '\r', '\n' };
+constexpr uint32_t FORMAT_VERSION = 2;                 // Bump when the layout or compiler output changes
+constexpr uint32_t OPCODE_COUNT = static_cast<uint32_t>(OpCode::ERROR) + 1;
+constexpr uint32_t NO_STRING = UINT32_MAX;
+constexpr uint32_t OPTIMIZED = 1;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t opcodeCount;          // Catches an OpCode list changed without a version bump
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    uint64_t fileSize;
+    uint64_t checksum;             // Of everything after the header
+    uint32_t flags;
+    uint32_t functionCount;
+    uint32_t stringCount;
+    uint32_t reserved;
+    uint64_t strings;              // Offset of the StringRecords
+};
+
+struct FunctionRecord
+{
+    uint32_t arity;
+    uint32_t upvalueCount;
+    uint32_t isGetter;
+    uint32_t name;                 // String index, or NO_STRING
+    uint32_t codeLength;           // Bytes of code, and entries of lines
+    uint32_t constantCount;
+    uint32_t nameCount;
+    uint32_t statementCount;
+    uint32_t line;                 // Of the declaration
+    uint32_t reserved;
+    uint64_t code;                 // uint8_t[codeLength]
+    uint64_t lines;                // int32_t[codeLength]
+    uint64_t constants;            // ConstantRecord[constantCount]
+    uint64_t names;                // uint32_t[nameCount], string indices
+    uint64_t statements;           // uint32_t[statementCount]
+};
+
+enum class ConstantKind : uint32_t { UNDEFINED, NIL, FALSE, TRUE, NUMBER, STRING, FUNCTION };
+
+struct ConstantRecord
+{
+    ConstantKind kind;
+    uint32_t index;                // STRING: string index; FUNCTION: function index
+    double number;                 // NUMBER
+};
+
+struct StringRecord
+{
+    uint64_t offset;
+    uint64_t length;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) % 8 == 0, "Header layout");
+static_assert(sizeof(FunctionRecord) % 8 == 0 && sizeof(ConstantRecord) == 16 && sizeof(StringRecord) == 16,
+              "Record layout");
+
+// ─────────────────────────────────────────────────────────────
+// FNV-1a over 8-byte words (the tail a byte at a time): quick
+// enough to hash a large source or cache on every start.
+// ─────────────────────────────────────────────────────────────
+uint64_t hashBytes(const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < size; ++i) hash = (hash ^ bytes[i]) * 1099511628211ull;
+    return hash;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Reader: bounds-checked views of the tables of a mapped file.
+// ─────────────────────────────────────────────────────────────
+class Reader
+{
+public:
+    explicit Reader(const MappedFile& file) : base(file.data()), size(file.size()) {}
+
+    // count records of T at `offset`, or null if they do not fit
+    template <typename T>
+    const T* table(uint64_t offset, uint64_t count) const
+    {
+        if (offset % alignof(T) != 0 || offset > size) return nullptr;
+        if (count > (size - offset) / sizeof(T)) return nullptr;
+        return reinterpret_cast<const T*>(base + offset);
+    }
+
+    const unsigned char* base;
+    size_t size;
+};
+
+// ─────────────────────────────────────────────────────────────
+// Writer: lays the functions out in preorder, so a function's
+// nested prototypes always have higher indices than it has.
+// ─────────────────────────────────────────────────────────────
+class Writer
+{
+public:
+    bool write(const Ref<VMFunction>& script, std::string& out);
+
+private:
+    uint32_t string(const std::string& text);
+    bool collect(const VMFunction* function);
+
+    template <typename T>
+    uint64_t append(const T* items, size_t count)
+    {
+        pad();
+        uint64_t offset = data.size();
+        if (count) data.append(reinterpret_cast<const char*>(items), count * sizeof(T));
+        return offset;
+    }
+
+    void pad() { data.append((8 - data.size() % 8) % 8, '\0'); }
+
+    std::vector<const VMFunction*> functions;
+    std::unordered_map<const VMFunction*, uint32_t> functionIndex;
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIndex;
+    std::string data;              // Everything after the function records
+};
+
+uint32_t Writer::string(const std::string& text)
+{
+    auto found = stringIndex.find(text);
+    if (found != stringIndex.end()) return found->second;
+    uint32_t index = static_cast<uint32_t>(strings.size());
+    strings.push_back(text);
+    stringIndex.emplace(text, index);
+    return index;
+}
+
+bool Writer::collect(const VMFunction* function)
+{
+    if (functionIndex.count(function)) return false;    // Shared prototypes do not occur
+    functionIndex.emplace(function, static_cast<uint32_t>(functions.size()));
+    functions.push_back(function);
+    for (const LiteralValue& constant : function->chunk.constants)
+        if (const VMFunction* nested = constant.as<VMFunction>())
+            if (!collect(nested)) return false;
+    return true;
+}
+
+bool Writer::write(const Ref<VMFunction>& script, std::string& out)
+{
+    if (!collect(script.get())) return false;
+
+    std::vector<FunctionRecord> records(functions.size());
+    const uint64_t dataStart = sizeof(Header) + records.size() * sizeof(FunctionRecord);
+
+    for (size_t i = 0; i < functions.size(); ++i)
+    {
+        const VMFunction& function = *functions[i];
+        const Chunk& chunk = function.chunk;
+        FunctionRecord& record = records[i];
+
+        record.arity = static_cast<uint32_t>(function.arity);
+        record.upvalueCount = static_cast<uint32_t>(function.upvalueCount);
+        record.isGetter = function.isGetter;
+        record.line = static_cast<uint32_t>(function.line);
+        record.name = function.name.empty() ? NO_STRING : string(function.name);
+
+        std::vector<ConstantRecord> constants;
+        constants.reserve(chunk.constants.size());
+        for (const LiteralValue& value : chunk.constants)
+        {
+            ConstantRecord constant{ConstantKind::UNDEFINED, 0, 0.0};
+            if (value.isUndefined()) constant.kind = ConstantKind::UNDEFINED;
+            else if (value.isNil()) constant.kind = ConstantKind::NIL;
+            else if (value.isBool()) constant.kind = value.asBool() ? ConstantKind::TRUE : ConstantKind::FALSE;
+            else if (value.isNumber())
+            {
+                constant.kind = ConstantKind::NUMBER;
+                constant.number = value.asNumber();
+            }
+            else if (const FlintString* text = value.as<FlintString>())
+            {
+                constant.kind = ConstantKind::STRING;
+                constant.index = string(text->value);
+            }
+            else if (const VMFunction* nested = value.as<VMFunction>())
+            {
+                constant.kind = ConstantKind::FUNCTION;
+                constant.index = functionIndex.at(nested);
+            }
+            else return false;     // A constant folded into some other object
+            constants.push_back(constant);
+        }
+
+        std::vector<uint32_t> names;
+        names.reserve(chunk.names.size());
+        for (Symbol name : chunk.names) names.push_back(string(std::string(SymbolTable::name(name))));
+
+        std::vector<int32_t> lines(chunk.lines.begin(), chunk.lines.end());
+        std::vector<uint32_t> statements(function.statementStarts.begin(), function.statementStarts.end());
+
+        record.codeLength = static_cast<uint32_t>(chunk.code.size());
+        record.constantCount = static_cast<uint32_t>(constants.size());
+        record.nameCount = static_cast<uint32_t>(names.size());
+        record.statementCount = static_cast<uint32_t>(statements.size());
+        record.code = dataStart + append(chunk.code.data(), chunk.code.size());
+        record.lines = dataStart + append(lines.data(), lines.size());
+        record.constants = dataStart + append(constants.data(), constants.size());
+        record.names = dataStart + append(names.data(), names.size());
+        record.statements = dataStart + append(statements.data(), statements.size());
+    }
+
+    // The string table, then the text it points at
+    std::vector<StringRecord> table(strings.size());
+    uint64_t tableOffset = append(table.data(), table.size());
+    for (size_t i = 0; i < strings.size(); ++i)
+    {
+        table[i].offset = dataStart + data.size();
+        table[i].length = strings[i].size();
+        data += strings[i];
+    }
+    std::memcpy(&data[tableOffset], table.data(), table.size() * sizeof(StringRecord));
+    pad();
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.opcodeCount = OPCODE_COUNT;
+    header.functionCount = static_cast<uint32_t>(records.size());
+    header.stringCount = static_cast<uint32_t>(strings.size());
+    header.strings = dataStart + tableOffset;
+    header.fileSize = dataStart + data.size();
+
+    out.clear();
+    out.reserve(header.fileSize);
+    out.append(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FunctionRecord));
+    out += data;
+    return true;
+}
+
+} // namespace
+
+std::string BytecodeCache::pathFor(const std::string& sourcePath)
+{
+    const std::string extension = ".flint";
+    if (sourcePath.size() >= extension.size() &&
+        sourcePath.compare(sourcePath.size() - extension.size(), extension.size(), extension) == 0)
+        return sourcePath + "c";
+    return sourcePath + ".flintc";
+}
+
+// ─────────────────────────────────────────────────────────────
+// load: everything is checked against the file's bounds before
+// it is read, and a file that fails any check is just not used.
+// ─────────────────────────────────────────────────────────────
+Ref<VMFunction> BytecodeCache::load(const std::string& path, std::string_view source, bool optimized)
+{
+    MappedFile file(path);
+    Reader reader(file);
+    const Header* header = reader.table<Header>(0, 1);
+    if (!header) return nullptr;
+
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != FORMAT_VERSION ||
+        header->opcodeCount != OPCODE_COUNT || header->fileSize != file.size() ||
+        header->flags != (optimized ? OPTIMIZED : 0) || header->sourceSize != source.size() ||
+        header->sourceHash != hashBytes(source.data(), source.size()) ||
+        header->checksum != hashBytes(file.data() + sizeof(Header), file.size() - sizeof(Header)))
+        return nullptr;
+
+    const FunctionRecord* records = reader.table<FunctionRecord>(sizeof(Header), header->functionCount);
+    const StringRecord* strings = reader.table<StringRecord>(header->strings, header->stringCount);
+    if (!records || !strings || header->functionCount == 0) return nullptr;
+
+    for (uint32_t i = 0; i < header->stringCount; ++i)
+        if (!reader.table<char>(strings[i].offset, strings[i].length)) return nullptr;
+    auto text = [&](uint32_t index) {
+        return std::string_view(reinterpret_cast<const char*>(file.data() + strings[index].offset),
+                                strings[index].length);
+    };
+
+    std::vector<Ref<VMFunction>> functions(header->functionCount);
+    for (Ref<VMFunction>& function : functions) function = makeRef<VMFunction>();
+
+    for (uint32_t i = 0; i < header->functionCount; ++i)
+    {
+        const FunctionRecord& record = records[i];
+        const uint8_t* code = reader.table<uint8_t>(record.code, record.codeLength);
+        const int32_t* lines = reader.table<int32_t>(record.lines, record.codeLength);
+        const ConstantRecord* constants = reader.table<ConstantRecord>(record.constants, record.constantCount);
+        const uint32_t* names = reader.table<uint32_t>(record.names, record.nameCount);
+        const uint32_t* statements = reader.table<uint32_t>(record.statements, record.statementCount);
+        if (!code || !lines || !constants || !names || !statements) return nullptr;
+        if (record.name != NO_STRING && record.name >= header->stringCount) return nullptr;
+
+        VMFunction& function = *functions[i];
+        function.arity = static_cast<int>(record.arity);
+        function.upvalueCount = static_cast<int>(record.upvalueCount);
+        function.isGetter = record.isGetter != 0;
+        function.line = static_cast<int>(record.line);
+        if (record.name != NO_STRING) function.name = std::string(text(record.name));
+
+        Chunk& chunk = function.chunk;
+        chunk.code.assign(code, code + record.codeLength);
+        chunk.lines.assign(lines, lines + record.codeLength);
+        function.statementStarts.assign(statements, statements + record.statementCount);
+
+        chunk.constants.reserve(record.constantCount);
+        for (uint32_t c = 0; c < record.constantCount; ++c)
+        {
+            const ConstantRecord& constant = constants[c];
+            switch (constant.kind)
+            {
+                case ConstantKind::UNDEFINED: chunk.constants.emplace_back(); break;
+                case ConstantKind::NIL:       chunk.constants.emplace_back(nullptr); break;
+                case ConstantKind::FALSE:     chunk.constants.emplace_back(false); break;
+                case ConstantKind::TRUE:      chunk.constants.emplace_back(true); break;
+                case ConstantKind::NUMBER:    chunk.constants.emplace_back(constant.number); break;
+                case ConstantKind::STRING:
+                    if (constant.index >= header->stringCount) return nullptr;
+                    chunk.constants.emplace_back(makeRef<FlintString>(std::string(text(constant.index))));
+                    break;
+                case ConstantKind::FUNCTION:
+                    // Nested prototypes come later, so no function can contain itself
+                    if (constant.index <= i || constant.index >= header->functionCount) return nullptr;
+                    chunk.constants.emplace_back(functions[constant.index]);
+                    break;
+                default: return nullptr;
+            }
+        }
+
+        chunk.names.reserve(record.nameCount);
+        for (uint32_t n = 0; n < record.nameCount; ++n)
+        {
+            if (names[n] >= header->stringCount) return nullptr;
+            chunk.names.push_back(SymbolTable::intern(text(names[n])));
+        }
+    }
+    return functions[0];
+}
+
+// ─────────────────────────────────────────────────────────────
+// store: written beside the final name, then renamed over it.
+// ─────────────────────────────────────────────────────────────
+bool BytecodeCache::store(const std::string& path, std::string_view source, bool optimized,
+                          const Ref<VMFunction>& script)
+{
+    std::string bytes;
+    if (!Writer().write(script, bytes)) return false;
+
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+    header.flags = optimized ? OPTIMIZED : 0;
+    header.sourceSize = source.size();
+    header.sourceHash = hashBytes(source.data(), source.size());
+    header.checksum = hashBytes(bytes.data() + sizeof(Header), bytes.size() - sizeof(Header));
+    std::memcpy(&bytes[0], &header, sizeof(Header));
+
+    std::string temporary = path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file.flush())
+        {
+            file.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
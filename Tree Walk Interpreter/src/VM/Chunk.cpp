@@ -0,0 +1,27 @@
+#include <algorithm>
+#include "Flint/VM/Chunk.h"
+
+void Chunk::write(uint8_t byte, int line)
+{
+    code.push_back(byte);
+    lines.push_back(line);
+}
+
+int Chunk::addConstant(LiteralValue value)
+{
+    constants.push_back(std::move(value));
+    return static_cast<int>(constants.size() - 1);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Names are few per function, so a linear scan keeps the table
+// free of duplicates without a side map.
+// ─────────────────────────────────────────────────────────────
+int Chunk::addName(Symbol name)
+{
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end()) return static_cast<int>(it - names.begin());
+
+    names.push_back(name);
+    return static_cast<int>(names.size() - 1);
+}
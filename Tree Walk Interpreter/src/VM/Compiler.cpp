@@ -0,0 +1,714 @@
+#include <utility>
+#include "Flint/VM/Compiler.h"
+#include "Flint/Flint.h"
+#include "Flint/FlintString.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Compiler
+// Lowers resolved AST nodes into bytecode, one VMFunction per function body.
+// Each visitor leaves exactly one value on the stack for an expression and
+// none for a statement.
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Name of slot 0 outside methods: holds the callee, never matches an identifier
+static const Symbol NO_NAME = SymbolTable::intern("");
+
+static constexpr int MAX_LOCALS = 256;
+static constexpr int MAX_UPVALUES = 256;
+static constexpr int MAX_ARGUMENTS = 255;
+static constexpr int MAX_OPERAND = 0xffff;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// compile()
+// The script is compiled like a function with no parameters.  The start of
+// every top-level statement is recorded so the VM can skip to the next one
+// after a runtime error.
+// ─────────────────────────────────────────────────────────────────────────────
+Ref<VMFunction> Compiler::compile(const std::vector<StmtPtr>& statements)
+{
+    FunctionState script{ nullptr, makeRef<VMFunction>(), FunctionKind::SCRIPT };
+    script.locals.push_back({ NO_NAME, 0, false });
+    current = &script;
+
+    for (const auto& statement : statements)
+    {
+        script.function->statementStarts.push_back(chunk().code.size());
+        compile(statement);
+    }
+
+    emit(OpCode::NIL);
+    emit(OpCode::RETURN);
+
+    current = nullptr;
+    return script.function;
+}
+
+void Compiler::compile(StmtPtr stmt)
+{
+    if (stmt) std::visit(*this, *stmt);
+}
+
+void Compiler::compile(const ExprPtr& expr)
+{
+    if (expr) std::visit(*this, *expr);
+    else emit(OpCode::NIL);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Statements
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::operator()(const ExpressionStmt& stmt)
+{
+    compile(stmt.expression);
+    emit(OpCode::POP);
+}
+
+// let a = 1, b;  Each initializer is evaluated in order; a local's slot is
+// simply where its initial value was pushed.
+void Compiler::operator()(const LetStmt& stmt)
+{
+    for (const auto& [name, initializer] : stmt.declarations)
+    {
+        setLine(name);
+        if (initializer) compile(initializer);
+        else emit(OpCode::NIL);
+        defineVariable(name);
+    }
+}
+
+// A local function is declared before its body is compiled, so the body
+// can call itself through its own slot.
+void Compiler::operator()(const FunctionStmt& stmt)
+{
+    setLine(*stmt.name);
+    if (current->scopeDepth > 0)
+    {
+        addLocal(stmt.name->symbol);
+        function(stmt, FunctionKind::FUNCTION);
+    }
+    else
+    {
+        function(stmt, FunctionKind::FUNCTION);
+        emitName(OpCode::DEFINE_GLOBAL, stmt.name->symbol);
+    }
+}
+
+void Compiler::operator()(const IfStmt& stmt)
+{
+    compile(stmt.condition);
+    int thenJump = emitJump(OpCode::JUMP_IF_FALSE);
+    emit(OpCode::POP);
+    compile(stmt.thenBranch);
+
+    int elseJump = emitJump(OpCode::JUMP);
+    patchJump(thenJump);
+    emit(OpCode::POP);
+    compile(stmt.elseBranch);
+    patchJump(elseJump);
+}
+
+void Compiler::operator()(const WhileStmt& stmt)
+{
+    int loopStart = static_cast<int>(chunk().code.size());
+    compile(stmt.condition);
+    int exitJump = emitJump(OpCode::JUMP_IF_FALSE);
+    emit(OpCode::POP);
+
+    current->loops.push_back({ current->scopeDepth, {} });
+    current->continues.push_back({ current->scopeDepth, loopStart, {} });
+
+    compile(stmt.statement);
+    emitLoop(loopStart);
+
+    current->continues.pop_back();
+    Loop loop = std::move(current->loops.back());
+    current->loops.pop_back();
+
+    patchJump(exitJump);
+    emit(OpCode::POP);
+
+    // Breaks leave after the condition has already been popped
+    for (int jump : loop.breakJumps) patchJump(jump);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// for (initializer; condition; increment) body
+// The initializer's variables live in a scope around the whole loop.
+// `continue` jumps forward to the increment.
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::operator()(const ForStmt& stmt)
+{
+    beginScope();
+    if (stmt.initializer) compile(stmt.initializer);
+
+    int loopStart = static_cast<int>(chunk().code.size());
+    int exitJump = -1;
+    if (stmt.condition)
+    {
+        compile(stmt.condition);
+        exitJump = emitJump(OpCode::JUMP_IF_FALSE);
+        emit(OpCode::POP);
+    }
+
+    current->loops.push_back({ current->scopeDepth, {} });
+    current->continues.push_back({ current->scopeDepth, -1, {} });
+
+    compile(stmt.body);
+
+    ContinueTarget target = std::move(current->continues.back());
+    current->continues.pop_back();
+    for (int jump : target.jumps) patchJump(jump);
+
+    if (stmt.increment)
+    {
+        compile(stmt.increment);
+        emit(OpCode::POP);
+    }
+    emitLoop(loopStart);
+
+    Loop loop = std::move(current->loops.back());
+    current->loops.pop_back();
+
+    if (exitJump >= 0)
+    {
+        patchJump(exitJump);
+        emit(OpCode::POP);
+    }
+
+    // Breaks leave after the condition has already been popped
+    for (int jump : loop.breakJumps) patchJump(jump);
+    endScope();
+}
+
+void Compiler::operator()(const BreakStmt& stmt)
+{
+    setLine(stmt.keyword);
+    if (current->loops.empty())
+    {
+        emit(OpCode::ERROR);
+        emitShort(chunk().addConstant(makeRef<FlintString>("Cannot use 'break' outside of a loop")));
+        return;
+    }
+
+    popLocalsAbove(current->loops.back().scopeDepth);
+    current->loops.back().breakJumps.push_back(emitJump(OpCode::JUMP));
+}
+
+void Compiler::operator()(const ContinueStmt& stmt)
+{
+    setLine(stmt.keyword);
+    if (current->continues.empty())
+    {
+        emit(OpCode::ERROR);
+        emitShort(chunk().addConstant(makeRef<FlintString>("Cannot use 'continue' outside of a loop")));
+        return;
+    }
+
+    ContinueTarget& target = current->continues.back();
+    popLocalsAbove(target.scopeDepth);
+    if (target.loopStart >= 0) emitLoop(target.loopStart);
+    else target.jumps.push_back(emitJump(OpCode::JUMP));
+}
+
+void Compiler::operator()(const ReturnStmt& stmt)
+{
+    setLine(stmt.keyword);
+    if (current->kind == FunctionKind::INITIALIZER)
+    {
+        emit(OpCode::GET_LOCAL);
+        emit(0);
+    }
+    else if (stmt.val)
+    {
+        tailCall = std::holds_alternative<Call>(*stmt.val);
+        compile(stmt.val);
+    }
+    else emit(OpCode::NIL);
+
+    emit(OpCode::RETURN);
+}
+
+void Compiler::operator()(const BlockStmt& stmt)
+{
+    beginScope();
+    for (const auto& statement : stmt.statements) compile(statement);
+    endScope();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// class Name < Super { ... }
+// The class stays on the stack while its methods are attached.  A subclass
+// gets a scope holding 'super', which its methods capture as an upvalue.
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::operator()(const ClassStmt& stmt)
+{
+    setLine(stmt.name);
+    Symbol name = stmt.name.symbol;
+    bool isLocal = current->scopeDepth > 0;
+
+    if (isLocal) addLocal(name);
+    emitName(OpCode::CLASS, name);
+    if (!isLocal) emitName(OpCode::DEFINE_GLOBAL, name);
+
+    if (stmt.superClass)
+    {
+        compile(stmt.superClass);
+        beginScope();
+        addLocal(Symbols::SUPER);
+
+        namedVariable(name, false);
+        setLine(stmt.name);
+        emit(OpCode::INHERIT);
+    }
+
+    namedVariable(name, false);
+
+    for (const auto& method : stmt.classMethods)
+    {
+        const FunctionStmt& decl = std::get<FunctionStmt>(*method);
+        function(decl, FunctionKind::METHOD);  // 'this' is the class
+        emitName(OpCode::STATIC_METHOD, decl.name->symbol);
+    }
+    for (const auto& method : stmt.instanceMethods)
+    {
+        const FunctionStmt& decl = std::get<FunctionStmt>(*method);
+        bool isInit = decl.name->symbol == Symbols::INIT;
+        function(decl, isInit ? FunctionKind::INITIALIZER : FunctionKind::METHOD);
+        emitName(OpCode::METHOD, decl.name->symbol);
+    }
+
+    emit(OpCode::POP);
+    if (stmt.superClass) endScope();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Expressions
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::operator()(const Binary& expr)
+{
+    compile(expr.left);
+
+    // Comma: evaluate both, keep the right
+    if (expr.op.type == TokenType::COMMA)
+    {
+        emit(OpCode::POP);
+        compile(expr.right);
+        return;
+    }
+
+    compile(expr.right);
+    setLine(expr.op);
+
+    switch (expr.op.type)
+    {
+        case TokenType::PLUS:          emit(OpCode::ADD); break;
+        case TokenType::MINUS:         emit(OpCode::SUBTRACT); break;
+        case TokenType::STAR:          emit(OpCode::MULTIPLY); break;
+        case TokenType::SLASH:         emit(OpCode::DIVIDE); break;
+        case TokenType::MODULO:        emit(OpCode::MODULO); break;
+        case TokenType::GREATER:       emit(OpCode::GREATER); break;
+        case TokenType::GREATER_EQUAL: emit(OpCode::GREATER_EQUAL); break;
+        case TokenType::LESS:          emit(OpCode::LESS); break;
+        case TokenType::LESS_EQUAL:    emit(OpCode::LESS_EQUAL); break;
+        case TokenType::EQUAL_EQUAL:   emit(OpCode::EQUAL); break;
+        case TokenType::BANG_EQUAL:    emit(OpCode::NOT_EQUAL); break;
+        default:
+            // Unsupported operators evaluate to `nothing`, as in the Evaluator
+            emit(OpCode::POP);
+            emit(OpCode::POP);
+            emitConstant(std::monostate{});
+            break;
+    }
+}
+
+// Short-circuit: the deciding operand is left on the stack as the result
+void Compiler::operator()(const Logical& expr)
+{
+    compile(expr.left);
+    setLine(expr.op);
+
+    if (expr.op.type == TokenType::OR)
+    {
+        int elseJump = emitJump(OpCode::JUMP_IF_FALSE);
+        int endJump = emitJump(OpCode::JUMP);
+        patchJump(elseJump);
+        emit(OpCode::POP);
+        compile(expr.right);
+        patchJump(endJump);
+    }
+    else
+    {
+        int endJump = emitJump(OpCode::JUMP_IF_FALSE);
+        emit(OpCode::POP);
+        compile(expr.right);
+        patchJump(endJump);
+    }
+}
+
+void Compiler::operator()(const Conditional& expr)
+{
+    compile(expr.condition);
+    int elseJump = emitJump(OpCode::JUMP_IF_FALSE);
+    emit(OpCode::POP);
+    compile(expr.left);
+
+    int endJump = emitJump(OpCode::JUMP);
+    patchJump(elseJump);
+    emit(OpCode::POP);
+    compile(expr.right);
+    patchJump(endJump);
+}
+
+void Compiler::operator()(const Unary& expr)
+{
+    compile(expr.right);
+    setLine(expr.op);
+
+    if (expr.op.type == TokenType::MINUS) emit(OpCode::NEGATE);
+    else if (expr.op.type == TokenType::BANG) emit(OpCode::NOT);
+    else {
+        emit(OpCode::POP);
+        emitConstant(std::monostate{});
+    }
+}
+
+void Compiler::operator()(const Literal& expr)
+{
+    const LiteralValue& value = expr.value;
+    if (value.isNil()) emit(OpCode::NIL);
+    else if (value.isBool()) emit(value.asBool() ? OpCode::TRUE : OpCode::FALSE);
+    else emitConstant(value);
+}
+
+void Compiler::operator()(const Grouping& expr)
+{
+    compile(expr.expression);
+}
+
+void Compiler::operator()(const Variable& expr)
+{
+    setLine(expr.name);
+    namedVariable(expr.name.symbol, false);
+}
+
+void Compiler::operator()(const Assignment& expr)
+{
+    compile(expr.value);
+    setLine(expr.name);
+    namedVariable(expr.name.symbol, true);
+}
+
+void Compiler::operator()(const Lambda& expr)
+{
+    function(*expr.function, FunctionKind::FUNCTION);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Calls
+// `obj.name(args)` and `super.name(args)` compile to fused invoke
+// instructions, so a method call never materializes a bound method.
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::operator()(const Call& expr)
+{
+    if (expr.arguments.size() > MAX_ARGUMENTS)
+        Flint::error(expr.paren, "Can't have more than 255 arguments.");
+
+    // Only this call is in tail position, not the ones in its operands
+    bool tail = std::exchange(tailCall, false);
+
+    auto arguments = [&] {
+        for (const ExprPtr& argument : expr.arguments) compile(argument);
+        setLine(expr.paren);
+    };
+    uint8_t argCount = static_cast<uint8_t>(expr.arguments.size());
+
+    if (auto get = std::get_if<Get>(expr.callee))
+    {
+        compile(get->object);
+        arguments();
+        emitName(tail ? OpCode::TAIL_INVOKE : OpCode::INVOKE, get->name.symbol);
+        emit(argCount);
+        return;
+    }
+
+    if (auto super = std::get_if<Super>(expr.callee))
+    {
+        setLine(super->keyword);
+        namedVariable(Symbols::THIS, false);
+        arguments();
+        namedVariable(Symbols::SUPER, false);
+        setLine(super->method);
+        emitName(OpCode::SUPER_INVOKE, super->method.symbol);
+        emit(argCount);
+        return;
+    }
+
+    compile(expr.callee);
+    arguments();
+    emit(tail ? OpCode::TAIL_CALL : OpCode::CALL);
+    emit(argCount);
+}
+
+void Compiler::operator()(const Get& expr)
+{
+    compile(expr.object);
+    setLine(expr.name);
+    emitName(OpCode::GET_PROPERTY, expr.name.symbol);
+}
+
+void Compiler::operator()(const Set& expr)
+{
+    compile(expr.object);
+    compile(expr.value);
+    setLine(expr.name);
+    emitName(OpCode::SET_PROPERTY, expr.name.symbol);
+}
+
+void Compiler::operator()(const This& expr)
+{
+    setLine(expr.keyword);
+    namedVariable(Symbols::THIS, false);
+}
+
+void Compiler::operator()(const Super& expr)
+{
+    setLine(expr.keyword);
+    namedVariable(Symbols::THIS, false);
+    namedVariable(Symbols::SUPER, false);
+    setLine(expr.method);
+    emitName(OpCode::GET_SUPER, expr.method.symbol);
+}
+
+void Compiler::operator()(const Array& expr)
+{
+    for (const ExprPtr& element : expr.elements) compile(element);
+    if (expr.elements.size() > MAX_OPERAND)
+        Flint::error(line, "Too many elements in an array literal.");
+    emit(OpCode::ARRAY);
+    emitShort(static_cast<int>(expr.elements.size()));
+}
+
+void Compiler::operator()(const GetIndex& expr)
+{
+    compile(expr.array);
+    compile(expr.index);
+    setLine(expr.bracket);
+    emit(OpCode::GET_INDEX);
+}
+
+void Compiler::operator()(const SetIndex& expr)
+{
+    compile(expr.array);
+    compile(expr.index);
+    compile(expr.value);
+    setLine(expr.bracket);
+    emit(OpCode::SET_INDEX);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// function()
+// Compiles a body into a fresh VMFunction and emits the CLOSURE that creates
+// it at runtime.  Slot 0 holds the receiver for methods and the closure
+// itself otherwise; parameters follow in order.
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::function(const FunctionStmt& stmt, FunctionKind kind)
+{
+    FunctionState state{ current, makeRef<VMFunction>(), kind };
+    VMFunction& fn = *state.function;
+    fn.name = stmt.name ? std::string(stmt.name->lexeme) : "";
+    fn.arity = static_cast<int>(stmt.params.size());
+    fn.isGetter = stmt.isGetter;
+    fn.line = static_cast<int>(stmt.line);
+
+    bool hasReceiver = kind == FunctionKind::METHOD || kind == FunctionKind::INITIALIZER;
+    state.locals.push_back({ hasReceiver ? Symbols::THIS : NO_NAME, 0, false });
+
+    current = &state;
+    beginScope();
+    for (const Token& param : stmt.params)
+    {
+        setLine(param);
+        addLocal(param.symbol);
+    }
+    for (const auto& statement : stmt.body) compile(statement);
+
+    // Falling off the end returns `this` from an initializer, nil otherwise
+    if (kind == FunctionKind::INITIALIZER)
+    {
+        emit(OpCode::GET_LOCAL);
+        emit(0);
+    }
+    else emit(OpCode::NIL);
+    emit(OpCode::RETURN);
+
+    current = state.enclosing;
+    fn.upvalueCount = static_cast<int>(state.upvalues.size());
+
+    emit(OpCode::CLOSURE);
+    emitShort(chunk().addConstant(state.function));
+    for (const Upvalue& upvalue : state.upvalues)
+    {
+        emit(upvalue.isLocal ? 1 : 0);
+        emit(upvalue.index);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Variables
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::namedVariable(Symbol name, bool assign)
+{
+    if (int slot = resolveLocal(*current, name); slot >= 0)
+    {
+        emit(assign ? OpCode::SET_LOCAL : OpCode::GET_LOCAL);
+        emit(static_cast<uint8_t>(slot));
+    }
+    else if (int index = resolveUpvalue(*current, name); index >= 0)
+    {
+        emit(assign ? OpCode::SET_UPVALUE : OpCode::GET_UPVALUE);
+        emit(static_cast<uint8_t>(index));
+    }
+    else
+    {
+        emitName(assign ? OpCode::SET_GLOBAL : OpCode::GET_GLOBAL, name);
+    }
+}
+
+// The value to bind is on top of the stack
+void Compiler::defineVariable(const Token& name)
+{
+    if (current->scopeDepth > 0) addLocal(name.symbol);
+    else emitName(OpCode::DEFINE_GLOBAL, name.symbol);
+}
+
+// Discard (or close) the locals of scopes being jumped out of, without
+// forgetting them: code after the jump still runs with them in place.
+void Compiler::popLocalsAbove(int depth)
+{
+    for (auto it = current->locals.rbegin();
+         it != current->locals.rend() && it->depth > depth; ++it)
+    {
+        emit(it->isCaptured ? OpCode::CLOSE_UPVALUE : OpCode::POP);
+    }
+}
+
+void Compiler::beginScope() { current->scopeDepth++; }
+
+void Compiler::endScope()
+{
+    current->scopeDepth--;
+    auto& locals = current->locals;
+    while (!locals.empty() && locals.back().depth > current->scopeDepth)
+    {
+        emit(locals.back().isCaptured ? OpCode::CLOSE_UPVALUE : OpCode::POP);
+        locals.pop_back();
+    }
+}
+
+void Compiler::addLocal(Symbol name)
+{
+    if (current->locals.size() >= MAX_LOCALS)
+    {
+        Flint::error(line, "Too many local variables in function.");
+        return;
+    }
+    current->locals.push_back({ name, current->scopeDepth, false });
+}
+
+int Compiler::resolveLocal(FunctionState& state, Symbol name)
+{
+    for (int i = static_cast<int>(state.locals.size()) - 1; i >= 0; --i)
+    {
+        if (state.locals[i].name == name) return i;
+    }
+    return -1;
+}
+
+int Compiler::resolveUpvalue(FunctionState& state, Symbol name)
+{
+    if (!state.enclosing) return -1;
+
+    if (int local = resolveLocal(*state.enclosing, name); local >= 0)
+    {
+        state.enclosing->locals[local].isCaptured = true;
+        return addUpvalue(state, static_cast<uint8_t>(local), true);
+    }
+    if (int upvalue = resolveUpvalue(*state.enclosing, name); upvalue >= 0)
+    {
+        return addUpvalue(state, static_cast<uint8_t>(upvalue), false);
+    }
+    return -1;
+}
+
+int Compiler::addUpvalue(FunctionState& state, uint8_t index, bool isLocal)
+{
+    for (size_t i = 0; i < state.upvalues.size(); ++i)
+    {
+        if (state.upvalues[i].index == index && state.upvalues[i].isLocal == isLocal)
+            return static_cast<int>(i);
+    }
+
+    if (state.upvalues.size() >= MAX_UPVALUES)
+    {
+        Flint::error(line, "Too many closure variables in function.");
+        return 0;
+    }
+    state.upvalues.push_back({ index, isLocal });
+    return static_cast<int>(state.upvalues.size() - 1);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Emission helpers
+// ─────────────────────────────────────────────────────────────────────────────
+void Compiler::emit(uint8_t byte)
+{
+    chunk().write(byte, line);
+}
+
+void Compiler::emitShort(int value)
+{
+    emit(static_cast<uint8_t>((value >> 8) & 0xff));
+    emit(static_cast<uint8_t>(value & 0xff));
+}
+
+void Compiler::emitConstant(LiteralValue value)
+{
+    int index = chunk().addConstant(std::move(value));
+    if (index > MAX_OPERAND) Flint::error(line, "Too many constants in one function.");
+    emit(OpCode::CONSTANT);
+    emitShort(index);
+}
+
+void Compiler::emitName(OpCode op, Symbol name)
+{
+    int index = chunk().addName(name);
+    if (index > MAX_OPERAND) Flint::error(line, "Too many names in one function.");
+    emit(op);
+    emitShort(index);
+}
+
+// Emits a jump with a placeholder offset; returns where to patch it
+int Compiler::emitJump(OpCode op)
+{
+    emit(op);
+    emit(0xff);
+    emit(0xff);
+    return static_cast<int>(chunk().code.size()) - 2;
+}
+
+void Compiler::patchJump(int offset)
+{
+    int jump = static_cast<int>(chunk().code.size()) - offset - 2;
+    if (jump > MAX_OPERAND) Flint::error(line, "Too much code to jump over.");
+
+    chunk().code[offset] = static_cast<uint8_t>((jump >> 8) & 0xff);
+    chunk().code[offset + 1] = static_cast<uint8_t>(jump & 0xff);
+}
+
+void Compiler::emitLoop(int loopStart)
+{
+    emit(OpCode::LOOP);
+    int offset = static_cast<int>(chunk().code.size()) - loopStart + 2;
+    if (offset > MAX_OPERAND) Flint::error(line, "Loop body too large.");
+    emitShort(offset);
+}
@@ -0,0 +1,1101 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include "Flint/VM/VM.h"
+#include "Flint/Flint.h"
+#include "Flint/Interpreter/Interpreter.h"
+#include "Flint/Interpreter/Evaluator.h"
+#include "Flint/Exceptions/RuntimeError.h"
+#include "Flint/Exceptions/BudgetExceeded.h"
+#include "Flint/Callables/FlintCallable.h"
+#include "Flint/FlintString.h"
+#include "Flint/FlintArray.h"
+#include "Flint/FlintFile.h"
+#include "Flint/FlintFloat64Array.h"
+#include "Flint/FlintMap.h"
+#include "Flint/FlintStringBuilder.h"
+#include "Flint/FlintMath.h"
+#include "Flint/Interpreter/Profiler.h"
+
+// Messages shared with the Evaluator, so both engines report errors alike
+static const char* const OPERAND_MESSAGE =
+    "compiler is disappointed in you \033[33m(pls go touch grass)\033[0m";
+static const char* const DIVIDE_BY_ZERO_MESSAGE =
+    "divide by zero? seriously? who gave this kid a computer.";
+
+static std::string arityMessage(int expected, int got)
+{
+    return "Function expects " + std::to_string(expected) +
+           " arguments but got " + std::to_string(got);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Construction
+// The VM starts with the same native globals as the Interpreter (print,
+// clock, scan, ...), shared rather than re-registered.
+// ─────────────────────────────────────────────────────────────────────────────
+VM::VM(Interpreter& host)
+    : host(host), framesMax(static_cast<int>(host.callDepthLimit()) + 1),
+      stackMax(framesMax * SLOTS_PER_FRAME),
+      stack(new LiteralValue[stackMax]), frames(framesMax)
+{
+    stackTop = stack.get();
+    for (const Environment::Named& global : host.globalEnvironment()->definitions())
+        globals.emplace(global.name, global.value);
+    host.setCallbackRunner(this);
+}
+
+VM::~VM() { host.setCallbackRunner(nullptr); }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// interpret()
+// Runs the script in frame 0.  A runtime error abandons the current top-level
+// statement only: the error is reported and execution resumes at the next one.
+// A run out of budget stops there.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::interpret(Ref<VMFunction> script)
+{
+    Interpreter::Run budgeted(host);
+    resetStack();
+
+    // The script's frame is the root of a profile, not a call in it
+    Ref<VMClosure> closure = makeRef<VMClosure>(std::move(script));
+    push(closure);
+    frames[frameCount++] = CallFrame{closure, closure->function->chunk.code.data(), stackTop - 1, false};
+
+    for (;;)
+    {
+        try {
+            run(0);
+            break;
+        } catch (const BudgetExceeded& error) {
+            Flint::runtimeError(error);
+            break;
+        } catch (const RuntimeError& error) {
+            Flint::runtimeError(error);
+            if (!recover()) break;
+        }
+    }
+
+    resetStack();
+}
+
+bool VM::recover()
+{
+    CallFrame& script = frames[0];
+    const VMFunction& function = *script.closure->function;
+    const auto& starts = function.statementStarts;
+
+    size_t failedAt = script.ip - function.chunk.code.data() - 1;
+    auto next = std::upper_bound(starts.begin(), starts.end(), failedAt);
+    if (next == starts.end()) return false;
+
+    // Unwind every frame above the script, and whatever the statement pushed
+    LiteralValue* base = script.slots + 1;
+    closeUpvalues(base);
+    popN(static_cast<int>(stackTop - base));
+    dropFrames(1);
+
+    script.ip = function.chunk.code.data() + *next;
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// run()
+// The dispatch loop.  `ip`, `slots` and the chunk tables of the running frame
+// are cached in locals and reloaded whenever a call or return switches frames.
+// frame->ip is kept current so errors can find their source line.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::run(int exitDepth)
+{
+    CallFrame* frame;
+    const uint8_t* ip;
+    LiteralValue* slots;
+    const LiteralValue* constants;
+    const Symbol* names;
+
+    auto load = [&] {
+        frame = &frames[frameCount - 1];
+        ip = frame->ip;
+        slots = frame->slots;
+        const Chunk& chunk = frame->closure->function->chunk;
+        constants = chunk.constants.data();
+        names = chunk.names.data();
+    };
+    auto readByte = [&] { return *ip++; };
+    auto readShort = [&] {
+        ip += 2;
+        return static_cast<uint16_t>((ip[-2] << 8) | ip[-1]);
+    };
+
+    load();
+
+    for (;;)
+    {
+        OpCode instruction = static_cast<OpCode>(*ip++);
+        frame->ip = ip;
+
+        switch (instruction)
+        {
+            case OpCode::CONSTANT: push(constants[readShort()]); break;
+            case OpCode::NIL:      push(nullptr); break;
+            case OpCode::TRUE:     push(true); break;
+            case OpCode::FALSE:    push(false); break;
+            case OpCode::POP:      *--stackTop = LiteralValue(); break;
+
+            //──────────────────────────────────────────────────────────────────
+            // Variables
+            //──────────────────────────────────────────────────────────────────
+            case OpCode::GET_LOCAL: push(slots[readByte()]); break;
+            case OpCode::SET_LOCAL: slots[readByte()] = peek(0); break;
+
+            case OpCode::GET_UPVALUE:
+                push(*frame->closure->upvalues[readByte()]->location);
+                break;
+            case OpCode::SET_UPVALUE:
+                *frame->closure->upvalues[readByte()]->location = peek(0);
+                break;
+
+            case OpCode::DEFINE_GLOBAL:
+                globals.insert_or_assign(names[readShort()], pop());
+                break;
+
+            case OpCode::GET_GLOBAL:
+            {
+                Symbol name = names[readShort()];
+                auto it = globals.find(name);
+                std::string_view lexeme = SymbolTable::name(name);
+                if (it == globals.end())
+                    error("Unknown variable '" + std::string(lexeme) + "'.", lexeme);
+                if (it->second.isNothing())
+                    error("Variable '" + std::string(lexeme) + "' has no value assigned to it.", lexeme);
+                push(it->second);
+                break;
+            }
+
+            case OpCode::SET_GLOBAL:
+            {
+                Symbol name = names[readShort()];
+                auto it = globals.find(name);
+                if (it == globals.end()) {
+                    std::string_view lexeme = SymbolTable::name(name);
+                    error("Undefined variable '" + std::string(lexeme) + "'.", lexeme);
+                }
+                it->second = peek(0);
+                break;
+            }
+
+            //──────────────────────────────────────────────────────────────────
+            // Properties and indexing
+            //──────────────────────────────────────────────────────────────────
+            case OpCode::GET_PROPERTY:
+                getProperty(names[readShort()]);
+                frame->ip = ip;
+                load();  // A getter may have pushed a frame
+                break;
+
+            case OpCode::SET_PROPERTY:
+            {
+                Symbol name = names[readShort()];
+                VMInstance* instance = peek(1).as<VMInstance>();
+                if (!instance)
+                    error("Only instances have fields.", SymbolTable::name(name));
+
+                instance->fields[name] = peek(0);
+                LiteralValue value = pop();
+                stackTop[-1] = std::move(value);
+                break;
+            }
+
+            case OpCode::GET_SUPER:
+            {
+                Symbol name = names[readShort()];
+                LiteralValue superClass = pop();
+                bindMethod(superClass.as<VMClass>(), name);
+                break;
+            }
+
+            case OpCode::GET_INDEX:
+            {
+                LiteralValue index = pop();
+                LiteralValue target = pop();
+
+                if (FlintMap* map = target.as<FlintMap>()) {
+                    const LiteralValue* value = map->find(index);
+                    push(value ? *value : LiteralValue(nullptr));
+                }
+                else if (FlintArray* arr = target.as<FlintArray>()) {
+                    if (!index.isNumber()) error(OPERAND_MESSAGE);
+                    int i = static_cast<int>(index.asNumber());
+                    if (i < 0 || i >= (int)arr->elements.size())
+                        error("Array index out of bounds \033[33m(why are you always reaching for things you can't have?)\033[0m");
+                    push(arr->elements[i]);
+                }
+                else if (FlintFloat64Array* arr = target.as<FlintFloat64Array>()) {
+                    if (!index.isNumber()) error(OPERAND_MESSAGE);
+                    int i = static_cast<int>(index.asNumber());
+                    if (i < 0 || i >= (int)arr->elements.size())
+                        error("Array index out of bounds \033[33m(why are you always reaching for things you can't have?)\033[0m");
+                    push(arr->elements[i]);
+                }
+                else if (FlintString* str = target.as<FlintString>()) {
+                    if (!index.isNumber()) error(OPERAND_MESSAGE);
+                    int i = static_cast<int>(index.asNumber());
+                    if (i < 0 || i >= (int)str->value.length())
+                        error("String index out of bounds \033[33m(why are you always reaching for things you can't have?)\033[0m");
+                    push(makeRef<FlintString>(std::string(1, str->value[i])));
+                }
+                else error("Only arrays, strings or maps can be indexed.");
+                break;
+            }
+
+            case OpCode::SET_INDEX:
+            {
+                LiteralValue value = pop();
+                LiteralValue index = pop();
+                LiteralValue target = pop();
+
+                if (FlintFloat64Array* packed = target.as<FlintFloat64Array>()) {
+                    if (!index.isNumber() || !value.isNumber()) error(OPERAND_MESSAGE);
+                    int i = static_cast<int>(index.asNumber());
+                    if (i < 0 || i >= (int)packed->elements.size())
+                        error("Array index out of bounds.");
+                    packed->elements[i] = value.asNumber();
+                    push(std::move(value));
+                    break;
+                }
+
+                if (FlintMap* map = target.as<FlintMap>()) {
+                    map->set(index, value, errorToken("]"));
+                    push(std::move(value));
+                    break;
+                }
+
+                FlintArray* arr = target.as<FlintArray>();
+                if (!arr) error("Only arrays and maps support indexed assignment.");
+                if (!index.isNumber()) error(OPERAND_MESSAGE);
+                int i = static_cast<int>(index.asNumber());
+                if (i < 0 || i >= (int)arr->elements.size())
+                    error("Array index out of bounds.");
+                arr->elements[i] = value;
+                push(std::move(value));
+                break;
+            }
+
+            //──────────────────────────────────────────────────────────────────
+            // Operators.  Number operands are overwritten in place; a number
+            // holds no reference, so dropping the right operand is free.
+            //──────────────────────────────────────────────────────────────────
+            case OpCode::EQUAL:
+            case OpCode::NOT_EQUAL:
+            {
+                bool equal = Evaluator::isEqual(peek(1), peek(0));
+                popN(2);
+                push(instruction == OpCode::EQUAL ? equal : !equal);
+                break;
+            }
+
+            case OpCode::GREATER:
+            case OpCode::GREATER_EQUAL:
+            case OpCode::LESS:
+            case OpCode::LESS_EQUAL:
+            {
+                LiteralValue& a = peek(1);
+                LiteralValue& b = peek(0);
+                int order;
+                if (a.isNumber() && b.isNumber()) {
+                    double x = a.asNumber(), y = b.asNumber();
+                    if (!(x == x && y == y)) order = 2;  // NaN: every comparison is false
+                    else order = x < y ? -1 : (x > y ? 1 : 0);
+                }
+                else if (a.is<FlintString>() && b.is<FlintString>()) {
+                    int c = a.as<FlintString>()->value.compare(b.as<FlintString>()->value);
+                    order = c < 0 ? -1 : (c > 0 ? 1 : 0);
+                }
+                else
+                    error("");
+
+                bool result;
+                switch (instruction) {
+                    case OpCode::GREATER:       result = order != 2 && order > 0; break;
+                    case OpCode::GREATER_EQUAL: result = order != 2 && order >= 0; break;
+                    case OpCode::LESS:          result = order < 0; break;
+                    default:                    result = order <= 0; break;
+                }
+                popN(2);
+                push(result);
+                break;
+            }
+
+            case OpCode::ADD:
+            {
+                LiteralValue& a = peek(1);
+                LiteralValue& b = peek(0);
+                if (a.isNumber() && b.isNumber()) {
+                    a = a.asNumber() + b.asNumber();
+                    --stackTop;
+                }
+                else if (a.is<FlintString>() || b.is<FlintString>()) {
+                    LiteralValue text = FlintString::concat(a, b);
+                    popN(2);
+                    push(std::move(text));
+                }
+                else if (FlintMath::isMath(a) || FlintMath::isMath(b))
+                    mathOperation(TokenType::PLUS, "+");
+                else error("Operands to '+' must be both numbers or at least one string.");
+                break;
+            }
+
+            case OpCode::SUBTRACT:
+            case OpCode::MULTIPLY:
+            case OpCode::DIVIDE:
+            case OpCode::MODULO:
+            {
+                LiteralValue& a = peek(1);
+                LiteralValue& b = peek(0);
+                if (!a.isNumber() || !b.isNumber())
+                {
+                    if (!FlintMath::isMath(a) && !FlintMath::isMath(b)) error(OPERAND_MESSAGE);
+                    switch (instruction) {
+                        case OpCode::SUBTRACT: mathOperation(TokenType::MINUS, "-"); break;
+                        case OpCode::MULTIPLY: mathOperation(TokenType::STAR, "*"); break;
+                        case OpCode::DIVIDE:   mathOperation(TokenType::SLASH, "/"); break;
+                        default:               mathOperation(TokenType::MODULO, "%"); break;
+                    }
+                    break;
+                }
+
+                double x = a.asNumber(), y = b.asNumber();
+                switch (instruction) {
+                    case OpCode::SUBTRACT: a = x - y; break;
+                    case OpCode::MULTIPLY: a = x * y; break;
+                    case OpCode::DIVIDE:
+                        if (y == 0) error(DIVIDE_BY_ZERO_MESSAGE);
+                        a = x / y;
+                        break;
+                    default:
+                        if (y == 0) error(DIVIDE_BY_ZERO_MESSAGE);
+                        a = std::fmod(x, y);
+                        break;
+                }
+                --stackTop;
+                break;
+            }
+
+            case OpCode::NOT:
+                peek(0) = !Evaluator::isTruthy(peek(0));
+                break;
+
+            case OpCode::NEGATE:
+                if (FlintMath::isMath(peek(0))) {
+                    peek(0) = FlintMath::negate(peek(0), errorToken("-"));
+                    break;
+                }
+                if (!peek(0).isNumber()) error(OPERAND_MESSAGE);
+                peek(0) = -peek(0).asNumber();
+                break;
+
+            //──────────────────────────────────────────────────────────────────
+            // Control flow
+            //──────────────────────────────────────────────────────────────────
+            case OpCode::JUMP:
+            {
+                uint16_t offset = readShort();
+                ip += offset;
+                break;
+            }
+            case OpCode::JUMP_IF_FALSE:
+            {
+                uint16_t offset = readShort();
+                if (!Evaluator::isTruthy(peek(0))) ip += offset;
+                break;
+            }
+            case OpCode::LOOP:
+            {
+                uint16_t offset = readShort();
+                if (host.stepDue()) {
+                    frame->ip = ip;
+                    checkBudget();
+                }
+                ip -= offset;
+                break;
+            }
+
+            //──────────────────────────────────────────────────────────────────
+            // Calls
+            //──────────────────────────────────────────────────────────────────
+            case OpCode::CALL:
+            {
+                int argCount = readByte();
+                frame->ip = ip;
+                callValue(argCount);
+                load();
+                break;
+            }
+
+            case OpCode::INVOKE:
+            {
+                Symbol name = names[readShort()];
+                int argCount = readByte();
+                frame->ip = ip;
+                invoke(name, argCount);
+                load();
+                break;
+            }
+
+            // A native callee has already returned: the RETURN that follows
+            // hands its result on
+            case OpCode::TAIL_CALL:
+            {
+                int argCount = readByte();
+                frame->ip = ip;
+                int caller = frameCount - 1;
+                endProfile(*frame);
+                callValue(argCount);
+                replaceCaller(caller);
+                load();
+                break;
+            }
+
+            case OpCode::TAIL_INVOKE:
+            {
+                Symbol name = names[readShort()];
+                int argCount = readByte();
+                frame->ip = ip;
+                int caller = frameCount - 1;
+                endProfile(*frame);
+                invoke(name, argCount);
+                replaceCaller(caller);
+                load();
+                break;
+            }
+
+            case OpCode::SUPER_INVOKE:
+            {
+                Symbol name = names[readShort()];
+                int argCount = readByte();
+                frame->ip = ip;
+                LiteralValue superClass = pop();
+                invokeFromClass(superClass.as<VMClass>(), name, argCount);
+                load();
+                break;
+            }
+
+            case OpCode::CLOSURE:
+            {
+                Ref<VMFunction> function = constants[readShort()].ref<VMFunction>();
+                Ref<VMClosure> closure = makeRef<VMClosure>(function);
+                for (int i = 0; i < function->upvalueCount; ++i)
+                {
+                    bool isLocal = readByte();
+                    uint8_t index = readByte();
+                    closure->upvalues[i] = isLocal
+                        ? captureUpvalue(slots + index)
+                        : frame->closure->upvalues[index];
+                }
+                push(std::move(closure));
+                break;
+            }
+
+            case OpCode::CLOSE_UPVALUE:
+                closeUpvalues(stackTop - 1);
+                *--stackTop = LiteralValue();
+                break;
+
+            case OpCode::RETURN:
+            {
+                LiteralValue result = pop();
+                closeUpvalues(slots);
+                popN(static_cast<int>(stackTop - slots));
+                endProfile(*frame);
+                frames[--frameCount].closure = nullptr;
+                push(std::move(result));
+
+                if (frameCount == exitDepth) return;
+                load();
+                break;
+            }
+
+            //──────────────────────────────────────────────────────────────────
+            // Arrays and classes
+            //──────────────────────────────────────────────────────────────────
+            case OpCode::ARRAY:
+            {
+                int count = readShort();
+                std::vector<LiteralValue> elements(
+                    std::make_move_iterator(stackTop - count),
+                    std::make_move_iterator(stackTop));
+                stackTop -= count;  // The moved-from slots are already empty
+                push(makeRef<FlintArray>(std::move(elements)));
+                break;
+            }
+
+            case OpCode::CLASS:
+                push(makeRef<VMClass>(std::string(SymbolTable::name(names[readShort()]))));
+                break;
+
+            case OpCode::INHERIT:
+            {
+                VMClass* superClass = peek(1).as<VMClass>();
+                if (!superClass) error("Superclass must be a class.");
+
+                // Copy-down inheritance: the subclass's own methods, added
+                // next, override these entries
+                VMClass* subClass = peek(0).as<VMClass>();
+                subClass->methods = superClass->methods;
+                subClass->initializer = superClass->initializer;
+                *--stackTop = LiteralValue();
+                break;
+            }
+
+            case OpCode::METHOD:
+            case OpCode::STATIC_METHOD:
+            {
+                Symbol name = names[readShort()];
+                Ref<VMClosure> method = peek(0).ref<VMClosure>();
+                VMClass* klass = peek(1).as<VMClass>();
+
+                if (instruction == OpCode::STATIC_METHOD)
+                    klass->staticMethods[name] = method;
+                else {
+                    if (name == Symbols::INIT) klass->initializer = method;
+                    klass->methods[name] = std::move(method);
+                }
+                *--stackTop = LiteralValue();
+                break;
+            }
+
+            case OpCode::ERROR:
+                error(constants[readShort()].as<FlintString>()->value);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Calls
+// Every path leaves the callee's slot holding the result, or pushes a frame
+// whose RETURN will.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::callValue(int argCount)
+{
+    LiteralValue& callee = peek(argCount);
+
+    if (callee.isObject())
+    {
+        switch (callee.asObject()->type)
+        {
+            case ObjectType::VM_CLOSURE:
+                call(callee.as<VMClosure>(), argCount);
+                return;
+
+            case ObjectType::VM_BOUND_METHOD:
+            {
+                VMBoundMethod* bound = callee.as<VMBoundMethod>();
+                Ref<VMClosure> method = bound->method;
+                LiteralValue receiver = bound->receiver;
+                callee = std::move(receiver);
+                call(method.get(), argCount);
+                return;
+            }
+
+            case ObjectType::VM_CLASS:
+            {
+                Ref<VMClass> klass(callee.as<VMClass>());
+                callee = makeRef<VMInstance>(klass);
+                if (klass->initializer)
+                    call(klass->initializer.get(), argCount);
+                else if (argCount != 0)
+                    error(arityMessage(0, argCount));
+                return;
+            }
+
+            default:
+                if (FlintCallable* callable = callee.as<FlintCallable>()) {
+                    callNative(callable, argCount);
+                    return;
+                }
+                break;
+        }
+    }
+
+    error("Call to other types except classes and functions is not valid!");
+}
+
+void VM::call(VMClosure* closure, int argCount)
+{
+    if (argCount != closure->function->arity)
+        error(arityMessage(closure->function->arity, argCount));
+    if (frameCount == framesMax)
+        error("Stack overflow.");
+    if (host.stepDue()) checkBudget();
+
+    CallFrame& frame = frames[frameCount++];
+    frame.closure = Ref<VMClosure>(closure);
+    frame.ip = closure->function->chunk.code.data();
+    frame.slots = stackTop - argCount - 1;
+    frame.profiled = host.profiler != nullptr;
+    if (frame.profiled)
+    {
+        const VMFunction& function = *closure->function;
+        host.profiler->enter(&function, [&] {
+            std::string name = function.name.empty() ? "<lambda>" : function.name;
+            return name + ":" + std::to_string(function.line);
+        });
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tail call: the callee's slots (callee or receiver, then the arguments) move
+// down over the caller's, whose upvalues are closed first, and the callee's
+// frame takes the caller's index.  The caller would only have returned the
+// result, so nothing of it is needed again.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::replaceCaller(int caller)
+{
+    if (frameCount != caller + 2) return;
+
+    CallFrame& from = frames[caller + 1];
+    CallFrame& to = frames[caller];
+    closeUpvalues(to.slots);
+
+    LiteralValue* slot = to.slots;
+    for (LiteralValue* value = from.slots; value < stackTop; ++value)
+        *slot++ = std::move(*value);
+    popN(static_cast<int>(stackTop - slot));
+
+    to.closure = std::move(from.closure);
+    to.ip = from.ip;
+    to.profiled = from.profiled;
+    frameCount--;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// A frame's profile entry ends when it returns, is unwound, or makes a tail
+// call: the callee is then profiled as called by the frame's caller, as the
+// Interpreter does.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::endProfile(CallFrame& frame)
+{
+    if (frame.profiled)
+    {
+        host.profiler->leave();
+        frame.profiled = false;
+    }
+}
+
+// Natives and bound builtins take their arguments as a vector, as they do
+// when called by the Interpreter
+void VM::callNative(FlintCallable* callable, int argCount)
+{
+    if (callable->arity() != -1 && argCount != callable->arity())
+        error(arityMessage(callable->arity(), argCount));
+
+    std::vector<LiteralValue> arguments(stackTop - argCount, stackTop);
+    LiteralValue result = callable->call(host, arguments, errorToken());
+    popN(argCount + 1);
+    push(std::move(result));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// invoke()
+// obj.name(args) without creating a bound method: the receiver is already in
+// the slot the method expects as `this`.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::invoke(Symbol name, int argCount)
+{
+    LiteralValue& receiver = peek(argCount);
+
+    if (VMInstance* instance = receiver.as<VMInstance>())
+    {
+        // A field holding a callable shadows any method
+        auto field = instance->fields.find(name);
+        if (field != instance->fields.end())
+        {
+            LiteralValue value = field->second;
+            receiver = std::move(value);
+            callValue(argCount);
+            return;
+        }
+
+        VMClosure* method = instance->klass->findMethod(name);
+        if (!method)
+            error("Undefined property '" + std::string(SymbolTable::name(name)) + "'.",
+                  SymbolTable::name(name));
+
+        if (method->function->isGetter)
+        {
+            // `obj.getter(args)` calls whatever the getter returns
+            LiteralValue value = callGetter(method, receiver);
+            peek(argCount) = std::move(value);
+            callValue(argCount);
+            return;
+        }
+
+        call(method, argCount);
+        return;
+    }
+
+    if (FlintString* str = receiver.as<FlintString>())
+    {
+        auto method = FlintString::findBuiltin(name);
+        if (!method) str->getInBuiltFunction(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*str, *method, name, argCount);
+        return;
+    }
+
+    if (FlintArray* arr = receiver.as<FlintArray>())
+    {
+        auto method = FlintArray::findBuiltin(name);
+        if (!method) arr->getInBuiltFunction(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*arr, *method, name, argCount);
+        return;
+    }
+
+    if (FlintFloat64Array* arr = receiver.as<FlintFloat64Array>())
+    {
+        auto method = FlintFloat64Array::findBuiltin(name);
+        if (!method) arr->getInBuiltFunction(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*arr, *method, name, argCount);
+        return;
+    }
+
+    if (FlintStringBuilder* builder = receiver.as<FlintStringBuilder>())
+    {
+        auto method = FlintStringBuilder::findBuiltin(name);
+        if (!method) builder->getInBuiltFunction(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*builder, *method, name, argCount);
+        return;
+    }
+
+    if (FlintMap* map = receiver.as<FlintMap>())
+    {
+        auto method = FlintMap::findBuiltin(name);
+        if (!method) map->getInBuiltFunction(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*map, *method, name, argCount);
+        return;
+    }
+
+    if (FlintFile* file = receiver.as<FlintFile>())
+    {
+        auto method = FlintFile::findBuiltin(name);
+        if (!method) file->getInBuiltFunction(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*file, *method, name, argCount);
+        return;
+    }
+
+    if (FlintVec3* vec = receiver.as<FlintVec3>())
+    {
+        auto method = FlintVec3::findBuiltin(name);
+        if (!method) {  // A component, which callValue then rejects
+            LiteralValue component = vec->get(errorToken(SymbolTable::name(name)));
+            peek(argCount) = std::move(component);
+            callValue(argCount);
+            return;
+        }
+        invokeBuiltin(*vec, *method, name, argCount);
+        return;
+    }
+
+    if (FlintQuat* quat = receiver.as<FlintQuat>())
+    {
+        auto method = FlintQuat::findBuiltin(name);
+        if (!method) {
+            LiteralValue component = quat->get(errorToken(SymbolTable::name(name)));
+            peek(argCount) = std::move(component);
+            callValue(argCount);
+            return;
+        }
+        invokeBuiltin(*quat, *method, name, argCount);
+        return;
+    }
+
+    if (FlintMat4* mat = receiver.as<FlintMat4>())
+    {
+        auto method = FlintMat4::findBuiltin(name);
+        if (!method) mat->get(errorToken(SymbolTable::name(name)));  // throws
+        invokeBuiltin(*mat, *method, name, argCount);
+        return;
+    }
+
+    if (VMClass* klass = receiver.as<VMClass>())
+    {
+        auto it = klass->staticMethods.find(name);
+        if (it == klass->staticMethods.end())
+            error("Undefined static property '" + std::string(SymbolTable::name(name)) + "'.",
+                  SymbolTable::name(name));
+
+        call(it->second.get(), argCount);  // The class stays in slot 0 as 'this'
+        return;
+    }
+
+    error("Only instances, strings, or arrays have properties.", SymbolTable::name(name));
+}
+
+// super.name(args): the lookup starts at the superclass, `this` stays the receiver
+void VM::invokeFromClass(VMClass* klass, Symbol name, int argCount)
+{
+    VMClosure* method = klass->findMethod(name);
+    if (!method)
+        error("Undefined property '" + std::string(SymbolTable::name(name)) + "'.",
+              SymbolTable::name(name));
+    call(method, argCount);
+}
+
+template <typename Receiver>
+void VM::invokeBuiltin(Receiver& receiver, const BuiltinMethod<Receiver>& method,
+                       Symbol name, int argCount)
+{
+    if (method.arity != -1 && argCount != method.arity)
+        error(arityMessage(method.arity, argCount));
+
+    std::vector<LiteralValue> arguments(stackTop - argCount, stackTop);
+    Profiler::Scope profile(host.profiler, &method, [&] { return builtinName<Receiver>(name); });
+    LiteralValue result = method.fn(receiver, host, arguments, errorToken());
+    popN(argCount + 1);
+    push(std::move(result));
+}
+
+LiteralValue VM::runCallback(const LiteralValue& callee,
+    const std::vector<LiteralValue>& arguments, const Token& paren)
+{
+    return callFunction(callee, arguments);
+}
+
+LiteralValue VM::callFunction(const LiteralValue& callee, ValueSpan arguments)
+{
+    Interpreter::Run budgeted(host);
+    int depth = frameCount;
+    LiteralValue* base = stackTop;
+    try {
+        push(callee);
+        for (const LiteralValue& argument : arguments) push(argument);
+        callValue(static_cast<int>(arguments.size()));
+        if (frameCount > depth) run(depth);
+        return pop();
+    } catch (...) {
+        closeUpvalues(base);
+        popN(static_cast<int>(stackTop - base));
+        dropFrames(depth);
+        throw;
+    }
+}
+
+LiteralValue VM::callGetter(VMClosure* getter, const LiteralValue& receiver)
+{
+    push(receiver);
+    call(getter, 0);
+    run(frameCount - 1);
+    return pop();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// getProperty()
+// Replaces the object on top of the stack with `object.name`.  Lookup order
+// matches the Interpreter: fields, then methods (getters are called), then
+// builtins for strings/arrays, static methods for classes.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::getProperty(Symbol name)
+{
+    LiteralValue& object = peek(0);
+    std::string_view lexeme = SymbolTable::name(name);
+
+    if (VMInstance* instance = object.as<VMInstance>())
+    {
+        auto field = instance->fields.find(name);
+        if (field != instance->fields.end())
+        {
+            LiteralValue value = field->second;  // Copy before the instance may be freed
+            object = std::move(value);
+            return;
+        }
+
+        VMClosure* method = instance->klass->findMethod(name);
+        if (!method)
+            error("Undefined property '" + std::string(lexeme) + "'.", lexeme);
+
+        // Getters run immediately, with the object already in slot 0
+        if (method->function->isGetter) call(method, 0);
+        else bindMethod(instance->klass.get(), name);
+        return;
+    }
+
+    if (FlintString* str = object.as<FlintString>())
+    {
+        LiteralValue method = str->getInBuiltFunction(errorToken(lexeme));
+        object = std::move(method);
+        return;
+    }
+
+    if (FlintArray* arr = object.as<FlintArray>())
+    {
+        LiteralValue method = arr->getInBuiltFunction(errorToken(lexeme));
+        object = std::move(method);
+        return;
+    }
+
+    if (FlintFloat64Array* arr = object.as<FlintFloat64Array>())
+    {
+        LiteralValue method = arr->getInBuiltFunction(errorToken(lexeme));
+        object = std::move(method);
+        return;
+    }
+
+    if (FlintStringBuilder* builder = object.as<FlintStringBuilder>())
+    {
+        LiteralValue method = builder->getInBuiltFunction(errorToken(lexeme));
+        object = std::move(method);
+        return;
+    }
+
+    if (FlintMap* map = object.as<FlintMap>())
+    {
+        LiteralValue method = map->getInBuiltFunction(errorToken(lexeme));
+        object = std::move(method);
+        return;
+    }
+
+    if (FlintFile* file = object.as<FlintFile>())
+    {
+        LiteralValue method = file->getInBuiltFunction(errorToken(lexeme));
+        object = std::move(method);
+        return;
+    }
+
+    if (FlintMath::isMath(object))
+    {
+        Token token = errorToken(lexeme);
+        LiteralValue value = object.is<FlintVec3>() ? object.as<FlintVec3>()->get(token)
+                           : object.is<FlintQuat>() ? object.as<FlintQuat>()->get(token)
+                           : object.as<FlintMat4>()->get(token);
+        object = std::move(value);
+        return;
+    }
+
+    if (VMClass* klass = object.as<VMClass>())
+    {
+        auto it = klass->staticMethods.find(name);
+        if (it == klass->staticMethods.end())
+            error("Undefined static property '" + std::string(lexeme) + "'.", lexeme);
+
+        object = makeRef<VMBoundMethod>(object, it->second);
+        return;
+    }
+
+    error("Only instances, strings, or arrays have properties.", lexeme);
+}
+
+// Replaces the receiver on top of the stack with klass.name bound to it
+void VM::bindMethod(VMClass* klass, Symbol name)
+{
+    VMClosure* method = klass->findMethod(name);
+    if (!method)
+    {
+        std::string_view lexeme = SymbolTable::name(name);
+        error("Undefined property '" + std::string(lexeme) + "'.", lexeme);
+    }
+
+    LiteralValue bound = makeRef<VMBoundMethod>(peek(0), Ref<VMClosure>(method));
+    peek(0) = std::move(bound);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Upvalues
+// Open upvalues form a list sorted by stack slot, so a variable captured by
+// several closures is shared, and closing a frame stops at its first slot.
+// ─────────────────────────────────────────────────────────────────────────────
+Ref<VMUpvalue> VM::captureUpvalue(LiteralValue* slot)
+{
+    VMUpvalue* previous = nullptr;
+    VMUpvalue* upvalue = openUpvalues.get();
+    while (upvalue && upvalue->location > slot)
+    {
+        previous = upvalue;
+        upvalue = upvalue->next.get();
+    }
+
+    if (upvalue && upvalue->location == slot) return Ref<VMUpvalue>(upvalue);
+
+    Ref<VMUpvalue> created = makeRef<VMUpvalue>(slot);
+    created->next = Ref<VMUpvalue>(upvalue);
+    if (previous) previous->next = created;
+    else openUpvalues = created;
+    return created;
+}
+
+void VM::closeUpvalues(LiteralValue* last)
+{
+    while (openUpvalues && openUpvalues->location >= last)
+    {
+        Ref<VMUpvalue> upvalue = openUpvalues;
+        upvalue->closed = *upvalue->location;
+        upvalue->location = &upvalue->closed;
+        openUpvalues = upvalue->next;
+        upvalue->next = nullptr;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Stack helpers
+// Slots above stackTop are always empty, so popping releases references.
+// ─────────────────────────────────────────────────────────────────────────────
+void VM::push(LiteralValue value)
+{
+    if (stackTop == stack.get() + stackMax) error("Stack overflow.");
+    *stackTop++ = std::move(value);
+}
+
+void VM::popN(int count)
+{
+    while (count-- > 0) *--stackTop = LiteralValue();
+}
+
+void VM::resetStack()
+{
+    closeUpvalues(stack.get());
+    popN(static_cast<int>(stackTop - stack.get()));
+    dropFrames(0);
+}
+
+void VM::dropFrames(int depth)
+{
+    while (frameCount > depth)
+    {
+        CallFrame& frame = frames[--frameCount];
+        endProfile(frame);
+        frame.closure = nullptr;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Errors
+// ─────────────────────────────────────────────────────────────────────────────
+// vec3/quat/mat4 operator on the top two values, replaced by the result
+void VM::mathOperation(TokenType op, std::string_view lexeme)
+{
+    LiteralValue result = FlintMath::binary(op, peek(1), peek(0), errorToken(lexeme));
+    popN(2);
+    push(std::move(result));
+}
+
+Token VM::errorToken(std::string_view lexeme) const
+{
+    int line = 0;
+    if (frameCount > 0)
+    {
+        const CallFrame& frame = frames[frameCount - 1];
+        const Chunk& chunk = frame.closure->function->chunk;
+        size_t offset = frame.ip - chunk.code.data();
+        line = chunk.lines[offset > 0 ? offset - 1 : 0];
+    }
+    return Token(TokenType::IDENTIFIER, lexeme, nullptr, line);
+}
+
+void VM::error(const std::string& message, std::string_view lexeme) const
+{
+    throw RuntimeError(errorToken(lexeme), message);
+}
+
+void VM::checkBudget() const
+{
+    host.checkBudget(errorToken().line);
+}
@@ -0,0 +1,21 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// Entry Point: main()
+// ─────────────────────────────────────────────────────────────────────────────
+// Runs Flint in either batch mode (file passed via CLI) or interactive mode.
+// Usage: flint [--engine=tree|vm|closure] [-O|-O0] [--no-cache] [--lazy]
+//               [--profile[=FILE]] [--stats] [--gc-threshold=N] [--gc-growth=F]
+//               [--max-depth=N] [--threads=N] [--max-steps=N] [--time-limit=MS] [script]
+//
+// Kept apart from Flint.cpp so that other programs (flint_bench, hosts
+// embedding Flint) link the runtime without this main().
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <string>
+#include <vector>
+#include "Flint/Flint.h"
+
+int main(int argc, char const *argv[])
+{
+    Flint::main(std::vector<std::string>(argv + 1, argv + argc));
+    return 0;
+}
@@ -0,0 +1,26 @@
+# ─────────────────────────────────────────────────────────────────────────────
+# CompareOutput.cmake – runs flint on a script and checks what it prints
+#
+#     cmake -DFLINT=<flint> "-DARGS=--engine=vm|--no-cache" -DSCRIPT=test.flint
+#           -DEXPECTED=tests/test.expected -P tests/CompareOutput.cmake
+#
+# Run from the directory the script expects to run in.  Fails unless flint
+# exits cleanly and its standard output is exactly the EXPECTED file.
+# ARGS separates flint's options with '|'.
+# ─────────────────────────────────────────────────────────────────────────────
+string(REPLACE "|" ";" args "${ARGS}")
+string(REPLACE "|" " " shown "${ARGS}")
+execute_process(COMMAND ${FLINT} ${args} ${SCRIPT}
+                OUTPUT_VARIABLE output
+                ERROR_VARIABLE errors
+                RESULT_VARIABLE status)
+file(READ ${EXPECTED} expected)
+
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "flint ${shown} ${SCRIPT} exited with ${status}:\n${errors}")
+endif()
+if(NOT output STREQUAL expected)
+    file(WRITE ${SCRIPT}.out "${output}")
+    message(FATAL_ERROR "flint ${shown} ${SCRIPT} printed something other than ${EXPECTED} "
+                        "(written to ${SCRIPT}.out):\n${output}")
+endif()
@@ -0,0 +1,119 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  EmbeddingTest.cpp – The Embedding API, Driven From a C++ Host
+// ─────────────────────────────────────────────────────────────────────────────
+//  Usage: flint_embedding_test [--engine=tree|vm|closure]
+//
+//  Does what a host does (see Embedding.h): defines globals and natives made
+//  by makeNative(), runs a script that uses them, then calls the script's
+//  functions through FunctionHandles, including the error paths a wrong
+//  argument takes.  Prints each failed check and exits with status 1 if
+//  there was one.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Flint/Flint.h"
+#include "Flint/Embedding.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what)
+{
+    if (ok) return;
+    std::cerr << "FAILED: " << what << "\n";
+    ++failures;
+}
+
+// The message of the RuntimeError `call` throws, or "" if it throws none
+template <typename Call>
+std::string errorOf(Call&& call)
+{
+    try {
+        call();
+    } catch (const RuntimeError& error) {
+        return error.what();
+    }
+    return "";
+}
+
+const char* const SCRIPT = R"(
+let calls = 0;
+let mixed = lerp(0, 10, scale / 6);
+
+func update(dt) {
+    calls = calls + 1;
+    return lerp(0, dt, 0.5) * scale;
+}
+
+func shout(text) { return text + "!"; }
+
+func mixWrongly() { return lerp(1, "half", 2); }
+
+func explode() { return fail(7); }
+)";
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Flint flint;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--engine=tree") flint.engine = Engine::TREE_WALK;
+        else if (arg == "--engine=vm") flint.engine = Engine::VM;
+        else if (arg == "--engine=closure") flint.engine = Engine::CLOSURE;
+        else {
+            std::cerr << "Usage: flint_embedding_test [--engine=tree|vm|closure]\n";
+            return 64;
+        }
+    }
+
+    // Globals and natives from the host, used by the script
+    flint.define("scale", toValue(3));
+    flint.define("lerp", makeNative("lerp", [](double a, double b, double t) { return a + (b - a) * t; }));
+    flint.define("fail", makeNative("fail", [](int code) -> int {
+        throw std::runtime_error("code " + std::to_string(code));
+    }));
+
+    flint.run(SCRIPT);
+    check(!flint.hadError() && !flint.hadRuntimeError(), "the script runs without errors");
+
+    LiteralValue mixed = flint.global(SymbolTable::intern("mixed"));
+    check(mixed.isNumber() && mixed.asNumber() == 5, "the script calls a native with a defined global");
+
+    // Script functions, called from C++
+    FunctionHandle update = flint.function("update");
+    check(static_cast<bool>(update), "function() finds a script function");
+    LiteralValue result;
+    for (int i = 0; i < 4; ++i) result = update(2);
+    check(result.isNumber() && result.asNumber() == 3, "a handle passes C++ arguments and returns the result");
+    LiteralValue calls = flint.global(SymbolTable::intern("calls"));
+    check(calls.isNumber() && calls.asNumber() == 4, "every handle call runs the function");
+
+    FunctionHandle shout = flint.function("shout");
+    LiteralValue shouted = shout(std::string("hello"));
+    check(ValueTraits<std::string>::is(shouted) && ValueTraits<std::string>::get(shouted) == "hello!",
+          "strings convert both ways");
+
+    check(!flint.function("missing"), "function() of an undefined global is empty");
+    check(!flint.function("calls"), "function() of a global that is not callable is empty");
+
+    // Error paths: a native given the wrong type, a C++ exception, a wrong arity
+    FunctionHandle mixWrongly = flint.function("mixWrongly");
+    check(errorOf([&] { mixWrongly(); }) == "lerp() expects a number as argument 2.",
+          "a native rejects an argument of the wrong type");
+    FunctionHandle explode = flint.function("explode");
+    check(errorOf([&] { explode(); }) == "fail(): code 7",
+          "a C++ exception in a native comes back as a RuntimeError");
+    check(!errorOf([&] { update(); }).empty(), "a handle called with too few arguments throws");
+
+    flint.run("calls = calls + 1;");
+    calls = flint.global(SymbolTable::intern("calls"));
+    check(calls.isNumber() && calls.asNumber() == 5, "globals persist from one run to the next");
+
+    if (failures == 0) std::cout << "All embedding checks passed\n";
+    return failures == 0 ? 0 : 1;
+}